@@ -145,6 +145,22 @@ def make_3gx(tools: dict, elf: Path, plginfo: Path, out_3gx: Path, verbose: bool
     cmd = [tools["gxtool"], str(elf), str(plginfo), str(out_3gx)]
     run(cmd, verbose)
 
+def regen_hook_tables(verbose: bool) -> None:
+    # plugin/src/hooks_table.cpp is generated from addresses/*.yml. Re-run the
+    # generator when a YAML file (or the HookId enum) is newer than the table.
+    out = HERE / "plugin" / "src" / "hooks_table.cpp"
+    gen = HERE / "scripts" / "gen_hook_tables.py"
+    inputs = sorted((HERE / "addresses").glob("*.yml")) + [HERE / "plugin" / "include" / "core" / "hooks.hpp", gen]
+    if out.exists() and all(p.stat().st_mtime_ns <= out.stat().st_mtime_ns for p in inputs if p.exists()):
+        return
+    try:
+        import yaml  # noqa: F401
+    except ModuleNotFoundError:
+        print("WARNING: pyyaml not installed; using the checked-in hooks_table.cpp", file=sys.stderr)
+        return
+    print("Generating hook tables")
+    run([sys.executable, str(gen)], verbose)
+
 def main(argv: list[str]) -> int:
     ap = argparse.ArgumentParser()
     ap.add_argument("action", nargs="?", choices=["build","clean"], default="build")
@@ -172,6 +188,8 @@ def main(argv: list[str]) -> int:
 
     tools = resolve_toolchain(cfg, args.verbose)
 
+    regen_hook_tables(args.verbose)
+
     src_globs = cfg.get("sources_glob", ["Sources/**/*.cpp", "Sources/**/*.c", "Sources/**/*.s"])
     srcs = glob_sources(src_globs)
     if not srcs:
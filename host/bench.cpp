@@ -0,0 +1,256 @@
+// host/bench.cpp
+//
+// Engine-layer microbenchmarks. For the hot event kinds (HpChange,
+// RngCall, Kill) three numbers are reported:
+//
+//   entry_<kind>     Engine::On*() as the hook stub calls it: context
+//                    build, trace / log gates, bus dispatch.
+//   dispatch_<kind>  Dispatch*() on a prebuilt context: bus only.
+//   ctx_<kind>       entry - dispatch, i.e. context construction and
+//                    the gates in front of the bus.
+//
+// plus module_<tag>_<kind> for every built-in module handler, called
+// directly with a prebuilt context, and events_per_sec for a mixed
+// stream of the three kinds through the entrypoints.
+//
+// Deferred events are drained inside the timed loop (the bus drains on
+// overflow and the harness drains once at the end), so the dispatch
+// numbers include the deferred handlers' work.
+
+#include "host_harness.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core/runtime.hpp"
+#include "engine/builtin_modules.hpp"
+#include "engine/bus.hpp"
+#include "engine/events.hpp"
+
+using namespace Fates;
+using namespace Fates::Engine;
+
+namespace FatesHost {
+namespace {
+
+constexpr std::uint32_t kUnitCount = 32;
+
+std::uint32_t gIters = 1000000;
+
+// Time 'body' over gIters iterations, deferred drain included.
+template <typename Fn>
+double TimeNsPerIter(Fn &&body)
+{
+    const u64 t0 = NowTicks();
+    for (std::uint32_t i = 0; i < gIters; ++i)
+        body(i);
+    DrainDeferredEvents();
+    const u64 t1 = NowTicks();
+
+    return TicksToNs(t1 - t0) / static_cast<double>(gIters);
+}
+
+void ReportEntryVsDispatch(const char *kind, double entryNs, double dispatchNs)
+{
+    char name[64];
+
+    std::snprintf(name, sizeof(name), "entry_%s", kind);
+    Result(name, entryNs, "ns");
+    std::snprintf(name, sizeof(name), "dispatch_%s", kind);
+    Result(name, dispatchNs, "ns");
+    std::snprintf(name, sizeof(name), "ctx_%s", kind);
+    Result(name, entryNs > dispatchNs ? entryNs - dispatchNs : 0.0, "ns");
+}
+
+HpChangeContext MakeHpContext(std::uint32_t i)
+{
+    HpChangeContext hc{};
+    hc.core          = HpEvent(UnitHandle(FakeUnit((i + 1) % kUnitCount)),
+                               UnitHandle(FakeUnit(i % kUnitCount)),
+                               (i & 3) ? 7 : -3, 0u, nullptr);
+    hc.map.seqRoot    = gMapState.seqRoot;
+    hc.map.generation = gMapState.generation;
+    hc.turn.map       = hc.map;
+    hc.turn.side      = TurnSide::Side0;
+    return hc;
+}
+
+RngContext MakeRngContext(std::uint32_t i)
+{
+    RngContext rc{};
+    rc.map.generation = gMapState.generation;
+    rc.turn.map       = rc.map;
+    rc.turn.side      = TurnSide::Side0;
+    rc.state          = FakePtr(0x0C000000u);
+    rc.raw            = i * 2654435761u;
+    rc.bound          = 100;
+    rc.result         = rc.raw % 100;
+    return rc;
+}
+
+KillContext MakeKillContext(std::uint32_t i)
+{
+    KillContext kc{};
+    kc.core.seq       = FakePtr(0x0C100000u);
+    kc.core.dead0     = FakeUnit(i % kUnitCount);
+    kc.core.dead1     = nullptr;
+    kc.map.generation = gMapState.generation;
+    kc.turn.map       = kc.map;
+    kc.turn.side      = TurnSide::Side0;
+    return kc;
+}
+
+void BenchHpChange()
+{
+    const double entry = TimeNsPerIter([](std::uint32_t i) {
+        OnHpChange(FakeUnit((i + 1) % kUnitCount), FakeUnit(i % kUnitCount),
+                   (i & 3) ? 7 : -3, 0u, nullptr, TurnSide::Side0);
+    });
+
+    HpChangeContext ctx[kUnitCount];
+    for (std::uint32_t i = 0; i < kUnitCount; ++i)
+        ctx[i] = MakeHpContext(i);
+
+    const double dispatch = TimeNsPerIter([&](std::uint32_t i) {
+        DispatchHpChange(ctx[i % kUnitCount]);
+    });
+
+    ReportEntryVsDispatch("hp_change", entry, dispatch);
+}
+
+void BenchRng()
+{
+    const double entry = TimeNsPerIter([](std::uint32_t i) {
+        const std::uint32_t raw = i * 2654435761u;
+        OnRngCall(FakePtr(0x0C000000u), raw, 100, raw % 100);
+    });
+
+    const RngContext ctx = MakeRngContext(1);
+    const double dispatch = TimeNsPerIter([&](std::uint32_t) {
+        DispatchRngCall(ctx);
+    });
+
+    ReportEntryVsDispatch("rng", entry, dispatch);
+}
+
+void BenchKill()
+{
+    const double entry = TimeNsPerIter([](std::uint32_t i) {
+        KillEvent ev{};
+        ev.seq   = FakePtr(0x0C100000u);
+        ev.dead0 = FakeUnit(i % kUnitCount);
+        OnKill(ev, TurnSide::Side0);
+    });
+
+    KillContext ctx[kUnitCount];
+    for (std::uint32_t i = 0; i < kUnitCount; ++i)
+        ctx[i] = MakeKillContext(i);
+
+    const double dispatch = TimeNsPerIter([&](std::uint32_t i) {
+        DispatchKill(ctx[i % kUnitCount]);
+    });
+
+    ReportEntryVsDispatch("kill", entry, dispatch);
+}
+
+template <EventKind K, typename Ctx>
+void BenchModuleHandler(const ModuleDef &m, const char *kind, const Ctx &ctx)
+{
+    const auto fn = HandlerOf<K>(m);
+    if (fn == nullptr)
+        return;
+
+    const double ns = TimeNsPerIter([&](std::uint32_t) { fn(ctx); });
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "module_%s_%s", m.tag, kind);
+    Result(name, ns, "ns");
+}
+
+void BenchModules()
+{
+    const HpChangeContext hc = MakeHpContext(3);
+    const RngContext      rc = MakeRngContext(3);
+    const KillContext     kc = MakeKillContext(3);
+
+    BuiltinModuleList::ForEach([&](const ModuleDef &m) {
+        BenchModuleHandler<EventKind::HpChange>(m, "hp_change", hc);
+        BenchModuleHandler<EventKind::RngCall>(m, "rng", rc);
+        BenchModuleHandler<EventKind::Kill>(m, "kill", kc);
+    });
+}
+
+// Mixed stream shaped like a combat round: mostly RNG, some HP
+// changes, the odd kill.
+void BenchMixed()
+{
+    const double ns = TimeNsPerIter([](std::uint32_t i) {
+        const std::uint32_t raw = i * 2654435761u;
+        switch (i & 7)
+        {
+        case 0:
+        case 4:
+            OnHpChange(nullptr, FakeUnit(i % kUnitCount), 5, 0u, nullptr, TurnSide::Side0);
+            break;
+        case 7:
+            if ((i & 63) == 63)
+            {
+                KillEvent ev{};
+                ev.dead0 = FakeUnit(i % kUnitCount);
+                OnKill(ev, TurnSide::Side0);
+                break;
+            }
+            [[fallthrough]];
+        default:
+            OnRngCall(FakePtr(0x0C000000u), raw, 100, raw % 100);
+            break;
+        }
+    });
+
+    Result("mixed_ns_per_event", ns, "ns");
+    Result("events_per_sec", ns > 0.0 ? 1.0e9 / ns : 0.0, "ev/s");
+}
+
+} // namespace
+
+int Bench_Main(int argc, char **argv)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc)
+            gIters = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        else
+        {
+            std::fprintf(stderr, "[x] bench: unknown argument '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (gIters == 0)
+        gIters = 1;
+
+    std::printf("[bench] %u iteration(s) per case, %u builtin module(s)\n",
+                static_cast<unsigned>(gIters),
+                static_cast<unsigned>(BuiltinModuleList::kCount));
+
+    // One open map with a turn in progress, like a fight mid-chapter.
+    OnMapBegin(FakePtr(0x0C200000u), TurnSide::Side0);
+    OnTurnBegin(TurnSide::Side0);
+    PumpSinks();
+
+    BenchHpChange();
+    PumpSinks();
+    BenchRng();
+    PumpSinks();
+    BenchKill();
+    PumpSinks();
+    BenchModules();
+    PumpSinks();
+    BenchMixed();
+
+    OnTurnEnd(TurnSide::Side0, nullptr);
+    OnMapEnd(FakePtr(0x0C200000u), TurnSide::Side0);
+    return 0;
+}
+
+} // namespace FatesHost
@@ -0,0 +1,62 @@
+// host/host_harness.hpp
+//
+// Shared bits of the host harness (fates_host). The harness links the
+// engine layer (plugin/src/engine, plugin/src/util, plugin/src/runtime.cpp)
+// against the stub platform in host/include and drives it through the
+// same Engine::On* entrypoints the hook stubs use.
+//
+// Every measurement is printed as one machine-readable line:
+//
+//   RESULT <name> <value> <unit>
+//
+// scripts/build_host.py collects these lines for baseline comparison.
+// Units ending in "/s" are higher-is-better, everything else is
+// lower-is-better.
+
+#pragma once
+
+#include <3ds.h>
+
+#include <cstdint>
+
+namespace FatesHost {
+
+inline u64 NowTicks()
+{
+    return svcGetSystemTick();
+}
+
+inline double TicksToNs(u64 ticks)
+{
+    return static_cast<double>(ticks) * 1.0e9 / static_cast<double>(kHostTickHz);
+}
+
+// Print one RESULT line.
+void Result(const char *name, double value, const char *unit);
+
+// Give an opaque, stable fake Unit* for slot i. The engine only uses
+// unit pointers as keys on the paths the harness drives, so these are
+// never dereferenced.
+inline void *FakeUnit(std::uint32_t i)
+{
+    return reinterpret_cast<void *>(static_cast<std::uintptr_t>(0x08100000u + (i << 9)));
+}
+
+inline void *FakePtr(std::uint32_t raw)
+{
+    return reinterpret_cast<void *>(static_cast<std::uintptr_t>(raw));
+}
+
+// Drain the log / trace / RNG / history sinks the way DebugThread
+// does. Called outside the timed sections.
+void PumpSinks();
+
+// Flush every sink (end of run).
+void FlushSinks();
+
+// Subcommands (host_main.cpp dispatches). Return the process exit code.
+int Bench_Main(int argc, char **argv);
+int Replay_Main(int argc, char **argv);
+int GenTrace_Main(int argc, char **argv);
+
+} // namespace FatesHost
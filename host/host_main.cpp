@@ -0,0 +1,83 @@
+// host/host_main.cpp
+//
+// fates_host: engine-layer benchmark and trace replay on a PC.
+//
+//   fates_host bench  [--iters N]
+//   fates_host replay <fates_trace.bin> [--repeat N]
+//   fates_host gen    <out.bin> [--maps N] [--turns N] [--seed N]
+//
+// Build and run through scripts/build_host.py.
+
+#include "host_harness.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "core/runtime.hpp"
+#include "engine/builtin_modules.hpp"
+#include "engine/rng_recorder.hpp"
+#include "engine/trace.hpp"
+#include "util/debug_log.hpp"
+
+namespace FatesHost {
+
+void Result(const char *name, double value, const char *unit)
+{
+    std::printf("RESULT %s %.3f %s\n", name, value, unit);
+    std::fflush(stdout);
+}
+
+void PumpSinks()
+{
+    Log_Pump();
+    Fates::Engine::Trace_Pump();
+    Fates::Engine::RngRec_Pump();
+    Fates::Engine::History_Pump();
+}
+
+void FlushSinks()
+{
+    Fates::Engine::Trace_Flush();
+    Fates::Engine::RngRec_Flush();
+    Fates::Engine::History_Pump();
+    Log_Flush();
+}
+
+} // namespace FatesHost
+
+static int Usage()
+{
+    std::fprintf(stderr,
+                 "usage:\n"
+                 "  fates_host bench  [--iters N]\n"
+                 "  fates_host replay <fates_trace.bin> [--repeat N]\n"
+                 "  fates_host gen    <out.bin> [--maps N] [--turns N] [--seed N]\n");
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+        return Usage();
+
+    // Same bring-up order as MainImpl: runtime state, then modules.
+    Fates::ResetMapState();
+    if (!Fates::Engine::BuiltinModules_RegisterHandlers())
+    {
+        std::fprintf(stderr, "[x] module registration failed\n");
+        return 1;
+    }
+
+    int rc;
+    if (std::strcmp(argv[1], "bench") == 0)
+        rc = FatesHost::Bench_Main(argc - 2, argv + 2);
+    else if (std::strcmp(argv[1], "replay") == 0)
+        rc = FatesHost::Replay_Main(argc - 2, argv + 2);
+    else if (std::strcmp(argv[1], "gen") == 0)
+        rc = FatesHost::GenTrace_Main(argc - 2, argv + 2);
+    else
+        rc = Usage();
+
+    FatesHost::FlushSinks();
+    return rc;
+}
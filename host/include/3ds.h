@@ -0,0 +1,197 @@
+// host/include/3ds.h
+//
+// Host stand-in for the libctru surface the engine layer uses
+// (plugin/src/engine, plugin/src/util, plugin/src/runtime.cpp). Only
+// what those files call is here; anything else failing to compile
+// means new code reached past the engine layer into the platform.
+//
+//   svcGetSystemTick  -> steady clock scaled to the 3DS tick rate
+//                        (268.111856 MHz), so tick maths is unchanged
+//   svcSleepThread    -> nanosleep
+//   osGetTime         -> wall clock, ms since 1900 like libctru
+//   LightLock         -> test-and-set spin lock
+//   threadCreate etc. -> pthreads (core / priority ignored)
+//   LightEvent        -> mutex + condition variable
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include <pthread.h>
+
+typedef std::uint8_t  u8;
+typedef std::uint16_t u16;
+typedef std::uint32_t u32;
+typedef std::uint64_t u64;
+typedef std::int8_t   s8;
+typedef std::int16_t  s16;
+typedef std::int32_t  s32;
+typedef std::int64_t  s64;
+
+typedef s32 Result;
+typedef u32 Handle;
+
+constexpr u64 kHostTickHz = 268111856ULL;
+
+inline u64 svcGetSystemTick(void)
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    const unsigned __int128 ns =
+        static_cast<unsigned __int128>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    return static_cast<u64>(ns * kHostTickHz / 1000000000ULL);
+}
+
+inline void svcSleepThread(s64 ns)
+{
+    if (ns <= 0)
+        return;
+
+    timespec ts;
+    ts.tv_sec  = static_cast<time_t>(ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+    nanosleep(&ts, nullptr);
+}
+
+// Milliseconds since 1900-01-01.
+inline u64 osGetTime(void)
+{
+    constexpr u64 kUnixTo1900Ms = 2208988800ULL * 1000ULL;
+
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return kUnixTo1900Ms + static_cast<u64>(ts.tv_sec) * 1000ULL +
+           static_cast<u64>(ts.tv_nsec / 1000000L);
+}
+
+typedef s32 LightLock;
+
+inline void LightLock_Init(LightLock *lock)
+{
+    *lock = 0;
+}
+
+inline void LightLock_Lock(LightLock *lock)
+{
+    while (__sync_lock_test_and_set(lock, 1))
+    {
+    }
+}
+
+// 0 if the lock was taken, like libctru.
+inline int LightLock_TryLock(LightLock *lock)
+{
+    return __sync_lock_test_and_set(lock, 1) ? 1 : 0;
+}
+
+inline void LightLock_Unlock(LightLock *lock)
+{
+    __sync_lock_release(lock);
+}
+
+#define CUR_THREAD_HANDLE 0xFFFF8000
+
+inline Result svcGetThreadPriority(s32 *out, Handle)
+{
+    *out = 0x30;
+    return 0;
+}
+
+typedef void (*ThreadFunc)(void *);
+
+struct HostThread
+{
+    pthread_t  handle;
+    ThreadFunc fn;
+    void      *arg;
+};
+
+typedef HostThread *Thread;
+
+inline void *HostThreadEntry(void *p)
+{
+    HostThread *t = static_cast<HostThread *>(p);
+    t->fn(t->arg);
+    return nullptr;
+}
+
+inline Thread threadCreate(ThreadFunc fn, void *arg, std::size_t, int, int, bool)
+{
+    HostThread *t = new HostThread{ pthread_t(), fn, arg };
+    if (pthread_create(&t->handle, nullptr, &HostThreadEntry, t) != 0)
+    {
+        delete t;
+        return nullptr;
+    }
+    return t;
+}
+
+// The timeout is ignored; joins always wait.
+inline Result threadJoin(Thread t, u64)
+{
+    return pthread_join(t->handle, nullptr) == 0 ? 0 : -1;
+}
+
+inline void threadFree(Thread t)
+{
+    delete t;
+}
+
+typedef enum
+{
+    RESET_ONESHOT = 0,
+    RESET_STICKY  = 1,
+    RESET_PULSE   = 2,
+} ResetType;
+
+struct LightEvent
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    bool            signalled;
+    ResetType       type;
+};
+
+inline void LightEvent_Init(LightEvent *ev, ResetType type)
+{
+    pthread_mutex_init(&ev->mutex, nullptr);
+    pthread_cond_init(&ev->cond, nullptr);
+    ev->signalled = false;
+    ev->type      = type;
+}
+
+inline void LightEvent_Signal(LightEvent *ev)
+{
+    pthread_mutex_lock(&ev->mutex);
+    ev->signalled = true;
+    pthread_cond_broadcast(&ev->cond);
+    pthread_mutex_unlock(&ev->mutex);
+}
+
+// 0 if signalled, 1 on timeout (libctru convention).
+inline int LightEvent_WaitTimeout(LightEvent *ev, s64 timeoutNs)
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec  += static_cast<time_t>(timeoutNs / 1000000000LL);
+    deadline.tv_nsec += static_cast<long>(timeoutNs % 1000000000LL);
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_nsec -= 1000000000L;
+        ++deadline.tv_sec;
+    }
+
+    pthread_mutex_lock(&ev->mutex);
+    while (!ev->signalled)
+    {
+        if (pthread_cond_timedwait(&ev->cond, &ev->mutex, &deadline) != 0)
+            break;
+    }
+    const bool got = ev->signalled;
+    if (got && ev->type != RESET_STICKY)
+        ev->signalled = false;
+    pthread_mutex_unlock(&ev->mutex);
+    return got ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+// host/include/CTRPluginFramework.hpp
+//
+// Host stand-in for the CTRPF pieces the engine layer uses: File,
+// Directory and System. Paths starting with "sdmc:/" are mapped under the host SD
+// root, $FATES_HOST_SDMC or ./host_sdmc by default, so the log, trace,
+// RNG and history sinks write the same files they would on the card.
+//
+// Return values follow CTRPF: 0 on success, non-zero on failure.
+
+#pragma once
+
+#include <3ds.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CTRPluginFramework {
+
+inline std::string HostPath(const std::string &path)
+{
+    static const char kPrefix[] = "sdmc:/";
+    if (path.compare(0, sizeof(kPrefix) - 1, kPrefix) != 0)
+        return path;
+
+    const char *root = std::getenv("FATES_HOST_SDMC");
+    std::string out  = (root && *root) ? root : "host_sdmc";
+    out += '/';
+    out += path.substr(sizeof(kPrefix) - 1);
+    return out;
+}
+
+class System
+{
+public:
+    static bool IsNew3DS() { return false; }
+};
+
+class Directory
+{
+public:
+    // Creates every missing component; 0 if the directory exists after.
+    static int Create(const std::string &path)
+    {
+        std::string p = HostPath(path);
+        for (std::size_t i = 1; i <= p.size(); ++i)
+        {
+            if (i == p.size() || p[i] == '/')
+            {
+                std::string part = p.substr(0, i);
+                if (::mkdir(part.c_str(), 0755) != 0 && errno != EEXIST)
+                    return -1;
+            }
+        }
+        return 0;
+    }
+};
+
+class File
+{
+public:
+    enum Mode
+    {
+        READ     = 1,
+        WRITE    = 1 << 1,
+        CREATE   = 1 << 2,
+        APPEND   = 1 << 3,
+        TRUNCATE = 1 << 4,
+        RW       = READ | WRITE,
+        RWC      = READ | WRITE | CREATE,
+    };
+
+    enum SeekPos
+    {
+        CUR,
+        SET,
+        END,
+    };
+
+    File() = default;
+    File(const File &) = delete;
+    File &operator=(const File &) = delete;
+    ~File() { Close(); }
+
+    static int Open(File &out, const std::string &path, int mode = READ)
+    {
+        out.Close();
+
+        int flags = 0;
+        if ((mode & READ) && (mode & WRITE))
+            flags = O_RDWR;
+        else if (mode & WRITE)
+            flags = O_WRONLY;
+        else
+            flags = O_RDONLY;
+        if (mode & CREATE)
+            flags |= O_CREAT;
+        if (mode & TRUNCATE)
+            flags |= O_TRUNC;
+        if (mode & APPEND)
+            flags |= O_APPEND;
+
+        out._fd   = ::open(HostPath(path).c_str(), flags, 0644);
+        out._mode = mode;
+        return out._fd >= 0 ? 0 : -1;
+    }
+
+    static int Exists(const std::string &path)
+    {
+        struct stat st;
+        return ::stat(HostPath(path).c_str(), &st) == 0 && S_ISREG(st.st_mode);
+    }
+
+    static int Remove(const std::string &path)
+    {
+        return ::unlink(HostPath(path).c_str()) == 0 ? 0 : -1;
+    }
+
+    int Read(void *buffer, u32 length) const
+    {
+        if (_fd < 0)
+            return -1;
+        return ::read(_fd, buffer, length) == static_cast<ssize_t>(length) ? 0 : -1;
+    }
+
+    int Write(const void *data, u32 length)
+    {
+        if (_fd < 0)
+            return -1;
+        return ::write(_fd, data, length) == static_cast<ssize_t>(length) ? 0 : -1;
+    }
+
+    int Seek(s64 offset, SeekPos origin = CUR) const
+    {
+        if (_fd < 0)
+            return -1;
+
+        const int whence = origin == SET ? SEEK_SET : origin == END ? SEEK_END : SEEK_CUR;
+        return ::lseek(_fd, static_cast<off_t>(offset), whence) < 0 ? -1 : 0;
+    }
+
+    u64 Tell() const
+    {
+        if (_fd < 0)
+            return 0;
+        off_t pos = ::lseek(_fd, 0, SEEK_CUR);
+        return pos < 0 ? 0 : static_cast<u64>(pos);
+    }
+
+    u64 GetSize() const
+    {
+        struct stat st;
+        if (_fd < 0 || ::fstat(_fd, &st) != 0)
+            return 0;
+        return static_cast<u64>(st.st_size);
+    }
+
+    int Flush() const
+    {
+        return _fd >= 0 && ::fsync(_fd) == 0 ? 0 : -1;
+    }
+
+    int Close() const
+    {
+        if (_fd < 0)
+            return 0;
+        ::close(_fd);
+        _fd = -1;
+        return 0;
+    }
+
+    bool IsOpen() const { return _fd >= 0; }
+
+private:
+    mutable int _fd   = -1;
+    int         _mode = 0;
+};
+
+} // namespace CTRPluginFramework
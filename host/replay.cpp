@@ -0,0 +1,510 @@
+// host/replay.cpp
+//
+// Trace replay and synthetic trace generation.
+//
+// replay: feeds a recorded sdmc:/Fates3GX/fates_trace.bin (engine/trace.hpp)
+// back through the Engine::On* entrypoints, in order, and reports the
+// engine's throughput on that real event mix. Pointers in the trace are
+// 32-bit 3DS addresses; they come back as opaque keys, which is all the
+// engine does with them on these paths. Fields the trace doesn't carry
+// (ItemGain seq helper, action cmdData) are passed as null.
+// BattleBegin records carry the decoded battle, so they go through
+// OnBattleBegin rather than decoding the (fake) calculator again.
+// HpSync records are fed back through OnUnitHpSync, which re-runs the
+// coalescing; the coalesced HpChange records it produced on hardware
+// are skipped so they aren't counted twice.
+//
+// gen: writes a synthetic trace in the same format (combat-shaped maps:
+// turns of actions that roll RNG, change HP and sometimes kill), so the
+// replay numbers can be tracked without hardware.
+
+#include "host_harness.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/runtime.hpp"
+#include "engine/events.hpp"
+#include "engine/trace.hpp"
+
+using namespace Fates;
+using namespace Fates::Engine;
+
+namespace FatesHost {
+namespace {
+
+// Records replayed between two sink pumps. The pumps run outside the
+// timed section, like DebugThread does on hardware.
+constexpr std::size_t kReplayChunk = 512;
+
+constexpr std::uint16_t kKindCount = static_cast<std::uint16_t>(EventKind::UnitPrewarm) + 1;
+
+bool LoadTrace(const char *path, std::vector<TraceRecord> &out)
+{
+    FILE *f = std::fopen(path, "rb");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "[x] replay: cannot open %s\n", path);
+        return false;
+    }
+
+    std::fseek(f, 0, SEEK_END);
+    const long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+
+    if (size < static_cast<long>(sizeof(TraceRecord)))
+    {
+        std::fprintf(stderr, "[x] replay: %s is empty\n", path);
+        std::fclose(f);
+        return false;
+    }
+    if (size % sizeof(TraceRecord) != 0)
+        std::fprintf(stderr, "[!] replay: trailing %ld byte(s) ignored\n",
+                     size % static_cast<long>(sizeof(TraceRecord)));
+
+    out.resize(static_cast<std::size_t>(size) / sizeof(TraceRecord));
+    const std::size_t got = std::fread(out.data(), sizeof(TraceRecord), out.size(), f);
+    std::fclose(f);
+    out.resize(got);
+
+    const TraceRecord &h = out[0];
+    if (h.kind != kTraceKindHeader || h.arg[0] != kTraceMagic)
+    {
+        std::fprintf(stderr, "[x] replay: %s is not a fates trace\n", path);
+        return false;
+    }
+    if (h.arg[1] != kTraceVersion || h.generation != sizeof(TraceRecord))
+    {
+        std::fprintf(stderr, "[x] replay: unsupported trace version %u / record size %u\n",
+                     static_cast<unsigned>(h.arg[1]), static_cast<unsigned>(h.generation));
+        return false;
+    }
+    return true;
+}
+
+// The hook stubs, not the engine, keep gMapState / gCurrentTurnSide
+// current (MapLife_* in hooks_handlers.cpp). Mirror that here so the
+// engine sees the same map / turn state it did on hardware.
+void HookStateMapBegin(void *seq, TurnSide side)
+{
+    gMapState.seqRoot     = seq;
+    ++gMapState.generation;
+    gMapState.startSide   = side;
+    gMapState.currentSide = side;
+    gMapState.totalTurns  = 0;
+    for (int i = 0; i < 4; ++i)
+        gMapState.turnCount[i] = 0;
+    gMapState.killEvents  = 0;
+    gMapState.mapActive   = true;
+    ResetKillEvents();
+    ResetMapStats();
+}
+
+void HookStateTurnBegin(TurnSide side)
+{
+    gCurrentTurnSide      = side;
+    gMapState.currentSide = side;
+    ++gMapState.totalTurns;
+
+    const int idx = static_cast<int>(side);
+    if (0 <= idx && idx <= 3)
+        ++gMapState.turnCount[idx];
+}
+
+// One record -> the entrypoint that produced it. Returns false for
+// records that aren't events (session headers, unknown kinds).
+bool ReplayRecord(const TraceRecord &r)
+{
+    const TurnSide side = static_cast<TurnSide>(r.side);
+    const std::uint32_t *a = r.arg;
+
+    switch (static_cast<EventKind>(r.kind))
+    {
+    case EventKind::MapBegin:
+        HookStateMapBegin(FakePtr(a[0]), side);
+        OnMapBegin(FakePtr(a[0]), side);
+        return true;
+    case EventKind::MapEnd:
+        OnMapEnd(FakePtr(a[0]), side);
+        gMapState.mapActive = false;
+        return true;
+    case EventKind::TurnBegin:
+        HookStateTurnBegin(side);
+        OnTurnBegin(side);
+        return true;
+    case EventKind::TurnEnd:
+        OnTurnEnd(side, FakePtr(a[2]));
+        return true;
+    case EventKind::Kill:
+    {
+        KillEvent ev{};
+        ev.seq   = FakePtr(a[0]);
+        ev.dead0 = FakePtr(a[1]);
+        ev.dead1 = FakePtr(a[2]);
+        ev.flags = a[3];
+        PushKillEvent(ev);
+        OnKill(ev, side);
+        return true;
+    }
+    case EventKind::RngCall:
+        OnRngCall(FakePtr(a[0]), a[1], a[2], a[3]);
+        return true;
+    case EventKind::LevelUp:
+        OnUnitLevelUp(FakePtr(a[0]), static_cast<std::uint8_t>(a[1]), side);
+        return true;
+    case EventKind::SkillLearn:
+        OnUnitSkillLearn(FakePtr(a[0]),
+                         static_cast<std::uint16_t>(a[1] & 0xFFFFu),
+                         static_cast<std::uint16_t>(a[1] >> 16),
+                         static_cast<int>(a[2]), side);
+        return true;
+    case EventKind::ItemGain:
+        OnItemGain(nullptr, FakePtr(a[0]), FakePtr(a[1]), FakePtr(a[2]),
+                   static_cast<int>(a[3]), side);
+        return true;
+    case EventKind::HpChange:
+        if (a[3] & kHpFlag_Coalesced)
+            return false;
+        OnHpChange(FakePtr(a[0]), FakePtr(a[1]), static_cast<int>(a[2]), a[3],
+                   nullptr, side);
+        return true;
+    case EventKind::HpSync:
+        // The recorded previous HP is the baseline for a unit the
+        // tracker hasn't seen yet, as the clone's is on hardware.
+        OnUnitHpSync(FakePtr(a[0]), static_cast<int>(a[3]), static_cast<int>(a[2]));
+        return true;
+    case EventKind::ActionEnd:
+    case EventKind::UnitMove:
+    {
+        ActionEvent ev;
+        ev.inst    = FakePtr(a[0]);
+        ev.cmdId   = a[1];
+        ev.sideRaw = a[2];
+        ev.unk28   = a[3];
+        if (r.kind == static_cast<std::uint16_t>(EventKind::ActionEnd))
+            OnActionEnd(ev, side);
+        else
+            OnUnitMove(ev, side);
+        return true;
+    }
+    case EventKind::ItemUse:
+    {
+        ActionEvent ev;
+        ev.inst    = FakePtr(a[0]);
+        ev.unit    = UnitHandle(FakePtr(a[1]));
+        ev.cmdId   = a[2];
+        ev.sideRaw = a[3];
+        OnItemUse(ev, side);
+        return true;
+    }
+    case EventKind::UnitPrewarm:
+        OnUnitCarryOver(FakePtr(a[0]), static_cast<int>(a[1]), static_cast<int>(a[2]),
+                      static_cast<int>(a[3]));
+        return true;
+    case EventKind::BattleBegin:
+    {
+        BattleContext bc;
+        bc.calc     = FakePtr(a[0]);
+        bc.root     = FakePtr(a[1]);
+        bc.attacker = UnitHandle(FakePtr(a[2]));
+        bc.defender = UnitHandle(FakePtr(a[3]));
+        OnBattleBegin(bc, side);
+        return true;
+    }
+    case EventKind::BattleEnd:
+        OnBattleEnd(side);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Small xorshift so generated traces are reproducible from the seed.
+struct GenRng
+{
+    std::uint32_t s;
+
+    std::uint32_t Next()
+    {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+
+    std::uint32_t Below(std::uint32_t n) { return Next() % n; }
+};
+
+struct GenWriter
+{
+    FILE         *f;
+    std::uint64_t tick;
+    std::uint32_t generation;
+    std::uint32_t count;
+
+    void Put(EventKind kind, TurnSide side, std::uint32_t a0, std::uint32_t a1 = 0,
+             std::uint32_t a2 = 0, std::uint32_t a3 = 0)
+    {
+        TraceRecord r{};
+        tick += 2000;
+        r.tick       = tick;
+        r.kind       = static_cast<std::uint16_t>(kind);
+        r.side       = static_cast<std::uint8_t>(side);
+        r.generation = generation;
+        r.arg[0] = a0;
+        r.arg[1] = a1;
+        r.arg[2] = a2;
+        r.arg[3] = a3;
+        std::fwrite(&r, sizeof(r), 1, f);
+        ++count;
+    }
+};
+
+} // namespace
+
+int Replay_Main(int argc, char **argv)
+{
+    const char *path   = nullptr;
+    unsigned    repeat = 1;
+
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+        else if (path == nullptr && argv[i][0] != '-')
+            path = argv[i];
+        else
+        {
+            std::fprintf(stderr, "[x] replay: unknown argument '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (path == nullptr)
+    {
+        std::fprintf(stderr, "[x] replay: no trace file given\n");
+        return 2;
+    }
+    if (repeat == 0)
+        repeat = 1;
+
+    std::vector<TraceRecord> records;
+    if (!LoadTrace(path, records))
+        return 1;
+
+    std::uint64_t perKind[kKindCount] = {};
+    std::uint64_t events   = 0;
+    std::uint64_t skipped  = 0;
+    u64           busyTick = 0;
+
+    for (unsigned pass = 0; pass < repeat; ++pass)
+    {
+        for (std::size_t base = 0; base < records.size(); base += kReplayChunk)
+        {
+            const std::size_t end = (base + kReplayChunk < records.size())
+                                        ? base + kReplayChunk
+                                        : records.size();
+
+            const u64 t0 = NowTicks();
+            for (std::size_t i = base; i < end; ++i)
+            {
+                if (ReplayRecord(records[i]))
+                    ++perKind[records[i].kind];
+                else
+                    ++skipped;
+            }
+            busyTick += NowTicks() - t0;
+
+            PumpSinks();
+        }
+    }
+
+    for (std::uint16_t k = 0; k < kKindCount; ++k)
+        events += perKind[k];
+
+    std::printf("[replay] %s: %zu record(s) x %u, %llu event(s), %llu skipped, %llu map(s)\n",
+                path, records.size(), repeat,
+                static_cast<unsigned long long>(events),
+                static_cast<unsigned long long>(skipped),
+                static_cast<unsigned long long>(perKind[static_cast<int>(EventKind::MapEnd)]));
+
+    const double ns = TicksToNs(busyTick);
+    Result("replay_events", static_cast<double>(events), "events");
+    Result("replay_ns_per_event", events ? ns / static_cast<double>(events) : 0.0, "ns");
+    Result("replay_events_per_sec", ns > 0.0 ? static_cast<double>(events) * 1.0e9 / ns : 0.0, "ev/s");
+    return 0;
+}
+
+int GenTrace_Main(int argc, char **argv)
+{
+    const char   *path  = nullptr;
+    unsigned      maps  = 4;
+    unsigned      turns = 20;
+    std::uint32_t seed  = 0x3D5F17E5u;
+
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--maps") == 0 && i + 1 < argc)
+            maps = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+        else if (std::strcmp(argv[i], "--turns") == 0 && i + 1 < argc)
+            turns = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 0));
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 0));
+        else if (path == nullptr && argv[i][0] != '-')
+            path = argv[i];
+        else
+        {
+            std::fprintf(stderr, "[x] gen: unknown argument '%s'\n", argv[i]);
+            return 2;
+        }
+    }
+    if (path == nullptr)
+    {
+        std::fprintf(stderr, "[x] gen: no output file given\n");
+        return 2;
+    }
+
+    FILE *f = std::fopen(path, "wb");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "[x] gen: cannot create %s\n", path);
+        return 1;
+    }
+
+    GenRng    rng{seed ? seed : 1u};
+    GenWriter w{f, 0, 0, 0};
+
+    TraceRecord header{};
+    header.kind       = kTraceKindHeader;
+    header.generation = sizeof(TraceRecord);
+    header.arg[0]     = kTraceMagic;
+    header.arg[1]     = kTraceVersion;
+    header.arg[2]     = static_cast<std::uint32_t>(kHostTickHz);
+    std::fwrite(&header, sizeof(header), 1, f);
+
+    constexpr std::uint32_t kSeqRoot   = 0x0C200000u;
+    constexpr std::uint32_t kRngState  = 0x0C000000u;
+    constexpr std::uint32_t kSeqBattle = 0x0C100000u;
+    constexpr std::uint32_t kBtlCalc   = 0x0C300000u;
+    constexpr std::uint32_t kBtlRoot   = 0x0C300400u;
+
+    constexpr std::uint32_t kGenUnits = 32;
+    constexpr int           kGenHp    = 60;
+
+    for (unsigned m = 0; m < maps; ++m)
+    {
+        w.generation = m + 1;
+        std::uint32_t totalTurns = 0;
+        std::uint32_t kills      = 0;
+        std::uint32_t sideTurn[2] = {};
+
+        int hp[kGenUnits];
+        for (int &h : hp)
+            h = kGenHp;
+
+        // From the second map on the last map's army is still indexed
+        // at map start: the hook carries it over.
+        if (m > 0)
+        {
+            for (std::uint32_t u = 0; u < kGenUnits; ++u)
+                w.Put(EventKind::UnitPrewarm, TurnSide::Unknown, 0x08100000u + (u << 9),
+                      static_cast<std::uint32_t>(kGenHp), 1 + u % 20, 0xFFFFFFFFu);
+        }
+
+        w.Put(EventKind::MapBegin, TurnSide::Side0, kSeqRoot, 0, 0, 0);
+
+        for (unsigned t = 0; t < turns; ++t)
+        {
+            const TurnSide side = (t & 1) ? TurnSide::Side1 : TurnSide::Side0;
+            ++totalTurns;
+            ++sideTurn[t & 1];
+
+            w.Put(EventKind::TurnBegin, side, sideTurn[t & 1], totalTurns);
+
+            const unsigned actions = 4 + rng.Below(8);
+            for (unsigned a = 0; a < actions; ++a)
+            {
+                const std::uint32_t atkIdx   = rng.Below(kGenUnits);
+                const std::uint32_t defIdx   = rng.Below(kGenUnits);
+                const std::uint32_t attacker = 0x08100000u + (atkIdx << 9);
+                const std::uint32_t defender = 0x08100000u + (defIdx << 9);
+
+                const std::uint32_t cmdId = 1 + rng.Below(4);
+                w.Put(EventKind::UnitMove, side, kSeqBattle, cmdId,
+                      static_cast<std::uint32_t>(side), 0);
+                if (rng.Below(32) == 0)
+                    w.Put(EventKind::ItemUse, side, kSeqBattle, attacker, cmdId,
+                          static_cast<std::uint32_t>(side));
+
+                // Defender unknown at begin, as on hardware.
+                w.Put(EventKind::BattleBegin, side, kBtlCalc, kBtlRoot, attacker, 0);
+
+                int atkLost = 0;
+                int defLost = 0;
+
+                // Hit, crit and skill rolls per strike, two to four strikes;
+                // each hit is one clone HP sync.
+                const unsigned strikes = 2 + rng.Below(3);
+                for (unsigned s = 0; s < strikes; ++s)
+                {
+                    for (int roll = 0; roll < 3; ++roll)
+                    {
+                        const std::uint32_t raw = rng.Next();
+                        w.Put(EventKind::RngCall, side, kRngState, raw, 100, raw % 100);
+                    }
+                    if (rng.Below(4) != 0 && hp[defIdx] > 0)
+                    {
+                        const int prev = hp[defIdx];
+                        const int dmg  = 1 + static_cast<int>(rng.Below(20));
+                        hp[defIdx] = prev > dmg ? prev - dmg : 0;
+                        defLost += prev - hp[defIdx];
+                        w.Put(EventKind::HpSync, side, defender, attacker,
+                              static_cast<std::uint32_t>(prev),
+                              static_cast<std::uint32_t>(hp[defIdx]));
+                    }
+                }
+
+                // Occasional heal on the attacker (skill / item proc).
+                if (rng.Below(16) == 0 && hp[atkIdx] > 0)
+                {
+                    const int prev = hp[atkIdx];
+                    hp[atkIdx] = prev + 5 + static_cast<int>(rng.Below(10));
+                    atkLost -= hp[atkIdx] - prev;
+                    w.Put(EventKind::HpSync, side, attacker, defender,
+                          static_cast<std::uint32_t>(prev),
+                          static_cast<std::uint32_t>(hp[atkIdx]));
+                }
+
+                std::uint32_t battleKills = 0;
+                if (hp[defIdx] == 0 && defLost > 0)
+                {
+                    ++kills;
+                    ++battleKills;
+                    w.Put(EventKind::Kill, side, kSeqBattle, defender, 0, 0);
+                }
+                if (rng.Below(24) == 0)
+                    w.Put(EventKind::LevelUp, side, attacker, 2 + rng.Below(18));
+
+                w.Put(EventKind::BattleEnd, side, attacker, defLost ? defender : 0,
+                      (static_cast<std::uint32_t>(atkLost) & 0xFFFFu) |
+                          (static_cast<std::uint32_t>(defLost) << 16),
+                      battleKills);
+
+                w.Put(EventKind::ActionEnd, side, kSeqBattle, cmdId,
+                      static_cast<std::uint32_t>(side), 0);
+            }
+
+            w.Put(EventKind::TurnEnd, side, sideTurn[t & 1], totalTurns, kSeqRoot);
+        }
+
+        w.Put(EventKind::MapEnd, TurnSide::Side0, kSeqRoot, totalTurns, kills, 0);
+    }
+
+    std::fclose(f);
+    std::printf("[gen] %s: %u map(s), %u record(s)\n", path, maps,
+                static_cast<unsigned>(w.count + 1));
+    return 0;
+}
+
+} // namespace FatesHost
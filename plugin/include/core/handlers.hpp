@@ -4,7 +4,8 @@
 // hook mechanism for each hook defined in hook_catalog_v6.  Each
 // function is implemented in plugin/src/hooks_handlers.cpp and is
 // responsible for bumping a hit counter and (eventually) calling back
-// into the original game code via CTRPluginFramework::HookContext.
+// into the original game code via HookCallOriginal (core/inline_hook.hpp),
+// which works for both hook backends.
 //
 // All signatures here are derived from docs/hooks/hook_catalog_v6.txt.
 // Arguments correspond to the register convention at the hook site
@@ -0,0 +1,92 @@
+// core/hook_calltree.hpp
+//
+// Optional call-tree tracer on top of the hook profiler. The flat
+// profile counts a hook firing inside another hook's original call in
+// the outer hook's original time; the call tree keeps the nesting, so
+// the HP cascade (SEQ_HpDamage -> SEQ_HpDamage_Helper -> UNIT_HpDamage
+// -> UNIT_UpdateCloneHP -> HP_KillCheck) shows which outer sequence
+// caused which inner calls and what each level costs.
+//
+// Every FATES_HOOK_PROFILE scope enters a node on entry and leaves it on
+// exit. A node is one (parent node, HookId) edge; per node it keeps the
+// call count and
+//
+//   - inclusive ticks: the whole stub, nested hooks included,
+//   - exclusive ticks: inclusive minus the inclusive time of the hooks
+//     nested directly inside it (our code plus the game's own work).
+//
+// Nodes live in a fixed table (kCallTreeMaxNodes) and the open-scope
+// stack is kCallTreeMaxDepth deep. Calls that find either full are not
+// recorded, only counted in gCallTree.dropped; their nested hooks are
+// then dropped too, so the tree never holds a wrong edge.
+//
+// DumpHookCallTreeToFile() (hook_debug.cpp) writes the tree as folded
+// stacks, one line per node with its exclusive microseconds:
+//
+//   SEQ_HpDamage;SEQ_HpDamage_Helper;UNIT_HpDamage 412
+//
+// which flamegraph.pl / speedscope / inferno read directly.
+//
+// Compile-time switch: build with FATES_HOOK_CALLTREE=1. It implies
+// FATES_HOOK_PROFILER=1 (see core/hook_profiler.hpp).
+//
+// Not thread-safe: hooks record from the game thread; the dump reads
+// the live table from the worker and may see a node mid-update.
+
+#pragma once
+
+#ifndef FATES_HOOK_CALLTREE
+#define FATES_HOOK_CALLTREE 0
+#endif
+
+#if FATES_HOOK_CALLTREE
+
+#include <cstdint>
+#include "core/hooks.hpp"
+
+namespace Fates {
+
+constexpr int           kCallTreeMaxNodes = 128;
+constexpr int           kCallTreeMaxDepth = 8;
+constexpr std::uint16_t kCallTreeNone     = 0xFFFF;
+
+struct CallTreeNode
+{
+    std::uint16_t parent;       // parent node, kCallTreeNone for a root
+    std::uint16_t hook;         // HookId
+    std::uint16_t firstChild;   // child list, kCallTreeNone if none
+    std::uint16_t nextSibling;
+    std::uint32_t calls;
+    std::uint64_t inclusiveTicks;
+    std::uint64_t exclusiveTicks;
+};
+
+struct CallTree
+{
+    CallTreeNode  nodes[kCallTreeMaxNodes];
+    std::uint16_t nodeCount;
+    std::uint16_t firstRoot = kCallTreeNone;  // root list, kCallTreeNone if empty
+    std::uint32_t dropped;       // calls not recorded (table or stack full)
+    std::uint16_t maxDepth;      // deepest nesting seen
+
+    // Open scopes, innermost last. stack[i] is kCallTreeNone for a
+    // dropped call; childTicks[i] sums its direct children's inclusive
+    // ticks so far.
+    std::uint16_t stack[kCallTreeMaxDepth];
+    std::uint32_t childTicks[kCallTreeMaxDepth];
+    std::uint16_t depth;         // may exceed kCallTreeMaxDepth (dropped calls)
+};
+
+extern CallTree gCallTree;
+
+// Called by HookProfileScope: open a scope for 'id' under the innermost
+// open one, and close the innermost scope with its total ticks.
+void CallTree_Enter(HookId id);
+void CallTree_Exit(std::uint32_t totalTicks);
+
+// Forget every node. Open scopes still close cleanly (as dropped calls).
+void CallTree_Reset();
+
+} // namespace Fates
+
+#endif // FATES_HOOK_CALLTREE
@@ -0,0 +1,72 @@
+// core/hook_config.hpp
+//
+// Named hook profiles plus per-hook overrides, persisted to
+// sdmc:/Fates3GX/hooks.cfg. The file is parsed once at boot
+// (HookConfig_LoadAndApply); the debug menu and hotkeys change the
+// profile at runtime and write the file back.
+//
+// A profile only decides which hooks are patched. A hook that is off
+// has its original instructions restored by HookManager (an inline hook
+// jumps straight through its thunk instead, core/inline_hook.hpp), so
+// switching off an expensive hook (SYS_Rng32, UNIT_UpdateCloneHP)
+// removes its stub's cost instead of adding an early-out to it.
+//
+// hooks.cfg format (one "key = value" per line, '#' comments):
+//
+//   profile = counters          # off | counters | telemetry | re
+//   SYS_Rng32 = off             # HookId name without the prefix:
+//   UNIT_LevelUp = on           #   on | off | default
+//
+// Overrides are applied on top of the profile.
+
+#pragma once
+
+#include <cstdint>
+#include "core/hooks.hpp"
+
+namespace Fates {
+
+enum class HookProfile : std::uint8_t
+{
+    Off,            // nothing patched
+    CountersOnly,   // core hooks except the per-roll / per-frame ones
+    FullTelemetry,  // every core hook (boot default)
+    REEverything,   // core + optional + experimental; RE only, may be unstable
+
+    Count
+};
+
+enum class HookOverride : std::uint8_t
+{
+    Default,  // follow the profile
+    On,
+    Off,
+};
+
+// hooks.cfg value ("off", "counters", ...) and menu label.
+const char *HookProfile_Name(HookProfile profile);
+const char *HookProfile_Label(HookProfile profile);
+
+// True if 'profile' patches 'entry' (before overrides).
+bool HookProfile_Wants(HookProfile profile, const HookEntry &entry);
+
+// Parse hooks.cfg (FullTelemetry with no overrides if it is missing),
+// then install and enable/disable hooks to match. Call once at boot in
+// place of HookManager::InstallCoreHooks().
+void HookConfig_LoadAndApply();
+
+// Switch profile / override at runtime and apply it. hooks.cfg is
+// saved by a worker job (util/worker.hpp), not on the calling thread.
+void HookConfig_SetProfile(HookProfile profile);
+void HookConfig_SetOverride(HookId id, HookOverride value);
+
+HookProfile  HookConfig_GetProfile();
+HookOverride HookConfig_GetOverride(HookId id);
+
+// Effective state for 'id' (profile + override), installed or not.
+bool HookConfig_Wants(HookId id);
+
+// Write the current profile and overrides to hooks.cfg.
+bool HookConfig_Save();
+
+} // namespace Fates
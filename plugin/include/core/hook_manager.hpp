@@ -2,16 +2,21 @@
 //
 // Defines the HookManager class used to install and manage runtime
 // hooks for Fire Emblem Fates.  HookManager relies on the
-// CTRPluginFramework Hook API to patch game code at runtime.  It
-// consumes the statically defined kHooks array (see core/hooks.hpp) and
-// dispatches each entry to CTRPF along with its corresponding stub
-// handler.
+// CTRPluginFramework Hook API to patch game code at runtime.  Init()
+// selects the generated hook table for the running title ID (see
+// core/hooks.hpp) and the installers dispatch each entry to CTRPF
+// along with its corresponding stub handler.
 //
 // The plugin distinguishes between core, optional and experimental
 // hooks.  Core hooks are installed by default when InstallCoreHooks()
 // or InstallAll() is invoked.  Optional hooks may be installed via
 // InstallOptionalHooks() or by enabling a menu toggle.  Experimental
 // hooks are not installed unless explicitly requested.
+//
+// Entries marked HookBackend::Inline (the hottest hooks) skip CTRPF and
+// are patched as direct detours with a prebuilt "call original" thunk
+// (core/inline_hook.hpp); CTRPF MITM stays the fallback for any of them
+// whose site can't be relocated.
 
 #pragma once
 
@@ -23,8 +28,8 @@ namespace Fates {
 
 class HookManager {
 public:
-    // Initialise internal data structures.  This must be called
-    // exactly once before any hooks are installed.
+    // Initialise internal data structures and select the hook table
+    // for the running title.  Called automatically by the installers.
     static void Init();
 
     // Install all core hooks defined in kHooks.  This should be
@@ -38,25 +43,44 @@ public:
 	// Install all core hooks (alias for InstallCoreHooks).
     static void InstallAll();
 
+    // Install hooks of every class with bit (1 << HookStability) set in
+    // 'stabilityMask'. If 'wanted' is non-null, only hooks with
+    // wanted[id] set are considered. Verifies all candidates before
+    // patching any; hooks already installed are skipped.
+    static void InstallHooks(std::uint32_t stabilityMask, const bool *wanted = nullptr);
+
     // Enable or disable all installed hooks.  These wrappers allow
     // toggling all hooks at once.
     static void EnableAll();
     static void DisableAll();
 
-    // Look up the static metadata for a given hook ID.  This simply
-    // returns the corresponding entry in kHooks.  No bounds checks
-    // are performed.
+    // Per-hook runtime switch. Disabling restores the original
+    // instructions, so a disabled hook costs nothing until re-enabled.
+    // Returns false if the hook isn't installed or CTRPF refused.
+    static bool SetHookEnabled(HookId id, bool enabled);
+    static bool IsHookEnabled(HookId id);
+    static bool IsHookInstalled(HookId id);
+
+    // Backend the hook was installed with (Mitm if not installed).
+    // Inline is only used for HookBackend::Inline entries whose site
+    // could be relocated (core/inline_hook.hpp).
+    static HookBackend GetBackend(HookId id);
+
+    // Look up the metadata for a given hook ID in the active table.
+    // Returns an unmapped (targetVA == 0) entry if no table is active.
     static const HookEntry &GetEntry(HookId id);
 
+    // Verified hook site (T-bit cleared) after installation: the table
+    // address, or the relocated one if the hook's bytes moved. 0 if the
+    // hook hasn't been verified.
+    static std::uint32_t GetSiteVA(HookId id);
+
 private:
     // Internal helper used to map a HookId to its stub handler.  If
     // no handler is available, this returns nullptr and the hook
     // installation will be skipped.
     static void *GetHandler(HookId id);
 
-    // Internal installation helper invoked by the public methods.
-    static void InstallByStability(HookStability s);
-
     // Array of CTRPF Hook objects, one per HookId.  These objects
     // manage the lifecycle of the underlying patches.
     static CTRPluginFramework::Hook sHooks[(std::size_t)HookId_Count];
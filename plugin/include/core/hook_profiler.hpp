@@ -0,0 +1,144 @@
+// core/hook_profiler.hpp
+//
+// Optional per-hook latency profiler, indexed by HookId alongside
+// gHookCount[]. Each profiled stub records, per call:
+//
+//   - total ticks spent in the stub,
+//   - ticks spent inside the original game function (HookCallOriginal
+//     or the replicated core call),
+//   - "own" ticks = total - original (our pre/post code).
+//
+// Per HookId it keeps calls, total/original sums, min/max own time and
+// a log2 histogram of total time. Results are shown by
+// ShowHookCountsOSD() / DumpHookCountsToFile() (hook_debug.cpp).
+//
+// Compile-time switch: build with FATES_HOOK_PROFILER=1 (add it to
+// 'defines' in build_config.toml). When it is 0 or undefined the macros
+// below expand to nothing / the bare call and no profiler code or data
+// is compiled in.
+//
+// Usage in a hook stub:
+//
+//   gHookCount[idx]++;
+//   FATES_HOOK_PROFILE(HookId_SEQ_TurnEnd);
+//   ...
+//   int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *>(HookId_SEQ_TurnEnd, seq));
+//
+// Nested hooks (a hook firing inside another hook's original call) are
+// counted in the outer hook's original time. Build with
+// FATES_HOOK_CALLTREE=1 to also keep the nesting (core/hook_calltree.hpp).
+
+#pragma once
+
+#include "core/hook_calltree.hpp"
+
+#ifndef FATES_HOOK_PROFILER
+#define FATES_HOOK_PROFILER FATES_HOOK_CALLTREE
+#endif
+
+#if FATES_HOOK_CALLTREE && !FATES_HOOK_PROFILER
+#error "FATES_HOOK_CALLTREE=1 needs FATES_HOOK_PROFILER=1"
+#endif
+
+#if FATES_HOOK_PROFILER
+
+#include <3ds.h>
+#include <cstdint>
+#include "core/hooks.hpp"
+
+namespace Fates {
+
+// Histogram bucket i counts calls whose total time t satisfies
+// 2^(i + kHookProfileHistShift) <= t < 2^(i + kHookProfileHistShift + 1);
+// bucket 0 also takes everything shorter, the last bucket everything
+// longer. With the 268 MHz system tick: bucket 0 is < 2^8 ticks
+// (~0.95us), bucket 15 is >= 2^22 ticks (~15.6ms).
+constexpr int kHookProfileHistBuckets = 16;
+constexpr int kHookProfileHistShift   = 7;
+
+struct HookProfileStats
+{
+    std::uint32_t calls;
+    std::uint64_t totalTicks;     // whole stub
+    std::uint64_t originalTicks;  // inside the original function
+    std::uint32_t minOwnTicks;    // own = total - original
+    std::uint32_t maxOwnTicks;
+    std::uint32_t maxTotalTicks;
+    std::uint32_t hist[kHookProfileHistBuckets];
+};
+
+extern HookProfileStats gHookProfile[HookId_Count];
+
+void HookProfiler_Record(HookId id,
+                         std::uint32_t totalTicks,
+                         std::uint32_t originalTicks);
+
+void HookProfiler_Reset();
+
+// Convert system ticks to microseconds (268.111856 ticks per us).
+inline std::uint32_t HookProfiler_TicksToUs(std::uint64_t ticks)
+{
+    return static_cast<std::uint32_t>((ticks * 1000ULL) / 268112ULL);
+}
+
+// RAII scope for one stub invocation.
+struct HookProfileScope
+{
+    HookId        id;
+    std::uint64_t start;
+    std::uint32_t originalTicks;
+
+    explicit HookProfileScope(HookId hookId)
+        : id(hookId)
+        , start(svcGetSystemTick())
+        , originalTicks(0)
+    {
+#if FATES_HOOK_CALLTREE
+        CallTree_Enter(hookId);
+#endif
+    }
+
+    ~HookProfileScope()
+    {
+        std::uint64_t total = svcGetSystemTick() - start;
+        HookProfiler_Record(id, static_cast<std::uint32_t>(total), originalTicks);
+#if FATES_HOOK_CALLTREE
+        CallTree_Exit(static_cast<std::uint32_t>(total));
+#endif
+    }
+};
+
+// Time one call to the original function and attribute it to 'scope'.
+template <typename Fn>
+inline decltype(auto) HookProfileCallOriginal(HookProfileScope &scope, Fn &&fn)
+{
+    struct Timer
+    {
+        HookProfileScope &scope;
+        std::uint64_t     start;
+
+        ~Timer()
+        {
+            scope.originalTicks +=
+                static_cast<std::uint32_t>(svcGetSystemTick() - start);
+        }
+    } timer{scope, svcGetSystemTick()};
+
+    return fn();
+}
+
+} // namespace Fates
+
+#define FATES_HOOK_PROFILE(hookId) \
+    ::Fates::HookProfileScope _fatesHookProfile(hookId)
+
+// Variadic so template argument lists with commas pass through.
+#define FATES_HOOK_ORIGINAL(...) \
+    ::Fates::HookProfileCallOriginal(_fatesHookProfile, [&]() -> decltype(auto) { return __VA_ARGS__; })
+
+#else // !FATES_HOOK_PROFILER
+
+#define FATES_HOOK_PROFILE(hookId) ((void)0)
+#define FATES_HOOK_ORIGINAL(...)   (__VA_ARGS__)
+
+#endif // FATES_HOOK_PROFILER
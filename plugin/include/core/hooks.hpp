@@ -13,6 +13,8 @@
 
 namespace Fates {
 
+namespace Engine { struct GameLayout; }
+
 // Enumerates every hook supported by the plugin.  The order here is
 // significant: it determines the indices used in gHookCount and other
 // arrays.  Update HookId_Count whenever adding or removing entries.
@@ -61,6 +63,16 @@ enum class HookStability : std::uint8_t {
     Experimental
 };
 
+// How HookManager patches a hook in. Mitm is CTRPF's Hook (stubs reach
+// the original through HookContext). Inline writes a direct branch to
+// the stub plus a prebuilt "call original" thunk (core/inline_hook.hpp);
+// meant for the few hooks that fire thousands of times per phase. An
+// Inline hook whose site can't be relocated is installed as Mitm.
+enum class HookBackend : std::uint8_t {
+    Mitm,
+    Inline
+};
+
 // Encapsulates all compile‑time metadata for a hook.  The plugin uses
 // this structure to initialise CTRPF hooks and to emit debug
 // information at runtime.
@@ -72,11 +84,64 @@ struct HookEntry {
     std::uint32_t guard[3];  // first three 32‑bit words of machine code
     bool          isThumb;   // true if the target executes in Thumb mode
     HookStability stability; // core/optional/experimental
+    HookBackend   backend;   // preferred backend ('backend' in the YAML)
 };
 
-// Extern declarations for the hook table and count.  These are
-// defined in plugin/src/hooks_table.cpp.
-extern const HookEntry kHooks[];
-extern const std::size_t kNumHooks;
+// Optional AOB signature for a hook (the 'aob' field in the YAML), used
+// to verify hooks without guard words and to find hooks whose bytes
+// moved. The pattern is packed into little-endian words; a mask bit of 0
+// is a wildcard. Matches are word-aligned; the hook site is the match
+// address plus siteOffset. Hooks without an aob fall back to their guard
+// words as an exact 3-word signature (see core/sig_scanner.hpp).
+struct HookSignature {
+    HookId               id;
+    std::uint8_t         numWords;   // <= kSigMaxWords
+    std::int16_t         siteOffset; // bytes from match start to hook site
+    const std::uint32_t *words;
+    const std::uint32_t *masks;
+};
+
+constexpr std::size_t kSigMaxWords = 16;
+
+// One region's hook table. The tables and kHookRegions[] are generated
+// into plugin/src/hooks_table.cpp from addresses/<region>.yml by
+// scripts/gen_hook_tables.py. Each table has one entry per HookId, in
+// HookId order; entries the region does not map have targetVA == 0.
+// The rest is the region's non-hook data, published by HookManager::Init.
+struct HookRegionTable {
+    const char               *region;          // e.g. "na_v11"
+    std::uint64_t             titleId;         // title the table applies to
+    const HookEntry          *hooks;           // indexed by HookId
+    std::size_t               numHooks;        // == HookId_Count
+    const HookSignature      *signatures;      // hooks with an aob, any order
+    std::size_t               numSignatures;
+    std::uint32_t             rngCoreVA;       // RNG step function SYS_Rng32 calls
+    std::uint32_t             turnStateRootVA; // core/turn_state.hpp chain root, 0 = unknown
+    const Engine::GameLayout *layout;          // struct offsets (engine/unit_layout.hpp)
+};
+
+extern const HookRegionTable kHookRegions[];
+extern const std::size_t     kNumHookRegions;
+
+// HookId enumerator names without the HookId_ prefix (the keys used in
+// addresses/*.yml and hooks.cfg). Generated with the tables.
+extern const char *const kHookIdNames[HookId_Count];
+
+// Active hook table for the running title; empty (nullptr / 0) until
+// SelectHookRegion() finds a match. Defined in core/hook_manager.cpp.
+extern const HookEntry *kHooks;
+extern std::size_t      kNumHooks;
+
+// Active region's RNG step function (HookRegionTable::rngCoreVA), 0
+// until HookManager::Init. The generator refuses a region that maps
+// SYS_Rng32 without one, so it is set whenever that hook is installed.
+extern std::uint32_t gRngCoreVA;
+
+// Point kHooks at the table for 'titleId'. Returns the selected region,
+// or nullptr (active table left empty) if no region matches.
+const HookRegionTable *SelectHookRegion(std::uint64_t titleId);
+
+// Currently selected region, or nullptr.
+const HookRegionTable *GetActiveHookRegion();
 
 } // namespace Fates
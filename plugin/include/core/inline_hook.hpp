@@ -0,0 +1,86 @@
+// core/inline_hook.hpp
+//
+// Inline hook backend (HookBackend::Inline). Instead of CTRPF's MITM
+// wrapper, the first two ARM instructions of the hook site are replaced
+// with an absolute jump straight into the C stub:
+//
+//   site+0 : ldr pc, [pc, #-4]
+//   site+4 : .word Hook_<Name>
+//
+// r0-r3 and lr are untouched, so the stub runs with the game's own
+// arguments and returns straight to the game's caller. The two stolen
+// instructions go into a per-hook thunk that is built once at install:
+//
+//   thunk+0  : stolen[0]
+//   thunk+4  : stolen[1]
+//   thunk+8  : ldr pc, [pc, #-4]
+//   thunk+12 : .word site+8
+//
+// Calling the thunk with the stub's arguments runs the original
+// function unchanged. Stubs reach it through HookCallOriginal(), which
+// also works for hooks CTRPF installed, so a stub doesn't care which
+// backend was picked.
+//
+// The site's two words are written once, by InlineHook_Install at boot.
+// Turning the hook off at runtime (hook profiles, per-hook overrides)
+// only points the literal at the thunk instead of the stub, so the
+// game runs its original instructions through the thunk; turning it on
+// points it back. Both are a single aligned word store, safe while the
+// game thread is executing the site.
+//
+// Only ARM sites whose two stolen instructions don't read or write pc
+// (no literal loads, branches or pc-relative adds) can be moved into a
+// thunk; InlineHook_Install refuses the rest and HookManager installs
+// them through CTRPF instead. As with the MITM backend the site must be
+// a function entry.
+//
+// FATES_INLINE_HOOKS=0 turns the backend off (every hook goes through
+// CTRPF).
+
+#pragma once
+
+#include <cstdint>
+#include <CTRPluginFramework.hpp>
+#include "core/hooks.hpp"
+
+#ifndef FATES_INLINE_HOOKS
+#define FATES_INLINE_HOOKS 1
+#endif
+
+namespace Fates {
+
+// Words per thunk (two stolen instructions + jump back).
+constexpr std::size_t kInlineThunkWords = 4;
+
+// Thunk address per HookId, 0 if the hook isn't installed inline.
+extern std::uint32_t gHookThunk[static_cast<std::size_t>(HookId_Count)];
+
+// True if 'count' ARM instructions can run from another address
+// unchanged.
+bool InlineHook_CanRelocate(const std::uint32_t *insns, std::size_t count);
+
+// Build the thunk for 'siteVA' (ARM, T-bit clear) and patch the site to
+// jump to 'stubVA'. Boot only (HookManager::InstallAll): it rewrites
+// two instructions. Returns false, leaving the site untouched, if the
+// site can't be relocated or its memory can't be made writable.
+bool InlineHook_Install(HookId id, std::uint32_t siteVA, std::uint32_t stubVA);
+
+// Route the site to the stub (true) or straight through the thunk to
+// the original function (false). Only the jump's literal is rewritten;
+// the thunk stays valid either way.
+bool InlineHook_SetEnabled(HookId id, bool enabled);
+
+// Call a hook's original function from its stub. Inline hooks go
+// through the thunk (one indirect call); everything else through the
+// CTRPF HookContext of the current call.
+template <typename R, typename... Args>
+inline R HookCallOriginal(HookId id, Args... args)
+{
+    const std::uint32_t thunk = gHookThunk[static_cast<std::size_t>(id)];
+    if (thunk != 0)
+        return reinterpret_cast<R (*)(Args...)>(thunk)(args...);
+
+    return CTRPluginFramework::HookContext::GetCurrent().OriginalFunction<R, Args...>(args...);
+}
+
+} // namespace Fates
@@ -136,4 +136,32 @@ extern MapStats gMapStats;
 // Reset the per-map statistics. Intended to be called at map start.
 void ResetMapStats();
 
+// ---------------------------------------------------------------------
+// Consistent snapshots for other threads
+// ---------------------------------------------------------------------
+//
+// gMapState, gMapStats, gKillEvents and gHookCount are written by hook
+// stubs on the game thread. Other threads (DebugThread, menu
+// callbacks) must not read them directly: they can observe a
+// half-updated state. Instead the game thread publishes a copy through
+// a seqlock (util/seqlock.hpp) at map/turn/action/kill boundaries, and
+// readers take a consistent copy without ever blocking the game thread.
+
+struct RuntimeSnapshot
+{
+    MapLifeCycleState map;
+    MapStats          stats;
+    int               killEventCount;
+    KillEvent         killEvents[kMaxKillEvents];
+    std::uint32_t     hookCount[static_cast<std::size_t>(HookId_Count)];
+    std::uint32_t     version;  // publish number, 1-based
+};
+
+// Game thread only: publish the current state.
+void PublishRuntimeSnapshot();
+
+// Any thread: copy the last published state into 'out'. Returns false
+// if nothing has been published yet or the writer stayed busy.
+bool ReadRuntimeSnapshot(RuntimeSnapshot &out);
+
 } // namespace Fates
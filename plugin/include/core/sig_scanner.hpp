@@ -0,0 +1,78 @@
+// core/sig_scanner.hpp
+//
+// Word-aligned AOB signature scanner over the code.bin text segment,
+// plus the SD cache of its results. HookManager::InstallHooks uses it to
+// relocate hooks whose guard words (or aob) no longer match at the
+// table address, i.e. the bytes moved in this code.bin.
+//
+// All pending signatures are matched in a single pass over the text:
+// each job is bucketed by its most specific word (the "anchor"), so the
+// per-word cost is one hash, one table load and, rarely, a candidate
+// compare. Jobs whose best word still has wildcard bits are checked at
+// every position, so patterns should have at least one fully known word.
+//
+// Results are cached in sdmc:/Fates3GX/hook_cache.bin keyed by title ID,
+// text size and a sparse hash of the text. Cached addresses are always
+// re-checked against their signature before use, so a stale cache can
+// only cost a rescan, never a wrong patch.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "core/hooks.hpp"
+
+namespace Fates {
+
+// code.bin text segment base (see HookEntry::targetVA).
+constexpr std::uint32_t kCodeTextBase = 0x00100000u;
+
+// One signature to find. words/masks are as in HookSignature.
+struct SigScanJob {
+    HookId               id;
+    std::uint8_t         numWords;
+    std::int16_t         siteOffset;
+    const std::uint32_t *words;
+    const std::uint32_t *masks;
+
+    // Out (SigScan_Run): address of the first match's hook site (0 if
+    // none) and the number of matches. Only hits == 1 is usable.
+    std::uint32_t        siteVA;
+    std::uint32_t        hits;
+};
+
+// Build a job from the hook's aob (if the region has one) or from its
+// guard words. Returns false if the hook has neither.
+bool SigScan_MakeJob(const HookEntry &entry, const HookRegionTable *region, SigScanJob &job);
+
+// True if 'job' matches with its hook site at 'siteVA'. Bounds-checked
+// against [textBase, textBase + textSize).
+bool SigScan_MatchAt(const SigScanJob &job, std::uint32_t siteVA,
+                     std::uint32_t textBase, std::uint32_t textSize);
+
+// Match every job against [textBase, textBase + textSize) in one pass
+// and fill in siteVA / hits. At most HookId_Count jobs.
+void SigScan_Run(SigScanJob *jobs, std::size_t numJobs,
+                 std::uint32_t textBase, std::uint32_t textSize);
+
+// Cheap fingerprint of the text segment (FNV-1a over one word in
+// every 16). Used as the cache key.
+std::uint32_t SigScan_HashText(std::uint32_t textBase, std::uint32_t textSize);
+
+// cachedVA[id] after SigCache_Load: kSigCacheNone if the cache has no
+// record for the hook, 0 if a previous scan found no unique match,
+// otherwise the resolved hook site.
+constexpr std::uint32_t kSigCacheNone = 0xFFFFFFFFu;
+
+// Load the cache for this code.bin. Returns false (and fills cachedVA[]
+// with kSigCacheNone) if there is no cache or it belongs to another
+// title / text.
+bool SigCache_Load(std::uint64_t titleId, std::uint32_t textSize, std::uint32_t textHash,
+                   std::uint32_t (&cachedVA)[HookId_Count]);
+
+// Rewrite the cache with every cachedVA[] entry that isn't
+// kSigCacheNone.
+bool SigCache_Save(std::uint64_t titleId, std::uint32_t textSize, std::uint32_t textHash,
+                   const std::uint32_t (&cachedVA)[HookId_Count]);
+
+} // namespace Fates
@@ -0,0 +1,59 @@
+// core/turn_state.hpp
+//
+// Cached resolver for the game's turn-side byte.
+//
+// The active side lives behind a pointer chain rooted in the game's
+// static data (the region's turn_state_root, addresses/<region>.yml):
+//
+//   ptr1 = *(u32 *)root
+//   base = *(u32 *)ptr1
+//   side = base[base[0x08]]
+//
+// TurnState_Resolve() walks and range-checks that chain with the
+// util/safe_read.hpp primitives and caches the address of the final
+// side byte. The map-sequence hooks call it at SEQ_MapStart and
+// SEQ_TurnBegin (the only points where the chain or the index can
+// move); every other lookup is then one byte load from the cached
+// address. A chain that doesn't resolve (title screen, between maps,
+// wrong game version) yields TurnSide::Unknown instead of a data abort.
+//
+// Game thread only.
+
+#pragma once
+
+#include <cstdint>
+#include "core/runtime.hpp"   // TurnSide
+
+namespace Fates {
+
+// Set the chain root from the active region (HookManager::Init) and
+// drop the cache. 0 (region doesn't map it, or before Init) makes
+// every resolve fail.
+void TurnState_SetRoot(std::uintptr_t rootVA);
+
+// Walk the chain and cache the side byte's address. Returns false (and
+// drops the cache) if any link is out of range.
+bool TurnState_Resolve();
+
+// Forget the cached address (SEQ_MapEnd: the map's state is about to
+// be freed). The next lookup resolves again.
+void TurnState_Invalidate();
+
+// 0..3 from the cached address, 0xFF if unresolved or out of range.
+// Resolves first if nothing is cached.
+std::uint8_t TurnState_GetSideRaw();
+
+// TurnState_GetSideRaw() as a TurnSide.
+TurnSide TurnState_GetSide();
+
+struct TurnStateStats
+{
+    std::uint32_t resolves;   // TurnState_Resolve() calls that succeeded
+    std::uint32_t failures;   // ... that failed a range check
+    std::uintptr_t base;      // last resolved chain base (0 if none)
+    std::uintptr_t sideAddr;  // cached side byte address (0 if none)
+};
+
+void TurnState_GetStats(TurnStateStats &out);
+
+} // namespace Fates
@@ -0,0 +1,116 @@
+// engine/arena.hpp
+//
+// Engine memory: two static bump arenas that engine modules carve
+// their tables out of, instead of each module owning a fixed array
+// with its own hard-coded cap.
+//
+//   ArenaId::Plugin : lives for the whole session. Allocate once, from
+//                     a module's init or first use.
+//   ArenaId::Map    : emptied by Engine::OnMapBegin (Arena_ResetMap,
+//                     O(1)) right after the unit index reset, so modules
+//                     allocate their per-map tables in their MapBegin
+//                     handler. Pointers into it are valid until the next
+//                     map begins.
+//
+// Table sizes come from the build's budget (engine/budget.hpp); the
+// arenas just have to be big enough for the sum. Allocation is a
+// pointer bump with no free, so it never touches the 3GX heap, and
+// nothing is allocated from a hook: event handlers only index tables
+// that MapBegin / init already handed out.
+//
+// Every allocation carries a tag (the module name). Per tag the arena
+// keeps the bytes allocated (this map, for the Map arena), the
+// high-water mark and the entries dropped because a budget-sized table
+// was full (Arena_NoteDrop). Engine::OnMapEnd logs the report; the debug
+// menu page "Engine memory" shows the same numbers.
+//
+//   // MapBegin handler
+//   sStats    = Arena_AllocArray<UnitStats>(ArenaId::Map, "HpKillTracker",
+//                                           kEngineBudget.trackedUnits);
+//   sCapacity = sStats ? kEngineBudget.trackedUnits : 0;
+//
+// Allocate and note drops from the game thread only (init, bus
+// handlers). The stats getters may be called from the UI thread; the
+// numbers are plain counters and can be one event stale.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifndef FATES_ARENA_PLUGIN_BYTES
+#define FATES_ARENA_PLUGIN_BYTES (4 * 1024)
+#endif
+
+#ifndef FATES_ARENA_MAP_BYTES
+#define FATES_ARENA_MAP_BYTES (8 * 1024)
+#endif
+
+namespace Fates {
+namespace Engine {
+
+enum class ArenaId : std::uint8_t
+{
+    Plugin,
+    Map,
+    Count
+};
+
+// Distinct tags tracked for the usage report.
+constexpr int kArenaMaxTags = 16;
+
+// 'bytes' from 'arena', aligned to 'align' (a power of two), charged to
+// 'tag'. Returns nullptr (and counts a failed allocation, logged once
+// per tag) if the arena is full. The memory is not cleared.
+void *Arena_Alloc(ArenaId arena, const char *tag, std::size_t bytes, std::size_t align = 8);
+
+// 'count' value-initialised T from 'arena', or nullptr if it is full.
+template <typename T>
+T *Arena_AllocArray(ArenaId arena, const char *tag, std::size_t count)
+{
+    void *p = Arena_Alloc(arena, tag, sizeof(T) * count, alignof(T));
+    if (p == nullptr)
+        return nullptr;
+
+    T *out = static_cast<T *>(p);
+    for (std::size_t i = 0; i < count; ++i)
+        new (&out[i]) T();
+    return out;
+}
+
+// A budget-sized table owned by 'tag' was full and an entry was dropped.
+void Arena_NoteDrop(const char *tag);
+
+// Empty the Map arena (Engine::OnMapBegin). Per-tag "this map" byte
+// counts reset lazily with it.
+void Arena_ResetMap();
+
+struct ArenaStats
+{
+    const char   *name;          // "plugin" / "map"
+    std::uint32_t capacity;      // bytes
+    std::uint32_t used;          // bytes handed out (this map for Map)
+    std::uint32_t highWater;     // max 'used' seen
+    std::uint32_t failedAllocs;  // Arena_Alloc calls that returned nullptr
+};
+
+void Arena_GetStats(ArenaId arena, ArenaStats &out);
+
+struct ArenaTagStats
+{
+    const char   *tag;
+    ArenaId       arena;      // arena of the tag's first allocation
+    std::uint32_t bytes;      // allocated (this map for Map tags)
+    std::uint32_t highWater;  // max 'bytes' seen
+    std::uint32_t drops;      // Arena_NoteDrop calls since boot
+};
+
+// Tags in first-allocation order. Returns the number written (<= max).
+int Arena_GetTagStats(ArenaTagStats *out, int max);
+
+// One log block with both arenas and every tag (Engine::OnMapEnd).
+void Arena_ReportMapEnd();
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,57 @@
+// engine/budget.hpp
+//
+// Capacity budget for the engine modules' tables. Each module sizes
+// its table from kEngineBudget and allocates it from an engine arena
+// (engine/arena.hpp) instead of declaring a fixed array, so one build
+// can be tuned for a deployment (RE build vs. long campaign) without
+// touching module code:
+//
+//   -DFATES_BUDGET_TRACKED_UNITS=128 -DFATES_ARENA_MAP_BYTES=16384
+//
+// Overflowing a table still drops the entry, but it is counted per
+// module (Arena_NoteDrop) and shows up in the map-end memory report,
+// so an undersized budget is visible instead of silent.
+//
+// Raising a budget may need a bigger arena; an allocation that doesn't
+// fit leaves the module with an empty table and is logged.
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef FATES_BUDGET_TRACKED_UNITS
+#define FATES_BUDGET_TRACKED_UNITS 64
+#endif
+
+#ifndef FATES_BUDGET_PENDING_LEARNS
+#define FATES_BUDGET_PENDING_LEARNS 64
+#endif
+
+#ifndef FATES_BUDGET_RNG_BOUNDS
+#define FATES_BUDGET_RNG_BOUNDS 8
+#endif
+
+#ifndef FATES_BUDGET_PREWARM_UNITS
+#define FATES_BUDGET_PREWARM_UNITS 64
+#endif
+
+namespace Fates {
+namespace Engine {
+
+struct EngineBudget
+{
+    std::uint16_t trackedUnits;   // HpKillTracker: units with per-unit stats per map (Map arena)
+    std::uint16_t pendingLearns;  // skill engine: units that learned skills between maps (Plugin arena)
+    std::uint16_t rngBounds;      // RngStats: distinct RNG bounds per map (Map arena)
+    std::uint16_t prewarmUnits;   // units carried over between maps (Plugin arena)
+};
+
+constexpr EngineBudget kEngineBudget = {
+    FATES_BUDGET_TRACKED_UNITS,
+    FATES_BUDGET_PENDING_LEARNS,
+    FATES_BUDGET_RNG_BOUNDS,
+    FATES_BUDGET_PREWARM_UNITS,
+};
+
+} // namespace Engine
+} // namespace Fates
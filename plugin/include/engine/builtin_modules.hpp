@@ -0,0 +1,48 @@
+// engine/builtin_modules.hpp
+//
+// The modules that ship with the plugin, in registration / dispatch
+// order. MainImpl calls BuiltinModules_RegisterHandlers() once at
+// startup.
+//
+// FATES_STATIC_MODULES=0 (default): the list is walked at startup and
+// every module goes through RegisterModule(), i.e. the runtime bus with
+// per-handler timing and budgets.
+//
+// FATES_STATIC_MODULES=1: the bus calls BuiltinModuleList::Dispatch<>()
+// directly in each Dispatch*() (before any runtime handlers), so every
+// built-in handler is a direct call the compiler can inline into the
+// bus. Built-in handlers are then not timed or budgeted. Modules
+// registered at runtime keep working as before.
+
+#pragma once
+
+#include "engine/module_list.hpp"
+#include "engine/skills.hpp"
+#include "engine/turn_rollup.hpp"
+#include "engine/hp_kill_tracker.hpp"
+#include "engine/damage_stats_module.hpp"
+#include "engine/rng_stats_module.hpp"
+#include "engine/history_store.hpp"
+
+#ifndef FATES_STATIC_MODULES
+#define FATES_STATIC_MODULES 0
+#endif
+
+namespace Fates {
+namespace Engine {
+
+using BuiltinModuleList = ModuleList<
+    &Skills::kSkillEngineModule,
+    &kTurnRollupModule,   // before everything that reads it
+    &kHpKillTrackerModule,
+    &kDamageStatsModule,
+    &kRngStatsModule,
+    &kHistoryModule>;
+
+// Initialise every built-in module and, unless FATES_STATIC_MODULES is
+// set, register its handlers on the bus. Returns false if any
+// registration failed.
+bool BuiltinModules_RegisterHandlers();
+
+} // namespace Engine
+} // namespace Fates
@@ -7,6 +7,19 @@
 //
 // No dynamic allocation, no removal API, just fixed-size handler
 // arrays per event type.
+//
+// Each family also has a bit in gBusSubscriberMask, set on the first
+// successful registration. Engine::On* checks HasSubscribers() before
+// building a context, so events nobody listens to cost a single load
+// and branch on the hook path.
+//
+// Delivery: map/turn, battle begin/end and action end handlers always
+// run synchronously. Kill, HP, RNG, unit-meta, unit move and item use
+// handlers are *deferred* by default: the hook only packs a compact
+// record into a fixed-size queue and the handler runs later, on the game
+// thread, at the next safe point (action end, or just before the next
+// map/turn/battle dispatch). Pass HandlerFlag_Sync when a handler has
+// to observe or mutate game state while the hook is still running.
 
 #pragma once
 
@@ -27,19 +40,84 @@ using RngHandler        = void(*)(const RngContext &);
 using LevelUpHandler    = void(*)(const LevelUpContext &);
 using SkillLearnHandler = void(*)(const SkillLearnContext &);
 using ItemGainHandler   = void(*)(const ItemGainContext &);
+using BattleBeginHandler = void(*)(const BattleEventContext &);
+using BattleEndHandler   = void(*)(const BattleEventContext &);
+using HpSyncHandler     = void(*)(const HpChangeContext &);
+using ActionEndHandler  = void(*)(const ActionContext &);
+using UnitMoveHandler   = void(*)(const ActionContext &);
+using ItemUseHandler    = void(*)(const ActionContext &);
+
+// One bit per EventKind that has at least one registered handler.
+// Written only by Register*Handler() (startup); read on every event.
+extern std::uint32_t gBusSubscriberMask;
+
+constexpr std::uint32_t EventBit(EventKind kind)
+{
+    return 1u << static_cast<unsigned>(kind);
+}
+
+inline bool HasSubscribers(EventKind kind)
+{
+    return (gBusSubscriberMask & EventBit(kind)) != 0;
+}
+
+// Per-registration delivery flags.
+enum HandlerFlags : std::uint32_t
+{
+    HandlerFlag_None     = 0,
+    HandlerFlag_Sync     = 1u << 0,   // call from inside the hook, never queue
+    HandlerFlag_NoBudget = 1u << 1,   // exempt from the time budget
+
+    // Set by the bus, not by callers: handler exhausted its budget.
+    HandlerFlag_Disabled = 1u << 31,
+};
+
+// Default per-call time budget for new handlers, in microseconds.
+// A handler that overruns its budget repeatedly is demoted from sync to
+// deferred delivery, or disabled if it is already deferred (or belongs
+// to a map/turn family). Each step is logged.
+constexpr std::uint32_t kDefaultHandlerBudgetUs = 2000;
 
 // Registration API: usually called from engine submodules at startup.
-// Returns true on success, false if capacity is full or fn == nullptr.
-bool RegisterMapBeginHandler(MapBeginHandler fn);
-bool RegisterMapEndHandler(MapEndHandler fn);
-bool RegisterTurnBeginHandler(TurnBeginHandler fn);
-bool RegisterTurnEndHandler(TurnEndHandler fn);
-bool RegisterKillHandler(KillHandler fn);
-bool RegisterHpChangeHandler(HpChangeHandler fn);
-bool RegisterRngHandler(RngHandler fn);
-bool RegisterLevelUpHandler(LevelUpHandler fn);
-bool RegisterSkillLearnHandler(SkillLearnHandler fn);
-bool RegisterItemGainHandler(ItemGainHandler fn);
+// 'tag' names the module in cost dumps and budget logs (string literal;
+// the pointer is stored). Returns true on success, false if capacity is
+// full or fn == nullptr.
+bool RegisterMapBeginHandler(MapBeginHandler fn, std::uint32_t flags = HandlerFlag_None,
+                             const char *tag = nullptr);
+bool RegisterMapEndHandler(MapEndHandler fn, std::uint32_t flags = HandlerFlag_None,
+                           const char *tag = nullptr);
+bool RegisterTurnBeginHandler(TurnBeginHandler fn, std::uint32_t flags = HandlerFlag_None,
+                              const char *tag = nullptr);
+bool RegisterTurnEndHandler(TurnEndHandler fn, std::uint32_t flags = HandlerFlag_None,
+                            const char *tag = nullptr);
+bool RegisterKillHandler(KillHandler fn, std::uint32_t flags = HandlerFlag_None,
+                         const char *tag = nullptr);
+bool RegisterHpChangeHandler(HpChangeHandler fn, std::uint32_t flags = HandlerFlag_None,
+                             const char *tag = nullptr);
+bool RegisterRngHandler(RngHandler fn, std::uint32_t flags = HandlerFlag_None,
+                        const char *tag = nullptr);
+bool RegisterLevelUpHandler(LevelUpHandler fn, std::uint32_t flags = HandlerFlag_None,
+                            const char *tag = nullptr);
+bool RegisterSkillLearnHandler(SkillLearnHandler fn, std::uint32_t flags = HandlerFlag_None,
+                               const char *tag = nullptr);
+bool RegisterItemGainHandler(ItemGainHandler fn, std::uint32_t flags = HandlerFlag_None,
+                             const char *tag = nullptr);
+bool RegisterBattleBeginHandler(BattleBeginHandler fn, std::uint32_t flags = HandlerFlag_None,
+                                const char *tag = nullptr);
+bool RegisterBattleEndHandler(BattleEndHandler fn, std::uint32_t flags = HandlerFlag_None,
+                              const char *tag = nullptr);
+// Raw per-sync HP stream, for modules that need every individual delta
+// rather than the coalesced HpChange.
+bool RegisterHpSyncHandler(HpSyncHandler fn, std::uint32_t flags = HandlerFlag_None,
+                           const char *tag = nullptr);
+// Unit commands (ActionContext). ActionEnd runs after the action's
+// queued events were drained and its battle closed.
+bool RegisterActionEndHandler(ActionEndHandler fn, std::uint32_t flags = HandlerFlag_None,
+                              const char *tag = nullptr);
+bool RegisterUnitMoveHandler(UnitMoveHandler fn, std::uint32_t flags = HandlerFlag_None,
+                             const char *tag = nullptr);
+bool RegisterItemUseHandler(ItemUseHandler fn, std::uint32_t flags = HandlerFlag_None,
+                            const char *tag = nullptr);
 
 // Internal dispatch API: used by Engine::On* in events.cpp.
 // You generally won't call these from outside the Engine module.
@@ -48,11 +126,49 @@ void DispatchMapEnd(const MapContext &ctx);
 void DispatchTurnBegin(const TurnContext &ctx);
 void DispatchTurnEnd(const TurnContext &ctx);
 void DispatchKill(const KillContext &ctx);
-void DispatchHpChange(const HpChangeContext &ctx);  
+void DispatchHpChange(const HpChangeContext &ctx);
 void DispatchRngCall(const RngContext &ctx);
 void DispatchLevelUp(const LevelUpContext &ctx);
 void DispatchSkillLearn(const SkillLearnContext &ctx);
 void DispatchItemGain(const ItemGainContext &ctx);
+void DispatchBattleBegin(const BattleEventContext &ctx);
+void DispatchBattleEnd(const BattleEventContext &ctx);
+void DispatchHpSync(const HpChangeContext &ctx);
+void DispatchActionEnd(const ActionContext &ctx);
+void DispatchUnitMove(const ActionContext &ctx);
+void DispatchItemUse(const ActionContext &ctx);
+
+// Deferred queue control.
+
+// Deliver every queued event to its deferred handlers, in order.
+// Game thread only (called from Engine::On* safe points).
+void DrainDeferredEvents();
+
+// Global switch (default on). When off, every handler runs
+// synchronously, as if registered with HandlerFlag_Sync.
+void SetDeferredDispatchEnabled(bool enabled);
+bool IsDeferredDispatchEnabled();
+
+struct DeferredQueueStats
+{
+    std::uint32_t capacity;       // ring size in records
+    std::uint32_t pending;        // records waiting right now
+    std::uint32_t highWater;      // most records pending at once (session)
+    std::uint32_t overflowDrains; // times the ring was full and drained inline
+    std::uint32_t enqueued;       // records queued this session
+};
+
+void GetDeferredQueueStats(DeferredQueueStats &out);
+
+// Handler accounting.
+
+// Set the per-call budget (0 = none) for every handler registered with
+// 'tag', or for all handlers plus future registrations if tag == nullptr.
+void SetHandlerBudgetUs(const char *tag, std::uint32_t budgetUs);
+
+// Log call counts and cumulative/avg/max time per handler, ranked by
+// cost within each event kind.
+void DumpHandlerStats();
 
 } // namespace Engine
 } // namespace Fates
@@ -1,14 +1,34 @@
 // damage_stats_module.hpp
 //
-// Simple example module that tracks per-side damage, healing,
-// and kill counts for the current map and prints a summary at
-// map end. Uses only the public Engine bus API.
+// Simple example module that prints per-side damage, healing and
+// kill counts for the map at map end. The numbers come from the shared
+// turn rollup (engine/turn_rollup.hpp); the module only adds a derived
+// "DamagePerTurn" metric on top.
 
 #pragma once
 
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
+
 namespace Fates {
 namespace Engine {
 
+// Bus handlers. Wired in through kDamageStatsModule; don't call directly.
+void DamageStatsModule_Init();
+void DamageStatsModule_OnMapBegin(const MapContext &ctx);
+void DamageStatsModule_OnMapEnd(const MapContext &ctx);
+
+// Module descriptor (built in, see engine/builtin_modules.hpp).
+inline constexpr ModuleDef kDamageStatsModule = [] {
+    ModuleDef m{};
+    m.tag        = "DamageStats";
+    m.init       = &DamageStatsModule_Init;
+    m.onMapBegin = &DamageStatsModule_OnMapBegin;
+    m.onMapEnd   = &DamageStatsModule_OnMapEnd;
+    return m;
+}();
+
+// Same as RegisterModule(kDamageStatsModule); harmless if already registered.
 bool DamageStatsModule_RegisterHandlers();
 
 } // namespace Engine
@@ -11,13 +11,17 @@
 #include <cstdint>
 #include "core/runtime.hpp"  // TurnSide, KillEvent, gMapState
 #include "engine/types.hpp"
+#include "engine/unit_index.hpp"  // UnitSummary
 
 namespace Fates {
 namespace Engine {
 
 // High-level event kind vocabulary. The current bus exposes per-event
-// registration (RegisterMapBeginHandler, etc.); EventKind is reserved
-// for a possible future generic dispatcher.
+// registration (RegisterMapBeginHandler, etc.); EventKind tags records
+// in the binary event trace (engine/trace.hpp).
+//
+// NOTE: values are written to fates_trace.bin, so only append new kinds
+// at the end and keep scripts/decode_trace.py in sync.
 enum class EventKind : std::uint16_t
 {
     MapBegin,
@@ -30,7 +34,14 @@ enum class EventKind : std::uint16_t
     SkillLearn,
     ItemGain,
     HpChange,   // generic damage/heal event
-    // Future: ActionBegin, ActionEnd, Damage, Heal...
+    ActionEnd,  // a unit command finished (EVENT_ActionEnd)
+    BattleBegin,
+    BattleEnd,
+    HpSync,     // raw per-sync HP delta (HpChange is the coalesced stream)
+    UnitMove,   // a unit's command sequence started (SEQ_UnitMove)
+    ItemUse,    // a unit used a (non-healing) item (SEQ_ItemUse)
+    UnitPrewarm, // trace only: a unit carried over to the next map (OnUnitCarryOver)
+    // Future: Damage, Heal...
 };
 
 
@@ -58,18 +69,44 @@ struct TurnContext
 // a good layout for later.
 struct KillContext
 {
-    KillEvent   core;  // raw struct from core/runtime.hpp
-    MapContext  map;   // map snapshot at time of kill
-    TurnContext turn;  // turn snapshot at time of kill
+    KillEvent     core;    // raw struct from core/runtime.hpp
+    MapContext    map;     // map snapshot at time of kill
+    TurnContext   turn;    // turn snapshot at time of kill
+    std::uint32_t battle;  // BattleContext::serial of the enclosing battle, 0 if none
 };
 
+// HpEvent::flags bit: this HpChange is the net of several HP syncs
+// folded together by the coalescing window (see OnUnitHpSync).
+constexpr std::uint32_t kHpFlag_Coalesced = 1u << 31;
+
 // HP change context: wraps a local HpEvent with map/turn snapshots.
 // Convention: amount > 0 = damage taken, amount < 0 = healing received.
+//
+// Used by both HP families: HpChange (one net event per unit per
+// window) and HpSync (one event per raw UNIT_UpdateCloneHP delta).
+// For a single change damage / healing are just the sign-split amount
+// and syncs is 1.
 struct HpChangeContext
 {
-    HpEvent    core;  // local HP event (source/target/amount/flags/context)
-    MapContext map;   // map snapshot at time of change
-    TurnContext turn; // turn snapshot at time of change
+    HpEvent       core;    // local HP event (source/target/amount/flags/context)
+    MapContext    map;     // map snapshot at time of change
+    TurnContext   turn;    // turn snapshot at time of change
+    std::uint32_t battle;  // BattleContext::serial of the enclosing battle, 0 if none
+    int           damage;  // gross damage in the window (>= 0)
+    int           healing; // gross healing in the window (>= 0)
+    std::uint32_t syncs;   // raw HP syncs folded into this event
+};
+
+// Battle begin / end context. 'battle' is the cached, decoded battle;
+// the totals are only meaningful for BattleEnd (zero at BattleBegin).
+struct BattleEventContext
+{
+    MapContext    map;            // snapshot at time of begin / end
+    TurnContext   turn;           // whose turn the battle is in
+    BattleContext battle;
+    int           attackerHpLost; // net HP the attacker lost (<0 = healed)
+    int           defenderHpLost; // net HP the defender lost (<0 = healed)
+    std::uint32_t kills;          // kill events during the battle
 };
 
 // RNG call context. Mostly for telemetry & future “RNG” tooling.
@@ -119,6 +156,43 @@ struct ItemGainContext
 };
 
 
+// Action context (ActionEnd / UnitMove / ItemUse): the decoded command
+// plus map / turn snapshots. 'turnCount' numbers actions of the same
+// family and command id within the turn, starting at 1, from the
+// engine's per-turn tally (GetTurnActionTally).
+struct ActionContext
+{
+    ActionEvent   core;       // decoded command (cmdId, side, cmdData, ...)
+    MapContext    map;        // snapshot at the time of the action
+    TurnContext   turn;       // whose turn it is
+    std::uint32_t turnCount;  // this family + cmdId so far this turn, including this one
+};
+
+// Per-turn action tally, one counter per command id and family. Ids at
+// or above kActionTallyCmds - 1 share the last slot. Reset at TurnBegin
+// and MapBegin.
+constexpr int kActionTallyCmds = 32;
+
+struct ActionTally
+{
+    std::uint16_t actionEnd[kActionTallyCmds];
+    std::uint16_t unitMove[kActionTallyCmds];
+    std::uint16_t itemUse[kActionTallyCmds];
+    std::uint32_t total;      // all three families
+};
+
+// Tally slot for a command id.
+constexpr int ActionTallySlot(std::uint32_t cmdId)
+{
+    return cmdId < static_cast<std::uint32_t>(kActionTallyCmds - 1)
+               ? static_cast<int>(cmdId)
+               : kActionTallyCmds - 1;
+}
+
+// This turn's tally. Game thread only; valid until the next action.
+const ActionTally &GetTurnActionTally();
+
+
 // Public entrypoints called from hooks_handlers.cpp.
 // These are intentionally thin; they don't know about CTRPF, only
 // data from the runtime layer.
@@ -126,6 +200,25 @@ struct ItemGainContext
 void OnMapBegin(void *seqRoot, TurnSide side);
 void OnMapEnd(void *seqRoot, TurnSide side);
 
+// Units carried over from the last map. Hook_SEQ_MapStart calls this,
+// right before OnMapBegin, for each unit pointer indexed since the last
+// map began that still reads as a live unit, with the fields it read
+// (-1 = unknown). It is not the new map's roster (the game's per-map
+// unit list isn't mapped): the pointers aren't confirmed on the new
+// map, and the first map after boot has none. OnMapBegin re-indexes
+// them after the unit index reset so per-unit state that follows a
+// unit between maps (skill masks) can find its slot. Nothing seeds HP
+// from them; the first HP sync of each unit takes its baseline from
+// the battle clone (OnUnitHpSync). Units past
+// kEngineBudget.prewarmUnits are dropped (and counted).
+void OnUnitCarryOver(void *unit, int hp, int level, int sideRaw);
+
+// The units OnMapBegin carried over, in slot order (UnitSummary::slot
+// is the unit index slot). Valid from MapBegin dispatch until the next
+// OnUnitCarryOver. Returns the number of entries; *out may be nullptr
+// if 0.
+int GetCarriedUnits(const UnitSummary **out);
+
 // Called from Hook_SEQ_TurnBegin and Hook_SEQ_TurnEnd.
 void OnTurnBegin(TurnSide side);
 void OnTurnEnd(TurnSide side, void *seqMaybe);
@@ -134,6 +227,23 @@ void OnTurnEnd(TurnSide side, void *seqMaybe);
 // "real" kill event.
 void OnKill(const KillEvent &ev, TurnSide side);
 
+// Called from Hook_BTL_FinalDamage_Pre. The first call of a battle
+// decodes calc -> BattleContext and emits BattleBegin; later calls with
+// the same calculator and root are a compare and return.
+void OnBattleCalc(void *calc, TurnSide side);
+
+// Start a battle from an already decoded context (OnBattleCalc, trace
+// replay). Ends any battle still open first; assigns battle.serial.
+void OnBattleBegin(const BattleContext &battle, TurnSide side);
+
+// End the current battle, if any, and emit BattleEnd. Engine::OnActionEnd,
+// OnTurnEnd and OnMapEnd call this, so hooks normally don't have to.
+void OnBattleEnd(TurnSide side);
+
+// The battle in progress, or nullptr between battles. Valid until the
+// next OnBattleBegin / OnBattleEnd; game thread only.
+const BattleContext *GetCurrentBattle();
+
 // RNG + unit misc events. These are currently log-only; later they’ll
 // fan out through engine/bus once I stabilize the shapes.
 
@@ -144,11 +254,27 @@ void OnRngCall(void *state,
 
 // NEW: canonical HP sync driver. Called from Hook_UNIT_UpdateCloneHP.
 // This tracks last HP per unit and, when it detects a change, emits a
-// high-level HpChange event via OnHpChange().
+// raw HpSync event and adds the delta to the unit's coalescing window.
+// The window is flushed as one net HpChange per unit (kHpFlag_Coalesced)
+// at the end of the battle, or outside a battle at the next sequence
+// boundary: SEQ_HpDamage, a kill, action / turn / map end.
+// 'prevHp' is the HP before this sync as far as the caller knows (the
+// clone's, read before the game copies the new value over; -1 =
+// unknown). It is only used the first time the engine sees the unit
+// this map; afterwards the tracked HP wins.
 void OnUnitHpSync(void *unit,
-                  int   newHp);
+                  int   newHp,
+                  int   prevHp = -1);
+
+// Flush the coalescing window: emit the pending net HpChange events.
+// Kill and action / battle / turn / map end do this themselves.
+void FlushHpChanges();
 
-// Generic HP-change event (damage or heal).
+// Sequence boundary from Hook_SEQ_HpDamage: flushes the window unless a
+// battle is open (a battle coalesces as a whole).
+void OnHpSequenceBoundary();
+
+// Generic HP-change event (damage or heal), dispatched immediately.
 // Convention: amount > 0 = damage taken, amount < 0 = healing received.
 void OnHpChange(void *sourceUnit,
                 void *targetUnit,
@@ -176,15 +302,17 @@ void OnItemGain(void *seqHelper,
                 void *modeOrCtx,
                 int   result,
                 TurnSide side);
-// Generic "action ended" hook (attack, wait, etc).
-// Currently used for structured logging only; no bus dispatch yet.
-void OnActionEnd(void *inst,
-                 void *seqMap,
-                 void *cmdData,
-                 std::uint32_t cmdId,
-                 std::uint32_t sideRaw,
-                 TurnSide side,
-                 std::uint32_t unk28);
+// Called from Hook_EVENT_ActionEnd after the game's handler returns
+// (attack, wait, etc). A safe point: flushes HP, drains the deferred
+// queue and closes the battle before ActionEnd handlers run.
+void OnActionEnd(const ActionEvent &ev, TurnSide side);
+
+// Called from Hook_SEQ_UnitMove once ProcSequence__UnitMove returns.
+void OnUnitMove(const ActionEvent &ev, TurnSide side);
+
+// Called from Hook_SEQ_ItemUse once ProcSequence__Use returns; ev.unit
+// is the item user.
+void OnItemUse(const ActionEvent &ev, TurnSide side);
 
 } // namespace Engine
 } // namespace Fates
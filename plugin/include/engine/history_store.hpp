@@ -0,0 +1,109 @@
+// engine/history_store.hpp
+//
+// Persistent campaign history. Every finished map appends one
+// fixed-size HistoryRecord (per-side damage / heals / kills / turns /
+// RNG calls) to sdmc:/Fates3GX/history.bin, plus one HistoryIndexEntry
+// to sdmc:/Fates3GX/history.idx. Both files are append-only.
+//
+// The MapEnd handler only fills a record from the turn rollup's map
+// totals (engine/turn_rollup.hpp) and queues it; the worker thread
+// (util/worker.hpp) writes it out in History_Pump(), so map end never
+// waits on the SD card.
+//
+// The index lets a reader fetch the last N maps with one read of the
+// index tail and one read per record. If the two files disagree (power
+// loss between the two writes), the index is rebuilt from history.bin
+// the next time the store is opened.
+//
+// File layout (little-endian):
+//   history.bin : HistoryFileHeader (magic kHistoryMagic), HistoryRecord...
+//   history.idx : HistoryFileHeader (magic kHistoryIndexMagic), HistoryIndexEntry...
+// scripts/decode_history.py dumps history.bin as text or CSV.
+
+#pragma once
+
+#include <cstdint>
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
+
+namespace Fates {
+namespace Engine {
+
+constexpr std::uint32_t kHistoryMagic      = 0x48483346u;  // "F3HH"
+constexpr std::uint32_t kHistoryIndexMagic = 0x49483346u;  // "F3HI"
+constexpr std::uint16_t kHistoryVersion    = 1;
+
+struct HistoryFileHeader
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t entrySize;    // sizeof(HistoryRecord) / sizeof(HistoryIndexEntry)
+    std::uint32_t reserved[2];
+};
+
+static_assert(sizeof(HistoryFileHeader) == 16, "HistoryFileHeader layout is part of the file format");
+
+struct HistoryRecord
+{
+    std::uint32_t session;          // plugin boot number (1 = first ever)
+    std::uint32_t generation;       // map generation within the session
+    std::uint64_t endTimeMs;        // osGetTime() at map end (ms since 1900)
+
+    std::uint32_t totalTurns;
+    std::uint32_t killEvents;       // kill events seen this map
+    std::uint8_t  startSide;        // raw TurnSide
+    std::uint8_t  endSide;          // raw TurnSide (side active at map end)
+    std::uint16_t reserved0;
+    std::uint32_t rngCalls;         // all RNG calls this map
+
+    // Indexed by TurnSide 0..3.
+    std::uint32_t turns[4];
+    std::int32_t  damage[4];        // HP damage dealt during the side's turns
+    std::int32_t  heals[4];         // HP healed during the side's turns
+    std::uint32_t kills[4];         // kills during the side's turns
+    std::uint32_t rngCallsBySide[4];
+
+    std::uint32_t reserved1[4];
+};
+
+static_assert(sizeof(HistoryRecord) == 128, "HistoryRecord layout is part of the file format");
+
+struct HistoryIndexEntry
+{
+    std::uint32_t offset;           // byte offset of the record in history.bin
+    std::uint32_t session;
+    std::uint32_t generation;
+    std::uint32_t totalTurns;
+};
+
+static_assert(sizeof(HistoryIndexEntry) == 16, "HistoryIndexEntry layout is part of the file format");
+
+// Bus handler. Wired in through kHistoryModule; don't call directly.
+void History_OnMapEnd(const MapContext &ctx);
+
+// Module descriptor (built in, see engine/builtin_modules.hpp). Must
+// come after the modules it reads from in the list.
+inline constexpr ModuleDef kHistoryModule = [] {
+    ModuleDef m{};
+    m.tag      = "History";
+    m.onMapEnd = &History_OnMapEnd;
+    return m;
+}();
+
+// Write queued records to SD (worker periodic, plugin exit).
+void History_Pump();
+
+// Crash path: Pump() unless another thread holds the store lock, in
+// which case nothing is written and it returns false.
+bool History_TryPump();
+
+// Copy up to 'max' of the most recent records into 'out', newest
+// first. Reads the SD card: call from a menu callback or a worker job,
+// never from a hook. Returns the number of records written.
+int History_LoadRecent(HistoryRecord *out, int max);
+
+// Records lost because the queue was full at map end.
+std::uint32_t History_GetDroppedRecords();
+
+} // namespace Engine
+} // namespace Fates
@@ -1,14 +1,17 @@
 // engine/hp_kill_tracker.hpp
 //
 // Small per-map HP + kill summary engine built on top of the
-// engine/bus event system. Listens to HpChange, Kill, and Map
-// begin/end events and maintains lightweight aggregates that other
-// systems (logging, logic systems, etc) can query.
+// engine/bus event system. Listens to HpChange and Map begin/end
+// events and maintains per-unit aggregates that other systems
+// (logging, logic systems, etc) can query. Per-side totals are views
+// of the turn rollup (engine/turn_rollup.hpp).
 
 #pragma once
 
 #include <cstddef>
 #include <cstdint>
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
 #include "engine/types.hpp"
 
 namespace Fates {
@@ -32,10 +35,24 @@ struct UnitHpStatsSnapshot
     std::int32_t healingReceived;
 };
 
-/// Register the HP/kill tracker with the engine bus.
-///
-/// Call this once during plugin startup (after the bus is available)
-/// to hook into MapBegin/MapEnd, HpChange, and Kill events.
+/// Bus handlers. Wired in through kHpKillTrackerModule; don't call directly.
+void HpKillTracker_OnMapBegin(const MapContext &ctx);
+void HpKillTracker_OnMapEnd(const MapContext &ctx);
+void HpKillTracker_OnHpChange(const HpChangeContext &ctx);
+
+/// Module descriptor (built in, see engine/builtin_modules.hpp).
+inline constexpr ModuleDef kHpKillTrackerModule = [] {
+    ModuleDef m{};
+    m.tag        = "HpKillTracker";
+    m.onMapBegin = &HpKillTracker_OnMapBegin;
+    m.onMapEnd   = &HpKillTracker_OnMapEnd;
+    m.onHpChange = &HpKillTracker_OnHpChange;
+    return m;
+}();
+
+/// Register the HP/kill tracker with the engine bus (same as
+/// RegisterModule(kHpKillTrackerModule)). BuiltinModules_RegisterHandlers()
+/// already does this at startup; calling it again is harmless.
 ///
 /// Returns true on success; false if any registration failed.
 bool HpKillTracker_RegisterHandlers();
@@ -43,9 +60,15 @@ bool HpKillTracker_RegisterHandlers();
 /// Returns a pointer to an internal array of 4 per-side stats
 /// (indices 0..3 correspond to TurnSide::Side0..Side3).
 ///
-/// Valid only for the *current map*. Data is reset on each MapBegin.
+/// Valid only for the *current map*. Refreshed from the turn rollup on
+/// each call; data is reset on each MapBegin.
 const SideHpStats *HpKillTracker_GetSideStats();
 
+/// Returns a pointer to an internal array of 4 per-side kill counts
+/// (kills during that side's turns). Valid for the current map;
+/// refreshed from the turn rollup on each call.
+const std::uint32_t *HpKillTracker_GetSideKills();
+
 /// Returns a pointer to an internal array of per-unit stats plus count.
 /// The array contains one entry per unit that has taken damage or
 /// received healing during the current map. Data is reset on MapBegin.
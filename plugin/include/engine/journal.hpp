@@ -0,0 +1,104 @@
+// engine/journal.hpp
+//
+// Per-map in-memory event journal. Every unit-level engine event
+// (HP change, kill, level-up, skill learn, item gain / use, battle) plus the
+// turn and action markers is appended to a fixed ring of JournalEntry records,
+// with tick, turn index, side and the unit's slot in the shared unit
+// index (engine/unit_index.hpp). RNG calls are not journaled: a map
+// rolls thousands of them and they would push the unit history out of
+// the ring within a few turns (engine/rng_recorder.hpp keeps those).
+//
+// Queries walk linked indices instead of scanning the ring:
+//   - each entry links to the previous entry for its unit (and for its
+//     second unit, e.g. the HP source), headed by a UnitSlotTable;
+//   - each entry links to the previous entry of the same kind.
+// So "last N events for unit X" and "all kills this turn" touch only
+// the entries they return.
+//
+// Entries are numbered with a running sequence number; a link is valid
+// while its entry is still inside the ring window and belongs to the
+// current map. Engine::OnMapBegin calls Journal_Reset(), which just
+// moves the map's first sequence number (O(1)); the per-unit heads
+// reset with the unit index stamp.
+//
+// When the ring wraps within one map the oldest entries are
+// overwritten. That is counted (Journal_GetStats, and a log line at map
+// end), and queries stop at the oldest surviving entry.
+//
+// Not thread-safe: record and query from the game thread (Engine::On*,
+// bus handlers).
+
+#pragma once
+
+#include <cstdint>
+#include "core/runtime.hpp"   // TurnSide
+#include "engine/events.hpp"  // EventKind
+
+namespace Fates {
+namespace Engine {
+
+// Ring size in entries. Must be a power of two.
+constexpr std::uint32_t kJournalCapacity = 1024;
+
+// Per-kind payload:
+//   unitSlot             otherSlot       value
+//   HpChange : target    source          amount (>0 damage, <0 heal)
+//   Kill     : dead unit killer (battle) kill flags
+//   LevelUp  : unit      -1              new level
+//   SkillLearn: unit     -1              skill id
+//   ItemGain : unit      -1              SEQ_ItemGain result
+//   TurnBegin / TurnEnd : -1  -1         side turn index
+//   ActionEnd / UnitMove : -1  -1        command id
+//   ItemUse  : unit      -1              command id
+//   BattleEnd: attacker  defender        battle serial
+// A kill with two dead units is journaled as two entries.
+struct JournalEntry
+{
+    std::uint64_t tick;        // svcGetSystemTick() at record time
+    std::uint32_t prevUnit;    // previous entry for unitSlot (0 = none)
+    std::uint32_t prevOther;   // previous entry for otherSlot (0 = none)
+    std::uint32_t prevKind;    // previous entry of the same kind (0 = none)
+    std::uint16_t turn;        // gMapState.totalTurns at record time
+    std::uint16_t kind;        // EventKind
+    std::int16_t  unitSlot;    // kInvalidUnitSlot if none
+    std::int16_t  otherSlot;   // kInvalidUnitSlot if none
+    std::int32_t  value;       // see table above
+    std::uint8_t  side;        // raw TurnSide
+    std::uint8_t  reserved[3];
+};
+
+static_assert(sizeof(JournalEntry) == 40, "keep JournalEntry compact");
+
+// Out-of-line append, called from the Engine::On* entrypoints.
+void Journal_Record(EventKind kind,
+                    TurnSide side,
+                    void *unit,
+                    void *other,
+                    std::int32_t value);
+
+// Forget the previous map's entries (O(1)). Call after UnitIndex_Reset().
+void Journal_Reset();
+
+// Log the map's entry / overwrite counts (Engine::OnMapEnd).
+void Journal_ReportMapEnd();
+
+// Copy up to 'max' of the newest entries involving 'unit' (as either
+// unit) into 'out', newest first. Returns the number written.
+int Journal_LastForUnit(void *unit, JournalEntry *out, int max);
+
+// Copy up to 'max' entries of 'kind' recorded during the current turn
+// (same gMapState.totalTurns), newest first.
+int Journal_ThisTurn(EventKind kind, JournalEntry *out, int max);
+
+struct JournalStats
+{
+    std::uint32_t capacity;
+    std::uint32_t mapEntries;     // recorded since the last reset
+    std::uint32_t mapOverwritten; // of those, lost to ring wrap
+    std::uint32_t totalEntries;   // session
+};
+
+void Journal_GetStats(JournalStats &out);
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,179 @@
+// engine/module_list.hpp
+//
+// Compile-time module descriptors. A module describes all of its bus
+// handlers in one constexpr ModuleDef instead of calling the
+// Register*Handler() functions one by one:
+//
+//   // my_module.hpp
+//   void MyModule_OnMapBegin(const MapContext &ctx);
+//   void MyModule_OnKill(const KillContext &ctx);
+//
+//   inline constexpr ModuleDef kMyModule = [] {
+//       ModuleDef m{};
+//       m.tag        = "MyModule";
+//       m.onMapBegin = &MyModule_OnMapBegin;
+//       m.onKill     = &MyModule_OnKill;
+//       return m;
+//   }();
+//
+// The same descriptor serves both ways of wiring a module in:
+//
+//   - RegisterModule(kMyModule) registers every non-null handler on the
+//     runtime bus, in field order, with the module's tag. Use this for
+//     modules that are optional or enabled at runtime.
+//   - ModuleList<&kA, &kB, ...> is a fixed module set. Its Dispatch<>()
+//     expands, per event kind, into one direct call per module that
+//     handles the kind: no function-pointer array, no null checks.
+//     engine/builtin_modules.hpp uses it for the modules that ship with
+//     the plugin when FATES_STATIC_MODULES is set.
+//
+// Handlers must have external linkage (declared in the module header)
+// so a ModuleList can call them directly.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "engine/bus.hpp"
+
+namespace Fates {
+namespace Engine {
+
+struct ModuleDef
+{
+    const char *tag;               // bus tag for stats / budget logs
+
+    // EventBit()s of the deferrable kinds whose handler must run inside
+    // the hook (HandlerFlag_Sync). Map/turn, battle and action end
+    // handlers are always sync.
+    std::uint32_t syncMask;
+
+    // Called once by RegisterModule(), before any handler (may be null).
+    void (*init)();
+
+    MapBeginHandler   onMapBegin;
+    MapEndHandler     onMapEnd;
+    TurnBeginHandler  onTurnBegin;
+    TurnEndHandler    onTurnEnd;
+    KillHandler       onKill;
+    HpChangeHandler   onHpChange;
+    RngHandler        onRng;
+    LevelUpHandler    onLevelUp;
+    SkillLearnHandler onSkillLearn;
+    ItemGainHandler   onItemGain;
+    BattleBeginHandler onBattleBegin;
+    BattleEndHandler  onBattleEnd;
+    HpSyncHandler     onHpSync;     // raw HP stream; most modules want onHpChange
+    ActionEndHandler  onActionEnd;
+    UnitMoveHandler   onUnitMove;
+    ItemUseHandler    onItemUse;
+};
+
+// The handler a module has for kind K (nullptr if none).
+template <EventKind K>
+constexpr auto HandlerOf(const ModuleDef &m)
+{
+    if constexpr (K == EventKind::MapBegin)        return m.onMapBegin;
+    else if constexpr (K == EventKind::MapEnd)     return m.onMapEnd;
+    else if constexpr (K == EventKind::TurnBegin)  return m.onTurnBegin;
+    else if constexpr (K == EventKind::TurnEnd)    return m.onTurnEnd;
+    else if constexpr (K == EventKind::Kill)       return m.onKill;
+    else if constexpr (K == EventKind::HpChange)   return m.onHpChange;
+    else if constexpr (K == EventKind::RngCall)    return m.onRng;
+    else if constexpr (K == EventKind::LevelUp)    return m.onLevelUp;
+    else if constexpr (K == EventKind::SkillLearn) return m.onSkillLearn;
+    else if constexpr (K == EventKind::ItemGain)   return m.onItemGain;
+    else if constexpr (K == EventKind::BattleBegin) return m.onBattleBegin;
+    else if constexpr (K == EventKind::BattleEnd)  return m.onBattleEnd;
+    else if constexpr (K == EventKind::HpSync)     return m.onHpSync;
+    else if constexpr (K == EventKind::ActionEnd)  return m.onActionEnd;
+    else if constexpr (K == EventKind::UnitMove)   return m.onUnitMove;
+    else if constexpr (K == EventKind::ItemUse)    return m.onItemUse;
+    else
+        static_assert(K != K, "EventKind has no bus family");
+}
+
+// EventBit()s of every kind 'm' has a handler for.
+constexpr std::uint32_t ModuleKinds(const ModuleDef &m)
+{
+    return (m.onMapBegin   ? EventBit(EventKind::MapBegin)   : 0u) |
+           (m.onMapEnd     ? EventBit(EventKind::MapEnd)     : 0u) |
+           (m.onTurnBegin  ? EventBit(EventKind::TurnBegin)  : 0u) |
+           (m.onTurnEnd    ? EventBit(EventKind::TurnEnd)    : 0u) |
+           (m.onKill       ? EventBit(EventKind::Kill)       : 0u) |
+           (m.onHpChange   ? EventBit(EventKind::HpChange)   : 0u) |
+           (m.onRng        ? EventBit(EventKind::RngCall)    : 0u) |
+           (m.onLevelUp    ? EventBit(EventKind::LevelUp)    : 0u) |
+           (m.onSkillLearn ? EventBit(EventKind::SkillLearn) : 0u) |
+           (m.onItemGain   ? EventBit(EventKind::ItemGain)   : 0u) |
+           (m.onBattleBegin ? EventBit(EventKind::BattleBegin) : 0u) |
+           (m.onBattleEnd  ? EventBit(EventKind::BattleEnd)  : 0u) |
+           (m.onHpSync     ? EventBit(EventKind::HpSync)     : 0u) |
+           (m.onActionEnd  ? EventBit(EventKind::ActionEnd)  : 0u) |
+           (m.onUnitMove   ? EventBit(EventKind::UnitMove)   : 0u) |
+           (m.onItemUse    ? EventBit(EventKind::ItemUse)    : 0u);
+}
+
+// Which of a module's handlers a static dispatch reaches.
+enum class ModulePass : std::uint8_t
+{
+    All,       // every handler (map/turn/battle, or deferral off)
+    Sync,      // only handlers in syncMask (called from the hook)
+    Deferred,  // only handlers not in syncMask (called from the drain)
+};
+
+template <const ModuleDef *M, EventKind K, ModulePass P, typename Ctx>
+inline void CallModule(const Ctx &ctx)
+{
+    constexpr auto fn = HandlerOf<K>(*M);
+    if constexpr (fn != nullptr)
+    {
+        constexpr bool isSync = (M->syncMask & EventBit(K)) != 0;
+        if constexpr (P == ModulePass::All || (P == ModulePass::Sync) == isSync)
+            fn(ctx);
+    }
+}
+
+template <const ModuleDef *... Mods>
+struct ModuleList
+{
+    static constexpr std::size_t kCount = sizeof...(Mods);
+
+    // Kinds handled by at least one module in the list.
+    static constexpr std::uint32_t kSubscriberMask = (0u | ... | ModuleKinds(*Mods));
+
+    // Modules in the list with a non-sync handler for K.
+    template <EventKind K>
+    static constexpr int CountDeferred()
+    {
+        return (0 + ... + ((HandlerOf<K>(*Mods) != nullptr &&
+                            (Mods->syncMask & EventBit(K)) == 0) ? 1 : 0));
+    }
+
+    // Call the list's handlers for K, in list order.
+    template <EventKind K, ModulePass P, typename Ctx>
+    static inline void Dispatch(const Ctx &ctx)
+    {
+        (CallModule<Mods, K, P>(ctx), ...);
+    }
+
+    static constexpr bool Contains(const ModuleDef *m)
+    {
+        return (false || ... || (m == Mods));
+    }
+
+    // Call fn(const ModuleDef &) for each module, in list order.
+    template <typename Fn>
+    static void ForEach(Fn &&fn)
+    {
+        (fn(*Mods), ...);
+    }
+};
+
+// Run m.init and register m's handlers on the runtime bus. A module
+// that is already registered (or compiled into the static list) is not
+// registered twice. Returns false if any registration failed.
+bool RegisterModule(const ModuleDef &m);
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,85 @@
+// engine/rng_recorder.hpp
+//
+// Full RNG stream recorder. When enabled, every SYS_Rng32 call (via
+// Engine::OnRngCall) is appended to a byte ring in a compact encoding,
+// interleaved with map/turn/action/battle boundary markers. The ring is
+// drained in bulk to sdmc:/Fates3GX/fates_rng.bin by RngRec_Pump() /
+// RngRec_Flush(), so a whole chapter's RNG stream can be captured
+// without per-call SD traffic or text logging.
+//
+// Stream encoding (little-endian; varint = LEB128, 7 bits per byte):
+//
+//   0x00..0x03  RNG call. bit0: bound changed, varint bound follows.
+//               bit1: state changed, u32 state follows. Then u32 raw.
+//               The result is not stored: it is (raw * bound) >> 32.
+//   0x10 | m    Marker m (RngMarker). u8 side, varint ticks since the
+//               previous marker (or the session header), varint arg.
+//   0x20        Gap. varint number of records lost (ring full).
+//   0xFF        Session header. u32 kRngRecMagic, u8 kRngRecVersion,
+//               u32 tick frequency (Hz), u64 start tick. Resets the
+//               "last bound / last state" used by the delta bits.
+//
+// A typical call (same state and bound as the previous one) costs five
+// bytes. scripts/decode_rng.py turns the file into text or CSV.
+
+#pragma once
+
+#include <cstdint>
+#include "core/runtime.hpp"   // TurnSide
+
+namespace Fates {
+namespace Engine {
+
+constexpr std::uint32_t kRngRecMagic   = 0x4E523346u;  // "F3RN"
+constexpr std::uint8_t  kRngRecVersion = 1;
+
+// Marker ids (low nibble of the 0x10 tag). Append-only.
+enum class RngMarker : std::uint8_t
+{
+    MapBegin    = 0,  // arg = map generation
+    MapEnd      = 1,  // arg = totalTurns
+    TurnBegin   = 2,  // arg = sideTurnIndex
+    TurnEnd     = 3,  // arg = sideTurnIndex
+    ActionEnd   = 4,  // arg = cmdId (closes the action and any battle in it)
+    BattleBegin = 5,  // arg = battle serial (this map); calls until BattleEnd are the battle's
+    BattleEnd   = 6,  // arg = battle serial
+};
+
+// Runtime switch; read inline on every RNG call so the disabled path is
+// a single load + branch.
+extern volatile bool gRngRecEnabled;
+
+void RngRec_SetEnabled(bool enabled);
+
+// Out-of-line appends. Use RngRec_Call() / RngRec_Mark() below.
+void RngRec_AppendCall(void *state, std::uint32_t raw, std::uint32_t bound);
+void RngRec_AppendMarker(RngMarker marker, TurnSide side, std::uint32_t arg);
+
+inline void RngRec_Call(void *state, std::uint32_t raw, std::uint32_t bound)
+{
+    if (gRngRecEnabled)
+        RngRec_AppendCall(state, raw, bound);
+}
+
+inline void RngRec_Mark(RngMarker marker, TurnSide side, std::uint32_t arg = 0)
+{
+    if (gRngRecEnabled)
+        RngRec_AppendMarker(marker, side, arg);
+}
+
+// Drain the ring if at least half of it is pending (worker periodic).
+void RngRec_Pump();
+
+// Drain everything now (worker job at map end, plugin exit).
+void RngRec_Flush();
+
+// Crash path: Flush() unless another thread holds the drain lock, in
+// which case nothing is written and it returns false.
+bool RngRec_TryFlush();
+
+// RNG calls recorded / lost (ring full) since boot.
+std::uint32_t RngRec_GetRecordedCalls();
+std::uint32_t RngRec_GetDroppedRecords();
+
+} // namespace Engine
+} // namespace Fates
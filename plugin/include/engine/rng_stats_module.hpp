@@ -1,14 +1,46 @@
 // rng_stats_module.hpp
 //
 // Example module that listens to Engine RNG events and summarizes
-// how many RNG calls were made per side, plus which bounds were
-// requested during the current map.
+// which bounds were requested during the current map. Call counts per
+// side come from the shared turn rollup (engine/turn_rollup.hpp).
 
 #pragma once
 
+#include <cstdint>
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
+
 namespace Fates {
 namespace Engine {
 
+// Bus handlers. Wired in through kRngStatsModule; don't call directly.
+void RngStatsModule_Init();
+void RngStatsModule_OnMapBegin(const MapContext &ctx);
+void RngStatsModule_OnRng(const RngContext &ctx);
+void RngStatsModule_OnMapEnd(const MapContext &ctx);
+
+// Module descriptor (built in, see engine/builtin_modules.hpp).
+inline constexpr ModuleDef kRngStatsModule = [] {
+    ModuleDef m{};
+    m.tag        = "RngStats";
+    m.init       = &RngStatsModule_Init;
+    m.onMapBegin = &RngStatsModule_OnMapBegin;
+    m.onRng      = &RngStatsModule_OnRng;
+    m.onMapEnd   = &RngStatsModule_OnMapEnd;
+    return m;
+}();
+
+// RNG call counts for the current map (reset at MapBegin). Read from
+// the turn rollup; totalCalls includes calls with no known side.
+struct RngStatsTotals
+{
+    std::uint32_t totalCalls;
+    std::uint32_t callsPerSide[4];  // indexed by TurnSide 0..3
+};
+
+void RngStatsModule_GetTotals(RngStatsTotals &out);
+
+// Same as RegisterModule(kRngStatsModule); harmless if already registered.
 bool RngStatsModule_RegisterHandlers();
 
 } // namespace Engine
@@ -1,27 +1,103 @@
 // engine/skills.hpp
 //
-// Thin front-door for the skill engine. For now this only exposes
-// a debug initialiser that registers global HP-change hooks with
-// the engine event bus. You normally don't need to call this
-// manually; skills.cpp arranges for automatic registration at
-// plugin load via a small static bootstrap.
+// Skill engine. Every tracked skill (one row of the static kSkillDefs[]
+// table in engine/skill_table.cpp) gets a bit; every unit gets a
+// SkillMask of the tracked skills it has learned, filled from
+// OnUnitSkillLearn and attached to its shared unit index slot.
+//
+// Effects are data: a row names the skill and the handler to run for
+// each event kind it cares about (HpChange, Kill, TurnBegin). At init
+// the engine ORs the rows into one mask per event kind, so an event
+// costs one slot lookup and one AND for a unit without a relevant skill,
+// and only the set bits are walked otherwise. Event kinds no skill
+// handles return before the lookup.
+//
+// The engine is a built-in module (kSkillEngineModule,
+// engine/builtin_modules.hpp); you don't need to call Init() yourself.
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include "engine/events.hpp"  // HpChangeContext, etc.
+#include "engine/module_list.hpp"
 
 namespace Fates {
 namespace Engine {
 namespace Skills {
 
-// Initialise the debug skill set (idempotent).
-// Currently this just wires a single global "extra damage on HP"
-// effect for testing purposes. (disabled, left for reference)
-//
-// You don't need to call this yourself; it is invoked automatically
-// at plugin startup. It's exposed mainly for clarity and potential
-// future tests.
-void InitDebugSkills();
+// One bit per kSkillDefs row.
+using SkillMask = std::uint64_t;
+constexpr std::size_t kMaxTrackedSkills = 64;
+
+struct SkillDef;
+
+// Effect handlers. 'unit' is the unit that has the skill:
+//   HpChange  - the HP event's target
+//   Kill      - a dead unit (dead0 / dead1)
+//   TurnBegin - every indexed unit with the skill, at each turn start
+using SkillHpChangeFn  = void (*)(const SkillDef &skill, const HpChangeContext &ctx, void *unit);
+using SkillKillFn      = void (*)(const SkillDef &skill, const KillContext &ctx, void *unit);
+using SkillTurnBeginFn = void (*)(const SkillDef &skill, const TurnContext &ctx, void *unit);
+
+struct SkillDef
+{
+    std::uint16_t    skillId;      // game skill id (Unit__AddEquipSkill)
+    const char      *name;         // for logs
+    SkillHpChangeFn  onHpChange;   // nullptr = not interested
+    SkillKillFn      onKill;
+    SkillTurnBeginFn onTurnBegin;
+};
+
+// The effect table (engine/skill_table.cpp). Row index == mask bit.
+extern const SkillDef    kSkillDefs[];
+extern const std::size_t kNumSkillDefs;
+
+// Build the lookup masks from kSkillDefs (idempotent). Run by
+// RegisterModule(kSkillEngineModule).
+void Init();
+
+// Bus handlers. Wired in through kSkillEngineModule; don't call directly.
+void OnMapBegin(const MapContext &ctx);
+void OnMapEnd(const MapContext &ctx);
+void OnTurnBegin(const TurnContext &ctx);
+void OnKill(const KillContext &ctx);
+void OnHpChange(const HpChangeContext &ctx);
+void OnSkillLearn(const SkillLearnContext &ctx);
+
+// Module descriptor. The learn handler is sync: hook stubs query
+// UnitHasSkill() directly, so the bit has to be set before the hook
+// returns.
+inline constexpr ModuleDef kSkillEngineModule = [] {
+    ModuleDef m{};
+    m.tag          = "SkillEngine";
+    m.syncMask     = EventBit(EventKind::SkillLearn);
+    m.init         = &Init;
+    m.onMapBegin   = &OnMapBegin;
+    m.onMapEnd     = &OnMapEnd;
+    m.onTurnBegin  = &OnTurnBegin;
+    m.onKill       = &OnKill;
+    m.onHpChange   = &OnHpChange;
+    m.onSkillLearn = &OnSkillLearn;
+    return m;
+}();
+
+// Tracked skills 'unit' has learned this map or carried into it (or,
+// between maps, the last map's masks plus learns since). 0 for nullptr /
+// unknown units.
+SkillMask GetUnitSkills(void *unit);
+
+// True if 'unit' has learned 'skillId' and the skill is in kSkillDefs.
+bool UnitHasSkill(void *unit, std::uint16_t skillId);
+
+// TEMP: Debug skill ID that marks units whose HP changes log.
+// Feel free to change this to a proper custom skill ID.
+constexpr std::uint16_t kDebugSkillId = 0x000E;
+
+inline bool UnitHasDebugSkill(void *unit)
+{
+    return UnitHasSkill(unit, kDebugSkillId);
+}
 
 } // namespace Skills
 } // namespace Engine
@@ -0,0 +1,107 @@
+// engine/trace.hpp
+//
+// Compact binary event trace. When enabled, every Engine::On* entrypoint
+// appends one fixed-size TraceRecord to a preallocated ring instead of
+// (or in addition to) its capped text log line. The ring is drained in
+// bulk to sdmc:/Fates3GX/fates_trace.bin by Trace_Pump()/Trace_Flush(),
+// so whole chapters can be traced without per-event SD traffic.
+//
+// The file is a flat sequence of 32-byte little-endian records. Each
+// plugin session starts with a header record (kind == kTraceKindHeader).
+// scripts/decode_trace.py turns the file back into text or CSV.
+//
+// Record payloads per EventKind (arg[0..3]):
+//   MapBegin / MapEnd : seqRoot, totalTurns, killEvents, startSide
+//   TurnBegin         : sideTurnIndex, totalTurns, 0, 0
+//   TurnEnd           : sideTurnIndex, totalTurns, seq, 0
+//   Kill              : seq, dead0, dead1, flags
+//   RngCall           : state, raw, bound, result
+//   LevelUp           : unit, level, 0, 0
+//   SkillLearn        : unit, skillId | (flags << 16), result, 0
+//   ItemGain          : unit, itemArg, modeOrCtx, result
+//   HpChange          : source, target, amount (signed), flags
+//                       (kHpFlag_Coalesced: net of the HpSync records before it)
+//   ActionEnd         : inst, cmdId, sideRaw, unk28
+//   BattleBegin       : calc, root, attacker, defender
+//   BattleEnd         : attacker, defender,
+//                       attackerHpLost | (defenderHpLost << 16) (s16 each), kills
+//   HpSync            : unit, source, prevHp, newHp
+//   UnitMove          : inst, cmdId, sideRaw, unk28
+//   ItemUse           : inst, unit, cmdId, sideRaw
+//   UnitPrewarm       : unit, hp, level, sideRaw (signed; -1 = unknown)
+
+#pragma once
+
+#include <cstdint>
+#include "core/runtime.hpp"   // TurnSide
+#include "engine/events.hpp"  // EventKind
+
+namespace Fates {
+namespace Engine {
+
+struct TraceRecord
+{
+    std::uint64_t tick;        // svcGetSystemTick() at record time
+    std::uint16_t kind;        // EventKind (or kTraceKindHeader)
+    std::uint8_t  side;        // raw TurnSide value
+    std::uint8_t  flags;       // reserved, 0
+    std::uint32_t generation;  // gMapState.generation
+    std::uint32_t arg[4];      // per-kind payload, see table above
+};
+
+static_assert(sizeof(TraceRecord) == 32, "TraceRecord layout is part of the file format");
+
+// Header record written at the start of every session:
+//   kind = kTraceKindHeader, generation = sizeof(TraceRecord),
+//   arg[0] = kTraceMagic, arg[1] = kTraceVersion,
+//   arg[2] = tick frequency (Hz), arg[3] = 0.
+constexpr std::uint16_t kTraceKindHeader = 0xFFFF;
+constexpr std::uint32_t kTraceMagic      = 0x52543346u;  // "F3TR"
+constexpr std::uint32_t kTraceVersion    = 1;
+
+// Runtime switch; read inline on every event so the disabled path is a
+// single load + branch.
+extern volatile bool gTraceEnabled;
+
+void Trace_SetEnabled(bool enabled);
+
+// Out-of-line append. Use Trace_Record() below instead.
+void Trace_Append(EventKind kind,
+                  TurnSide side,
+                  std::uint32_t a0,
+                  std::uint32_t a1,
+                  std::uint32_t a2,
+                  std::uint32_t a3);
+
+inline void Trace_Record(EventKind kind,
+                         TurnSide side,
+                         std::uint32_t a0,
+                         std::uint32_t a1 = 0,
+                         std::uint32_t a2 = 0,
+                         std::uint32_t a3 = 0)
+{
+    if (gTraceEnabled)
+        Trace_Append(kind, side, a0, a1, a2, a3);
+}
+
+// Helper for pointer payloads.
+inline std::uint32_t TraceArg(const void *p)
+{
+    return static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(p));
+}
+
+// Drain the ring if at least half of it is pending (worker periodic).
+void Trace_Pump();
+
+// Drain everything now (worker job at map end, plugin exit).
+void Trace_Flush();
+
+// Crash path: Flush() unless another thread holds the drain lock, in
+// which case nothing is written and it returns false.
+bool Trace_TryFlush();
+
+// Records lost because the ring was full when an event fired.
+std::uint32_t Trace_GetDroppedRecords();
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,137 @@
+// engine/turn_rollup.hpp
+//
+// Shared per-turn aggregates for the stats modules. Every HpChange,
+// Kill and RngCall is added to the open row (damage, heals, kills, RNG
+// calls and HP events per side); each TurnEnd closes that row into a
+// fixed prefix-sum table, so any closed turn range costs one
+// subtraction:
+//
+//     RollupRow r;
+//     TurnRollup_Range(3, 7, r);              // closed turns 3..7
+//     r.damage[1]                             // damage during Side1's turns
+//
+//     int t = TurnRollup_LastTurnOf(TurnSide::Side1);
+//     TurnRollup_Range(t, t, r);              // the last enemy phase
+//
+// Turns are numbered by close order within the map, starting at 0.
+// TurnRollup_MapTotals() adds the open row, so it is exact at any time
+// (mid-turn, at MapEnd). Events seen while no side is known go to
+// column kRollupUnattributed.
+//
+// Modules that want something derived (per-turn averages, ratios)
+// register a RollupMetricFn instead of keeping their own counters; it
+// is evaluated on a range row on demand, and every registered metric is
+// logged per side at MapEnd.
+//
+// The table holds kRollupMaxTurns closed turns. Turns closed after that
+// stay in the open row: map totals remain exact, range queries only see
+// the first kRollupMaxTurns turns, and the overflow is logged at MapEnd.
+//
+// Not thread-safe: update and query from the game thread.
+
+#pragma once
+
+#include <cstdint>
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
+
+#ifndef FATES_ROLLUP_MAX_TURNS
+#define FATES_ROLLUP_MAX_TURNS 128
+#endif
+
+namespace Fates {
+namespace Engine {
+
+constexpr int kRollupMaxTurns      = FATES_ROLLUP_MAX_TURNS;
+constexpr int kRollupSides         = 4;  // TurnSide::Side0..Side3
+constexpr int kRollupUnattributed  = 4;  // TurnSide::Unknown / out of range
+constexpr int kRollupColumns       = 5;
+
+// One row of per-side sums. Depending on the query it covers one turn,
+// a range of turns, the open turn or the whole map.
+struct RollupRow
+{
+    std::int32_t  damage[kRollupColumns];   // HP damage during the side's turns
+    std::int32_t  heals[kRollupColumns];    // HP healed during the side's turns
+    std::uint32_t kills[kRollupColumns];
+    std::uint32_t rngCalls[kRollupColumns];
+    std::uint32_t hpEvents[kRollupColumns]; // HpChange events with damage or healing
+    std::uint32_t turns[kRollupColumns];    // closed turns of that side in the range
+};
+
+struct RollupTurnInfo
+{
+    TurnSide      side;           // side whose turn it was
+    std::uint32_t sideTurnIndex;  // TurnContext::sideTurnIndex at TurnEnd
+    std::uint32_t totalTurns;     // gMapState.totalTurns at TurnEnd
+};
+
+// Derived metric: a value computed from a range row for one column
+// (0..kRollupColumns-1).
+using RollupMetricFn = std::int32_t (*)(const RollupRow &range, int column);
+
+constexpr int kRollupMaxMetrics = 8;
+
+// Bus handlers. Wired in through kTurnRollupModule; don't call directly.
+void TurnRollup_OnMapBegin(const MapContext &ctx);
+void TurnRollup_OnMapEnd(const MapContext &ctx);
+void TurnRollup_OnTurnEnd(const TurnContext &ctx);
+void TurnRollup_OnHpChange(const HpChangeContext &ctx);
+void TurnRollup_OnKill(const KillContext &ctx);
+void TurnRollup_OnRng(const RngContext &ctx);
+
+// Module descriptor (built in, see engine/builtin_modules.hpp). Listed
+// before the modules that read it, so their MapEnd summaries see the
+// final numbers.
+inline constexpr ModuleDef kTurnRollupModule = [] {
+    ModuleDef m{};
+    m.tag        = "TurnRollup";
+    // A few adds per event: cheaper than a deferred queue slot, and the
+    // open row stays current between drains.
+    m.syncMask   = EventBit(EventKind::HpChange) | EventBit(EventKind::Kill) |
+                   EventBit(EventKind::RngCall);
+    m.onMapBegin = &TurnRollup_OnMapBegin;
+    m.onMapEnd   = &TurnRollup_OnMapEnd;
+    m.onTurnEnd  = &TurnRollup_OnTurnEnd;
+    m.onHpChange = &TurnRollup_OnHpChange;
+    m.onKill     = &TurnRollup_OnKill;
+    m.onRng      = &TurnRollup_OnRng;
+    return m;
+}();
+
+// Same as RegisterModule(kTurnRollupModule); harmless if already registered.
+bool TurnRollup_RegisterHandlers();
+
+// Number of turns closed this map (clamped to kRollupMaxTurns).
+int TurnRollup_ClosedTurns();
+
+// Sums over closed turns first..last (inclusive, clamped to the closed
+// range). Returns false and zeroes 'out' if the range is empty.
+bool TurnRollup_Range(int first, int last, RollupRow &out);
+
+// Sums since the last TurnEnd (the turn in progress).
+void TurnRollup_Open(RollupRow &out);
+
+// Closed turns plus the open row: everything seen this map.
+void TurnRollup_MapTotals(RollupRow &out);
+
+// Index of the most recently closed turn of 'side', or -1 if none.
+int TurnRollup_LastTurnOf(TurnSide side);
+
+// Who a closed turn belonged to. Returns false if 'turn' isn't closed.
+bool TurnRollup_GetTurnInfo(int turn, RollupTurnInfo &out);
+
+// Register a derived metric under 'name' (a string literal). Returns
+// its id, the existing id if 'name' is already registered, or -1 if the
+// table is full. Call from a module's init.
+int TurnRollup_RegisterMetric(const char *name, RollupMetricFn fn);
+
+// Id of the metric registered as 'name', or -1.
+int TurnRollup_FindMetric(const char *name);
+
+// Evaluate metric 'id' over closed turns first..last for 'column'.
+// Returns false if the id or the range is invalid.
+bool TurnRollup_QueryMetric(int id, int first, int last, int column, std::int32_t &out);
+
+} // namespace Engine
+} // namespace Fates
@@ -5,22 +5,24 @@
 // structs that higher-level systems can consume without having to
 // know about actual game layouts.
 //
-// Nothing in here touches CTRPF or concrete game structs; it's
-// all header-only and uses only opaque void* pointers.
+// Nothing in here touches CTRPF; it's all header-only. The few game
+// fields UnitHandle exposes come from the audited offset table in
+// engine/unit_layout.hpp.
 
 #pragma once
 
 #include <cstdint>
+#include "engine/unit_layout.hpp"
 
 namespace Fates {
 namespace Engine {
 
 /// Lightweight wrapper around a raw Unit*.
 ///
-/// This does NOT assume anything about the Unit layout. It just
-/// carries the pointer and provides a few utility helpers. Later,
-/// once we have a trusted catalog of offsets, buildings blocks
-/// such as HP / level / class here in one place.
+/// Carries the pointer plus typed field getters backed by
+/// engine/unit_layout.hpp. Each getter is a null check, the offset
+/// load from the active region layout and the field load; fields that
+/// aren't mapped yet (or before a layout is selected) return -1.
 struct UnitHandle
 {
     void *ptr;  // opaque Unit* (may be nullptr)
@@ -34,19 +36,24 @@ struct UnitHandle
     /// Raw underlying pointer (for logging / low-level work).
     void *Raw() const { return ptr; }
 
-    // Future: helpers like:
-    //   int  GetLevel() const;
-    //   int  GetCurrentHp() const;
-    //   int  GetMaxHp() const;
-    //   int  GetSide() const;
-    // all implemented in terms of a small, audited offset table.
+    int GetLevel() const     { return ptr ? Unit_GetLevel(ptr) : -1; }
+    int GetCurrentHp() const { return ptr ? Unit_GetCurrentHp(ptr) : -1; }
+    int GetMaxHp() const     { return ptr ? Unit_GetMaxHp(ptr) : -1; }
+
+    /// Raw side / force index (not a TurnSide). -1 until mapped.
+    int GetSideRaw() const   { return ptr ? Unit_GetSideRaw(ptr) : -1; }
+
+    /// Battle clone of this unit, or an invalid handle.
+    UnitHandle GetClone() const { return UnitHandle(ptr ? Unit_GetClone(ptr) : nullptr); }
 };
 
 /// High-level view of a single battle interaction.
 ///
-/// For now this is very conservative: I track the opaque battle
-/// calculator pointer and "main" unit pointer(s). As I reverse more
-/// of the combat engine, I will add weapon, stance, terrain, etc.
+/// Decoded once per battle by Engine::OnBattleCalc (first
+/// BTL_FinalDamage_Pre of the battle) and cached until the battle ends,
+/// so HP / kill attribution never has to go back to game memory.
+/// Fields come from engine/unit_layout.hpp (BattleLayout). As I reverse
+/// more of the combat engine, I will add weapon, stance, terrain, etc.
 /// without changing the rest of the event/bus API.
 struct BattleContext
 {
@@ -54,21 +61,37 @@ struct BattleContext
     void *calc;      // e.g. map__BattleCalculator*, Situation*, etc.
     void *root;      // e.g. BattleRoot* (if available), may be nullptr.
 
-    // Participants (attacker/defender) as abstract handles.
+    // Participants (attacker/defender) as abstract handles. The
+    // attacker is BattleRoot's main unit; the defender offset isn't
+    // mapped yet, so until it is the engine fills it in from the first
+    // HP change on another unit during the battle.
     UnitHandle attacker;
     UnitHandle defender;
 
     // Future: weapon, stance, terrain, flags...
     std::uint32_t flags;  // generic battle flags (semantics TBD)
 
+    // 1-based battle number within the current map (0 = no battle).
+    std::uint32_t serial;
+
     BattleContext()
         : calc(nullptr)
         , root(nullptr)
         , attacker()
         , defender()
         , flags(0)
+        , serial(0)
     {
     }
+
+    /// The other participant, or an invalid handle if 'unit' isn't
+    /// the attacker and the defender isn't known yet.
+    UnitHandle OpponentOf(void *unit) const
+    {
+        if (unit == attacker.Raw())
+            return defender;
+        return attacker;
+    }
 };
 
 /// Canonical representation of an HP change event.
@@ -118,5 +141,33 @@ struct HpEvent
     }
 };
 
+/// One unit command, decoded once by the hook stub from the game's
+/// 0x40-byte command event instance (ProcSequence object; the same
+/// header is seen behind EVENT_ActionEnd, SEQ_UnitMove and SEQ_ItemUse):
+///
+///   [0x1C] cmdData   [0x20] cmdId   [0x24] side   [0x28] unk28
+///
+/// Modules receive it through ActionContext and never need to read the
+/// instance themselves.
+struct ActionEvent
+{
+    void         *inst;     ///< the command event instance
+    void         *cmdData;  ///< [0x1C] command data / context
+    UnitHandle    unit;     ///< acting unit where the hook knows it (ItemUse), else null
+    std::uint32_t cmdId;    ///< [0x20] command type (0x0C in the attack test)
+    std::uint32_t sideRaw;  ///< [0x24] side as the game stores it (1 = Side1)
+    std::uint32_t unk28;    ///< [0x28] mode / flags word, meaning unknown
+
+    ActionEvent()
+        : inst(nullptr)
+        , cmdData(nullptr)
+        , unit()
+        , cmdId(0)
+        , sideRaw(0)
+        , unk28(0)
+    {
+    }
+};
+
 } // namespace Engine
 } // namespace Fates
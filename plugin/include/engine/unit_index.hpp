@@ -0,0 +1,108 @@
+// engine/unit_index.hpp
+//
+// Shared per-map Unit* -> dense slot index. Every engine module that
+// keeps per-unit state attaches it to the same slot id instead of
+// running its own pointer scan or hash map.
+//
+//   - Fixed capacity, open-addressed (linear probing), no allocation.
+//   - Buckets carry a generation stamp; UnitIndex_Reset() just bumps
+//     the stamp, so starting a new map is O(1) with no clearing loop.
+//   - UnitSlotTable<T> gives modules a per-slot array with the same
+//     lazy reset: an entry whose stamp is stale reads as "not set".
+//
+// Engine::OnMapBegin resets the index. Slots are only meaningful
+// within one index generation; don't keep them across maps.
+//
+// Not thread-safe: use from the game thread (hooks, bus handlers).
+
+#pragma once
+
+#include <cstdint>
+
+namespace Fates {
+namespace Engine {
+
+// Max distinct units per map. Must be a power of two.
+constexpr int kUnitIndexCapacity = 256;
+
+constexpr int kInvalidUnitSlot = -1;
+
+// Look up 'unit', inserting it if new. Returns a slot in
+// [0, kUnitIndexCapacity) or kInvalidUnitSlot (nullptr / index full).
+int UnitIndex_Acquire(void *unit);
+
+// Look up only. Returns kInvalidUnitSlot if 'unit' has not been seen
+// since the last reset.
+int UnitIndex_Find(void *unit);
+
+// Unit* stored in 'slot' (nullptr if the slot is unused).
+void *UnitIndex_GetUnit(int slot);
+
+// Number of slots handed out since the last reset.
+int UnitIndex_Count();
+
+// Current stamp; bumped by every reset. Never 0.
+std::uint32_t UnitIndex_Generation();
+
+// Forget every unit (O(1)).
+void UnitIndex_Reset();
+
+// Commonly needed per-unit fields, read together (engine/unit_layout.hpp).
+struct UnitSummary
+{
+    void         *unit;
+    std::int16_t  slot;
+    std::int16_t  hp;       // current HP
+    std::int16_t  maxHp;    // -1 until the field is mapped
+    std::uint8_t  level;
+    std::int8_t   sideRaw;  // raw force index, -1 until mapped
+};
+
+// Summarise every unit indexed this map, in slot order, in one sweep
+// over the slot table (prefetching the next unit while reading the
+// current one). Use this instead of reading fields unit by unit. Slots
+// whose pointer no longer covers a readable Unit (kUnitReadSpan in the
+// heap, util/safe_read.hpp) are skipped, so UnitSummary::slot can have
+// gaps. Returns the number of entries written (<= max).
+int UnitIndex_ReadSummaries(UnitSummary *out, int max);
+
+// Per-slot module data with generation-stamped lazy reset.
+//
+//   static UnitSlotTable<MyUnitData> sData;
+//   if (MyUnitData *d = sData.Get(UnitIndex_Acquire(unit))) ...
+//
+// Get() value-initialises the entry on first touch in a generation;
+// Peek() returns nullptr for entries not touched in this generation.
+template <typename T>
+struct UnitSlotTable
+{
+    T             data[kUnitIndexCapacity];
+    std::uint32_t stamp[kUnitIndexCapacity];
+
+    T *Get(int slot)
+    {
+        if (slot < 0 || slot >= kUnitIndexCapacity)
+            return nullptr;
+
+        std::uint32_t gen = UnitIndex_Generation();
+        if (stamp[slot] != gen)
+        {
+            data[slot]  = T{};
+            stamp[slot] = gen;
+        }
+        return &data[slot];
+    }
+
+    const T *Peek(int slot) const
+    {
+        if (slot < 0 || slot >= kUnitIndexCapacity)
+            return nullptr;
+
+        if (stamp[slot] != UnitIndex_Generation())
+            return nullptr;
+        return &data[slot];
+    }
+};
+
+} // namespace Engine
+} // namespace Fates
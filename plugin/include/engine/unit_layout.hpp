@@ -0,0 +1,236 @@
+// engine/unit_layout.hpp
+//
+// Audited field offsets for the game structs the engine reads. Every
+// raw "+0xF3"-style read in the hook stubs and engine goes through the
+// accessors below, so an offset lives in exactly one place.
+//
+// The offsets themselves are per region: they live in
+// addresses/<region>.yml ('layout') and are generated into the region's
+// HookRegionTable with its hooks. HookManager::Init picks the table by
+// title ID and hands its layout to UnitLayout_Select(); until then (and
+// on the host harness) every field reads as unmapped. Each accessor is
+// one load of the offset from the active layout plus the field load.
+//
+// Fields that haven't been found yet are kUnmappedField; their
+// accessors return "unknown" (-1 / nullptr). Don't guess offsets here:
+// add them to the YAML once they're confirmed in a disassembly or a
+// memory dump.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Fates {
+namespace Engine {
+
+constexpr std::uint16_t kUnmappedField = 0xFFFF;
+
+// Unit (Unit__* functions, 'this' in UNIT_* hooks).
+struct UnitLayout
+{
+    std::uint16_t level;     // u8  (Unit__LevelUp)
+    std::uint16_t curHp;     // s8  (Unit__UpdateCloneHP)
+    std::uint16_t maxHp;     // not mapped yet
+    std::uint16_t side;      // not mapped yet (force / army index)
+    std::uint16_t clone;     // Unit*, battle clone (Unit__UpdateCloneHP)
+};
+
+// map::SequenceBattle::ProcSequence (HP_KillCheck 'this').
+struct SeqBattleLayout
+{
+    std::uint16_t deadFlags; // u32 bitfield
+    std::uint16_t dead0;     // Unit* or nullptr
+    std::uint16_t dead1;     // Unit* or nullptr
+};
+
+// map::BattleCalculator and the BattleRoot it points at
+// (BTL_FinalDamage_Pre 'this').
+struct BattleLayout
+{
+    std::uint16_t calcRoot;     // BattleRoot*, in the calculator
+    std::uint16_t rootMain;     // Unit*, initiating unit (UNIT_UpdateCloneHP space)
+    std::uint16_t rootTarget;   // Unit*, other side, not mapped yet
+    std::uint16_t rootFlags;    // u32, 0x4000xxxx / 0x4001xxxx patterns
+};
+
+// Everything one region maps; emitted per region by
+// scripts/gen_hook_tables.py.
+struct GameLayout
+{
+    UnitLayout      unit;
+    SeqBattleLayout seqBattle;
+    BattleLayout    battle;
+};
+
+// Byte spans the accessors may read from each struct. The hook stubs
+// only hand a game pointer to them if the whole span is in the heap
+// (util/safe_read.hpp), so every mapped field must lie inside.
+constexpr std::size_t kUnitReadSpan       = 0x100;
+constexpr std::size_t kSeqBattleReadSpan  = 0x28C;
+constexpr std::size_t kBattleRootReadSpan = 0x20;
+
+constexpr bool IsMapped(std::uint16_t offset)
+{
+    return offset != kUnmappedField;
+}
+
+constexpr bool IsWordAligned(std::uint16_t offset)
+{
+    return !IsMapped(offset) || (offset & 3u) == 0;
+}
+
+// 'size' bytes at 'offset' lie inside 'span' (or the field is unmapped).
+constexpr bool FitsSpan(std::uint16_t offset, std::size_t size, std::size_t span)
+{
+    return !IsMapped(offset) || offset + size <= span;
+}
+
+// The checks the accessors and the stub read guards rely on. The
+// generated tables static_assert this for every region;
+// UnitLayout_Select() checks it again before publishing a layout.
+constexpr bool IsValidLayout(const GameLayout &l)
+{
+    return IsMapped(l.unit.level) && IsMapped(l.unit.curHp) &&
+           l.unit.level != l.unit.curHp &&
+           IsWordAligned(l.unit.clone) &&
+           FitsSpan(l.unit.level, 1, kUnitReadSpan) &&
+           FitsSpan(l.unit.curHp, 1, kUnitReadSpan) &&
+           FitsSpan(l.unit.maxHp, 1, kUnitReadSpan) &&
+           FitsSpan(l.unit.side, 1, kUnitReadSpan) &&
+           FitsSpan(l.unit.clone, 4, kUnitReadSpan) &&
+           IsWordAligned(l.seqBattle.deadFlags) &&
+           IsWordAligned(l.seqBattle.dead0) &&
+           IsWordAligned(l.seqBattle.dead1) &&
+           FitsSpan(l.seqBattle.deadFlags, 4, kSeqBattleReadSpan) &&
+           FitsSpan(l.seqBattle.dead0, 4, kSeqBattleReadSpan) &&
+           FitsSpan(l.seqBattle.dead1, 4, kSeqBattleReadSpan) &&
+           IsMapped(l.battle.calcRoot) && IsMapped(l.battle.rootMain) &&
+           IsWordAligned(l.battle.calcRoot) &&
+           IsWordAligned(l.battle.rootMain) &&
+           IsWordAligned(l.battle.rootTarget) &&
+           IsWordAligned(l.battle.rootFlags) &&
+           FitsSpan(l.battle.rootMain, 4, kBattleRootReadSpan) &&
+           FitsSpan(l.battle.rootTarget, 4, kBattleRootReadSpan) &&
+           FitsSpan(l.battle.rootFlags, 4, kBattleRootReadSpan);
+}
+
+// Active layout, all fields unmapped until UnitLayout_Select().
+// Defined in engine/unit_layout.cpp; written once at boot, before any
+// hook is installed, and only read afterwards.
+extern UnitLayout      gUnitLayout;
+extern SeqBattleLayout gSeqBattleLayout;
+extern BattleLayout    gBattleLayout;
+
+// Publish 'layout' as the active one. Returns false (and leaves every
+// field unmapped) if it fails IsValidLayout().
+bool UnitLayout_Select(const GameLayout &layout, const char *region);
+
+// Single load of a T at 'obj + offset'. 'obj' must be non-null.
+template <typename T>
+inline T ReadField(const void *obj, std::uint16_t offset)
+{
+    return *reinterpret_cast<const T *>(static_cast<const std::uint8_t *>(obj) + offset);
+}
+
+// --- Unit accessors ('unit' must be non-null) ---------------------------
+
+// -1 until a layout is selected.
+inline int Unit_GetLevel(const void *unit)
+{
+    if (!IsMapped(gUnitLayout.level))
+        return -1;
+    return ReadField<std::uint8_t>(unit, gUnitLayout.level);
+}
+
+// -1 until a layout is selected.
+inline int Unit_GetCurrentHp(const void *unit)
+{
+    if (!IsMapped(gUnitLayout.curHp))
+        return -1;
+    return ReadField<std::int8_t>(unit, gUnitLayout.curHp);
+}
+
+// -1 until the field is mapped.
+inline int Unit_GetMaxHp(const void *unit)
+{
+    if (!IsMapped(gUnitLayout.maxHp))
+        return -1;
+    return ReadField<std::uint8_t>(unit, gUnitLayout.maxHp);
+}
+
+// Raw side / force index, -1 until the field is mapped.
+inline int Unit_GetSideRaw(const void *unit)
+{
+    if (!IsMapped(gUnitLayout.side))
+        return -1;
+    return ReadField<std::uint8_t>(unit, gUnitLayout.side);
+}
+
+// nullptr while unmapped.
+inline void *Unit_GetClone(const void *unit)
+{
+    if (!IsMapped(gUnitLayout.clone))
+        return nullptr;
+    return ReadField<void *>(unit, gUnitLayout.clone);
+}
+
+// --- SequenceBattle accessors ('seq' must be non-null) ------------------
+
+// Unmapped fields read as 0 / nullptr.
+inline std::uint32_t SeqBattle_GetDeadFlags(const void *seq)
+{
+    if (!IsMapped(gSeqBattleLayout.deadFlags))
+        return 0;
+    return ReadField<std::uint32_t>(seq, gSeqBattleLayout.deadFlags);
+}
+
+inline void *SeqBattle_GetDead0(const void *seq)
+{
+    if (!IsMapped(gSeqBattleLayout.dead0))
+        return nullptr;
+    return ReadField<void *>(seq, gSeqBattleLayout.dead0);
+}
+
+inline void *SeqBattle_GetDead1(const void *seq)
+{
+    if (!IsMapped(gSeqBattleLayout.dead1))
+        return nullptr;
+    return ReadField<void *>(seq, gSeqBattleLayout.dead1);
+}
+
+// --- Battle accessors ('calc' / 'root' must be non-null) -----------------
+
+// nullptr until a layout is selected.
+inline void *BattleCalc_GetRoot(const void *calc)
+{
+    if (!IsMapped(gBattleLayout.calcRoot))
+        return nullptr;
+    return ReadField<void *>(calc, gBattleLayout.calcRoot);
+}
+
+// nullptr until a layout is selected.
+inline void *BattleRoot_GetMainUnit(const void *root)
+{
+    if (!IsMapped(gBattleLayout.rootMain))
+        return nullptr;
+    return ReadField<void *>(root, gBattleLayout.rootMain);
+}
+
+// nullptr until the field is mapped.
+inline void *BattleRoot_GetTargetUnit(const void *root)
+{
+    if (!IsMapped(gBattleLayout.rootTarget))
+        return nullptr;
+    return ReadField<void *>(root, gBattleLayout.rootTarget);
+}
+
+inline std::uint32_t BattleRoot_GetFlags(const void *root)
+{
+    if (!IsMapped(gBattleLayout.rootFlags))
+        return 0;
+    return ReadField<std::uint32_t>(root, gBattleLayout.rootFlags);
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -11,4 +11,6 @@ void DumpKillEventsToLog();
 
 void ShowHookCountsOSD();
 void DumpHookCountsToFile();
+// FATES_HOOK_CALLTREE builds only: sdmc:/Fates3GX/hook_calltree.folded.
+void DumpHookCallTreeToFile();
 void InstallHookDebugMenu(CTRPluginFramework::PluginMenu& menu);
@@ -0,0 +1,55 @@
+// stats_overlay.hpp
+//
+// Live stats overlay on the top screen: per-side damage / kills for the
+// current map, the RNG call rate and the three busiest hooks (by cost
+// with FATES_HOOK_PROFILER, by calls otherwise). Drawn every frame from
+// CTRPF's OSD callback, so it can stay on during play.
+//
+//   - The game thread samples the counters (turn rollup, map state) at
+//     map / turn / action / battle boundaries and from
+//     Hook_HUD_Battle_HPGaugeUpdate while a battle is on screen, and
+//     publishes them through a seqlock only when they changed.
+//   - The OSD callback keeps every line pre-formatted together with the
+//     values it shows. A frame re-reads the counters only if a new
+//     version was published, and a line is re-formatted only if its
+//     values differ, so a frame where nothing changed costs one
+//     comparison per line plus the draw calls.
+//   - Rate and hook lines are recomputed once per second.
+//
+// Toggle with L + R + Select + Y or the debug menu entry.
+
+#pragma once
+
+#include "engine/events.hpp"
+#include "engine/module_list.hpp"
+
+// Register the sampling handlers on the engine bus. Call once at
+// startup with the other modules; they return at once while the
+// overlay is off.
+bool StatsOverlay_RegisterHandlers();
+
+// Any thread. Starts / stops the OSD callback.
+void StatsOverlay_SetEnabled(bool enabled);
+bool StatsOverlay_IsEnabled();
+
+// Game thread: sample the counters and publish them if they changed.
+// No-op while the overlay is off.
+void StatsOverlay_Sample();
+
+// Bus handlers (kStatsOverlayModule); each just samples.
+void StatsOverlay_OnMapBegin(const Fates::Engine::MapContext &ctx);
+void StatsOverlay_OnTurnBegin(const Fates::Engine::TurnContext &ctx);
+void StatsOverlay_OnTurnEnd(const Fates::Engine::TurnContext &ctx);
+void StatsOverlay_OnBattleEnd(const Fates::Engine::BattleEventContext &ctx);
+void StatsOverlay_OnActionEnd(const Fates::Engine::ActionContext &ctx);
+
+inline constexpr Fates::Engine::ModuleDef kStatsOverlayModule = [] {
+    Fates::Engine::ModuleDef m{};
+    m.tag         = "StatsOverlay";
+    m.onMapBegin  = &StatsOverlay_OnMapBegin;
+    m.onTurnBegin = &StatsOverlay_OnTurnBegin;
+    m.onTurnEnd   = &StatsOverlay_OnTurnEnd;
+    m.onBattleEnd = &StatsOverlay_OnBattleEnd;
+    m.onActionEnd = &StatsOverlay_OnActionEnd;
+    return m;
+}();
@@ -1,28 +1,144 @@
+// util/debug_log.hpp
+//
+// Plugin-wide debug logging. Logf() only formats the line and copies
+// it into an in-RAM ring buffer; nothing touches the SD card on the
+// calling thread. The ring is drained to sdmc:/Fates3GX/fates_3gx.log
+// through a single file handle that stays open for the session.
+//
+//   - Log_Pump()  : called periodically (worker thread, util/worker.hpp).
+//                   Writes only when a large chunk is pending or the
+//                   last write is old enough, so SD writes stay big and
+//                   infrequent.
+//   - Log_Flush() : drains everything now. Posted to the worker at map
+//                   end; called directly on plugin exit.
+//
+// If the ring is full when Logf() is called the line is dropped and
+// counted; the drop count is written into the log on the next drain.
+//
+// Levels and categories
+// ---------------------
+// Plugin code logs through FATES_LOG(level, category, fmt, ...) rather
+// than calling Logf() directly:
+//
+//   FATES_LOG(Debug, Hook, "Hook_SYS_Rng32: raw=%08X (n=%u)", raw, n);
+//
+// A call whose level is above FATES_LOG_LEVEL, or whose category is
+// not in FATES_LOG_CATEGORIES, is discarded at compile time: the format
+// string, the argument setup and the Logf() call are all gone from the
+// 3GX. Guard a LogGate (or any other work done only for a log line)
+// with FATES_LOG_ON() so it folds away too:
+//
+//   if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
+//       FATES_LOG(Debug, Hook, "...", LogGate_Count(sLogGate));
+//
+// Categories that are compiled in can be switched off at runtime
+// through Log_SetCategoryMask() (debug menu "Log categories...").
+//
+//   Hook   : hook stubs and hook install / config
+//   Engine : engine core, bus, sinks, plugin lifecycle
+//   Module : built-in and SDK modules
+//   RE     : raw struct dumps and other reverse-engineering output
+//
+// The default (FATES_LOG_LEVEL_DEBUG, every category) keeps the full
+// RE-build verbosity. A shipping build passes e.g.
+// -DFATES_LOG_LEVEL=FATES_LOG_LEVEL_WARN -DFATES_LOG_CATEGORIES=0x7.
+// Trace is for per-call output that is too noisy even for RE builds.
+// Logf() itself is unconditional.
+
 #pragma once
-#include <CTRPluginFramework.hpp>
-#include <cstdarg>
-#include <cstring>
-
-inline void Logf(const char* fmt, ...) {
-    using namespace CTRPluginFramework;
-
-    va_list va; 
-    va_start(va, fmt);
-    char buf[256];
-    vsnprintf(buf, sizeof(buf), fmt, va);
-    va_end(va);
-
-    // Ensure directory exists (best-effort)
-    Directory::Create("sdmc:/Fates3GX");
-
-    File f;
-    if (File::Open(f, "sdmc:/Fates3GX/fates_3gx.log", File::WRITE | File::CREATE) == 0) {
-        f.Seek(0, File::END);
-        f.Write(buf, strlen(buf));
-        f.Write("\r\n", 2);
-        f.Close();
-    }
+
+#include <cstdint>
+
+#define FATES_LOG_LEVEL_NONE  0
+#define FATES_LOG_LEVEL_ERROR 1
+#define FATES_LOG_LEVEL_WARN  2
+#define FATES_LOG_LEVEL_INFO  3
+#define FATES_LOG_LEVEL_DEBUG 4
+#define FATES_LOG_LEVEL_TRACE 5
+
+#ifndef FATES_LOG_LEVEL
+#define FATES_LOG_LEVEL FATES_LOG_LEVEL_DEBUG
+#endif
+
+#define FATES_LOG_CAT_HOOK   0x1u
+#define FATES_LOG_CAT_ENGINE 0x2u
+#define FATES_LOG_CAT_MODULE 0x4u
+#define FATES_LOG_CAT_RE     0x8u
+#define FATES_LOG_CAT_ALL    0xFu
+
+#ifndef FATES_LOG_CATEGORIES
+#define FATES_LOG_CATEGORIES FATES_LOG_CAT_ALL
+#endif
+
+enum class LogLevel : std::uint8_t
+{
+    None  = FATES_LOG_LEVEL_NONE,
+    Error = FATES_LOG_LEVEL_ERROR,
+    Warn  = FATES_LOG_LEVEL_WARN,
+    Info  = FATES_LOG_LEVEL_INFO,
+    Debug = FATES_LOG_LEVEL_DEBUG,
+    Trace = FATES_LOG_LEVEL_TRACE,
+};
+
+enum LogCategory : std::uint32_t
+{
+    LogCat_Hook   = FATES_LOG_CAT_HOOK,
+    LogCat_Engine = FATES_LOG_CAT_ENGINE,
+    LogCat_Module = FATES_LOG_CAT_MODULE,
+    LogCat_RE     = FATES_LOG_CAT_RE,
+    LogCat_All    = FATES_LOG_CAT_ALL,
+};
+
+// Compile-time filter.
+constexpr bool Log_Compiled(LogLevel level, std::uint32_t category)
+{
+    return static_cast<int>(level) <= FATES_LOG_LEVEL &&
+           (category & FATES_LOG_CATEGORIES) != 0;
 }
 
+// Runtime filter for the compiled-in categories (all on at boot).
+extern volatile std::uint32_t gLogCategoryMask;
+
+inline bool Log_CategoryOn(std::uint32_t category)
+{
+    return (gLogCategoryMask & category) != 0;
+}
+
+void          Log_SetCategoryMask(std::uint32_t mask);
+std::uint32_t Log_GetCategoryMask();
+
+// Category name for menus ("Hook", "Engine", ...); one bit only.
+const char *Log_CategoryName(std::uint32_t category);
+
+#define FATES_LOG_ON(level, cat) \
+    (Log_Compiled(LogLevel::level, LogCat_##cat) && Log_CategoryOn(LogCat_##cat))
+
+#define FATES_LOG(level, cat, ...)                                  \
+    do {                                                            \
+        if constexpr (Log_Compiled(LogLevel::level, LogCat_##cat))  \
+        {                                                           \
+            if (Log_CategoryOn(LogCat_##cat))                       \
+                Logf(__VA_ARGS__);                                  \
+        }                                                           \
+    } while (0)
+
+void Logf(const char *fmt, ...);
+
+// Drain pending log data if enough has accumulated (cheap otherwise).
+void Log_Pump();
+
+// Drain all pending log data and flush the file handle.
+void Log_Flush();
+
+// Crash path. Log_TryFlush() is Log_Flush() without waiting: it returns
+// false, and writes nothing, if another thread holds the drain lock.
+// After Log_BeginCrash(), Logf() drops the line instead of blocking on
+// a held producer lock.
+bool Log_TryFlush();
+void Log_BeginCrash();
 
+// Total number of lines dropped because the ring was full.
+std::uint32_t Log_GetDroppedLines();
 
+// Highest number of bytes that were pending in the ring at once.
+std::uint32_t Log_GetHighWater();
@@ -0,0 +1,103 @@
+// util/log_gate.hpp
+//
+// Shared rate limiter for hot-path debug logging. Replaces the
+// per-stub "static int sLogCount; if (sLogCount < 64)" windows, which
+// went silent for the rest of the session once the cap was hit.
+//
+// Each gate lets a burst of lines through per map, then samples one
+// line in every 'sampleEvery' for the rest of that map:
+//
+//   static LogGate sLogGate("HitCalc", 64);
+//   if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
+//       FATES_LOG(Debug, Hook, "... (n=%u)", LogGate_Count(sLogGate));
+//
+//   - The constructor is constexpr, so a function-local static gate is
+//     constant-initialised (no guard variable).
+//   - LogGate_Allow() is one decrement and one branch; the burst /
+//     sampling decision only runs out of line when the countdown hits
+//     zero (end of burst, or once per sampled line).
+//   - A gate links itself into a global list the first time it fires.
+//     Engine::OnMapBegin calls LogGate_ResetAll(), Engine::OnMapEnd
+//     calls LogGate_ReportDrops() to log per-gate drop counts.
+//
+// Not thread-safe: use from the game thread (hooks, bus handlers). A
+// race only skews counts, it can't corrupt the list (linking happens
+// once per gate).
+
+#pragma once
+
+#include <cstdint>
+
+// Default sampling rate after the burst: 1 line in 256.
+constexpr std::uint32_t kLogGateDefaultSampleEvery = 256;
+
+struct LogGate
+{
+    enum Phase : std::uint8_t
+    {
+        Phase_Fresh,     // nothing seen this generation
+        Phase_Burst,     // passing everything
+        Phase_Sampling,  // passing 1 in sampleEvery
+    };
+
+    const char   *name;
+    std::uint32_t burst;
+    std::uint32_t sampleEvery;
+
+    // Calls left until the next out-of-line decision. The call that
+    // takes it to zero goes to LogGate_Decide().
+    std::uint32_t countdown;
+    // Call count at which countdown reaches zero; the calls seen this
+    // generation are (deadline - countdown).
+    std::uint32_t deadline;
+    std::uint32_t sampled;   // lines passed while sampling
+    bool          open;      // result for calls that don't decide
+    Phase         phase;
+    bool          linked;
+    LogGate      *next;
+
+    constexpr LogGate(const char   *gateName,
+                      std::uint32_t burstLines,
+                      std::uint32_t sampleEveryN = kLogGateDefaultSampleEvery)
+        : name(gateName)
+        , burst(burstLines)
+        , sampleEvery(sampleEveryN < 2 ? 2 : sampleEveryN)
+        , countdown(1)
+        , deadline(1)
+        , sampled(0)
+        , open(true)
+        , phase(Phase_Fresh)
+        , linked(false)
+        , next(nullptr)
+    {
+    }
+};
+
+// Out-of-line part of LogGate_Allow(). Don't call directly.
+bool LogGate_Decide(LogGate &gate);
+
+// True if the caller should log this line.
+inline bool LogGate_Allow(LogGate &gate)
+{
+    if (__builtin_expect(--gate.countdown != 0, 1))
+        return gate.open;
+    return LogGate_Decide(gate);
+}
+
+// Calls seen by this gate in the current generation, including the
+// one just passed to LogGate_Allow(). Handy for "(n=%u)" suffixes.
+inline std::uint32_t LogGate_Count(const LogGate &gate)
+{
+    return gate.deadline - gate.countdown;
+}
+
+// Lines this gate has suppressed in the current generation.
+std::uint32_t LogGate_Dropped(const LogGate &gate);
+
+// Start a new generation on every gate (burst budget restored, drop
+// counts cleared). Called from Engine::OnMapBegin.
+void LogGate_ResetAll();
+
+// Log one line per gate that dropped something this generation.
+// Called from Engine::OnMapEnd.
+void LogGate_ReportDrops();
@@ -0,0 +1,129 @@
+// util/safe_read.hpp
+//
+// Bounds-checked reads of game memory for hook stubs. A hook that
+// follows a pointer it got from the game (struct fields, static
+// pointer chains) should go through these instead of dereferencing it
+// directly: an unmapped address is a data abort that takes the whole
+// game down, while a rejected SafeRead just returns false.
+//
+// The check is a range test against the regions game objects are
+// known to live in (no syscall, so it is cheap enough for every call):
+//
+//   kSafeReadHeap  : battle / map heap (observed unit, root and
+//                    situation pointers all fall in 0x32xxxxxx-0x33xxxxxx)
+//   kSafeReadImage : the game's code and static data (hook sites, the
+//                    turn-state chain root)
+//
+// plus natural alignment for the type read. Rejections are counted
+// (SafeRead_GetRejects) so a wrong offset shows up in the log instead
+// of as a crash.
+//
+//   std::uint32_t v;
+//   if (SafeRead(base + 0x20, v)) ...
+//
+//   std::uintptr_t unit = 0;
+//   SafeRead_HeapPtr(seq + 0x30, unit);   // pointer must land in the heap
+//
+// Game thread and hooks only; the counter is not atomic.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct SafeReadRange
+{
+    std::uintptr_t min;  // first valid byte
+    std::uintptr_t max;  // last valid byte
+};
+
+constexpr SafeReadRange kSafeReadHeap  = { 0x32000000u, 0x33FFFFFFu };
+constexpr SafeReadRange kSafeReadImage = { 0x00100000u, 0x00FFFFFFu };
+
+// Reads rejected since boot (out of range or misaligned).
+extern std::uint32_t gSafeReadRejects;
+
+inline bool SafeRead_InRange(std::uintptr_t addr, std::size_t size, const SafeReadRange &r)
+{
+    return size != 0 && addr >= r.min && addr <= r.max && size - 1 <= r.max - addr;
+}
+
+inline bool SafeRead_InHeap(std::uintptr_t addr, std::size_t size = 1)
+{
+    return SafeRead_InRange(addr, size, kSafeReadHeap);
+}
+
+inline bool SafeRead_InHeap(const void *p, std::size_t size = 1)
+{
+    return SafeRead_InHeap(reinterpret_cast<std::uintptr_t>(p), size);
+}
+
+inline bool SafeRead_IsReadable(std::uintptr_t addr, std::size_t size)
+{
+    return SafeRead_InRange(addr, size, kSafeReadHeap) ||
+           SafeRead_InRange(addr, size, kSafeReadImage);
+}
+
+// Read a T from 'addr' if it is readable and aligned for T.
+template <typename T>
+inline bool SafeRead(std::uintptr_t addr, T &out)
+{
+    if ((addr & (alignof(T) - 1)) != 0 || !SafeRead_IsReadable(addr, sizeof(T)))
+    {
+        ++gSafeReadRejects;
+        return false;
+    }
+
+    out = *reinterpret_cast<const volatile T *>(addr);
+    return true;
+}
+
+template <typename T>
+inline bool SafeRead(const void *addr, T &out)
+{
+    return SafeRead(reinterpret_cast<std::uintptr_t>(addr), out);
+}
+
+// Read a pointer field and require the pointer itself to point into
+// the heap. 'out' is 0 on failure.
+inline bool SafeRead_HeapPtr(std::uintptr_t addr, std::uintptr_t &out)
+{
+    std::uint32_t v = 0;
+    if (!SafeRead(addr, v) || !SafeRead_InHeap(v))
+    {
+        if (v != 0)
+            ++gSafeReadRejects;
+        out = 0;
+        return false;
+    }
+
+    out = v;
+    return true;
+}
+
+inline bool SafeRead_HeapPtr(const void *addr, std::uintptr_t &out)
+{
+    return SafeRead_HeapPtr(reinterpret_cast<std::uintptr_t>(addr), out);
+}
+
+// Copy 'count' words for a hexdump; zero-fills and returns false if
+// any of them is out of range.
+inline bool SafeRead_Words(const void *addr, std::uint32_t *out, std::size_t count)
+{
+    const std::uintptr_t a = reinterpret_cast<std::uintptr_t>(addr);
+    if ((a & 3u) != 0 || !SafeRead_IsReadable(a, count * 4u))
+    {
+        ++gSafeReadRejects;
+        std::memset(out, 0, count * 4u);
+        return false;
+    }
+
+    std::memcpy(out, addr, count * 4u);
+    return true;
+}
+
+inline std::uint32_t SafeRead_GetRejects()
+{
+    return gSafeReadRejects;
+}
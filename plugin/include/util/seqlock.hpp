@@ -0,0 +1,63 @@
+// util/seqlock.hpp
+//
+// Single-writer sequence lock around a plain-old-data value. The writer
+// (game thread) never blocks: Publish() bumps the sequence to odd,
+// copies the value in and bumps it back to even. Readers (DebugThread,
+// menu callbacks, later the second-core worker) copy the value out and
+// retry if the sequence was odd or changed while they were copying, so
+// they never see a half-written value.
+//
+//   static SeqLock<MySnapshot> sSnap;
+//   sSnap.Publish(value);                  // writer only
+//   MySnapshot copy;
+//   if (sSnap.Read(copy)) ...              // any thread
+//
+// T must be trivially copyable. Only one thread may call Publish().
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template <typename T>
+struct SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock<T> copies T with memcpy");
+
+    volatile std::uint32_t seq = 0;  // odd while a publish is in progress
+    T                      value{};
+
+    // Copy 'v' in. Writer thread only; never waits.
+    void Publish(const T &v)
+    {
+        seq = seq + 1;
+        __sync_synchronize();
+        std::memcpy(&value, &v, sizeof(T));
+        __sync_synchronize();
+        seq = seq + 1;
+    }
+
+    // Copy the latest value into 'out'. Returns false if nothing has
+    // been published yet, or if the writer kept publishing for
+    // 'maxTries' attempts in a row ('out' is then unspecified).
+    bool Read(T &out, int maxTries = 64) const
+    {
+        for (int i = 0; i < maxTries; ++i)
+        {
+            const std::uint32_t s0 = seq;
+            if (s0 & 1u)
+                continue;
+            __sync_synchronize();
+            std::memcpy(&out, const_cast<const T *>(&value), sizeof(T));
+            __sync_synchronize();
+            if (seq == s0)
+                return s0 != 0;
+        }
+        return false;
+    }
+
+    // Number of completed publishes (0 = never published).
+    std::uint32_t Version() const { return seq >> 1; }
+};
@@ -0,0 +1,50 @@
+// util/worker.hpp
+//
+// Background worker thread for SD I/O. Hotkeys and menu entries post
+// jobs (dumps, config saves, sink flushes) instead of running them on
+// their own thread, and the worker also runs a periodic callback
+// (MainImpl passes the log / trace / RNG / history pumps), so neither
+// the game thread nor the plugin's UI loop ever waits on the SD card.
+//
+// On New 3DS the worker is pinned to core 2 when the process may use
+// it; otherwise it shares the plugin's core at a slightly lower
+// priority. If the thread can't be created at all, Worker_Post() runs
+// jobs inline and Worker_IsRunning() returns false so the caller keeps
+// pumping the sinks itself.
+//
+// The engine's deferred event queue is not drained here: it stays on
+// the game thread (engine/bus.hpp) so module state is never shared
+// across threads.
+
+#pragma once
+
+#include <cstdint>
+
+using WorkerJobFn = void (*)(void *arg);
+
+// Start the worker. 'periodic' (may be null) runs every ~50 ms and
+// after each batch of jobs. Returns false if no thread could be created
+// (inline mode).
+bool Worker_Start(WorkerJobFn periodic);
+
+// Run the remaining jobs and one last periodic pass, then join the
+// thread. Safe to call when the worker never started.
+void Worker_Stop();
+
+bool Worker_IsRunning();
+
+// Queue fn(arg) for the worker. 'tag' names the job in the log.
+// Returns false (and logs) if the queue is full; the job is dropped.
+// Without a worker the job runs inline before this returns.
+bool Worker_Post(WorkerJobFn fn, void *arg, const char *tag);
+
+struct WorkerStats
+{
+    std::int32_t  core;        // core the worker was created on (-2 = creator's)
+    std::uint32_t posted;
+    std::uint32_t completed;
+    std::uint32_t dropped;     // Worker_Post() calls refused (queue full)
+    std::uint64_t maxJobTicks; // slowest single job
+};
+
+void Worker_GetStats(WorkerStats &out);
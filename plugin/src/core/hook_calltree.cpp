@@ -0,0 +1,113 @@
+// core/hook_calltree.cpp
+//
+// Node table + scope stack for the optional hook call-tree tracer. See
+// core/hook_calltree.hpp. Compiles to nothing unless
+// FATES_HOOK_CALLTREE=1.
+
+#include "core/hook_calltree.hpp"
+
+#if FATES_HOOK_CALLTREE
+
+namespace Fates {
+
+CallTree gCallTree;
+
+namespace {
+
+// Child of 'parent' (kCallTreeNone = root list) for 'hook', created on
+// first use. kCallTreeNone if the table is full.
+std::uint16_t FindOrAddNode(std::uint16_t parent, std::uint16_t hook)
+{
+    CallTree &t = gCallTree;
+
+    std::uint16_t &head = (parent == kCallTreeNone) ? t.firstRoot
+                                                    : t.nodes[parent].firstChild;
+    for (std::uint16_t n = head; n != kCallTreeNone; n = t.nodes[n].nextSibling)
+    {
+        if (t.nodes[n].hook == hook)
+            return n;
+    }
+
+    if (t.nodeCount >= kCallTreeMaxNodes)
+        return kCallTreeNone;
+
+    std::uint16_t n = t.nodeCount++;
+    CallTreeNode &node = t.nodes[n];
+    node = CallTreeNode{};
+    node.parent      = parent;
+    node.hook        = hook;
+    node.firstChild  = kCallTreeNone;
+    node.nextSibling = head;
+    head = n;
+    return n;
+}
+
+} // anonymous namespace
+
+void CallTree_Enter(HookId id)
+{
+    CallTree &t = gCallTree;
+    std::uint16_t d = t.depth++;
+
+    if (t.depth > t.maxDepth)
+        t.maxDepth = t.depth;
+
+    if (d >= kCallTreeMaxDepth)
+    {
+        ++t.dropped;
+        return;
+    }
+
+    // Under a dropped call the edge is unknown: drop this one too.
+    std::uint16_t parent = (d == 0) ? kCallTreeNone : t.stack[d - 1];
+    std::uint16_t node   = kCallTreeNone;
+    if (d == 0 || parent != kCallTreeNone)
+        node = FindOrAddNode(parent, static_cast<std::uint16_t>(id));
+
+    if (node == kCallTreeNone)
+        ++t.dropped;
+
+    t.stack[d]      = node;
+    t.childTicks[d] = 0;
+}
+
+void CallTree_Exit(std::uint32_t totalTicks)
+{
+    CallTree &t = gCallTree;
+    if (t.depth == 0)
+        return;
+
+    std::uint16_t d = --t.depth;
+    if (d >= kCallTreeMaxDepth)
+        return;
+
+    std::uint16_t n = t.stack[d];
+    if (n != kCallTreeNone)
+    {
+        // Children can only exceed the parent through tick rounding.
+        std::uint32_t children = t.childTicks[d];
+        CallTreeNode &node = t.nodes[n];
+        ++node.calls;
+        node.inclusiveTicks += totalTicks;
+        node.exclusiveTicks += (totalTicks > children) ? totalTicks - children : 0;
+    }
+
+    if (d > 0)
+        t.childTicks[d - 1] += totalTicks;
+}
+
+void CallTree_Reset()
+{
+    CallTree &t = gCallTree;
+    t.nodeCount = 0;
+    t.firstRoot = kCallTreeNone;
+    t.dropped   = 0;
+    t.maxDepth  = t.depth;
+
+    for (int i = 0; i < kCallTreeMaxDepth; ++i)
+        t.stack[i] = kCallTreeNone;
+}
+
+} // namespace Fates
+
+#endif // FATES_HOOK_CALLTREE
@@ -0,0 +1,356 @@
+// core/hook_config.cpp
+//
+// Hook profiles + hooks.cfg. See core/hook_config.hpp.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+#include <cstdio>
+#include <cstring>
+
+#include "core/hook_config.hpp"
+#include "core/hook_manager.hpp"
+#include "util/debug_log.hpp"
+#include "util/worker.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace Fates {
+
+namespace {
+
+constexpr const char *kCfgDir  = "sdmc:/Fates3GX";
+constexpr const char *kCfgPath = "sdmc:/Fates3GX/hooks.cfg";
+
+// hooks.cfg is a handful of lines; anything past this is ignored.
+constexpr std::size_t kMaxCfgBytes = 4096;
+
+struct ProfileInfo
+{
+    const char *name;   // hooks.cfg value
+    const char *label;  // menu text
+};
+
+const ProfileInfo kProfiles[static_cast<std::size_t>(HookProfile::Count)] = {
+    { "off",       "Off (no hooks)" },
+    { "counters",  "Counters only" },
+    { "telemetry", "Full telemetry" },
+    { "re",        "RE everything (unstable)" },
+};
+
+// Core hooks that fire per RNG roll or per frame. CountersOnly leaves
+// them unpatched; the lifecycle/HP hooks that feed the counters stay on.
+const HookId kHotHooks[] = {
+    HookId_SYS_Rng32,
+    HookId_UNIT_UpdateCloneHP,
+    HookId_HUD_Battle_HPGaugeUpdate,
+};
+
+HookProfile  sProfile = HookProfile::FullTelemetry;
+HookOverride sOverride[static_cast<std::size_t>(HookId_Count)] = {};
+
+inline bool IsHot(HookId id)
+{
+    for (HookId hot : kHotHooks)
+    {
+        if (hot == id)
+            return true;
+    }
+    return false;
+}
+
+inline std::uint32_t StabilityBit(HookStability s)
+{
+    return 1u << static_cast<std::uint32_t>(s);
+}
+
+bool ParseProfile(const char *s, HookProfile &out)
+{
+    for (std::size_t i = 0; i < static_cast<std::size_t>(HookProfile::Count); ++i)
+    {
+        if (std::strcmp(s, kProfiles[i].name) == 0)
+        {
+            out = static_cast<HookProfile>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseHookId(const char *s, HookId &out)
+{
+    for (std::size_t i = 0; i < static_cast<std::size_t>(HookId_Count); ++i)
+    {
+        if (std::strcmp(s, kHookIdNames[i]) == 0)
+        {
+            out = static_cast<HookId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParseOverride(const char *s, HookOverride &out)
+{
+    if (std::strcmp(s, "on") == 0)      { out = HookOverride::On;      return true; }
+    if (std::strcmp(s, "off") == 0)     { out = HookOverride::Off;     return true; }
+    if (std::strcmp(s, "default") == 0) { out = HookOverride::Default; return true; }
+    return false;
+}
+
+// Strip leading/trailing blanks in place.
+char *Trim(char *s)
+{
+    while (*s == ' ' || *s == '\t')
+        ++s;
+
+    char *end = s + std::strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+        --end;
+    *end = '\0';
+    return s;
+}
+
+void ParseLine(char *line, int lineNo)
+{
+    if (char *hash = std::strchr(line, '#'))
+        *hash = '\0';
+
+    line = Trim(line);
+    if (*line == '\0')
+        return;
+
+    char *eq = std::strchr(line, '=');
+    if (eq == nullptr)
+    {
+        FATES_LOG(Warn, Hook, "HookConfig: hooks.cfg:%d: expected 'key = value'", lineNo);
+        return;
+    }
+
+    *eq = '\0';
+    const char *key   = Trim(line);
+    const char *value = Trim(eq + 1);
+
+    if (std::strcmp(key, "profile") == 0)
+    {
+        if (!ParseProfile(value, sProfile))
+            FATES_LOG(Warn, Hook, "HookConfig: hooks.cfg:%d: unknown profile '%s'", lineNo, value);
+        return;
+    }
+
+    HookId       id;
+    HookOverride ov;
+    if (!ParseHookId(key, id))
+    {
+        FATES_LOG(Warn, Hook, "HookConfig: hooks.cfg:%d: unknown hook '%s'", lineNo, key);
+        return;
+    }
+    if (!ParseOverride(value, ov))
+    {
+        FATES_LOG(Warn, Hook, "HookConfig: hooks.cfg:%d: '%s' must be on, off or default", lineNo, value);
+        return;
+    }
+    sOverride[static_cast<std::size_t>(id)] = ov;
+}
+
+bool Load()
+{
+    File f;
+    if (File::Open(f, kCfgPath, File::READ) != 0)
+        return false;
+
+    static char buf[kMaxCfgBytes + 1];
+
+    std::uint64_t size = f.GetSize();
+    if (size > kMaxCfgBytes)
+    {
+        FATES_LOG(Warn, Hook, "HookConfig: hooks.cfg is larger than %u bytes; reading the start only",
+                              static_cast<unsigned>(kMaxCfgBytes));
+        size = kMaxCfgBytes;
+    }
+
+    const bool ok = f.Read(buf, static_cast<u32>(size)) == 0;
+    f.Close();
+    if (!ok)
+        return false;
+    buf[size] = '\0';
+
+    int   lineNo = 0;
+    char *line   = buf;
+    while (line != nullptr && *line != '\0')
+    {
+        char *nl = std::strchr(line, '\n');
+        if (nl != nullptr)
+            *nl = '\0';
+
+        ParseLine(line, ++lineNo);
+        line = (nl != nullptr) ? nl + 1 : nullptr;
+    }
+    return true;
+}
+
+// Install whatever the effective set needs, then enable/disable every
+// installed hook to match it.
+void Apply()
+{
+    bool          wanted[static_cast<std::size_t>(HookId_Count)];
+    std::uint32_t mask = 0;
+
+    for (std::size_t i = 0; i < kNumHooks; ++i)
+    {
+        wanted[i] = HookConfig_Wants(static_cast<HookId>(i));
+        if (wanted[i] && kHooks[i].targetVA != 0)
+            mask |= StabilityBit(kHooks[i].stability);
+    }
+
+    if (mask != 0)
+        HookManager::InstallHooks(mask, wanted);
+
+    int on  = 0;
+    int off = 0;
+    for (std::size_t i = 0; i < kNumHooks; ++i)
+    {
+        const HookId id = static_cast<HookId>(i);
+        if (!HookManager::IsHookInstalled(id))
+            continue;
+
+        HookManager::SetHookEnabled(id, wanted[i]);
+        if (HookManager::IsHookEnabled(id))
+            ++on;
+        else
+            ++off;
+    }
+
+    FATES_LOG(Info, Hook, "HookConfig: profile '%s': %d hook(s) on, %d installed but off",
+                          HookProfile_Name(sProfile), on, off);
+}
+
+// Setters save hooks.cfg off the calling (menu / UI) thread.
+void SaveJob(void *)
+{
+    HookConfig_Save();
+}
+
+} // anonymous namespace
+
+const char *HookProfile_Name(HookProfile profile)
+{
+    const std::size_t i = static_cast<std::size_t>(profile);
+    return (i < static_cast<std::size_t>(HookProfile::Count)) ? kProfiles[i].name : "?";
+}
+
+const char *HookProfile_Label(HookProfile profile)
+{
+    const std::size_t i = static_cast<std::size_t>(profile);
+    return (i < static_cast<std::size_t>(HookProfile::Count)) ? kProfiles[i].label : "?";
+}
+
+bool HookProfile_Wants(HookProfile profile, const HookEntry &entry)
+{
+    switch (profile)
+    {
+    case HookProfile::Off:
+        return false;
+    case HookProfile::CountersOnly:
+        return entry.stability == HookStability::Core && !IsHot(entry.id);
+    case HookProfile::FullTelemetry:
+        return entry.stability == HookStability::Core;
+    case HookProfile::REEverything:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool HookConfig_Wants(HookId id)
+{
+    const std::size_t i = static_cast<std::size_t>(id);
+    if (i >= kNumHooks)
+        return false;
+
+    switch (sOverride[i])
+    {
+    case HookOverride::On:  return true;
+    case HookOverride::Off: return false;
+    default:                return HookProfile_Wants(sProfile, kHooks[i]);
+    }
+}
+
+void HookConfig_LoadAndApply()
+{
+    HookManager::Init();
+
+    if (Load())
+        FATES_LOG(Info, Hook, "HookConfig: loaded %s (profile '%s')", kCfgPath, HookProfile_Name(sProfile));
+    else
+        FATES_LOG(Info, Hook, "HookConfig: no %s, using profile '%s'", kCfgPath, HookProfile_Name(sProfile));
+
+    Apply();
+}
+
+void HookConfig_SetProfile(HookProfile profile)
+{
+    if (static_cast<std::size_t>(profile) >= static_cast<std::size_t>(HookProfile::Count))
+        return;
+
+    sProfile = profile;
+    Apply();
+    Worker_Post(&SaveJob, nullptr, "HookConfig_Save");
+}
+
+void HookConfig_SetOverride(HookId id, HookOverride value)
+{
+    const std::size_t i = static_cast<std::size_t>(id);
+    if (i >= static_cast<std::size_t>(HookId_Count))
+        return;
+
+    sOverride[i] = value;
+    Apply();
+    Worker_Post(&SaveJob, nullptr, "HookConfig_Save");
+}
+
+HookProfile HookConfig_GetProfile()
+{
+    return sProfile;
+}
+
+HookOverride HookConfig_GetOverride(HookId id)
+{
+    const std::size_t i = static_cast<std::size_t>(id);
+    return (i < static_cast<std::size_t>(HookId_Count)) ? sOverride[i] : HookOverride::Default;
+}
+
+bool HookConfig_Save()
+{
+    Directory::Create(kCfgDir);
+
+    File f;
+    if (File::Open(f, kCfgPath, File::WRITE | File::CREATE | File::TRUNCATE) != 0)
+    {
+        FATES_LOG(Warn, Hook, "HookConfig: couldn't open %s for writing", kCfgPath);
+        return false;
+    }
+
+    char line[96];
+    int  n = std::snprintf(line, sizeof(line),
+                           "# Fates3GX hook profile (off | counters | telemetry | re)\r\n"
+                           "profile = %s\r\n",
+                           HookProfile_Name(sProfile));
+    f.Write(line, static_cast<u32>(n));
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(HookId_Count); ++i)
+    {
+        if (sOverride[i] == HookOverride::Default)
+            continue;
+
+        n = std::snprintf(line, sizeof(line), "%s = %s\r\n",
+                          kHookIdNames[i],
+                          sOverride[i] == HookOverride::On ? "on" : "off");
+        f.Write(line, static_cast<u32>(n));
+    }
+
+    f.Flush();
+    f.Close();
+    return true;
+}
+
+} // namespace Fates
@@ -3,16 +3,28 @@
 // Centralised runtime control for all gameplay hooks.
 //
 // Responsibilities:
-//  - Build CTRPF Hook objects from the compile-time kHooks table.
-//  - Install subsets of hooks by HookStability (Core / Optional / Experimental).
-//  - Verify guard words before patching to protect against mismatched code.bin.
-//  - Provide helpers to enable/disable all hooks at once.
-
-
+//  - Pick the generated hook table for the running title (region).
+//  - Build CTRPF Hook objects from the active kHooks table.
+//  - Install subsets of hooks by HookStability (Core / Optional / Experimental)
+//    in one pass: verify every guard first, then patch.
+//  - Relocate hooks whose bytes moved (guard / aob mismatch) with one
+//    batched signature scan, cached on SD (core/sig_scanner.hpp).
+//  - Refuse to patch anything if a core hook can't be found (wrong code.bin).
+//  - Enable/disable installed hooks individually or all at once
+//    (hook profiles, core/hook_config.hpp).
+//  - Install hooks marked HookBackend::Inline as direct detours
+//    (core/inline_hook.hpp), falling back to CTRPF MITM per hook.
+
+
+#include <3ds.h>
 #include <CTRPluginFramework.hpp>
 #include "core/hook_manager.hpp"
 #include "core/hooks.hpp"
 #include "core/handlers.hpp"
+#include "core/inline_hook.hpp"
+#include "core/sig_scanner.hpp"
+#include "core/turn_state.hpp"
+#include "engine/unit_layout.hpp"
 #include "util/debug_log.hpp"
 
 
@@ -44,12 +56,12 @@ static bool VerifyGuard(const HookEntry &entry)
             current[1] != entry.guard[1] ||
             current[2] != entry.guard[2])
         {
-            Logf("HookManager: guard mismatch for %s at 0x%08lX "
-                 "(cur=%08lX %08lX %08lX, exp=%08lX %08lX %08lX)",
-                 entry.name,
-                 static_cast<unsigned long>(baseVA),
-                 current[0], current[1], current[2],
-                 entry.guard[0], entry.guard[1], entry.guard[2]);
+            FATES_LOG(Warn, Hook, "HookManager: guard mismatch for %s at 0x%08lX "
+                                  "(cur=%08lX %08lX %08lX, exp=%08lX %08lX %08lX)",
+                                  entry.name,
+                                  static_cast<unsigned long>(baseVA),
+                                  current[0], current[1], current[2],
+                                  entry.guard[0], entry.guard[1], entry.guard[2]);
             return false;
         }
     }
@@ -58,6 +70,113 @@ static bool VerifyGuard(const HookEntry &entry)
 }
 
 
+    // Active region table (see core/hooks.hpp).
+    const HookEntry *kHooks    = nullptr;
+    std::size_t      kNumHooks = 0;
+    std::uint32_t    gRngCoreVA = 0;
+
+    static const HookRegionTable *sActiveRegion = nullptr;
+    static std::uint64_t          sTitleId      = 0;
+
+    const HookRegionTable *SelectHookRegion(std::uint64_t titleId)
+    {
+        for (std::size_t i = 0; i < kNumHookRegions; ++i)
+        {
+            const HookRegionTable &r = kHookRegions[i];
+            if (r.titleId != titleId)
+                continue;
+
+            sActiveRegion = &r;
+            kHooks        = r.hooks;
+            kNumHooks     = r.numHooks;
+            return &r;
+        }
+
+        sActiveRegion = nullptr;
+        kHooks        = nullptr;
+        kNumHooks     = 0;
+        return nullptr;
+    }
+
+    const HookRegionTable *GetActiveHookRegion()
+    {
+        return sActiveRegion;
+    }
+
+    // HookId -> C stub, in HookId order. These stubs are declared in
+    // core/handlers.hpp and implemented in hooks_handlers.cpp. Each row
+    // carries its id so an out-of-order edit is caught at install time
+    // instead of wiring a hook to the wrong stub.
+    struct HandlerRow
+    {
+        HookId id;
+        void  *fn;
+    };
+
+#define FATES_HANDLER(hookName) { HookId_##hookName, reinterpret_cast<void *>(&Hook_##hookName) }
+
+    static const HandlerRow kHandlers[] = {
+        FATES_HANDLER(BTL_HitCalc_Main),
+        FATES_HANDLER(BTL_CritCalc_Main),
+        FATES_HANDLER(BTL_FinalDamage_Pre),
+        FATES_HANDLER(BTL_FinalDamage_Post),
+        FATES_HANDLER(BTL_GuardGauge_Add),
+        FATES_HANDLER(BTL_GuardGauge_Spend),
+        FATES_HANDLER(SEQ_HpDamage),
+        FATES_HANDLER(UNIT_HpDamage),
+        FATES_HANDLER(UNIT_UpdateCloneHP),
+        FATES_HANDLER(HP_KillCheck),
+        FATES_HANDLER(SEQ_HpDamage_Helper),
+        FATES_HANDLER(SEQ_ItemGain),
+        FATES_HANDLER(MAP_ProcSkillDamage),
+        FATES_HANDLER(MAP_ProcTerrainDamage),
+        FATES_HANDLER(MAP_ProcTrickDamage),
+        FATES_HANDLER(EVENT_ActionEnd),
+        FATES_HANDLER(BTL_AttackStance_Check),
+        FATES_HANDLER(BTL_AttackStance_ApplySupport),
+        FATES_HANDLER(HUD_Battle_HPGaugeUpdate),
+        FATES_HANDLER(BTL_SkillEffect_Apply),
+        FATES_HANDLER(SYS_Rng32),
+        FATES_HANDLER(SEQ_TurnBegin),
+        FATES_HANDLER(SEQ_TurnEnd),
+        FATES_HANDLER(SEQ_MapEnd),
+        FATES_HANDLER(SEQ_MapStart),
+        FATES_HANDLER(SEQ_ItemUse),
+        FATES_HANDLER(UNIT_LevelUp),
+        FATES_HANDLER(UNIT_SkillLearn),
+        FATES_HANDLER(SEQ_UnitMove),
+    };
+
+#undef FATES_HANDLER
+
+    static_assert(sizeof(kHandlers) / sizeof(kHandlers[0]) == HookId_Count,
+                  "kHandlers needs exactly one row per HookId");
+
+    // Which hooks have been patched, so a later Install*() call doesn't
+    // patch the same site twice.
+    static bool sInstalled[static_cast<std::size_t>(HookId_Count)] = {};
+
+    // Installed hooks whose patch is currently active.
+    static bool sEnabled[static_cast<std::size_t>(HookId_Count)] = {};
+
+    // Backend each installed hook actually went in with.
+    static HookBackend sBackend[static_cast<std::size_t>(HookId_Count)] = {};
+
+    // Verified hook site per HookId (T-bit cleared): the table address,
+    // or where the signature scan found it. 0 = not resolved.
+    static std::uint32_t sSiteVA[static_cast<std::size_t>(HookId_Count)] = {};
+
+    static inline std::uint32_t StabilityBit(HookStability s)
+    {
+        return 1u << static_cast<std::uint32_t>(s);
+    }
+
+    // svcGetSystemTick() ticks -> microseconds (268.111856 ticks per us).
+    static inline unsigned TicksToUs(std::uint64_t ticks)
+    {
+        return static_cast<unsigned>((ticks * 1000ULL) / 268112ULL);
+    }
+
     void HookManager::Init()
     {
         if (sInitialised)
@@ -68,150 +187,369 @@ static bool VerifyGuard(const HookEntry &entry)
         // Default-construct all Hook objects
         for (auto &h : sHooks)
             h = Hook();
+
+        const std::uint64_t titleId = CTRPluginFramework::Process::GetTitleID();
+        sTitleId = titleId;
+        const HookRegionTable *region = SelectHookRegion(titleId);
+        if (region != nullptr)
+        {
+            FATES_LOG(Info, Hook, "HookManager: title %016llX -> region %s (%u hooks)",
+                                  static_cast<unsigned long long>(titleId),
+                                  region->region,
+                                  static_cast<unsigned>(region->numHooks));
+
+            // The region's non-hook data: RNG step function, turn-side
+            // chain root and struct offsets. Published before any hook is
+            // installed, read-only afterwards.
+            gRngCoreVA = region->rngCoreVA;
+            TurnState_SetRoot(region->turnStateRootVA);
+            Engine::UnitLayout_Select(*region->layout, region->region);
+        }
+        else
+        {
+            FATES_LOG(Error, Hook, "HookManager: title %016llX has no hook table (%u region(s) known); "
+                                   "no hooks will be installed",
+                                   static_cast<unsigned long long>(titleId),
+                                   static_cast<unsigned>(kNumHookRegions));
+        }
     }
 
     const HookEntry &HookManager::GetEntry(HookId id)
     {
+        static const HookEntry kUnmapped = {
+            HookId_Count, "<unmapped>", 0u, 0u, { 0u, 0u, 0u }, false, HookStability::Optional,
+            HookBackend::Mitm
+        };
+
+        if (kHooks == nullptr || static_cast<std::size_t>(id) >= kNumHooks)
+            return kUnmapped;
         return kHooks[static_cast<std::size_t>(id)];
     }
 
     void *HookManager::GetHandler(HookId id)
     {
-        // Map HookId -> C stub.  These stubs are declared in
-        // core/handlers.hpp and implemented in hooks_handlers.cpp.
-        switch (id)
-        {
-            case HookId_BTL_HitCalc_Main:
-                return reinterpret_cast<void *>(&Hook_BTL_HitCalc_Main);
-            case HookId_BTL_CritCalc_Main:
-                return reinterpret_cast<void *>(&Hook_BTL_CritCalc_Main);
-            case HookId_BTL_FinalDamage_Pre:
-                return reinterpret_cast<void *>(&Hook_BTL_FinalDamage_Pre);
-            case HookId_BTL_FinalDamage_Post:
-                return reinterpret_cast<void *>(&Hook_BTL_FinalDamage_Post);
-            case HookId_BTL_GuardGauge_Add:
-                return reinterpret_cast<void *>(&Hook_BTL_GuardGauge_Add);
-            case HookId_BTL_GuardGauge_Spend:
-                return reinterpret_cast<void *>(&Hook_BTL_GuardGauge_Spend);
-            case HookId_SEQ_HpDamage:
-				return reinterpret_cast<void *>(&Hook_SEQ_HpDamage);
-			case HookId_UNIT_HpDamage:
-				return reinterpret_cast<void *>(&Hook_UNIT_HpDamage);
-			case HookId_UNIT_UpdateCloneHP:
-				return reinterpret_cast<void *>(&Hook_UNIT_UpdateCloneHP);
-            case HookId_HP_KillCheck:
-                return reinterpret_cast<void *>(&Hook_HP_KillCheck);
-            case HookId_SEQ_HpDamage_Helper:
-                return reinterpret_cast<void *>(&Hook_SEQ_HpDamage_Helper);
-			case HookId_SEQ_ItemGain:
-				return reinterpret_cast<void *>(&Hook_SEQ_ItemGain);
-            case HookId_MAP_ProcSkillDamage:
-                return reinterpret_cast<void *>(&Hook_MAP_ProcSkillDamage);
-            case HookId_MAP_ProcTerrainDamage:
-                return reinterpret_cast<void *>(&Hook_MAP_ProcTerrainDamage);
-            case HookId_MAP_ProcTrickDamage:
-                return reinterpret_cast<void *>(&Hook_MAP_ProcTrickDamage);
-            case HookId_EVENT_ActionEnd:
-                return reinterpret_cast<void *>(&Hook_EVENT_ActionEnd);
-            case HookId_BTL_AttackStance_Check:
-                return reinterpret_cast<void *>(&Hook_BTL_AttackStance_Check);
-            case HookId_BTL_AttackStance_ApplySupport:
-                return reinterpret_cast<void *>(&Hook_BTL_AttackStance_ApplySupport);
-            case HookId_HUD_Battle_HPGaugeUpdate:
-                return reinterpret_cast<void *>(&Hook_HUD_Battle_HPGaugeUpdate);
-            case HookId_BTL_SkillEffect_Apply:
-                return reinterpret_cast<void *>(&Hook_BTL_SkillEffect_Apply);
-			case HookId_SYS_Rng32:
-                return reinterpret_cast<void *>(&Hook_SYS_Rng32);
-			case HookId_SEQ_TurnBegin:
-				return reinterpret_cast<void *>(&Hook_SEQ_TurnBegin);
-			case HookId_SEQ_TurnEnd:
-				return reinterpret_cast<void *>(&Hook_SEQ_TurnEnd);
-			case HookId_SEQ_MapEnd:
-				return reinterpret_cast<void *>(&Hook_SEQ_MapEnd);
-			case HookId_SEQ_MapStart:
-				return reinterpret_cast<void *>(&Hook_SEQ_MapStart);
-			case HookId_SEQ_ItemUse:
-				return reinterpret_cast<void *>(&Hook_SEQ_ItemUse);
-			case HookId_UNIT_LevelUp:
-				return reinterpret_cast<void *>(&Hook_UNIT_LevelUp);
-			case HookId_UNIT_SkillLearn:
-				return reinterpret_cast<void *>(&Hook_UNIT_SkillLearn);
-			case HookId_SEQ_UnitMove:
-				return reinterpret_cast<void *>(&Hook_SEQ_UnitMove);
-			
-            default:
-                return nullptr;
-        }
-    }
-
-    void HookManager::InstallByStability(HookStability desired)
+        const std::size_t i = static_cast<std::size_t>(id);
+        if (i >= static_cast<std::size_t>(HookId_Count) || kHandlers[i].id != id)
+            return nullptr;
+        return kHandlers[i].fn;
+    }
+
+    std::uint32_t HookManager::GetSiteVA(HookId id)
+    {
+        const std::size_t i = static_cast<std::size_t>(id);
+        if (i >= static_cast<std::size_t>(HookId_Count))
+            return 0;
+        return sSiteVA[i];
+    }
+
+    // Find the hooks in 'jobs' (guard / aob mismatch at the table
+    // address) elsewhere in the text segment. Cached sites are re-checked
+    // and used directly; everything else is found by one SigScan_Run
+    // pass and written back to the cache. On return jobs[n].hits == 1
+    // and jobs[n].siteVA is set for every hook that was found.
+    static void ResolveMoved(SigScanJob *jobs, std::size_t numJobs)
+    {
+        const std::uint32_t textSize = CTRPluginFramework::Process::GetTextSize();
+        if (textSize == 0)
+        {
+            for (std::size_t n = 0; n < numJobs; ++n)
+                jobs[n].hits = 0;
+            return;
+        }
+
+        const std::uint64_t t0 = svcGetSystemTick();
+        const std::uint32_t textHash = SigScan_HashText(kCodeTextBase, textSize);
+
+        std::uint32_t cachedVA[static_cast<std::size_t>(HookId_Count)];
+        SigCache_Load(sTitleId, textSize, textHash, cachedVA);
+
+        SigScanJob  toScan[static_cast<std::size_t>(HookId_Count)];
+        std::size_t numScan   = 0;
+        int         fromCache = 0;
+
+        for (std::size_t n = 0; n < numJobs; ++n)
+        {
+            SigScanJob &job = jobs[n];
+            const std::uint32_t c = cachedVA[static_cast<std::size_t>(job.id)];
+
+            if (c != kSigCacheNone && c != 0 &&
+                SigScan_MatchAt(job, c, kCodeTextBase, textSize))
+            {
+                job.siteVA = c;
+                job.hits   = 1;
+                ++fromCache;
+                continue;
+            }
+            if (c == 0)
+            {
+                // Same text, and the last scan found nothing unique.
+                job.hits = 0;
+                continue;
+            }
+
+            toScan[numScan++] = job;
+        }
+
+        if (numScan > 0)
+        {
+            const std::uint64_t s0 = svcGetSystemTick();
+            SigScan_Run(toScan, numScan, kCodeTextBase, textSize);
+            const std::uint64_t s1 = svcGetSystemTick();
+
+            FATES_LOG(Info, Hook, "SigScan: %u signature(s) over %u KB of text in %uus (%d from cache)",
+                                  static_cast<unsigned>(numScan),
+                                  static_cast<unsigned>(textSize / 1024u),
+                                  TicksToUs(s1 - s0),
+                                  fromCache);
+
+            for (std::size_t k = 0; k < numScan; ++k)
+            {
+                const SigScanJob &r = toScan[k];
+                cachedVA[static_cast<std::size_t>(r.id)] = (r.hits == 1) ? r.siteVA : 0u;
+
+                for (std::size_t n = 0; n < numJobs; ++n)
+                {
+                    if (jobs[n].id == r.id)
+                        jobs[n] = r;
+                }
+            }
+
+            SigCache_Save(sTitleId, textSize, textHash, cachedVA);
+        }
+
+        for (std::size_t n = 0; n < numJobs; ++n)
+        {
+            const SigScanJob &job  = jobs[n];
+            const HookEntry  &entry = kHooks[static_cast<std::size_t>(job.id)];
+
+            if (job.hits == 1)
+            {
+                FATES_LOG(Info, Hook, "HookManager: '%s' relocated 0x%08lX -> 0x%08lX",
+                                      entry.name,
+                                      static_cast<unsigned long>(entry.targetVA & ~1u),
+                                      static_cast<unsigned long>(job.siteVA & ~1u));
+            }
+            else if (job.hits == 0)
+            {
+                FATES_LOG(Warn, Hook, "HookManager: '%s' signature not found in text", entry.name);
+            }
+            else
+            {
+                FATES_LOG(Warn, Hook, "HookManager: '%s' signature is ambiguous (%u matches), not relocating",
+                                      entry.name, static_cast<unsigned>(job.hits));
+            }
+        }
+
+        FATES_LOG(Info, Hook, "SigScan: resolve took %uus", TicksToUs(svcGetSystemTick() - t0));
+    }
+
+    void HookManager::InstallHooks(std::uint32_t stabilityMask, const bool *wanted)
     {
         if (!sInitialised)
             Init();
 
-        Logf("HookManager::InstallByStability(%d) - begin",
-             static_cast<int>(desired));
+        if (kNumHooks == 0)
+            return;
+
+        const char *region = sActiveRegion ? sActiveRegion->region : "?";
+
+        // ---- Phase 1: resolve + verify every candidate. Nothing is
+        // patched yet, so a wrong code.bin leaves the game untouched.
+        const std::uint64_t t0 = svcGetSystemTick();
+
+        HookId planned[static_cast<std::size_t>(HookId_Count)];
+        std::size_t numPlanned = 0;
+
+        // Hooks that failed verification but have a signature to search
+        // for; resolved in one batch after the loop.
+        SigScanJob  moved[static_cast<std::size_t>(HookId_Count)];
+        std::size_t numMoved = 0;
+
+        const std::uint32_t textSize = CTRPluginFramework::Process::GetTextSize();
+
+        int unmapped      = 0;
+        int noHandler     = 0;
+        int guardFailed   = 0;
+        int coreMismatch  = 0;
+        int relocated     = 0;
+        int unchecked     = 0;
 
         for (std::size_t i = 0; i < kNumHooks; ++i)
         {
             const HookEntry &entry = kHooks[i];
 
-            if (entry.stability != desired)
+            if ((stabilityMask & StabilityBit(entry.stability)) == 0)
+                continue;
+            if (sInstalled[static_cast<std::size_t>(entry.id)])
+                continue;
+            if (wanted != nullptr && !wanted[static_cast<std::size_t>(entry.id)])
                 continue;
 
-            void *handler = GetHandler(entry.id);
-            if (handler == nullptr)
+            if (entry.targetVA == 0)
             {
-                Logf("HookManager: no handler for '%s' (id=%d)",
-                     entry.name, static_cast<int>(entry.id));
+                ++unmapped;
                 continue;
             }
 
-            if (!VerifyGuard(entry))
+            if (GetHandler(entry.id) == nullptr)
             {
-                Logf("HookManager: guard check failed for '%s'; skipping",
-                     entry.name);
+                FATES_LOG(Warn, Hook, "HookManager: no handler for '%s' (id=%d)",
+                                      entry.name, static_cast<int>(entry.id));
+                ++noHandler;
                 continue;
             }
 
-Hook &hook = sHooks[static_cast<std::size_t>(entry.id)];
+            // Verify at the table address: against the aob if the
+            // region has one, else against the guard words.
+            SigScanJob &job = moved[numMoved];
+            const bool hasSig = SigScan_MakeJob(entry, sActiveRegion, job);
+
+            bool ok;
+            if (hasSig && job.words != entry.guard)
+            {
+                ok = SigScan_MatchAt(job, entry.targetVA, kCodeTextBase, textSize);
+                if (!ok)
+                    FATES_LOG(Warn, Hook, "HookManager: aob mismatch for %s at 0x%08lX",
+                                          entry.name, static_cast<unsigned long>(entry.targetVA & ~1u));
+            }
+            else
+            {
+                ok = VerifyGuard(entry);
+                if (ok && !hasSig && !(entry.guard[0] || entry.guard[1] || entry.guard[2]))
+                {
+                    FATES_LOG(Warn, Hook, "HookManager: '%s' has no guard words or aob; installing unverified",
+                                          entry.name);
+                    ++unchecked;
+                }
+            }
+
+            if (ok)
+            {
+                sSiteVA[static_cast<std::size_t>(entry.id)] = entry.targetVA & ~1u;
+                planned[numPlanned++] = entry.id;
+                continue;
+            }
+
+            if (hasSig)
+            {
+                ++numMoved;  // try to relocate below
+                continue;
+            }
+
+            ++guardFailed;
+            if (entry.stability == HookStability::Core)
+                ++coreMismatch;
+        }
+
+        if (numMoved > 0)
+        {
+            ResolveMoved(moved, numMoved);
+
+            for (std::size_t n = 0; n < numMoved; ++n)
+            {
+                const SigScanJob &job  = moved[n];
+                const HookEntry  &entry = kHooks[static_cast<std::size_t>(job.id)];
+
+                if (job.hits == 1)
+                {
+                    sSiteVA[static_cast<std::size_t>(job.id)] = job.siteVA & ~1u;
+                    planned[numPlanned++] = job.id;
+                    ++relocated;
+                    continue;
+                }
+
+                ++guardFailed;
+                if (entry.stability == HookStability::Core)
+                    ++coreMismatch;
+            }
+        }
+
+        const std::uint64_t t1 = svcGetSystemTick();
+
+        // Core hooks only make sense as a set (map/turn lifecycle, HP
+        // pipeline). A core guard mismatch means this isn't the code.bin
+        // the table was made for: install nothing.
+        if (coreMismatch > 0)
+        {
+            FATES_LOG(Error, Hook, "HookManager: region %s: %d core hook(s) failed verification and "
+                                   "could not be relocated; wrong game version? no hooks installed",
+                                   region, coreMismatch);
+            return;
+        }
+
+        // ---- Phase 2: patch everything that passed.
+        int installed   = 0;
+        int inlined     = 0;
+        int enableFails = 0;
 
-// Canonical, T-bit–cleared VA 
-const u32 rawVA        = entry.targetVA & ~1u;
-u32       targetAddr   = rawVA;
-const u32 callbackAddr = reinterpret_cast<u32>(handler);
+        for (std::size_t n = 0; n < numPlanned; ++n)
+        {
+            const HookEntry &entry = kHooks[static_cast<std::size_t>(planned[n])];
+            Hook &hook = sHooks[static_cast<std::size_t>(entry.id)];
 
-// Enforce T-bit based on isThumb.
-//  - ARM  : even address
-//  - Thumb: odd address
-if (entry.isThumb)
-    targetAddr |= 1u;
-else
-    targetAddr &= ~1u;
+            // Canonical, T-bit–cleared VA, then enforce the T-bit from
+            // isThumb (ARM: even address, Thumb: odd address).
+            u32 targetAddr = sSiteVA[static_cast<std::size_t>(entry.id)];
+            if (entry.isThumb)
+                targetAddr |= 1u;
 
-Logf("HookManager: installing '%s' (MITM) raw=0x%08lX hookVA=0x%08lX -> 0x%08lX (thumb=%s)",
-     entry.name,
-     static_cast<unsigned long>(rawVA),
-     static_cast<unsigned long>(targetAddr),
-     static_cast<unsigned long>(callbackAddr),
-     entry.isThumb ? "true" : "false");
+            const u32 callbackAddr = reinterpret_cast<u32>(GetHandler(entry.id));
 
-// MITM mode so HookContext::OriginalFunction works
-hook.InitializeForMitm(targetAddr, callbackAddr);
-auto result = hook.Enable();
-Logf("HookManager: '%s' Enable() -> %d",
-     entry.name, static_cast<int>(result));
+            // Hot hooks: direct detour + thunk. Thumb sites and sites
+            // that can't be relocated fall through to MITM.
+            if (FATES_INLINE_HOOKS && entry.backend == HookBackend::Inline && !entry.isThumb &&
+                InlineHook_Install(entry.id, targetAddr, callbackAddr))
+            {
+                sInstalled[static_cast<std::size_t>(entry.id)] = true;
+                sEnabled[static_cast<std::size_t>(entry.id)]   = true;
+                sBackend[static_cast<std::size_t>(entry.id)]   = HookBackend::Inline;
+                ++installed;
+                ++inlined;
+                continue;
+            }
+
+            // MITM mode so HookContext::OriginalFunction works
+            hook.InitializeForMitm(targetAddr, callbackAddr);
+            auto result = hook.Enable();
+            if (result != CTRPluginFramework::HookResult::Success)
+            {
+                FATES_LOG(Warn, Hook, "HookManager: '%s' at 0x%08lX Enable() -> %d",
+                                      entry.name,
+                                      static_cast<unsigned long>(targetAddr),
+                                      static_cast<int>(result));
+                ++enableFails;
+                continue;
+            }
 
+            sInstalled[static_cast<std::size_t>(entry.id)] = true;
+            sEnabled[static_cast<std::size_t>(entry.id)]   = true;
+            sBackend[static_cast<std::size_t>(entry.id)]   = HookBackend::Mitm;
+            ++installed;
         }
 
-        Logf("HookManager::InstallByStability(%d) - end",
-             static_cast<int>(desired));
+        const std::uint64_t t2 = svcGetSystemTick();
+
+        FATES_LOG(Info, Hook, "HookManager: region %s mask=0x%X: installed %d/%u "
+                              "(inline=%d relocated=%d unverified=%d unmapped=%d noHandler=%d guardFail=%d "
+                              "enableFail=%d) verify=%uus enable=%uus",
+                              region,
+                              static_cast<unsigned>(stabilityMask),
+                              installed,
+                              static_cast<unsigned>(numPlanned + unmapped + noHandler + guardFailed),
+                              inlined,
+                              relocated,
+                              unchecked,
+                              unmapped,
+                              noHandler,
+                              guardFailed,
+                              enableFails,
+                              TicksToUs(t1 - t0),
+                              TicksToUs(t2 - t1));
     }
 
     void HookManager::InstallCoreHooks()
     {
-        InstallByStability(HookStability::Core);
+        InstallHooks(StabilityBit(HookStability::Core));
     }
 
     void HookManager::InstallOptionalHooks()
@@ -219,7 +557,7 @@ Logf("HookManager: '%s' Enable() -> %d",
 		// Install all hooks marked HookStability::Optional.
 		// WARNING: most Optional hooks are RE candidates or unstable and
 		// should only be enabled when you know what you’re doing.
-        InstallByStability(HookStability::Optional);
+        InstallHooks(StabilityBit(HookStability::Optional));
     }
 
     void HookManager::InstallAll()
@@ -231,13 +569,69 @@ Logf("HookManager: '%s' Enable() -> %d",
     void HookManager::EnableAll()
     {
         for (std::size_t i = 0; i < kNumHooks; ++i)
-            sHooks[i].Enable();
+        {
+            if (sInstalled[i])
+                SetHookEnabled(static_cast<HookId>(i), true);
+        }
     }
 
     void HookManager::DisableAll()
     {
         for (std::size_t i = 0; i < kNumHooks; ++i)
-            sHooks[i].Disable();
+        {
+            if (sInstalled[i])
+                SetHookEnabled(static_cast<HookId>(i), false);
+        }
+    }
+
+    bool HookManager::SetHookEnabled(HookId id, bool enabled)
+    {
+        const std::size_t i = static_cast<std::size_t>(id);
+        if (i >= static_cast<std::size_t>(HookId_Count) || !sInstalled[i])
+            return false;
+        if (sEnabled[i] == enabled)
+            return true;
+
+        if (sBackend[i] == HookBackend::Inline)
+        {
+            if (!InlineHook_SetEnabled(id, enabled))
+                return false;
+            sEnabled[i] = enabled;
+            return true;
+        }
+
+        auto result = enabled ? sHooks[i].Enable() : sHooks[i].Disable();
+        if (result != CTRPluginFramework::HookResult::Success)
+        {
+            FATES_LOG(Warn, Hook, "HookManager: '%s' %s() -> %d",
+                                  kHooks[i].name,
+                                  enabled ? "Enable" : "Disable",
+                                  static_cast<int>(result));
+            return false;
+        }
+
+        sEnabled[i] = enabled;
+        return true;
+    }
+
+    bool HookManager::IsHookEnabled(HookId id)
+    {
+        const std::size_t i = static_cast<std::size_t>(id);
+        return i < static_cast<std::size_t>(HookId_Count) && sEnabled[i];
+    }
+
+    bool HookManager::IsHookInstalled(HookId id)
+    {
+        const std::size_t i = static_cast<std::size_t>(id);
+        return i < static_cast<std::size_t>(HookId_Count) && sInstalled[i];
+    }
+
+    HookBackend HookManager::GetBackend(HookId id)
+    {
+        const std::size_t i = static_cast<std::size_t>(id);
+        if (i >= static_cast<std::size_t>(HookId_Count) || !sInstalled[i])
+            return HookBackend::Mitm;
+        return sBackend[i];
     }
 
 } // namespace Fates
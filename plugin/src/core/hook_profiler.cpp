@@ -0,0 +1,67 @@
+// core/hook_profiler.cpp
+//
+// Storage + recording for the optional hook profiler. See
+// core/hook_profiler.hpp. Compiles to nothing unless
+// FATES_HOOK_PROFILER=1.
+
+#include "core/hook_profiler.hpp"
+
+#if FATES_HOOK_PROFILER
+
+namespace Fates {
+
+HookProfileStats gHookProfile[HookId_Count] = {};
+
+namespace {
+
+inline int HistBucket(std::uint32_t ticks)
+{
+    // floor(log2(ticks)), 0 for ticks == 0.
+    int log2 = ticks ? 31 - __builtin_clz(ticks) : 0;
+    int b = log2 - kHookProfileHistShift;
+    if (b < 0)
+        return 0;
+    if (b >= kHookProfileHistBuckets)
+        return kHookProfileHistBuckets - 1;
+    return b;
+}
+
+} // anonymous namespace
+
+void HookProfiler_Record(HookId id,
+                         std::uint32_t totalTicks,
+                         std::uint32_t originalTicks)
+{
+    if (id >= HookId_Count)
+        return;
+
+    HookProfileStats &s = gHookProfile[id];
+
+    // Original time can only exceed total through tick rounding.
+    std::uint32_t own = (totalTicks > originalTicks) ? totalTicks - originalTicks : 0;
+
+    if (s.calls == 0 || own < s.minOwnTicks)
+        s.minOwnTicks = own;
+    if (own > s.maxOwnTicks)
+        s.maxOwnTicks = own;
+    if (totalTicks > s.maxTotalTicks)
+        s.maxTotalTicks = totalTicks;
+
+    ++s.calls;
+    s.totalTicks    += totalTicks;
+    s.originalTicks += originalTicks;
+    ++s.hist[HistBucket(totalTicks)];
+}
+
+void HookProfiler_Reset()
+{
+    for (int i = 0; i < HookId_Count; ++i)
+        gHookProfile[i] = HookProfileStats{};
+#if FATES_HOOK_CALLTREE
+    CallTree_Reset();
+#endif
+}
+
+} // namespace Fates
+
+#endif // FATES_HOOK_PROFILER
@@ -0,0 +1,185 @@
+// core/inline_hook.cpp
+//
+// Inline hook backend. See core/inline_hook.hpp.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+#include <csvc.h>
+
+#include "core/inline_hook.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+
+std::uint32_t gHookThunk[static_cast<std::size_t>(HookId_Count)] = {};
+
+namespace {
+
+constexpr std::uint32_t kLdrPcPcMinus4 = 0xE51FF004u;  // ldr pc, [pc, #-4]
+constexpr std::uint32_t kPc            = 15u;
+constexpr std::uint32_t kPageSize      = 0x1000u;
+
+// Thunks live in plugin memory; one row per HookId.
+alignas(8) std::uint32_t sThunks[static_cast<std::size_t>(HookId_Count)][kInlineThunkWords];
+
+struct InlineSite
+{
+    std::uint32_t siteVA;       // 0 = not installed
+    std::uint32_t stubVA;
+    std::uint32_t original[2];  // stolen instructions (also in the thunk)
+};
+
+InlineSite sSites[static_cast<std::size_t>(HookId_Count)] = {};
+
+bool sThunksExecutable = false;
+
+inline std::uint32_t Field(std::uint32_t insn, unsigned shift)
+{
+    return (insn >> shift) & 0xFu;
+}
+
+// Make [addr, addr + size) RWX, page-aligned.
+bool Unprotect(std::uint32_t addr, std::uint32_t size)
+{
+    const std::uint32_t first = addr & ~(kPageSize - 1u);
+    const std::uint32_t last  = (addr + size + kPageSize - 1u) & ~(kPageSize - 1u);
+    return CTRPluginFramework::Process::ProtectMemory(first, last - first);
+}
+
+void SyncCode(std::uint32_t addr, std::uint32_t size)
+{
+    svcFlushProcessDataCache(CUR_PROCESS_HANDLE, addr, size);
+    svcInvalidateEntireInstructionCache();
+}
+
+void WriteJump(std::uint32_t siteVA, std::uint32_t to)
+{
+    volatile std::uint32_t *site = reinterpret_cast<volatile std::uint32_t *>(siteVA);
+    site[0] = kLdrPcPcMinus4;
+    site[1] = to;
+    SyncCode(siteVA, 8);
+}
+
+} // namespace
+
+bool InlineHook_CanRelocate(const std::uint32_t *insns, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint32_t insn = insns[i];
+
+        // Unconditional space (blx imm, pld, cps, ...).
+        if ((insn >> 28) == 0xFu)
+            return false;
+
+        switch ((insn >> 25) & 0x7u)
+        {
+        case 0x0:  // data processing (register), multiply, misc
+            if (Field(insn, 16) == kPc || Field(insn, 12) == kPc || Field(insn, 0) == kPc)
+                return false;
+            if ((insn & 0x10u) != 0 && Field(insn, 8) == kPc)
+                return false;
+            break;
+
+        case 0x1:  // data processing (immediate)
+            if (Field(insn, 16) == kPc || Field(insn, 12) == kPc)
+                return false;
+            break;
+
+        case 0x2:  // load / store (immediate offset)
+            if (Field(insn, 16) == kPc || Field(insn, 12) == kPc)
+                return false;
+            break;
+
+        case 0x3:  // load / store (register offset), media
+            if (Field(insn, 16) == kPc || Field(insn, 12) == kPc || Field(insn, 0) == kPc)
+                return false;
+            break;
+
+        case 0x4:  // ldm / stm
+            if (Field(insn, 16) == kPc || (insn & 0x8000u) != 0)
+                return false;
+            break;
+
+        default:   // b / bl, coprocessor, svc
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InlineHook_Install(HookId id, std::uint32_t siteVA, std::uint32_t stubVA)
+{
+    const std::size_t i = static_cast<std::size_t>(id);
+    if (i >= static_cast<std::size_t>(HookId_Count) || sSites[i].siteVA != 0)
+        return false;
+    if ((siteVA & 3u) != 0 || stubVA == 0)
+        return false;
+
+    const std::uint32_t *site = reinterpret_cast<const std::uint32_t *>(siteVA);
+    const std::uint32_t  stolen[2] = { site[0], site[1] };
+
+    if (!InlineHook_CanRelocate(stolen, 2))
+    {
+        FATES_LOG(Info, Hook, "InlineHook: %s at 0x%08lX: %08lX %08lX use pc, not relocatable",
+                              kHookIdNames[i],
+                              static_cast<unsigned long>(siteVA),
+                              static_cast<unsigned long>(stolen[0]),
+                              static_cast<unsigned long>(stolen[1]));
+        return false;
+    }
+
+    if (!sThunksExecutable)
+    {
+        if (!Unprotect(reinterpret_cast<std::uint32_t>(&sThunks[0][0]), sizeof(sThunks)))
+        {
+            FATES_LOG(Warn, Hook, "InlineHook: couldn't make the thunk pool executable");
+            return false;
+        }
+        sThunksExecutable = true;
+    }
+
+    if (!Unprotect(siteVA, 8))
+    {
+        FATES_LOG(Warn, Hook, "InlineHook: %s at 0x%08lX: site is not writable",
+                              kHookIdNames[i], static_cast<unsigned long>(siteVA));
+        return false;
+    }
+
+    // Thunk first, so the site never jumps to a half-built one.
+    std::uint32_t *thunk = sThunks[i];
+    thunk[0] = stolen[0];
+    thunk[1] = stolen[1];
+    thunk[2] = kLdrPcPcMinus4;
+    thunk[3] = siteVA + 8u;
+    SyncCode(reinterpret_cast<std::uint32_t>(thunk), kInlineThunkWords * 4u);
+
+    InlineSite &s = sSites[i];
+    s.siteVA      = siteVA;
+    s.stubVA      = stubVA;
+    s.original[0] = stolen[0];
+    s.original[1] = stolen[1];
+
+    gHookThunk[i] = reinterpret_cast<std::uint32_t>(thunk);
+    WriteJump(siteVA, stubVA);
+    return true;
+}
+
+bool InlineHook_SetEnabled(HookId id, bool enabled)
+{
+    const std::size_t i = static_cast<std::size_t>(id);
+    if (i >= static_cast<std::size_t>(HookId_Count) || sSites[i].siteVA == 0)
+        return false;
+
+    // The game thread may be inside the site right now, so never touch
+    // its instructions again: only retarget the jump's literal. That is
+    // one aligned word store, and ldr pc reads it as data, so a thread
+    // sees either the stub or the thunk (the original), nothing between.
+    const InlineSite &s = sSites[i];
+    volatile std::uint32_t *literal = reinterpret_cast<volatile std::uint32_t *>(s.siteVA + 4u);
+    *literal = enabled ? s.stubVA : gHookThunk[i];
+    svcFlushProcessDataCache(CUR_PROCESS_HANDLE, s.siteVA + 4u, 4);
+    return true;
+}
+
+} // namespace Fates
@@ -0,0 +1,307 @@
+// core/sig_scanner.cpp
+//
+// Single-pass AOB scanner + SD result cache. See core/sig_scanner.hpp.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+#include <cstring>
+
+#include "core/sig_scanner.hpp"
+#include "util/debug_log.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace Fates {
+
+namespace {
+
+constexpr const char *kCacheDir  = "sdmc:/Fates3GX";
+constexpr const char *kCachePath = "sdmc:/Fates3GX/hook_cache.bin";
+
+constexpr std::uint32_t kCacheMagic   = 0x43483346u;  // "F3HC"
+constexpr std::uint16_t kCacheVersion = 1;
+
+struct CacheHeader
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t count;
+    std::uint64_t titleId;
+    std::uint32_t textSize;
+    std::uint32_t textHash;
+};
+
+struct CacheRecord
+{
+    std::uint16_t id;
+    std::uint16_t reserved;
+    std::uint32_t siteVA;
+};
+
+static_assert(sizeof(CacheHeader) == 24, "hook_cache.bin header layout changed");
+static_assert(sizeof(CacheRecord) == 8,  "hook_cache.bin record layout changed");
+
+// Guard-derived signatures compare all three words exactly.
+const std::uint32_t kGuardMasks[3] = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu };
+
+// Anchor buckets for SigScan_Run. Job indices fit in a byte.
+constexpr std::size_t  kNumBuckets = 256;
+constexpr std::uint8_t kNoJob      = 0xFF;
+
+static_assert(static_cast<std::size_t>(HookId_Count) < kNoJob,
+              "SigScan_Run stores job indices in a byte");
+
+inline std::uint32_t Bucket(std::uint32_t w)
+{
+    return (w * 0x9E3779B1u) >> 24;
+}
+
+inline int PopCount(std::uint32_t v)
+{
+    return __builtin_popcount(v);
+}
+
+// Index of the job's most specific word.
+std::uint8_t PickAnchor(const SigScanJob &job)
+{
+    std::uint8_t best     = 0;
+    int          bestBits = -1;
+    for (std::uint8_t k = 0; k < job.numWords; ++k)
+    {
+        int bits = PopCount(job.masks[k]);
+        if (bits > bestBits)
+        {
+            best     = k;
+            bestBits = bits;
+        }
+    }
+    return best;
+}
+
+inline bool MatchWords(const SigScanJob &job, const std::uint32_t *at)
+{
+    for (std::uint8_t k = 0; k < job.numWords; ++k)
+    {
+        if (((at[k] ^ job.words[k]) & job.masks[k]) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Candidate: the job's first word would sit at text[start].
+inline void TryAt(SigScanJob &job, const std::uint32_t *text, std::size_t numWords,
+                  std::uint32_t textBase, std::ptrdiff_t start)
+{
+    if (start < 0 || static_cast<std::size_t>(start) + job.numWords > numWords)
+        return;
+    if (!MatchWords(job, text + start))
+        return;
+
+    if (job.hits == 0)
+        job.siteVA = textBase + static_cast<std::uint32_t>(start) * 4u +
+                     static_cast<std::uint32_t>(static_cast<std::int32_t>(job.siteOffset));
+    ++job.hits;
+}
+
+} // anonymous namespace
+
+bool SigScan_MakeJob(const HookEntry &entry, const HookRegionTable *region, SigScanJob &job)
+{
+    job.id     = entry.id;
+    job.siteVA = 0;
+    job.hits   = 0;
+
+    if (region != nullptr)
+    {
+        for (std::size_t i = 0; i < region->numSignatures; ++i)
+        {
+            const HookSignature &sig = region->signatures[i];
+            if (sig.id != entry.id)
+                continue;
+
+            job.numWords   = sig.numWords;
+            job.siteOffset = sig.siteOffset;
+            job.words      = sig.words;
+            job.masks      = sig.masks;
+            return sig.numWords > 0 && sig.numWords <= kSigMaxWords;
+        }
+    }
+
+    // No aob: the guard words are an exact signature for a word-aligned
+    // site.
+    if (!(entry.guard[0] || entry.guard[1] || entry.guard[2]))
+        return false;
+    if ((entry.targetVA & 3u) != 0 && (entry.targetVA & 3u) != 1u)
+        return false;
+
+    job.numWords   = 3;
+    job.siteOffset = 0;
+    job.words      = entry.guard;
+    job.masks      = kGuardMasks;
+    return true;
+}
+
+bool SigScan_MatchAt(const SigScanJob &job, std::uint32_t siteVA,
+                     std::uint32_t textBase, std::uint32_t textSize)
+{
+    const std::uint32_t start = (siteVA & ~1u) - static_cast<std::uint32_t>(static_cast<std::int32_t>(job.siteOffset));
+    if ((start & 3u) != 0 || start < textBase)
+        return false;
+    if (start - textBase + job.numWords * 4u > textSize)
+        return false;
+
+    return MatchWords(job, reinterpret_cast<const std::uint32_t *>(start));
+}
+
+void SigScan_Run(SigScanJob *jobs, std::size_t numJobs,
+                 std::uint32_t textBase, std::uint32_t textSize)
+{
+    if (numJobs > static_cast<std::size_t>(HookId_Count))
+        numJobs = static_cast<std::size_t>(HookId_Count);
+
+    std::uint8_t head[kNumBuckets];
+    std::uint8_t next[HookId_Count];
+    std::uint8_t anchor[HookId_Count];
+    std::uint8_t slow[HookId_Count];
+    std::size_t  numSlow = 0;
+
+    std::memset(head, kNoJob, sizeof(head));
+
+    for (std::size_t j = 0; j < numJobs; ++j)
+    {
+        SigScanJob &job = jobs[j];
+        job.siteVA = 0;
+        job.hits   = 0;
+
+        anchor[j] = PickAnchor(job);
+        if (job.masks[anchor[j]] == 0xFFFFFFFFu)
+        {
+            const std::uint32_t b = Bucket(job.words[anchor[j]]);
+            next[j] = head[b];
+            head[b] = static_cast<std::uint8_t>(j);
+        }
+        else
+        {
+            slow[numSlow++] = static_cast<std::uint8_t>(j);
+        }
+    }
+
+    const std::uint32_t *text     = reinterpret_cast<const std::uint32_t *>(textBase);
+    const std::size_t    numWords = textSize / 4u;
+
+    for (std::size_t i = 0; i < numWords; ++i)
+    {
+        const std::uint32_t w = text[i];
+
+        for (std::uint8_t j = head[Bucket(w)]; j != kNoJob; j = next[j])
+        {
+            if (jobs[j].words[anchor[j]] == w)
+                TryAt(jobs[j], text, numWords, textBase,
+                      static_cast<std::ptrdiff_t>(i) - anchor[j]);
+        }
+
+        for (std::size_t s = 0; s < numSlow; ++s)
+        {
+            const std::uint8_t j = slow[s];
+            const SigScanJob &job = jobs[j];
+            if (((w ^ job.words[anchor[j]]) & job.masks[anchor[j]]) == 0)
+                TryAt(jobs[j], text, numWords, textBase,
+                      static_cast<std::ptrdiff_t>(i) - anchor[j]);
+        }
+    }
+}
+
+std::uint32_t SigScan_HashText(std::uint32_t textBase, std::uint32_t textSize)
+{
+    const std::uint32_t *text     = reinterpret_cast<const std::uint32_t *>(textBase);
+    const std::size_t    numWords = textSize / 4u;
+
+    std::uint32_t h = 2166136261u;
+    h = (h ^ textSize) * 16777619u;
+    for (std::size_t i = 0; i < numWords; i += 16)
+        h = (h ^ text[i]) * 16777619u;
+    return h;
+}
+
+bool SigCache_Load(std::uint64_t titleId, std::uint32_t textSize, std::uint32_t textHash,
+                   std::uint32_t (&cachedVA)[HookId_Count])
+{
+    for (auto &va : cachedVA)
+        va = kSigCacheNone;
+
+    File f;
+    if (File::Open(f, kCachePath, File::READ) != 0)
+        return false;
+
+    CacheHeader hdr;
+    if (f.Read(&hdr, sizeof(hdr)) != 0 ||
+        hdr.magic != kCacheMagic || hdr.version != kCacheVersion)
+    {
+        FATES_LOG(Warn, Hook, "SigScan: %s has a bad header, ignoring it", kCachePath);
+        f.Close();
+        return false;
+    }
+
+    if (hdr.titleId != titleId || hdr.textSize != textSize || hdr.textHash != textHash)
+    {
+        FATES_LOG(Info, Hook, "SigScan: cache is for another code.bin (hash %08lX, now %08lX), ignoring it",
+                              static_cast<unsigned long>(hdr.textHash),
+                              static_cast<unsigned long>(textHash));
+        f.Close();
+        return false;
+    }
+
+    for (std::uint16_t n = 0; n < hdr.count; ++n)
+    {
+        CacheRecord rec;
+        if (f.Read(&rec, sizeof(rec)) != 0)
+            break;
+        if (rec.id < static_cast<std::uint16_t>(HookId_Count))
+            cachedVA[rec.id] = rec.siteVA;
+    }
+
+    f.Close();
+    return true;
+}
+
+bool SigCache_Save(std::uint64_t titleId, std::uint32_t textSize, std::uint32_t textHash,
+                   const std::uint32_t (&cachedVA)[HookId_Count])
+{
+    Directory::Create(kCacheDir);
+
+    File f;
+    if (File::Open(f, kCachePath, File::WRITE | File::CREATE | File::TRUNCATE) != 0)
+    {
+        FATES_LOG(Warn, Hook, "SigScan: couldn't open %s for writing", kCachePath);
+        return false;
+    }
+
+    CacheHeader hdr = {};
+    hdr.magic    = kCacheMagic;
+    hdr.version  = kCacheVersion;
+    hdr.titleId  = titleId;
+    hdr.textSize = textSize;
+    hdr.textHash = textHash;
+    for (std::uint32_t va : cachedVA)
+    {
+        if (va != kSigCacheNone)
+            ++hdr.count;
+    }
+
+    f.Write(&hdr, sizeof(hdr));
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(HookId_Count); ++i)
+    {
+        if (cachedVA[i] == kSigCacheNone)
+            continue;
+
+        CacheRecord rec = { static_cast<std::uint16_t>(i), 0, cachedVA[i] };
+        f.Write(&rec, sizeof(rec));
+    }
+
+    f.Flush();
+    f.Close();
+    return true;
+}
+
+} // namespace Fates
@@ -0,0 +1,119 @@
+// core/turn_state.cpp
+//
+// Cached turn-side resolver. See core/turn_state.hpp.
+
+#include "core/turn_state.hpp"
+#include "util/debug_log.hpp"
+#include "util/safe_read.hpp"
+
+namespace Fates {
+
+namespace {
+
+// Offset of the side index byte in the chain base.
+constexpr std::uintptr_t kSideIndexOffset = 0x08;
+
+// Chain root, 0 until TurnState_SetRoot().
+std::uintptr_t sRootVA = 0;
+
+// Side byte address, 0 while unresolved.
+std::uintptr_t sSideAddr = 0;
+
+TurnStateStats sStats = {};
+
+// Log only when the chain changes between resolvable and not, so a
+// broken chain doesn't print once per turn.
+bool sLastResolveOk = true;
+
+bool WalkChain(std::uintptr_t &base, std::uintptr_t &sideAddr)
+{
+    std::uint32_t ptr1 = 0;
+    if (sRootVA == 0 || !SafeRead(sRootVA, ptr1) || ptr1 == 0)
+        return false;
+
+    std::uint32_t ptr2 = 0;
+    if (!SafeRead(static_cast<std::uintptr_t>(ptr1), ptr2) || ptr2 == 0)
+        return false;
+
+    std::uint8_t idx = 0;
+    if (!SafeRead(ptr2 + kSideIndexOffset, idx))
+        return false;
+
+    const std::uintptr_t addr = ptr2 + idx;
+    if (!SafeRead_IsReadable(addr, 1))
+        return false;
+
+    base     = ptr2;
+    sideAddr = addr;
+    return true;
+}
+
+} // namespace
+
+void TurnState_SetRoot(std::uintptr_t rootVA)
+{
+    sRootVA   = rootVA;
+    sSideAddr = 0;
+}
+
+bool TurnState_Resolve()
+{
+    std::uintptr_t base = 0;
+    std::uintptr_t addr = 0;
+    const bool ok = WalkChain(base, addr);
+
+    sSideAddr      = ok ? addr : 0;
+    sStats.base     = base;
+    sStats.sideAddr = sSideAddr;
+
+    if (ok)
+        ++sStats.resolves;
+    else
+        ++sStats.failures;
+
+    if (ok != sLastResolveOk)
+    {
+        if (ok)
+            FATES_LOG(Info, Hook, "TurnState: chain resolved base=%08X side@%08X",
+                                  static_cast<unsigned>(base), static_cast<unsigned>(addr));
+        else
+            FATES_LOG(Warn, Hook, "TurnState: chain at %08X does not resolve; side is Unknown",
+                                  static_cast<unsigned>(sRootVA));
+        sLastResolveOk = ok;
+    }
+    return ok;
+}
+
+void TurnState_Invalidate()
+{
+    sSideAddr       = 0;
+    sStats.sideAddr = 0;
+}
+
+std::uint8_t TurnState_GetSideRaw()
+{
+    if (sSideAddr == 0 && !TurnState_Resolve())
+        return 0xFF;
+
+    const std::uint8_t side = *reinterpret_cast<const volatile std::uint8_t *>(sSideAddr);
+    return (side <= 3) ? side : 0xFF;
+}
+
+TurnSide TurnState_GetSide()
+{
+    switch (TurnState_GetSideRaw())
+    {
+    case 0: return TurnSide::Side0;
+    case 1: return TurnSide::Side1;
+    case 2: return TurnSide::Side2;
+    case 3: return TurnSide::Side3;
+    default: return TurnSide::Unknown;
+    }
+}
+
+void TurnState_GetStats(TurnStateStats &out)
+{
+    out = sStats;
+}
+
+} // namespace Fates
@@ -0,0 +1,213 @@
+// engine/arena.cpp
+//
+// Plugin / per-map bump arenas and their usage report. See
+// engine/arena.hpp.
+
+#include <cstring>
+
+#include "engine/arena.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+struct Arena
+{
+    const char    *name;
+    std::uint8_t  *base;
+    std::uint32_t  capacity;
+    std::uint32_t  used;
+    std::uint32_t  highWater;
+    std::uint32_t  failedAllocs;
+};
+
+struct TagUsage
+{
+    const char    *tag;
+    ArenaId        arena;
+    std::uint32_t  bytes;
+    std::uint32_t  highWater;
+    std::uint32_t  drops;
+    std::uint32_t  mapGen;      // Map tags: 'bytes' is stale if != sMapGen
+    bool           failLogged;
+};
+
+alignas(8) std::uint8_t sPluginBytes[FATES_ARENA_PLUGIN_BYTES];
+alignas(8) std::uint8_t sMapBytes[FATES_ARENA_MAP_BYTES];
+
+Arena sArenas[static_cast<int>(ArenaId::Count)] = {
+    { "plugin", sPluginBytes, FATES_ARENA_PLUGIN_BYTES, 0, 0, 0 },
+    { "map",    sMapBytes,    FATES_ARENA_MAP_BYTES,    0, 0, 0 },
+};
+
+TagUsage sTags[kArenaMaxTags] = {};
+int      sNumTags = 0;
+
+// Bumped by every Arena_ResetMap(). Never 0.
+std::uint32_t sMapGen = 1;
+
+// Tag pointers are string literals, so the pointer compare almost
+// always hits; strcmp covers the same name from two translation units.
+TagUsage *FindTag(const char *tag, ArenaId arena, bool create)
+{
+    for (int i = 0; i < sNumTags; ++i)
+    {
+        if (sTags[i].tag == tag || std::strcmp(sTags[i].tag, tag) == 0)
+            return &sTags[i];
+    }
+
+    if (!create || sNumTags >= kArenaMaxTags)
+        return nullptr;
+
+    TagUsage &t = sTags[sNumTags++];
+    t.tag    = tag;
+    t.arena  = arena;
+    t.mapGen = sMapGen;
+    return &t;
+}
+
+// 'bytes' of a Map tag only count for the current map.
+void Refresh(TagUsage &t)
+{
+    if (t.arena == ArenaId::Map && t.mapGen != sMapGen)
+    {
+        t.bytes  = 0;
+        t.mapGen = sMapGen;
+    }
+}
+
+} // namespace
+
+void *Arena_Alloc(ArenaId arena, const char *tag, std::size_t bytes, std::size_t align)
+{
+    const int a = static_cast<int>(arena);
+    if (a < 0 || a >= static_cast<int>(ArenaId::Count) || tag == nullptr)
+        return nullptr;
+
+    Arena    &ar = sArenas[a];
+    TagUsage *t  = FindTag(tag, arena, true);
+    if (t != nullptr)
+        Refresh(*t);
+
+    const std::uint32_t start = (ar.used + static_cast<std::uint32_t>(align) - 1u) &
+                                ~(static_cast<std::uint32_t>(align) - 1u);
+    if (start > ar.capacity || bytes > ar.capacity - start)
+    {
+        ++ar.failedAllocs;
+        if (t == nullptr || !t->failLogged)
+        {
+            FATES_LOG(Error, Engine, "Arena[%s]: %s needs %u byte(s), %u of %u free; table left empty",
+                                     ar.name, tag,
+                                     static_cast<unsigned>(bytes),
+                                     static_cast<unsigned>(ar.capacity - ar.used),
+                                     static_cast<unsigned>(ar.capacity));
+            if (t != nullptr)
+                t->failLogged = true;
+        }
+        return nullptr;
+    }
+
+    ar.used = start + static_cast<std::uint32_t>(bytes);
+    if (ar.used > ar.highWater)
+        ar.highWater = ar.used;
+
+    if (t != nullptr)
+    {
+        t->bytes += static_cast<std::uint32_t>(bytes);
+        if (t->bytes > t->highWater)
+            t->highWater = t->bytes;
+    }
+
+    return ar.base + start;
+}
+
+void Arena_NoteDrop(const char *tag)
+{
+    if (tag == nullptr)
+        return;
+
+    if (TagUsage *t = FindTag(tag, ArenaId::Map, false))
+        ++t->drops;
+}
+
+void Arena_ResetMap()
+{
+    sArenas[static_cast<int>(ArenaId::Map)].used = 0;
+
+    if (++sMapGen == 0)
+        sMapGen = 1;
+}
+
+void Arena_GetStats(ArenaId arena, ArenaStats &out)
+{
+    const int a = static_cast<int>(arena);
+    if (a < 0 || a >= static_cast<int>(ArenaId::Count))
+    {
+        out = ArenaStats{};
+        return;
+    }
+
+    const Arena &ar  = sArenas[a];
+    out.name         = ar.name;
+    out.capacity     = ar.capacity;
+    out.used         = ar.used;
+    out.highWater    = ar.highWater;
+    out.failedAllocs = ar.failedAllocs;
+}
+
+int Arena_GetTagStats(ArenaTagStats *out, int max)
+{
+    int n = 0;
+    for (int i = 0; i < sNumTags && n < max; ++i)
+    {
+        const TagUsage &t = sTags[i];
+        ArenaTagStats  &o = out[n++];
+        o.tag       = t.tag;
+        o.arena     = t.arena;
+        o.bytes     = (t.arena == ArenaId::Map && t.mapGen != sMapGen) ? 0u : t.bytes;
+        o.highWater = t.highWater;
+        o.drops     = t.drops;
+    }
+    return n;
+}
+
+void Arena_ReportMapEnd()
+{
+    for (int a = 0; a < static_cast<int>(ArenaId::Count); ++a)
+    {
+        const Arena &ar = sArenas[a];
+        FATES_LOG(Info, Engine, "Arena[%s]: used=%u highWater=%u/%u failedAllocs=%u",
+                                ar.name,
+                                static_cast<unsigned>(ar.used),
+                                static_cast<unsigned>(ar.highWater),
+                                static_cast<unsigned>(ar.capacity),
+                                static_cast<unsigned>(ar.failedAllocs));
+    }
+
+    for (int i = 0; i < sNumTags; ++i)
+    {
+        TagUsage &t = sTags[i];
+        Refresh(t);
+        if (t.drops != 0)
+        {
+            FATES_LOG(Warn, Engine, "  %-14s [%s] %u B (hw %u B), %u entr%s dropped: budget too small",
+                                    t.tag, sArenas[static_cast<int>(t.arena)].name,
+                                    static_cast<unsigned>(t.bytes),
+                                    static_cast<unsigned>(t.highWater),
+                                    static_cast<unsigned>(t.drops),
+                                    t.drops == 1 ? "y" : "ies");
+        }
+        else
+        {
+            FATES_LOG(Info, Engine, "  %-14s [%s] %u B (hw %u B)",
+                                    t.tag, sArenas[static_cast<int>(t.arena)].name,
+                                    static_cast<unsigned>(t.bytes),
+                                    static_cast<unsigned>(t.highWater));
+        }
+    }
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -5,10 +5,40 @@
 // has a small fixed-size handler array. Register*Handler() appends,
 // Dispatch*() walks the list and calls each handler.
 //
+// Deferred delivery: for the high-frequency families (kill, HP, RNG,
+// unit meta, unit move / item use), handlers registered without
+// HandlerFlag_Sync are not called from the hook. Dispatch*() runs the
+// sync handlers, then packs the event into a DeferredEvent in sQueue.
+// DrainDeferredEvents() rebuilds the contexts and hands them to the
+// queued handlers in order. The drain runs on the game thread at safe
+// points (action end, and before every map/turn dispatch) so module
+// state never has to be shared across threads. If the ring fills up,
+// the producer drains it inline before enqueueing; nothing is dropped,
+// but the overflow is counted so the ring size can be tuned.
+//
+// Accounting: every handler call is timed with svcGetSystemTick().
+// Per handler the bus keeps call count, cumulative/max ticks and a
+// budget. A handler that overruns its budget kBudgetStrikeLimit calls in
+// a row is demoted: a sync handler in a deferrable family becomes
+// deferred (off the hook path), anything else is disabled. Any call
+// within budget clears the strikes, so scattered overruns (the thread
+// preempted mid-call, e.g. by the worker on Old 3DS) never add up. DumpHandlerStats() ranks
+// handlers by cumulative cost per event kind.
+//
+// Built-in modules: with FATES_STATIC_MODULES set, every Dispatch*()
+// first calls BuiltinModuleList::Dispatch<>() (engine/builtin_modules.hpp),
+// which expands into direct calls to the built-in modules' handlers,
+// then walks the runtime list as usual. The same sync / deferred split
+// applies; built-in handlers just aren't timed or budgeted.
+//
 // This is intentionally basic C so it's easy to reason
 // about and friendly to the 3DS architecture.
 
+#include <3ds.h>
+#include <cstring>
+
 #include "engine/bus.hpp"
+#include "engine/builtin_modules.hpp"
 #include "util/debug_log.hpp"
 
 namespace Fates {
@@ -16,212 +46,1090 @@ namespace Engine {
 
 namespace {
 
+#if FATES_STATIC_MODULES
+template <EventKind K, ModulePass P, typename Ctx>
+inline void DispatchStatic(const Ctx &ctx)
+{
+    BuiltinModuleList::Dispatch<K, P>(ctx);
+}
+
+template <EventKind K>
+constexpr int StaticDeferredCount()
+{
+    return BuiltinModuleList::CountDeferred<K>();
+}
+
+constexpr std::uint32_t kStaticSubscriberMask = BuiltinModuleList::kSubscriberMask;
+#else
+template <EventKind K, ModulePass P, typename Ctx>
+inline void DispatchStatic(const Ctx &)
+{
+}
+
+template <EventKind K>
+constexpr int StaticDeferredCount()
+{
+    return 0;
+}
+
+constexpr std::uint32_t kStaticSubscriberMask = 0;
+#endif
+
+} // anonymous namespace
+
+std::uint32_t gBusSubscriberMask = kStaticSubscriberMask;
+
+namespace {
+
 // Bump these if you ever need more listeners.
 constexpr int kMaxMapBeginHandlers   = 8;
 constexpr int kMaxMapEndHandlers     = 8;
 constexpr int kMaxTurnBeginHandlers  = 8;
 constexpr int kMaxTurnEndHandlers    = 8;
 constexpr int kMaxKillHandlers       = 8;
-constexpr int kMaxHpChangeHandlers = 16; 
+constexpr int kMaxHpChangeHandlers = 16;
 constexpr int kMaxRngHandlers        = 4;
 constexpr int kMaxLevelUpHandlers    = 4;
 constexpr int kMaxSkillLearnHandlers = 4;
 constexpr int kMaxItemGainHandlers   = 4;
+constexpr int kMaxBattleBeginHandlers = 8;
+constexpr int kMaxBattleEndHandlers   = 8;
+constexpr int kMaxHpSyncHandlers     = 4;
+constexpr int kMaxActionEndHandlers  = 8;
+constexpr int kMaxUnitMoveHandlers   = 4;
+constexpr int kMaxItemUseHandlers    = 4;
+
+// Consecutive overruns allowed before a handler is demoted / disabled.
+constexpr std::uint16_t kBudgetStrikeLimit = 8;
+
+// svcGetSystemTick() runs at 268.111856 MHz.
+constexpr std::uint32_t kTicksPerUs = 268;
+
+inline std::uint32_t TicksToUs(std::uint64_t ticks)
+{
+    return static_cast<std::uint32_t>((ticks * 1000ULL) / 268112ULL);
+}
+
+struct HandlerStats
+{
+    const char   *tag;          // module/handler name (may be nullptr)
+    std::uint32_t calls;
+    std::uint64_t ticks;        // cumulative
+    std::uint32_t maxTicks;
+    std::uint32_t budgetTicks;  // 0 = no budget
+    std::uint16_t strikes;      // consecutive budget overruns
+};
+
+// Handlers + their registration flags + stats + counts, per family.
+template <typename Fn, int N>
+struct HandlerList
+{
+    Fn            fns[N];
+    std::uint32_t flags[N];
+    HandlerStats  stats[N];
+    int           count;
+    int           numDeferred;  // live handlers registered without HandlerFlag_Sync
+};
+
+HandlerList<MapBeginHandler,   kMaxMapBeginHandlers>   sMapBeginHandlers   = {};
+HandlerList<MapEndHandler,     kMaxMapEndHandlers>     sMapEndHandlers     = {};
+HandlerList<TurnBeginHandler,  kMaxTurnBeginHandlers>  sTurnBeginHandlers  = {};
+HandlerList<TurnEndHandler,    kMaxTurnEndHandlers>    sTurnEndHandlers    = {};
+HandlerList<KillHandler,       kMaxKillHandlers>       sKillHandlers       = {};
+HandlerList<HpChangeHandler,   kMaxHpChangeHandlers>   sHpChangeHandlers   = {};
+HandlerList<RngHandler,        kMaxRngHandlers>        sRngHandlers        = {};
+HandlerList<LevelUpHandler,    kMaxLevelUpHandlers>    sLevelUpHandlers    = {};
+HandlerList<SkillLearnHandler, kMaxSkillLearnHandlers> sSkillLearnHandlers = {};
+HandlerList<ItemGainHandler,   kMaxItemGainHandlers>   sItemGainHandlers   = {};
+HandlerList<BattleBeginHandler, kMaxBattleBeginHandlers> sBattleBeginHandlers = {};
+HandlerList<BattleEndHandler,   kMaxBattleEndHandlers>   sBattleEndHandlers   = {};
+HandlerList<HpSyncHandler,     kMaxHpSyncHandlers>     sHpSyncHandlers     = {};
+HandlerList<ActionEndHandler,  kMaxActionEndHandlers>  sActionEndHandlers  = {};
+HandlerList<UnitMoveHandler,   kMaxUnitMoveHandlers>   sUnitMoveHandlers   = {};
+HandlerList<ItemUseHandler,    kMaxItemUseHandlers>    sItemUseHandlers    = {};
+
+// == Deferred queue ==================================================
+
+// Compact event record. The map snapshot is stored once; DrainDeferredEvents
+// copies it into both ctx.map and ctx.turn.map when rebuilding.
+struct DeferredEvent
+{
+    EventKind     kind;
+    TurnSide      side;
+    std::uint32_t sideTurnIndex;
+    std::uint32_t battle;        // kill / HP / HP sync only, 0 otherwise
+    MapContext    map;
+
+    struct HpPayload
+    {
+        void         *source;
+        void         *target;
+        int           amount;
+        std::uint32_t flags;
+        void         *context;
+        std::int16_t  damage;   // per-window totals fit easily in s16
+        std::int16_t  healing;
+        std::uint16_t syncs;
+    };
+
+    struct RngPayload
+    {
+        void         *state;
+        std::uint32_t raw;
+        std::uint32_t bound;
+        std::uint32_t result;
+    };
+
+    struct LevelUpPayload
+    {
+        void         *unit;
+        std::uint8_t  level;
+    };
+
+    struct SkillLearnPayload
+    {
+        void          *unit;
+        std::uint16_t  skillId;
+        std::uint16_t  flags;
+        int            result;
+    };
+
+    struct ItemGainPayload
+    {
+        void *seq;
+        void *unit;
+        void *itemArg;
+        void *modeOrCtx;
+        int   result;
+    };
+
+    struct ActionPayload
+    {
+        void          *inst;
+        void          *cmdData;
+        void          *unit;
+        std::uint32_t  cmdId;
+        std::uint32_t  sideRaw;
+        std::uint32_t  unk28;
+        std::uint32_t  turnCount;
+    };
+
+    union
+    {
+        KillEvent         kill;
+        HpPayload         hp;
+        RngPayload        rng;
+        LevelUpPayload    levelUp;
+        SkillLearnPayload skillLearn;
+        ItemGainPayload   itemGain;
+        ActionPayload     action;
+    } u;
+};
+
+// Must be a power of two. An enemy phase with many battles produces a
+// few hundred RNG + HP events between action ends.
+constexpr std::uint32_t kQueueCapacity = 256;
+constexpr std::uint32_t kQueueMask     = kQueueCapacity - 1;
+
+DeferredEvent sQueue[kQueueCapacity];
+
+// Monotonic counters; (head - tail) is the pending record count.
+volatile std::uint32_t sQueueHead = 0;
+volatile std::uint32_t sQueueTail = 0;
+
+bool sDeferredEnabled = true;
+bool sDraining        = false;
+
+std::uint32_t sDefaultBudgetUs = kDefaultHandlerBudgetUs;
+
+std::uint32_t sQueueHighWater      = 0;
+std::uint32_t sQueueOverflowDrains = 0;
+std::uint32_t sQueueEnqueued       = 0;
+
+// Families that can be queued (see Dispatch* below). Battle begin/end
+// handlers exist to set up / read per-battle state around the battle's
+// own HP and kill events, so they can't arrive after them. ActionEnd is
+// itself the safe point that drains the queue.
+constexpr bool IsDeferrable(EventKind kind)
+{
+    return kind != EventKind::MapBegin && kind != EventKind::MapEnd &&
+           kind != EventKind::TurnBegin && kind != EventKind::TurnEnd &&
+           kind != EventKind::BattleBegin && kind != EventKind::BattleEnd &&
+           kind != EventKind::ActionEnd;
+}
+
+const char *KindName(EventKind kind)
+{
+    switch (kind)
+    {
+    case EventKind::MapBegin:   return "MapBegin";
+    case EventKind::MapEnd:     return "MapEnd";
+    case EventKind::TurnBegin:  return "TurnBegin";
+    case EventKind::TurnEnd:    return "TurnEnd";
+    case EventKind::Kill:       return "Kill";
+    case EventKind::RngCall:    return "RngCall";
+    case EventKind::LevelUp:    return "LevelUp";
+    case EventKind::SkillLearn: return "SkillLearn";
+    case EventKind::ItemGain:   return "ItemGain";
+    case EventKind::HpChange:   return "HpChange";
+    case EventKind::ActionEnd:  return "ActionEnd";
+    case EventKind::BattleBegin: return "BattleBegin";
+    case EventKind::BattleEnd:  return "BattleEnd";
+    case EventKind::HpSync:     return "HpSync";
+    case EventKind::UnitMove:   return "UnitMove";
+    case EventKind::ItemUse:    return "ItemUse";
+    case EventKind::UnitPrewarm: return "UnitPrewarm";
+    }
+    return "?";
+}
+
+inline const char *TagOf(const HandlerStats &st)
+{
+    return st.tag ? st.tag : "(untagged)";
+}
 
-// Storage for handler arrays + counts.
-MapBeginHandler   sMapBeginHandlers[kMaxMapBeginHandlers]     = {};
-MapEndHandler     sMapEndHandlers[kMaxMapEndHandlers]         = {};
-TurnBeginHandler  sTurnBeginHandlers[kMaxTurnBeginHandlers]   = {};
-TurnEndHandler    sTurnEndHandlers[kMaxTurnEndHandlers]       = {};
-KillHandler       sKillHandlers[kMaxKillHandlers]             = {};
-HpChangeHandler  sHpChangeHandlers[kMaxHpChangeHandlers]   = {};
-RngHandler        sRngHandlers[kMaxRngHandlers]               = {};
-LevelUpHandler    sLevelUpHandlers[kMaxLevelUpHandlers]       = {};
-SkillLearnHandler sSkillLearnHandlers[kMaxSkillLearnHandlers] = {};
-ItemGainHandler   sItemGainHandlers[kMaxItemGainHandlers]     = {};
-
-int sNumMapBeginHandlers   = 0;
-int sNumMapEndHandlers     = 0;
-int sNumTurnBeginHandlers  = 0;
-int sNumTurnEndHandlers    = 0;
-int sNumKillHandlers       = 0;
-int sNumHpChangeHandlers  = 0;
-int sNumRngHandlers        = 0;
-int sNumLevelUpHandlers    = 0;
-int sNumSkillLearnHandlers = 0;
-int sNumItemGainHandlers   = 0;
-
-template <typename Fn>
-bool RegisterHandler(Fn fn, Fn *storage, int &count, int capacity, const char *name)
+template <typename Fn, int N>
+bool RegisterHandler(Fn fn, std::uint32_t flags, const char *tag,
+                     HandlerList<Fn, N> &list, EventKind kind, const char *name)
 {
     if (fn == nullptr)
         return false;
 
-    if (count >= capacity)
+    if (list.count >= N)
     {
-        Logf("Engine::%s: capacity full (%d)", name, capacity);
+        FATES_LOG(Warn, Engine, "Engine::%s: capacity full (%d)", name, N);
         return false;
     }
 
-    storage[count++] = fn;
-    Logf("Engine::%s: registered handler #%d", name, count);
+    // Map/turn families are always delivered synchronously.
+    if (!IsDeferrable(kind))
+        flags |= HandlerFlag_Sync;
+    flags &= ~static_cast<std::uint32_t>(HandlerFlag_Disabled);
+
+    HandlerStats &st = list.stats[list.count];
+    st             = HandlerStats{};
+    st.tag         = tag;
+    st.budgetTicks = (flags & HandlerFlag_NoBudget) ? 0 : sDefaultBudgetUs * kTicksPerUs;
+
+    list.fns[list.count]   = fn;
+    list.flags[list.count] = flags;
+    ++list.count;
+
+    if ((flags & HandlerFlag_Sync) == 0)
+        ++list.numDeferred;
+
+    gBusSubscriberMask |= EventBit(kind);
+    FATES_LOG(Info, Engine, "Engine::%s: registered handler #%d tag=%s%s",
+                            name, list.count, TagOf(st),
+                            (IsDeferrable(kind) && (flags & HandlerFlag_Sync)) ? " (sync)" : "");
     return true;
 }
 
-template <typename Fn, typename Ctx>
-void DispatchHandlers(const Ctx &ctx, Fn *storage, int count)
+// Budget overrun: strike, then demote (sync -> deferred) or disable.
+// Map/turn handlers can only be disabled and fire rarely, so each of
+// their strikes is logged before it comes to that.
+template <typename Fn, int N>
+void OnBudgetExceeded(HandlerList<Fn, N> &list, int i, EventKind kind, std::uint32_t ticks)
+{
+    HandlerStats &st = list.stats[i];
+    if (++st.strikes < kBudgetStrikeLimit)
+    {
+        if (!IsDeferrable(kind))
+        {
+            FATES_LOG(Warn, Engine, "Engine::Bus: [%s] handler %s over budget (%uus > %uus), strike %u/%u",
+                                    KindName(kind), TagOf(st),
+                                    static_cast<unsigned>(TicksToUs(ticks)),
+                                    static_cast<unsigned>(TicksToUs(st.budgetTicks)),
+                                    static_cast<unsigned>(st.strikes),
+                                    static_cast<unsigned>(kBudgetStrikeLimit));
+        }
+        return;
+    }
+
+    st.strikes = 0;
+
+    std::uint32_t &flags = list.flags[i];
+    if ((flags & HandlerFlag_Sync) && IsDeferrable(kind))
+    {
+        flags &= ~static_cast<std::uint32_t>(HandlerFlag_Sync);
+        ++list.numDeferred;
+        FATES_LOG(Warn, Engine, "Engine::Bus: [%s] handler %s over budget (%uus > %uus, %u strikes) -> demoted to deferred",
+                                KindName(kind), TagOf(st),
+                                static_cast<unsigned>(TicksToUs(ticks)),
+                                static_cast<unsigned>(TicksToUs(st.budgetTicks)),
+                                static_cast<unsigned>(kBudgetStrikeLimit));
+        return;
+    }
+
+    if ((flags & HandlerFlag_Sync) == 0)
+        --list.numDeferred;
+    flags |= HandlerFlag_Disabled;
+    FATES_LOG(Warn, Engine, "Engine::Bus: [%s] handler %s over budget (%uus > %uus, %u strikes) -> DISABLED",
+                            KindName(kind), TagOf(st),
+                            static_cast<unsigned>(TicksToUs(ticks)),
+                            static_cast<unsigned>(TicksToUs(st.budgetTicks)),
+                            static_cast<unsigned>(kBudgetStrikeLimit));
+}
+
+// Time one handler call and account it.
+template <typename Fn, int N, typename Ctx>
+inline void CallHandler(const Ctx &ctx, HandlerList<Fn, N> &list, int i, EventKind kind)
+{
+    std::uint64_t t0 = svcGetSystemTick();
+    list.fns[i](ctx);
+    std::uint32_t dt = static_cast<std::uint32_t>(svcGetSystemTick() - t0);
+
+    HandlerStats &st = list.stats[i];
+    ++st.calls;
+    st.ticks += dt;
+    if (dt > st.maxTicks)
+        st.maxTicks = dt;
+
+    if (st.budgetTicks != 0 && dt > st.budgetTicks)
+        OnBudgetExceeded(list, i, kind, dt);
+    else
+        st.strikes = 0;
+}
+
+// Call every live handler, ignoring delivery flags.
+template <typename Fn, int N, typename Ctx>
+void DispatchHandlers(const Ctx &ctx, HandlerList<Fn, N> &list, EventKind kind)
+{
+    for (int i = 0; i < list.count; ++i)
+    {
+        if ((list.flags[i] & HandlerFlag_Disabled) == 0 && list.fns[i] != nullptr)
+            CallHandler(ctx, list, i, kind);
+    }
+}
+
+// Call only live handlers whose HandlerFlag_Sync bit equals 'sync'.
+template <typename Fn, int N, typename Ctx>
+void DispatchHandlers(const Ctx &ctx, HandlerList<Fn, N> &list, EventKind kind, bool sync)
+{
+    for (int i = 0; i < list.count; ++i)
+    {
+        std::uint32_t flags = list.flags[i];
+        bool isSync = (flags & HandlerFlag_Sync) != 0;
+        if (isSync == sync && (flags & HandlerFlag_Disabled) == 0 && list.fns[i] != nullptr)
+            CallHandler(ctx, list, i, kind);
+    }
+}
+
+// Apply a budget to every handler in 'list' whose tag matches (nullptr = all).
+template <typename Fn, int N>
+int ApplyBudget(HandlerList<Fn, N> &list, const char *tag, std::uint32_t budgetTicks)
+{
+    int n = 0;
+    for (int i = 0; i < list.count; ++i)
+    {
+        HandlerStats &st = list.stats[i];
+        if (tag != nullptr && (st.tag == nullptr || std::strcmp(st.tag, tag) != 0))
+            continue;
+        st.budgetTicks = budgetTicks;
+        st.strikes     = 0;
+        ++n;
+    }
+    return n;
+}
+
+// Log one family's handlers ranked by cumulative ticks.
+template <typename Fn, int N>
+void DumpList(const HandlerList<Fn, N> &list, EventKind kind)
 {
-    for (int i = 0; i < count; ++i)
+    if (list.count == 0)
+        return;
+
+    int order[N];
+    for (int i = 0; i < list.count; ++i)
+        order[i] = i;
+
+    // Tiny lists: selection sort, highest cost first.
+    for (int a = 0; a < list.count; ++a)
+    {
+        int best = a;
+        for (int b = a + 1; b < list.count; ++b)
+        {
+            if (list.stats[order[b]].ticks > list.stats[order[best]].ticks)
+                best = b;
+        }
+        int t = order[a]; order[a] = order[best]; order[best] = t;
+    }
+
+    FATES_LOG(Info, Engine, "  [%s]", KindName(kind));
+    for (int r = 0; r < list.count; ++r)
     {
-        if (storage[i] != nullptr)
-            storage[i](ctx);
+        int i = order[r];
+        const HandlerStats &st = list.stats[i];
+        std::uint32_t flags = list.flags[i];
+
+        const char *state = (flags & HandlerFlag_Disabled) ? "disabled"
+                          : (!IsDeferrable(kind))          ? "sync"
+                          : (flags & HandlerFlag_Sync)     ? "sync"
+                                                           : "deferred";
+
+        FATES_LOG(Info, Engine, "    #%d %-16s calls=%u total=%uus avg=%uus max=%uus budget=%uus strikes=%u %s",
+                                r + 1,
+                                TagOf(st),
+                                static_cast<unsigned>(st.calls),
+                                static_cast<unsigned>(TicksToUs(st.ticks)),
+                                static_cast<unsigned>(st.calls ? TicksToUs(st.ticks / st.calls) : 0),
+                                static_cast<unsigned>(TicksToUs(st.maxTicks)),
+                                static_cast<unsigned>(TicksToUs(st.budgetTicks)),
+                                static_cast<unsigned>(st.strikes),
+                                state);
     }
 }
 
+template <EventKind K, typename Fn, int N>
+inline bool ShouldDefer(const HandlerList<Fn, N> &list)
+{
+    return sDeferredEnabled && !sDraining &&
+           (list.numDeferred + StaticDeferredCount<K>()) != 0;
+}
+
+// Rebuild the context for one record and run the queued handlers.
+void DeliverDeferred(const DeferredEvent &ev)
+{
+    TurnContext tc{};
+    tc.map           = ev.map;
+    tc.side          = ev.side;
+    tc.sideTurnIndex = ev.sideTurnIndex;
+
+    switch (ev.kind)
+    {
+    case EventKind::Kill:
+    {
+        KillContext kc{};
+        kc.core   = ev.u.kill;
+        kc.map    = ev.map;
+        kc.turn   = tc;
+        kc.battle = ev.battle;
+        DispatchStatic<EventKind::Kill, ModulePass::Deferred>(kc);
+        DispatchHandlers(kc, sKillHandlers, EventKind::Kill, false);
+        break;
+    }
+    case EventKind::HpChange:
+    case EventKind::HpSync:
+    {
+        HpChangeContext hc{};
+        hc.core.source  = UnitHandle(ev.u.hp.source);
+        hc.core.target  = UnitHandle(ev.u.hp.target);
+        hc.core.amount  = ev.u.hp.amount;
+        hc.core.flags   = ev.u.hp.flags;
+        hc.core.context = ev.u.hp.context;
+        hc.map     = ev.map;
+        hc.turn    = tc;
+        hc.battle  = ev.battle;
+        hc.damage  = ev.u.hp.damage;
+        hc.healing = ev.u.hp.healing;
+        hc.syncs   = ev.u.hp.syncs;
+        if (ev.kind == EventKind::HpSync)
+        {
+            DispatchStatic<EventKind::HpSync, ModulePass::Deferred>(hc);
+            DispatchHandlers(hc, sHpSyncHandlers, EventKind::HpSync, false);
+        }
+        else
+        {
+            DispatchStatic<EventKind::HpChange, ModulePass::Deferred>(hc);
+            DispatchHandlers(hc, sHpChangeHandlers, EventKind::HpChange, false);
+        }
+        break;
+    }
+    case EventKind::RngCall:
+    {
+        RngContext rc{};
+        rc.map    = ev.map;
+        rc.turn   = tc;
+        rc.state  = ev.u.rng.state;
+        rc.raw    = ev.u.rng.raw;
+        rc.bound  = ev.u.rng.bound;
+        rc.result = ev.u.rng.result;
+        DispatchStatic<EventKind::RngCall, ModulePass::Deferred>(rc);
+        DispatchHandlers(rc, sRngHandlers, EventKind::RngCall, false);
+        break;
+    }
+    case EventKind::LevelUp:
+    {
+        LevelUpContext lc{};
+        lc.map   = ev.map;
+        lc.turn  = tc;
+        lc.unit  = UnitHandle(ev.u.levelUp.unit);
+        lc.level = ev.u.levelUp.level;
+        DispatchStatic<EventKind::LevelUp, ModulePass::Deferred>(lc);
+        DispatchHandlers(lc, sLevelUpHandlers, EventKind::LevelUp, false);
+        break;
+    }
+    case EventKind::SkillLearn:
+    {
+        SkillLearnContext sc{};
+        sc.map     = ev.map;
+        sc.turn    = tc;
+        sc.unit    = UnitHandle(ev.u.skillLearn.unit);
+        sc.skillId = ev.u.skillLearn.skillId;
+        sc.flags   = ev.u.skillLearn.flags;
+        sc.result  = ev.u.skillLearn.result;
+        DispatchStatic<EventKind::SkillLearn, ModulePass::Deferred>(sc);
+        DispatchHandlers(sc, sSkillLearnHandlers, EventKind::SkillLearn, false);
+        break;
+    }
+    case EventKind::ItemGain:
+    {
+        ItemGainContext ic{};
+        ic.map       = ev.map;
+        ic.turn      = tc;
+        ic.seq       = ev.u.itemGain.seq;
+        ic.unit      = UnitHandle(ev.u.itemGain.unit);
+        ic.itemArg   = ev.u.itemGain.itemArg;
+        ic.modeOrCtx = ev.u.itemGain.modeOrCtx;
+        ic.result    = ev.u.itemGain.result;
+        DispatchStatic<EventKind::ItemGain, ModulePass::Deferred>(ic);
+        DispatchHandlers(ic, sItemGainHandlers, EventKind::ItemGain, false);
+        break;
+    }
+    case EventKind::UnitMove:
+    case EventKind::ItemUse:
+    {
+        ActionContext ac{};
+        ac.core.inst    = ev.u.action.inst;
+        ac.core.cmdData = ev.u.action.cmdData;
+        ac.core.unit    = UnitHandle(ev.u.action.unit);
+        ac.core.cmdId   = ev.u.action.cmdId;
+        ac.core.sideRaw = ev.u.action.sideRaw;
+        ac.core.unk28   = ev.u.action.unk28;
+        ac.map       = ev.map;
+        ac.turn      = tc;
+        ac.turnCount = ev.u.action.turnCount;
+        if (ev.kind == EventKind::UnitMove)
+        {
+            DispatchStatic<EventKind::UnitMove, ModulePass::Deferred>(ac);
+            DispatchHandlers(ac, sUnitMoveHandlers, EventKind::UnitMove, false);
+        }
+        else
+        {
+            DispatchStatic<EventKind::ItemUse, ModulePass::Deferred>(ac);
+            DispatchHandlers(ac, sItemUseHandlers, EventKind::ItemUse, false);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// Reserve the next queue slot, draining inline if the ring is full.
+// The caller fills the slot and then calls CommitDeferred().
+DeferredEvent &ReserveDeferred(EventKind kind, const TurnContext &turn)
+{
+    if (sQueueHead - sQueueTail >= kQueueCapacity)
+    {
+        ++sQueueOverflowDrains;
+        DrainDeferredEvents();
+    }
+
+    DeferredEvent &ev = sQueue[sQueueHead & kQueueMask];
+    ev.kind          = kind;
+    ev.side          = turn.side;
+    ev.sideTurnIndex = turn.sideTurnIndex;
+    ev.battle        = 0;
+    ev.map           = turn.map;
+    return ev;
+}
+
+void PackHp(DeferredEvent &ev, const HpChangeContext &ctx)
+{
+    ev.battle       = ctx.battle;
+    ev.u.hp.source  = ctx.core.source.Raw();
+    ev.u.hp.target  = ctx.core.target.Raw();
+    ev.u.hp.amount  = ctx.core.amount;
+    ev.u.hp.flags   = ctx.core.flags;
+    ev.u.hp.context = ctx.core.context;
+    ev.u.hp.damage  = static_cast<std::int16_t>(ctx.damage);
+    ev.u.hp.healing = static_cast<std::int16_t>(ctx.healing);
+    ev.u.hp.syncs   = static_cast<std::uint16_t>(ctx.syncs);
+}
+
+void PackAction(DeferredEvent &ev, const ActionContext &ctx)
+{
+    ev.u.action.inst      = ctx.core.inst;
+    ev.u.action.cmdData   = ctx.core.cmdData;
+    ev.u.action.unit      = ctx.core.unit.Raw();
+    ev.u.action.cmdId     = ctx.core.cmdId;
+    ev.u.action.sideRaw   = ctx.core.sideRaw;
+    ev.u.action.unk28     = ctx.core.unk28;
+    ev.u.action.turnCount = ctx.turnCount;
+}
+
+void CommitDeferred()
+{
+    __sync_synchronize();
+    std::uint32_t head = sQueueHead + 1;
+    sQueueHead = head;
+    ++sQueueEnqueued;
+
+    std::uint32_t pending = head - sQueueTail;
+    if (pending > sQueueHighWater)
+        sQueueHighWater = pending;
+}
+
 } // anonymous namespace
 
 // == Registration ====================================================
 
-bool RegisterMapBeginHandler(MapBeginHandler fn)
+bool RegisterMapBeginHandler(MapBeginHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sMapBeginHandlers,
-                           sNumMapBeginHandlers,
-                           kMaxMapBeginHandlers,
+                           EventKind::MapBegin,
                            "RegisterMapBeginHandler");
 }
 
-bool RegisterMapEndHandler(MapEndHandler fn)
+bool RegisterMapEndHandler(MapEndHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sMapEndHandlers,
-                           sNumMapEndHandlers,
-                           kMaxMapEndHandlers,
+                           EventKind::MapEnd,
                            "RegisterMapEndHandler");
 }
 
-bool RegisterTurnBeginHandler(TurnBeginHandler fn)
+bool RegisterTurnBeginHandler(TurnBeginHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sTurnBeginHandlers,
-                           sNumTurnBeginHandlers,
-                           kMaxTurnBeginHandlers,
+                           EventKind::TurnBegin,
                            "RegisterTurnBeginHandler");
 }
 
-bool RegisterTurnEndHandler(TurnEndHandler fn)
+bool RegisterTurnEndHandler(TurnEndHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sTurnEndHandlers,
-                           sNumTurnEndHandlers,
-                           kMaxTurnEndHandlers,
+                           EventKind::TurnEnd,
                            "RegisterTurnEndHandler");
 }
 
-bool RegisterKillHandler(KillHandler fn)
+bool RegisterKillHandler(KillHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sKillHandlers,
-                           sNumKillHandlers,
-                           kMaxKillHandlers,
+                           EventKind::Kill,
                            "RegisterKillHandler");
 }
 
-bool RegisterHpChangeHandler(HpChangeHandler fn)
+bool RegisterHpChangeHandler(HpChangeHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sHpChangeHandlers,
-                           sNumHpChangeHandlers,
-                           kMaxHpChangeHandlers,
+                           EventKind::HpChange,
                            "RegisterHpChangeHandler");
 }
 
-bool RegisterRngHandler(RngHandler fn)
+bool RegisterRngHandler(RngHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sRngHandlers,
-                           sNumRngHandlers,
-                           kMaxRngHandlers,
+                           EventKind::RngCall,
                            "RegisterRngHandler");
 }
 
-bool RegisterLevelUpHandler(LevelUpHandler fn)
+bool RegisterLevelUpHandler(LevelUpHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sLevelUpHandlers,
-                           sNumLevelUpHandlers,
-                           kMaxLevelUpHandlers,
+                           EventKind::LevelUp,
                            "RegisterLevelUpHandler");
 }
 
-bool RegisterSkillLearnHandler(SkillLearnHandler fn)
+bool RegisterSkillLearnHandler(SkillLearnHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sSkillLearnHandlers,
-                           sNumSkillLearnHandlers,
-                           kMaxSkillLearnHandlers,
+                           EventKind::SkillLearn,
                            "RegisterSkillLearnHandler");
 }
 
-bool RegisterItemGainHandler(ItemGainHandler fn)
+bool RegisterItemGainHandler(ItemGainHandler fn, std::uint32_t flags, const char *tag)
 {
-    return RegisterHandler(fn,
+    return RegisterHandler(fn, flags, tag,
                            sItemGainHandlers,
-                           sNumItemGainHandlers,
-                           kMaxItemGainHandlers,
+                           EventKind::ItemGain,
                            "RegisterItemGainHandler");
 }
 
+bool RegisterBattleBeginHandler(BattleBeginHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sBattleBeginHandlers,
+                           EventKind::BattleBegin,
+                           "RegisterBattleBeginHandler");
+}
+
+bool RegisterBattleEndHandler(BattleEndHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sBattleEndHandlers,
+                           EventKind::BattleEnd,
+                           "RegisterBattleEndHandler");
+}
+
+bool RegisterHpSyncHandler(HpSyncHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sHpSyncHandlers,
+                           EventKind::HpSync,
+                           "RegisterHpSyncHandler");
+}
+
+bool RegisterActionEndHandler(ActionEndHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sActionEndHandlers,
+                           EventKind::ActionEnd,
+                           "RegisterActionEndHandler");
+}
+
+bool RegisterUnitMoveHandler(UnitMoveHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sUnitMoveHandlers,
+                           EventKind::UnitMove,
+                           "RegisterUnitMoveHandler");
+}
+
+bool RegisterItemUseHandler(ItemUseHandler fn, std::uint32_t flags, const char *tag)
+{
+    return RegisterHandler(fn, flags, tag,
+                           sItemUseHandlers,
+                           EventKind::ItemUse,
+                           "RegisterItemUseHandler");
+}
+
 // == Dispatch ========================================================
 
+// Map/turn and battle begin/end events are safe points themselves:
+// flush anything queued first so handlers always see events in game
+// order.
+
 void DispatchMapBegin(const MapContext &ctx)
 {
-    DispatchHandlers(ctx, sMapBeginHandlers, sNumMapBeginHandlers);
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::MapBegin, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sMapBeginHandlers, EventKind::MapBegin);
 }
 
 void DispatchMapEnd(const MapContext &ctx)
 {
-    DispatchHandlers(ctx, sMapEndHandlers, sNumMapEndHandlers);
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::MapEnd, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sMapEndHandlers, EventKind::MapEnd);
 }
 
 void DispatchTurnBegin(const TurnContext &ctx)
 {
-    DispatchHandlers(ctx, sTurnBeginHandlers, sNumTurnBeginHandlers);
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::TurnBegin, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sTurnBeginHandlers, EventKind::TurnBegin);
 }
 
 void DispatchTurnEnd(const TurnContext &ctx)
 {
-    DispatchHandlers(ctx, sTurnEndHandlers, sNumTurnEndHandlers);
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::TurnEnd, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sTurnEndHandlers, EventKind::TurnEnd);
+}
+
+void DispatchBattleBegin(const BattleEventContext &ctx)
+{
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::BattleBegin, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sBattleBeginHandlers, EventKind::BattleBegin);
+}
+
+void DispatchBattleEnd(const BattleEventContext &ctx)
+{
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::BattleEnd, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sBattleEndHandlers, EventKind::BattleEnd);
+}
+
+// Engine::OnActionEnd has already drained the queue and closed the
+// battle; the drain here only matters for direct callers.
+void DispatchActionEnd(const ActionContext &ctx)
+{
+    DrainDeferredEvents();
+    DispatchStatic<EventKind::ActionEnd, ModulePass::All>(ctx);
+    DispatchHandlers(ctx, sActionEndHandlers, EventKind::ActionEnd);
 }
 
 void DispatchKill(const KillContext &ctx)
 {
-    DispatchHandlers(ctx, sKillHandlers, sNumKillHandlers);
+    if (!ShouldDefer<EventKind::Kill>(sKillHandlers))
+    {
+        DispatchStatic<EventKind::Kill, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sKillHandlers, EventKind::Kill);
+        return;
+    }
+
+    DispatchStatic<EventKind::Kill, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sKillHandlers, EventKind::Kill, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::Kill, ctx.turn);
+    ev.battle = ctx.battle;
+    ev.u.kill = ctx.core;
+    CommitDeferred();
 }
 
 void DispatchHpChange(const HpChangeContext &ctx)
 {
-    DispatchHandlers(ctx, sHpChangeHandlers, sNumHpChangeHandlers);
+    if (!ShouldDefer<EventKind::HpChange>(sHpChangeHandlers))
+    {
+        DispatchStatic<EventKind::HpChange, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sHpChangeHandlers, EventKind::HpChange);
+        return;
+    }
+
+    DispatchStatic<EventKind::HpChange, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sHpChangeHandlers, EventKind::HpChange, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::HpChange, ctx.turn);
+    PackHp(ev, ctx);
+    CommitDeferred();
+}
+
+void DispatchHpSync(const HpChangeContext &ctx)
+{
+    if (!ShouldDefer<EventKind::HpSync>(sHpSyncHandlers))
+    {
+        DispatchStatic<EventKind::HpSync, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sHpSyncHandlers, EventKind::HpSync);
+        return;
+    }
+
+    DispatchStatic<EventKind::HpSync, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sHpSyncHandlers, EventKind::HpSync, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::HpSync, ctx.turn);
+    PackHp(ev, ctx);
+    CommitDeferred();
 }
 
 void DispatchRngCall(const RngContext &ctx)
 {
-    DispatchHandlers(ctx, sRngHandlers, sNumRngHandlers);
+    if (!ShouldDefer<EventKind::RngCall>(sRngHandlers))
+    {
+        DispatchStatic<EventKind::RngCall, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sRngHandlers, EventKind::RngCall);
+        return;
+    }
+
+    DispatchStatic<EventKind::RngCall, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sRngHandlers, EventKind::RngCall, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::RngCall, ctx.turn);
+    ev.u.rng.state  = ctx.state;
+    ev.u.rng.raw    = ctx.raw;
+    ev.u.rng.bound  = ctx.bound;
+    ev.u.rng.result = ctx.result;
+    CommitDeferred();
 }
 
 void DispatchLevelUp(const LevelUpContext &ctx)
 {
-    DispatchHandlers(ctx, sLevelUpHandlers, sNumLevelUpHandlers);
+    if (!ShouldDefer<EventKind::LevelUp>(sLevelUpHandlers))
+    {
+        DispatchStatic<EventKind::LevelUp, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sLevelUpHandlers, EventKind::LevelUp);
+        return;
+    }
+
+    DispatchStatic<EventKind::LevelUp, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sLevelUpHandlers, EventKind::LevelUp, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::LevelUp, ctx.turn);
+    ev.u.levelUp.unit  = ctx.unit.Raw();
+    ev.u.levelUp.level = ctx.level;
+    CommitDeferred();
 }
 
 void DispatchSkillLearn(const SkillLearnContext &ctx)
 {
-    DispatchHandlers(ctx, sSkillLearnHandlers, sNumSkillLearnHandlers);
+    if (!ShouldDefer<EventKind::SkillLearn>(sSkillLearnHandlers))
+    {
+        DispatchStatic<EventKind::SkillLearn, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sSkillLearnHandlers, EventKind::SkillLearn);
+        return;
+    }
+
+    DispatchStatic<EventKind::SkillLearn, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sSkillLearnHandlers, EventKind::SkillLearn, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::SkillLearn, ctx.turn);
+    ev.u.skillLearn.unit    = ctx.unit.Raw();
+    ev.u.skillLearn.skillId = ctx.skillId;
+    ev.u.skillLearn.flags   = ctx.flags;
+    ev.u.skillLearn.result  = ctx.result;
+    CommitDeferred();
 }
 
 void DispatchItemGain(const ItemGainContext &ctx)
 {
-    DispatchHandlers(ctx, sItemGainHandlers, sNumItemGainHandlers);
+    if (!ShouldDefer<EventKind::ItemGain>(sItemGainHandlers))
+    {
+        DispatchStatic<EventKind::ItemGain, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sItemGainHandlers, EventKind::ItemGain);
+        return;
+    }
+
+    DispatchStatic<EventKind::ItemGain, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sItemGainHandlers, EventKind::ItemGain, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::ItemGain, ctx.turn);
+    ev.u.itemGain.seq       = ctx.seq;
+    ev.u.itemGain.unit      = ctx.unit.Raw();
+    ev.u.itemGain.itemArg   = ctx.itemArg;
+    ev.u.itemGain.modeOrCtx = ctx.modeOrCtx;
+    ev.u.itemGain.result    = ctx.result;
+    CommitDeferred();
+}
+
+void DispatchUnitMove(const ActionContext &ctx)
+{
+    if (!ShouldDefer<EventKind::UnitMove>(sUnitMoveHandlers))
+    {
+        DispatchStatic<EventKind::UnitMove, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sUnitMoveHandlers, EventKind::UnitMove);
+        return;
+    }
+
+    DispatchStatic<EventKind::UnitMove, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sUnitMoveHandlers, EventKind::UnitMove, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::UnitMove, ctx.turn);
+    PackAction(ev, ctx);
+    CommitDeferred();
+}
+
+void DispatchItemUse(const ActionContext &ctx)
+{
+    if (!ShouldDefer<EventKind::ItemUse>(sItemUseHandlers))
+    {
+        DispatchStatic<EventKind::ItemUse, ModulePass::All>(ctx);
+        DispatchHandlers(ctx, sItemUseHandlers, EventKind::ItemUse);
+        return;
+    }
+
+    DispatchStatic<EventKind::ItemUse, ModulePass::Sync>(ctx);
+    DispatchHandlers(ctx, sItemUseHandlers, EventKind::ItemUse, true);
+
+    DeferredEvent &ev = ReserveDeferred(EventKind::ItemUse, ctx.turn);
+    PackAction(ev, ctx);
+    CommitDeferred();
+}
+
+// == Deferred queue control ==========================================
+
+void DrainDeferredEvents()
+{
+    // Handlers never dispatch, but guard against re-entry from an
+    // overflow drain anyway.
+    if (sDraining)
+        return;
+
+    std::uint32_t tail = sQueueTail;
+    std::uint32_t head = sQueueHead;
+    if (tail == head)
+        return;
+
+    sDraining = true;
+    __sync_synchronize();
+
+    for (; tail != head; ++tail)
+        DeliverDeferred(sQueue[tail & kQueueMask]);
+
+    __sync_synchronize();
+    sQueueTail = tail;
+    sDraining  = false;
+}
+
+void SetDeferredDispatchEnabled(bool enabled)
+{
+    // Going back to synchronous delivery: flush first so nothing is
+    // delivered out of order.
+    if (!enabled)
+        DrainDeferredEvents();
+
+    sDeferredEnabled = enabled;
+    FATES_LOG(Info, Engine, "Engine::Bus: deferred dispatch %s", enabled ? "ENABLED" : "DISABLED");
+}
+
+bool IsDeferredDispatchEnabled()
+{
+    return sDeferredEnabled;
+}
+
+// == Handler accounting ==============================================
+
+void SetHandlerBudgetUs(const char *tag, std::uint32_t budgetUs)
+{
+    std::uint32_t ticks = budgetUs * kTicksPerUs;
+
+    if (tag == nullptr)
+        sDefaultBudgetUs = budgetUs;
+
+    int n = 0;
+    n += ApplyBudget(sMapBeginHandlers,   tag, ticks);
+    n += ApplyBudget(sMapEndHandlers,     tag, ticks);
+    n += ApplyBudget(sTurnBeginHandlers,  tag, ticks);
+    n += ApplyBudget(sTurnEndHandlers,    tag, ticks);
+    n += ApplyBudget(sKillHandlers,       tag, ticks);
+    n += ApplyBudget(sHpChangeHandlers,   tag, ticks);
+    n += ApplyBudget(sRngHandlers,        tag, ticks);
+    n += ApplyBudget(sLevelUpHandlers,    tag, ticks);
+    n += ApplyBudget(sSkillLearnHandlers, tag, ticks);
+    n += ApplyBudget(sItemGainHandlers,   tag, ticks);
+    n += ApplyBudget(sBattleBeginHandlers, tag, ticks);
+    n += ApplyBudget(sBattleEndHandlers,  tag, ticks);
+    n += ApplyBudget(sHpSyncHandlers,     tag, ticks);
+    n += ApplyBudget(sActionEndHandlers,  tag, ticks);
+    n += ApplyBudget(sUnitMoveHandlers,   tag, ticks);
+    n += ApplyBudget(sItemUseHandlers,    tag, ticks);
+
+    FATES_LOG(Info, Engine, "Engine::Bus: budget %uus applied to %d handler(s) (tag=%s)",
+                            static_cast<unsigned>(budgetUs), n, tag ? tag : "*");
+}
+
+void DumpHandlerStats()
+{
+    FATES_LOG(Info, Engine, "Engine::Bus: handler cost by event kind (ranked by total time)");
+#if FATES_STATIC_MODULES
+    BuiltinModuleList::ForEach([](const ModuleDef &m) {
+        FATES_LOG(Info, Engine, "  [static] %s (direct calls, not timed)", m.tag);
+    });
+#endif
+    DumpList(sMapBeginHandlers,   EventKind::MapBegin);
+    DumpList(sMapEndHandlers,     EventKind::MapEnd);
+    DumpList(sTurnBeginHandlers,  EventKind::TurnBegin);
+    DumpList(sTurnEndHandlers,    EventKind::TurnEnd);
+    DumpList(sKillHandlers,       EventKind::Kill);
+    DumpList(sHpChangeHandlers,   EventKind::HpChange);
+    DumpList(sRngHandlers,        EventKind::RngCall);
+    DumpList(sLevelUpHandlers,    EventKind::LevelUp);
+    DumpList(sSkillLearnHandlers, EventKind::SkillLearn);
+    DumpList(sItemGainHandlers,   EventKind::ItemGain);
+    DumpList(sBattleBeginHandlers, EventKind::BattleBegin);
+    DumpList(sBattleEndHandlers,  EventKind::BattleEnd);
+    DumpList(sHpSyncHandlers,     EventKind::HpSync);
+    DumpList(sActionEndHandlers,  EventKind::ActionEnd);
+    DumpList(sUnitMoveHandlers,   EventKind::UnitMove);
+    DumpList(sItemUseHandlers,    EventKind::ItemUse);
+}
+
+void GetDeferredQueueStats(DeferredQueueStats &out)
+{
+    out.capacity       = kQueueCapacity;
+    out.pending        = sQueueHead - sQueueTail;
+    out.highWater      = sQueueHighWater;
+    out.overflowDrains = sQueueOverflowDrains;
+    out.enqueued       = sQueueEnqueued;
 }
 
 } // namespace Engine
@@ -5,83 +5,265 @@
 //
 // Responsibilities:
 //   1) Build small, stable context snapshots (MapContext, TurnContext,
-//      KillContext, etc.) from core/runtime.hpp state.
-//   2) Emit structured debug logs (with caps where needed).
+//      KillContext, etc.) from core/runtime.hpp state. High-frequency
+//      events (RNG, HP, unit meta) only build a context when the bus
+//      has a subscriber for that kind; the context is filled in place
+//      and passed to every handler by reference.
+//   2) Emit structured debug logs, rate-limited per map through
+//      util/log_gate.hpp where needed.
 //   3) Dispatch the contexts into the lightweight event bus in
 //      engine/bus.cpp.
+//   4) Publish a RuntimeSnapshot (core/runtime.hpp) at map, turn,
+//      action and kill boundaries for readers on other threads.
+//   5) Append unit-level events and turn/action markers to the per-map
+//      journal (engine/journal.hpp) before dispatch, so handlers can
+//      query it including the current event.
+//   6) Decode one BattleContext per battle (OnBattleCalc) and keep it
+//      until action end, so HP and kill events inside the battle get
+//      their source / battle serial from the cache instead of game
+//      memory.
+//   7) Coalesce raw HP syncs into one net HpChange per unit per window
+//      (a battle, or outside one a sequence window); the raw deltas
+//      go out as HpSync for modules that want them.
+//   8) Re-index the units the hook carries over from the last map
+//      before OnMapBegin, in one pass (no HP baseline: each unit's
+//      first HP sync takes it from the battle clone).
 //
 // Later, separate engine subsystems (HP engine, skill engine,
 // roguelike engine, UI overlays, etc.) will register handlers
 // with the bus instead of touching hooks directly.
 
-#include <unordered_map>
-
 #include "engine/events.hpp"
+#include "engine/arena.hpp"
+#include "engine/budget.hpp"
 #include "engine/bus.hpp"
+#include "engine/journal.hpp"
+#include "engine/trace.hpp"
+#include "engine/rng_recorder.hpp"
+#include "engine/unit_index.hpp"
+#include "engine/unit_layout.hpp"
 #include "util/debug_log.hpp"
+#include "util/log_gate.hpp"
+#include "util/worker.hpp"
 
 namespace Fates {
 namespace Engine {
 
 // Small per-map HP tracker used to derive delta-based HP events
-// from raw UNIT_UpdateCloneHP sync calls.
-// Keys are raw Unit* pointers (identity-based). The map is cleared on
-// each Engine::OnMapBegin so HP deltas don't leak across maps.
+// from raw UNIT_UpdateCloneHP sync calls. Entries hang off the shared
+// unit index slot, so they vanish with the UnitIndex_Reset() in
+// Engine::OnMapBegin and HP deltas don't leak across maps.
+//
+// The same entry holds the unit's share of the HP coalescing window:
+// deltas are summed here and FlushHpChanges() emits one net HpChange
+// per unit, in the order the units first changed.
 
-struct HpTracker
+struct HpTrackEntry
 {
-    std::unordered_map<void*, int> lastHp;
+    int           lastHp;
+    int           damage;   // gross, this window
+    int           healing;  // gross, this window
+    std::uint16_t syncs;    // 0 = not in the window
+    void         *source;   // last non-null source this window
 };
 
-static HpTracker gHpTracker;
+static UnitSlotTable<HpTrackEntry> gHpTracker;
 
-// Helper: snapshot gMapState into a MapContext.
-static MapContext BuildMapContext()
+// Units with a pending window entry. A combat touches two units, an
+// AoE heal or a chain of enemy-phase syncs a handful; if it fills up
+// the window is flushed early.
+constexpr int kMaxHpPending = 16;
+
+static std::int16_t gHpPending[kMaxHpPending];
+static int          gHpPendingCount = 0;
+
+// Units carried over from the last map (OnUnitCarryOver -> OnMapBegin
+// -> GetCarriedUnits). kEngineBudget.prewarmUnits entries from the
+// Plugin arena, allocated on the first carry-over: they are recorded
+// before the Map arena is reset and read back after it.
+// 'gCarriedApplied' marks a list OnMapBegin already indexed, so the
+// next carry-over starts a new one.
+constexpr const char *kCarryOverArenaTag = "CarryOver";
+
+static UnitSummary *gCarried         = nullptr;
+static int          gCarriedCapacity = 0;
+static int          gCarriedCount    = 0;
+static bool         gCarriedApplied  = false;
+
+// The battle in progress. Decoded once in OnBattleCalc and only read
+// afterwards; closed by OnBattleEnd (action / turn / map end).
+struct BattleState
+{
+    BattleContext ctx;
+    bool          open;
+    int           attackerHpLost;
+    int           defenderHpLost;
+    std::uint32_t kills;
+    std::uint32_t lastSerial;  // battles started this map
+};
+
+static BattleState gBattle;
+
+// This turn's actions per command id (GetTurnActionTally). Cleared at
+// TurnBegin and MapBegin, logged at TurnEnd.
+static ActionTally gActionTally;
+
+// Count one action in 'row'; returns the new count for its command id.
+static std::uint32_t TallyAction(std::uint16_t *row, std::uint32_t cmdId)
+{
+    std::uint16_t &n = row[ActionTallySlot(cmdId)];
+    if (n != 0xFFFFu)
+        ++n;
+    ++gActionTally.total;
+    return n;
+}
+
+// Serial of the open battle, 0 between battles.
+static inline std::uint32_t CurrentBattleSerial()
+{
+    return gBattle.open ? gBattle.ctx.serial : 0u;
+}
+
+// The defender offset isn't mapped yet, so the first unit other than
+// the attacker to change HP becomes the defender.
+static void LearnDefender(void *target)
+{
+    BattleContext &bc = gBattle.ctx;
+    if (!bc.defender.IsValid() && target != bc.attacker.Raw())
+        bc.defender = UnitHandle(target);
+}
+
+// Per-battle HP totals.
+static void NoteBattleHp(void *target, int amount)
+{
+    LearnDefender(target);
+
+    const BattleContext &bc = gBattle.ctx;
+    if (target == bc.attacker.Raw())
+        gBattle.attackerHpLost += amount;
+    else if (target == bc.defender.Raw())
+        gBattle.defenderHpLost += amount;
+}
+
+// Helper: snapshot gMapState into an existing MapContext.
+static void FillMapContext(MapContext &ctx)
 {
-    MapContext ctx{};
     ctx.seqRoot     = gMapState.seqRoot;
     ctx.generation  = gMapState.generation;
     ctx.startSide   = gMapState.startSide;
     ctx.currentSide = gMapState.currentSide;
     ctx.totalTurns  = gMapState.totalTurns;
     ctx.killEvents  = gMapState.killEvents;
-    return ctx;
 }
 
-// Helper: build TurnContext using current map state + side.
-static TurnContext BuildTurnContext(TurnSide side)
+static MapContext BuildMapContext()
 {
-    TurnContext tc{};
-    tc.map  = BuildMapContext();
-    tc.side = side;
+    MapContext ctx{};
+    FillMapContext(ctx);
+    return ctx;
+}
 
-    // Side index 0..3 maps directly to gMapState.turnCount[]
+// Helper: how many turns 'side' has taken this map.
+// Side index 0..3 maps directly to gMapState.turnCount[].
+static std::uint32_t SideTurnIndex(TurnSide side)
+{
     int idx = static_cast<int>(side);
     if (0 <= idx && idx < 4)
-        tc.sideTurnIndex = gMapState.turnCount[idx];
-    else
-        tc.sideTurnIndex = 0;
+        return gMapState.turnCount[idx];
+    return 0;
+}
 
+// Helper: fill a TurnContext (including its embedded map snapshot)
+// in place, so callers don't build the map snapshot twice.
+static void FillTurnContext(TurnContext &tc, TurnSide side)
+{
+    FillMapContext(tc.map);
+    tc.side          = side;
+    tc.sideTurnIndex = SideTurnIndex(side);
+}
+
+static TurnContext BuildTurnContext(TurnSide side)
+{
+    TurnContext tc{};
+    FillTurnContext(tc, side);
     return tc;
 }
 
+static void FillBattleEventContext(BattleEventContext &ctx, TurnSide side)
+{
+    FillTurnContext(ctx.turn, side);
+    ctx.map            = ctx.turn.map;
+    ctx.battle         = gBattle.ctx;
+    ctx.attackerHpLost = gBattle.attackerHpLost;
+    ctx.defenderHpLost = gBattle.defenderHpLost;
+    ctx.kills          = gBattle.kills;
+}
+
 void OnMapBegin(void *seqRoot, TurnSide side)
 {
-    // New map: clear the per-map HP tracker so no mixing deltas
-    // across different battles.
-    gHpTracker.lastHp.clear();
-	
+    // Anything still queued belongs to the previous map; deliver it
+    // while the unit index still describes that map.
+    FlushHpChanges();
+    DrainDeferredEvents();
+
+    // New map: reset the shared unit index (and with it the HP tracker
+    // and every module's per-unit slots) so no mixing deltas across
+    // different battles.
+    UnitIndex_Reset();
+    Journal_Reset();
+
+    // Per-map module tables are re-allocated by their MapBegin handlers.
+    Arena_ResetMap();
+
+    // Re-index the carried-over units in one pass. No HP baseline: a
+    // pointer is only known to be a live unit once the game syncs it on
+    // this map, and the HP read at map start predates the game's own
+    // between-map restore. The first sync takes its baseline from the
+    // clone instead (OnUnitHpSync).
+    if (gCarriedApplied)
+        gCarriedCount = 0;  // nothing carried over since the last map
+
+    for (int i = 0; i < gCarriedCount; ++i)
+    {
+        UnitSummary &u = gCarried[i];
+        u.slot = static_cast<std::int16_t>(UnitIndex_Acquire(u.unit));
+    }
+    gCarriedApplied = true;
+
+    // Battle serials restart per map. Any battle still open belonged
+    // to the previous map (OnMapEnd normally closes it).
+    gBattle.open       = false;
+    gBattle.lastSerial = 0;
+
+    // Every log gate gets a fresh burst for the new map.
+    LogGate_ResetAll();
+    gActionTally = ActionTally{};
+
 	// NOTE: Hook_SEQ_MapStart calls MapLife_OnNewMap() *before* this,
     // so BuildMapContext() already sees the new generation and reset
     // per-map counters.
     MapContext mc = BuildMapContext();
 
-    Logf("Engine::OnMapBegin: seq=%p gen=%u start=%s current=%s totalTurns=%u",
-         seqRoot,
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(mc.startSide),
-         TurnSideToString(mc.currentSide),
-         static_cast<unsigned>(mc.totalTurns));
+    FATES_LOG(Info, Engine, "Engine::OnMapBegin: seq=%p gen=%u start=%s current=%s totalTurns=%u",
+                            seqRoot,
+                            static_cast<unsigned>(mc.generation),
+                            TurnSideToString(mc.startSide),
+                            TurnSideToString(mc.currentSide),
+                            static_cast<unsigned>(mc.totalTurns));
+
+    if (gCarriedCount > 0)
+    {
+        FATES_LOG(Info, Engine, "Engine::OnMapBegin: carried over %d unit(s) from the last map, index=%d",
+                                gCarriedCount, UnitIndex_Count());
+    }
+
+    Trace_Record(EventKind::MapBegin, side,
+                 TraceArg(seqRoot),
+                 mc.totalTurns,
+                 mc.killEvents,
+                 static_cast<std::uint32_t>(mc.startSide));
+    RngRec_Mark(RngMarker::MapBegin, side, mc.generation);
+    PublishRuntimeSnapshot();
 
     // For now, ignore the 'side' parameter (it should match mc.startSide).
     (void)side;
@@ -90,72 +272,347 @@ void OnMapBegin(void *seqRoot, TurnSide side)
     DispatchMapBegin(mc);
 }
 
+void OnUnitCarryOver(void *unit, int hp, int level, int sideRaw)
+{
+    if (unit == nullptr)
+        return;
+
+    if (gCarried == nullptr && gCarriedCapacity == 0)
+    {
+        gCarried         = Arena_AllocArray<UnitSummary>(ArenaId::Plugin, kCarryOverArenaTag,
+                                                        kEngineBudget.prewarmUnits);
+        gCarriedCapacity = gCarried ? kEngineBudget.prewarmUnits : -1;
+    }
+
+    // First unit of a new carry-over: the previous map's is done.
+    if (gCarriedApplied)
+    {
+        gCarriedCount   = 0;
+        gCarriedApplied = false;
+    }
+
+    Trace_Record(EventKind::UnitPrewarm, TurnSide::Unknown,
+                 TraceArg(unit),
+                 static_cast<std::uint32_t>(hp),
+                 static_cast<std::uint32_t>(level),
+                 static_cast<std::uint32_t>(sideRaw));
+
+    if (gCarriedCount >= gCarriedCapacity)
+    {
+        Arena_NoteDrop(kCarryOverArenaTag);
+        return;
+    }
+
+    UnitSummary &u = gCarried[gCarriedCount++];
+    u.unit    = unit;
+    u.slot    = static_cast<std::int16_t>(kInvalidUnitSlot);
+    u.hp      = static_cast<std::int16_t>(hp);
+    u.maxHp   = -1;
+    u.level   = static_cast<std::uint8_t>(level > 0 ? level : 0);
+    u.sideRaw = static_cast<std::int8_t>(sideRaw);
+}
+
+int GetCarriedUnits(const UnitSummary **out)
+{
+    const int n = gCarriedApplied ? gCarriedCount : 0;
+    if (out != nullptr)
+        *out = gCarried;
+    return n;
+}
+
+// Map-end sink flushes, run as worker jobs (util/worker.hpp).
+static void JobLogFlush(void *)     { Log_Flush(); }
+static void JobTraceFlush(void *)   { Trace_Flush(); }
+static void JobRngRecFlush(void *)  { RngRec_Flush(); }
+
 void OnMapEnd(void *seqRoot, TurnSide side)
 {
+    OnBattleEnd(side);
+    FlushHpChanges();
+
     MapContext mc = BuildMapContext();
 
-    Logf("Engine::OnMapEnd: seq=%p gen=%u side=%s totalTurns=%u kills=%u",
-         seqRoot,
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(mc.totalTurns),
-         static_cast<unsigned>(mc.killEvents));
+    FATES_LOG(Info, Engine, "Engine::OnMapEnd: seq=%p gen=%u side=%s totalTurns=%u kills=%u",
+                            seqRoot,
+                            static_cast<unsigned>(mc.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(mc.totalTurns),
+                            static_cast<unsigned>(mc.killEvents));
+
+    Trace_Record(EventKind::MapEnd, side,
+                 TraceArg(seqRoot),
+                 mc.totalTurns,
+                 mc.killEvents,
+                 static_cast<std::uint32_t>(mc.startSide));
+    RngRec_Mark(RngMarker::MapEnd, side, mc.totalTurns);
+    PublishRuntimeSnapshot();
 
     DispatchMapEnd(mc);
+
+    DeferredQueueStats qs{};
+    GetDeferredQueueStats(qs);
+    FATES_LOG(Info, Engine, "Engine::OnMapEnd: deferred queue highWater=%u/%u overflowDrains=%u enqueued=%u",
+                            static_cast<unsigned>(qs.highWater),
+                            static_cast<unsigned>(qs.capacity),
+                            static_cast<unsigned>(qs.overflowDrains),
+                            static_cast<unsigned>(qs.enqueued));
+    DumpHandlerStats();
+    Journal_ReportMapEnd();
+    Arena_ReportMapEnd();
+    LogGate_ReportDrops();
+
+    // Map summaries were just logged by the modules; have the worker
+    // push them to SD now rather than at the next periodic pump. Never
+    // inline: without a worker the DebugThread pump picks them up.
+    if (Worker_IsRunning())
+    {
+        Worker_Post(&JobLogFlush, nullptr, "Log_Flush");
+        Worker_Post(&JobTraceFlush, nullptr, "Trace_Flush");
+        Worker_Post(&JobRngRecFlush, nullptr, "RngRec_Flush");
+    }
 }
 
 void OnTurnBegin(TurnSide side)
 {
     TurnContext tc = BuildTurnContext(side);
 
-    Logf("Engine::OnTurnBegin: gen=%u side=%s sideTurn=%u totalTurns=%u",
-         static_cast<unsigned>(tc.map.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(tc.map.totalTurns));
+    FATES_LOG(Info, Engine, "Engine::OnTurnBegin: gen=%u side=%s sideTurn=%u totalTurns=%u",
+                            static_cast<unsigned>(tc.map.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(tc.sideTurnIndex),
+                            static_cast<unsigned>(tc.map.totalTurns));
+
+    Trace_Record(EventKind::TurnBegin, side,
+                 tc.sideTurnIndex,
+                 tc.map.totalTurns);
+    RngRec_Mark(RngMarker::TurnBegin, side, tc.sideTurnIndex);
+    Journal_Record(EventKind::TurnBegin, side, nullptr, nullptr,
+                   static_cast<std::int32_t>(tc.sideTurnIndex));
+    PublishRuntimeSnapshot();
+    gActionTally = ActionTally{};
 
     DispatchTurnBegin(tc);
 }
 
 void OnTurnEnd(TurnSide side, void *seqMaybe)
 {
+    OnBattleEnd(side);
+    FlushHpChanges();
+
     TurnContext tc = BuildTurnContext(side);
 
-    Logf("Engine::OnTurnEnd: seq=%p gen=%u side=%s sideTurn=%u totalTurns=%u",
-         seqMaybe,
-         static_cast<unsigned>(tc.map.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(tc.map.totalTurns));
+    FATES_LOG(Info, Engine, "Engine::OnTurnEnd: seq=%p gen=%u side=%s sideTurn=%u totalTurns=%u",
+                            seqMaybe,
+                            static_cast<unsigned>(tc.map.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(tc.sideTurnIndex),
+                            static_cast<unsigned>(tc.map.totalTurns));
+
+    Trace_Record(EventKind::TurnEnd, side,
+                 tc.sideTurnIndex,
+                 tc.map.totalTurns,
+                 TraceArg(seqMaybe));
+    RngRec_Mark(RngMarker::TurnEnd, side, tc.sideTurnIndex);
+    Journal_Record(EventKind::TurnEnd, side, nullptr, nullptr,
+                   static_cast<std::int32_t>(tc.sideTurnIndex));
+    PublishRuntimeSnapshot();
+
+    if (FATES_LOG_ON(Debug, Engine) && gActionTally.total != 0)
+    {
+        for (int cmd = 0; cmd < kActionTallyCmds; ++cmd)
+        {
+            const unsigned ends  = gActionTally.actionEnd[cmd];
+            const unsigned moves = gActionTally.unitMove[cmd];
+            const unsigned items = gActionTally.itemUse[cmd];
+            if (ends + moves + items == 0)
+                continue;
+            FATES_LOG(Debug, Engine, "  actions cmd=%s%u: end=%u move=%u item=%u",
+                                     cmd == kActionTallyCmds - 1 ? ">=" : "",
+                                     static_cast<unsigned>(cmd), ends, moves, items);
+        }
+    }
 
     DispatchTurnEnd(tc);
 }
 
 void OnKill(const KillEvent &ev, TurnSide side)
 {
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    // Kill listeners should see the HP change that caused it first.
+    FlushHpChanges();
 
     KillContext kc{};
     kc.core = ev;
-    kc.map  = mc;
-    kc.turn = tc;
-
-    Logf("Engine::OnKill: seq=%p flags=0x%08X dead0=%p dead1=%p "
-         "gen=%u side=%s totalTurns=%u mapKills=%u sideTurn=%u",
-         ev.seq,
-         ev.flags,
-         ev.dead0,
-         ev.dead1,
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(mc.totalTurns),
-         static_cast<unsigned>(mc.killEvents),
-         static_cast<unsigned>(tc.sideTurnIndex));
+    FillTurnContext(kc.turn, side);
+    kc.map    = kc.turn.map;
+    kc.battle = CurrentBattleSerial();
+
+    // Inside a battle the killer is the dead unit's opponent.
+    void *killer0 = nullptr;
+    void *killer1 = nullptr;
+    if (gBattle.open)
+    {
+        killer0 = gBattle.ctx.OpponentOf(ev.dead0).Raw();
+        killer1 = gBattle.ctx.OpponentOf(ev.dead1).Raw();
+        ++gBattle.kills;
+    }
+
+    const MapContext  &mc = kc.map;
+    const TurnContext &tc = kc.turn;
+
+    FATES_LOG(Info, Engine, "Engine::OnKill: seq=%p flags=0x%08X dead0=%p dead1=%p "
+                            "gen=%u side=%s totalTurns=%u mapKills=%u sideTurn=%u",
+                            ev.seq,
+                            ev.flags,
+                            ev.dead0,
+                            ev.dead1,
+                            static_cast<unsigned>(mc.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(mc.totalTurns),
+                            static_cast<unsigned>(mc.killEvents),
+                            static_cast<unsigned>(tc.sideTurnIndex));
+
+    Trace_Record(EventKind::Kill, side,
+                 TraceArg(ev.seq),
+                 TraceArg(ev.dead0),
+                 TraceArg(ev.dead1),
+                 ev.flags);
+    Journal_Record(EventKind::Kill, side, ev.dead0, killer0,
+                   static_cast<std::int32_t>(ev.flags));
+    if (ev.dead1 != nullptr && ev.dead1 != ev.dead0)
+        Journal_Record(EventKind::Kill, side, ev.dead1, killer1,
+                       static_cast<std::int32_t>(ev.flags));
+    PublishRuntimeSnapshot();
 
     DispatchKill(kc);
 }
 
+// ---------------------------------------------------------------------
+// Battle begin / end
+// ---------------------------------------------------------------------
+
+void OnBattleCalc(void *calc, TurnSide side)
+{
+    if (calc == nullptr)
+        return;
+
+    // Every strike of a battle goes through BTL_FinalDamage_Pre with
+    // the same calculator / root: only the first one decodes.
+    void *root = BattleCalc_GetRoot(calc);
+    if (gBattle.open && calc == gBattle.ctx.calc && root == gBattle.ctx.root)
+        return;
+
+    BattleContext bc;
+    bc.calc = calc;
+    bc.root = root;
+    if (root != nullptr)
+    {
+        bc.attacker = UnitHandle(BattleRoot_GetMainUnit(root));
+        bc.defender = UnitHandle(BattleRoot_GetTargetUnit(root));
+        bc.flags    = BattleRoot_GetFlags(root);
+    }
+
+    OnBattleBegin(bc, side);
+}
+
+void OnBattleBegin(const BattleContext &battle, TurnSide side)
+{
+    if (gBattle.open)
+        OnBattleEnd(side);
+
+    // Syncs from before the battle are their own window.
+    FlushHpChanges();
+
+    gBattle.ctx            = battle;
+    gBattle.ctx.serial     = ++gBattle.lastSerial;
+    gBattle.open           = true;
+    gBattle.attackerHpLost = 0;
+    gBattle.defenderHpLost = 0;
+    gBattle.kills          = 0;
+
+    const BattleContext &bc = gBattle.ctx;
+
+    static LogGate sLogGate("Engine::OnBattleBegin", 32);
+    if (FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnBattleBegin: #%u calc=%p root=%p atk=%p def=%p flags=%08X "
+                                 "gen=%u side=%s totalTurns=%u (n=%u)",
+                                 static_cast<unsigned>(bc.serial),
+                                 bc.calc,
+                                 bc.root,
+                                 bc.attacker.Raw(),
+                                 bc.defender.Raw(),
+                                 static_cast<unsigned>(bc.flags),
+                                 static_cast<unsigned>(gMapState.generation),
+                                 TurnSideToString(side),
+                                 static_cast<unsigned>(gMapState.totalTurns),
+                                 LogGate_Count(sLogGate));
+    }
+
+    Trace_Record(EventKind::BattleBegin, side,
+                 TraceArg(bc.calc),
+                 TraceArg(bc.root),
+                 TraceArg(bc.attacker.Raw()),
+                 TraceArg(bc.defender.Raw()));
+    RngRec_Mark(RngMarker::BattleBegin, side, bc.serial);
+
+    if (!HasSubscribers(EventKind::BattleBegin))
+        return;
+
+    BattleEventContext ctx{};
+    FillBattleEventContext(ctx, side);
+    DispatchBattleBegin(ctx);
+}
+
+void OnBattleEnd(TurnSide side)
+{
+    if (!gBattle.open)
+        return;
+
+    // The battle's net HP changes, while it is still current.
+    FlushHpChanges();
+
+    const BattleContext &bc = gBattle.ctx;
+
+    static LogGate sLogGate("Engine::OnBattleEnd", 32);
+    if (FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnBattleEnd: #%u atk=%p (lost %d) def=%p (lost %d) kills=%u (n=%u)",
+                                 static_cast<unsigned>(bc.serial),
+                                 bc.attacker.Raw(),
+                                 gBattle.attackerHpLost,
+                                 bc.defender.Raw(),
+                                 gBattle.defenderHpLost,
+                                 static_cast<unsigned>(gBattle.kills),
+                                 LogGate_Count(sLogGate));
+    }
+
+    Trace_Record(EventKind::BattleEnd, side,
+                 TraceArg(bc.attacker.Raw()),
+                 TraceArg(bc.defender.Raw()),
+                 (static_cast<std::uint32_t>(gBattle.attackerHpLost) & 0xFFFFu) |
+                     (static_cast<std::uint32_t>(gBattle.defenderHpLost) << 16),
+                 gBattle.kills);
+    RngRec_Mark(RngMarker::BattleEnd, side, bc.serial);
+    Journal_Record(EventKind::BattleEnd, side, bc.attacker.Raw(), bc.defender.Raw(),
+                   static_cast<std::int32_t>(bc.serial));
+
+    // Handlers (and the deferred drain in DispatchBattleEnd) still see
+    // the battle as current.
+    if (HasSubscribers(EventKind::BattleEnd))
+    {
+        BattleEventContext ctx{};
+        FillBattleEventContext(ctx, side);
+        DispatchBattleEnd(ctx);
+    }
+
+    gBattle.open = false;
+}
+
+const BattleContext *GetCurrentBattle()
+{
+    return gBattle.open ? &gBattle.ctx : nullptr;
+}
+
 // ---------------------------------------------------------------------
 // RNG + unit meta events
 // ---------------------------------------------------------------------
@@ -165,159 +622,287 @@ void OnRngCall(void *state,
                std::uint32_t bound,
                std::uint32_t result)
 {
-    MapContext  mc = BuildMapContext();
-    TurnContext tc = BuildTurnContext(mc.currentSide);
+    // Hottest entrypoint (every SYS_Rng32 call): read the few fields
+    // logging and tracing need straight from gMapState, and only build
+    // a full RngContext if somebody is subscribed.
+    TurnSide side = gMapState.currentSide;
+
+    // Rate-limit logging so performance does not die.
+    static LogGate sLogGate("Engine::OnRngCall", 64);
+    if (FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnRngCall: state=%p raw=%08X bound=%u -> %u "
+                                 "gen=%u side=%s sideTurn=%u totalTurns=%u (n=%u)",
+                                 state,
+                                 raw,
+                                 static_cast<unsigned>(bound),
+                                 static_cast<unsigned>(result),
+                                 static_cast<unsigned>(gMapState.generation),
+                                 TurnSideToString(side),
+                                 static_cast<unsigned>(SideTurnIndex(side)),
+                                 static_cast<unsigned>(gMapState.totalTurns),
+                                 LogGate_Count(sLogGate));
+    }
+
+    Trace_Record(EventKind::RngCall, side,
+                 TraceArg(state), raw, bound, result);
+    RngRec_Call(state, raw, bound);
+
+    if (!HasSubscribers(EventKind::RngCall))
+        return;
 
     RngContext rc{};
-    rc.map    = mc;
-    rc.turn   = tc;
+    FillTurnContext(rc.turn, side);
+    rc.map    = rc.turn.map;
     rc.state  = state;
     rc.raw    = raw;
     rc.bound  = bound;
     rc.result = result;
 
-    // Cap logging so performance does not die.
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    DispatchRngCall(rc);
+}
+
+// Shared tail of every HpChange (direct, or flushed from the window):
+// trace, journal, per-battle totals, dispatch.
+static void EmitHpChange(void *sourceUnit,
+                         void *targetUnit,
+                         int  amount,
+                         std::uint32_t flags,
+                         void *context,
+                         TurnSide side,
+                         int damage,
+                         int healing,
+                         std::uint32_t syncs)
+{
+    // Lightweight, rate-limited log
+    static LogGate sLogGate("Engine::OnHpChange", 128);
+    if (gHpApplyLogEnabled && FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
     {
-        Logf("Engine::OnRngCall: state=%p raw=%08X bound=%u -> %u "
-             "gen=%u side=%s sideTurn=%u totalTurns=%u (n=%d)",
-             state,
-             raw,
-             static_cast<unsigned>(bound),
-             static_cast<unsigned>(result),
-             static_cast<unsigned>(mc.generation),
-             TurnSideToString(tc.side),
-             static_cast<unsigned>(tc.sideTurnIndex),
-             static_cast<unsigned>(mc.totalTurns),
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Engine, "Engine::OnHpChange: src=%p tgt=%p amt=%d (dmg=%d heal=%d syncs=%u) flags=0x%08X "
+                                 "gen=%u side=%s sideTurn=%u totalTurns=%u",
+                                 sourceUnit,
+                                 targetUnit,
+                                 amount,
+                                 damage,
+                                 healing,
+                                 static_cast<unsigned>(syncs),
+                                 static_cast<unsigned>(flags),
+                                 static_cast<unsigned>(gMapState.generation),
+                                 TurnSideToString(side),
+                                 static_cast<unsigned>(SideTurnIndex(side)),
+                                 static_cast<unsigned>(gMapState.totalTurns));
     }
 
-    // Fan out to any RNG listeners (likely none for now).
-    DispatchRngCall(rc);
+    Trace_Record(EventKind::HpChange, side,
+                 TraceArg(sourceUnit),
+                 TraceArg(targetUnit),
+                 static_cast<std::uint32_t>(amount),
+                 flags);
+    Journal_Record(EventKind::HpChange, side, targetUnit, sourceUnit, amount);
+
+    if (gBattle.open)
+        NoteBattleHp(targetUnit, amount);
+
+    if (!HasSubscribers(EventKind::HpChange))
+        return;
+
+    // Fill the local HP event and map/turn snapshots in place.
+    HpChangeContext hc{};
+    hc.core.source  = UnitHandle(sourceUnit);
+    hc.core.target  = UnitHandle(targetUnit);
+    hc.core.amount  = amount;   // >0 damage, <0 heal
+    hc.core.flags   = flags;    // cause bits (battle, terrain, poison, skill, etc.)
+    hc.core.context = context;  // e.g. seq pointer, battle root, or other proc
+    FillTurnContext(hc.turn, side);
+    hc.map     = hc.turn.map;
+    hc.battle  = CurrentBattleSerial();
+    hc.damage  = damage;
+    hc.healing = healing;
+    hc.syncs   = syncs;
+
+    DispatchHpChange(hc);
+}
+
+static inline TurnSide HpSide()
+{
+    return gMapState.mapActive ? gCurrentTurnSide : TurnSide::Unknown;
 }
 
 // Canonical HP sync driver. Called from Hook_UNIT_UpdateCloneHP
 // after the game's own logic has written the unit's HP. Track
-// the last seen HP per unit and emit an HpChange event when 
-// detect a delta.
+// the last seen HP per unit; on a delta, publish the raw HpSync event
+// and fold the delta into the unit's coalescing window.
 //
 // Convention: amount > 0 = damage taken, amount < 0 = healing received.
-void OnUnitHpSync(void *unit, int newHp)
+void OnUnitHpSync(void *unit, int newHp, int prevHp)
 {
     if (unit == nullptr)
         return;
 
-    auto &map = gHpTracker.lastHp;
+    int slot = UnitIndex_Acquire(unit);
 
-    int prev = -1;
-    auto it = map.find(unit);
-    if (it != map.end())
-        prev = it->second;
+    // The tracked HP if this map has seen the unit, else the caller's
+    // pre-sync HP, so the first damage a unit takes isn't lost.
+    int prev = prevHp;
+    if (const HpTrackEntry *seen = gHpTracker.Peek(slot))
+        prev = seen->lastHp;
 
     // Update the stored HP for this unit.
-    map[unit] = newHp;
+    HpTrackEntry *e = gHpTracker.Get(slot);
+    if (e == nullptr)
+        return;  // unit index full
+    e->lastHp = newHp;
 
-    // First time unit has been seen, or no change? Don't emit anything.
+    // No baseline at all, or no change? Don't emit anything.
     if (prev < 0 || prev == newHp)
         return;
 
     int delta = prev - newHp;  // >0 damage, <0 heal
 
-    // OPTIONAL: extra diagnostics, capped, and gated behind HP debug toggle.
-    static int sHpSyncLogCount = 0;
-    if (gHpApplyLogEnabled && sHpSyncLogCount < 64)
+    // OPTIONAL: extra diagnostics, rate-limited, and gated behind HP debug toggle.
+    static LogGate sHpSyncLogGate("Engine::OnUnitHpSync", 64);
+    if (gHpApplyLogEnabled && FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sHpSyncLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnUnitHpSync: unit=%p prev=%d new=%d delta=%d mapActive=%d",
+                                 unit,
+                                 prev,
+                                 newHp,
+                                 delta,
+                                 gMapState.mapActive ? 1 : 0);
+    }
+
+    TurnSide side = HpSide();
+
+    // Inside a battle the source is the target's opponent, straight
+    // from the cached BattleContext.
+    void *source = nullptr;
+    if (gBattle.open)
+    {
+        LearnDefender(unit);
+        source = gBattle.ctx.OpponentOf(unit).Raw();
+    }
+
+    Trace_Record(EventKind::HpSync, side,
+                 TraceArg(unit),
+                 TraceArg(source),
+                 static_cast<std::uint32_t>(prev),
+                 static_cast<std::uint32_t>(newHp));
+
+    if (HasSubscribers(EventKind::HpSync))
     {
-        Logf("Engine::OnUnitHpSync: unit=%p prev=%d new=%d delta=%d mapActive=%d",
-             unit,
-             prev,
-             newHp,
-             delta,
-             gMapState.mapActive ? 1 : 0);
-        ++sHpSyncLogCount;
+        HpChangeContext hc{};
+        hc.core.source  = UnitHandle(source);
+        hc.core.target  = UnitHandle(unit);
+        hc.core.amount  = delta;
+        hc.core.context = gBattle.open ? gBattle.ctx.root : nullptr;
+        FillTurnContext(hc.turn, side);
+        hc.map     = hc.turn.map;
+        hc.battle  = CurrentBattleSerial();
+        hc.damage  = delta > 0 ? delta : 0;
+        hc.healing = delta < 0 ? -delta : 0;
+        hc.syncs   = 1;
+        DispatchHpSync(hc);
     }
 
-    TurnSide side =
-        gMapState.mapActive ? gCurrentTurnSide : TurnSide::Unknown;
+    // Coalescing window.
+    if (e->syncs == 0)
+    {
+        if (gHpPendingCount >= kMaxHpPending)
+            FlushHpChanges();
+        gHpPending[gHpPendingCount++] = static_cast<std::int16_t>(slot);
+    }
 
-    OnHpChange(
-        /*sourceUnit=*/nullptr,
-        /*targetUnit=*/unit,
-        /*amount=*/delta,
-        /*flags=*/0u,
-        /*context=*/nullptr,
-        /*side=*/side);
+    if (delta > 0)
+        e->damage += delta;
+    else
+        e->healing -= delta;
+    if (source != nullptr)
+        e->source = source;
+    ++e->syncs;
 }
 
-void OnHpChange(void *sourceUnit,
-                void *targetUnit,
-                int  amount,
-                std::uint32_t flags,
-                void *context,
-                TurnSide side)
+void FlushHpChanges()
 {
-    // Build the usual map/turn snapshots.
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    if (gHpPendingCount == 0)
+        return;
 
-    // Fill the local HP event.
-    HpEvent ev{};
-    ev.source  = UnitHandle(sourceUnit);
-    ev.target  = UnitHandle(targetUnit);
-    ev.amount  = amount;   // >0 damage, <0 heal
-    ev.flags   = flags;    // cause bits (battle, terrain, poison, skill, etc.)
-    ev.context = context;  // e.g. seq pointer, battle root, or other proc
+    const TurnSide side    = HpSide();
+    void          *context = gBattle.open ? gBattle.ctx.root : nullptr;
 
-    // Wrap into a full context for the bus.
-    HpChangeContext hc{};
-    hc.core = ev;
-    hc.map  = mc;
-    hc.turn = tc;
+    // Emitting never adds to the window, so the list is stable here.
+    const int count = gHpPendingCount;
+    gHpPendingCount = 0;
 
-    // Lightweight log with a cap 
-    static int sLogCount = 0;
-    if (gHpApplyLogEnabled && sLogCount < 128)
+    for (int i = 0; i < count; ++i)
     {
-        Logf("Engine::OnHpChange: src=%p tgt=%p amt=%d flags=0x%08X "
-             "gen=%u side=%s sideTurn=%u totalTurns=%u",
-             ev.source.Raw(),
-             ev.target.Raw(),
-             amount,
-             static_cast<unsigned>(flags),
-             static_cast<unsigned>(mc.generation),
-             TurnSideToString(side),
-             static_cast<unsigned>(tc.sideTurnIndex),
-             static_cast<unsigned>(mc.totalTurns));
-        ++sLogCount;
+        const int slot = gHpPending[i];
+        HpTrackEntry *e = gHpTracker.Get(slot);
+        if (e == nullptr || e->syncs == 0)
+            continue;
+
+        const int           damage  = e->damage;
+        const int           healing = e->healing;
+        const std::uint32_t syncs   = e->syncs;
+        void               *source  = e->source;
+
+        e->damage  = 0;
+        e->healing = 0;
+        e->syncs   = 0;
+        e->source  = nullptr;
+
+        // Damage and healing that cancel out still produce an event:
+        // listeners get the breakdown even when the net is zero.
+        EmitHpChange(source, UnitIndex_GetUnit(slot), damage - healing,
+                     kHpFlag_Coalesced, context, side, damage, healing, syncs);
     }
+}
 
-    // Fan out to future HP listeners.
-    DispatchHpChange(hc);
+void OnHpSequenceBoundary()
+{
+    if (!gBattle.open)
+        FlushHpChanges();
+}
+
+void OnHpChange(void *sourceUnit,
+                void *targetUnit,
+                int  amount,
+                std::uint32_t flags,
+                void *context,
+                TurnSide side)
+{
+    EmitHpChange(sourceUnit, targetUnit, amount, flags, context, side,
+                 amount > 0 ? amount : 0,
+                 amount < 0 ? -amount : 0,
+                 1u);
 }
 
 void OnUnitLevelUp(void *unit,
                    std::uint8_t level,
                    TurnSide side)
 {
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    FATES_LOG(Info, Engine, "Engine::OnUnitLevelUp: unit=%p level=%u "
+                            "gen=%u side=%s sideTurn=%u totalTurns=%u",
+                            unit,
+                            static_cast<unsigned>(level),
+                            static_cast<unsigned>(gMapState.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(SideTurnIndex(side)),
+                            static_cast<unsigned>(gMapState.totalTurns));
+
+    Trace_Record(EventKind::LevelUp, side,
+                 TraceArg(unit),
+                 level);
+    Journal_Record(EventKind::LevelUp, side, unit, nullptr, level);
+
+    if (!HasSubscribers(EventKind::LevelUp))
+        return;
 
     LevelUpContext ctx{};
-    ctx.map   = mc;
-    ctx.turn  = tc;
+    FillTurnContext(ctx.turn, side);
+    ctx.map   = ctx.turn.map;
     ctx.unit  = UnitHandle(unit);
     ctx.level = level;
 
-    Logf("Engine::OnUnitLevelUp: unit=%p level=%u "
-         "gen=%u side=%s sideTurn=%u totalTurns=%u",
-         ctx.unit.Raw(),
-         static_cast<unsigned>(level),
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(tc.map.totalTurns));
-
     DispatchLevelUp(ctx);
 }
 
@@ -327,28 +912,35 @@ void OnUnitSkillLearn(void *unit,
                       int result,
                       TurnSide side)
 {
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    FATES_LOG(Info, Engine, "Engine::OnUnitSkillLearn: unit=%p skill=0x%04X flags=0x%04X result=%d "
+                            "gen=%u side=%s sideTurn=%u totalTurns=%u",
+                            unit,
+                            static_cast<unsigned>(skillId),
+                            static_cast<unsigned>(flags),
+                            result,
+                            static_cast<unsigned>(gMapState.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(SideTurnIndex(side)),
+                            static_cast<unsigned>(gMapState.totalTurns));
+
+    Trace_Record(EventKind::SkillLearn, side,
+                 TraceArg(unit),
+                 static_cast<std::uint32_t>(skillId) |
+                     (static_cast<std::uint32_t>(flags) << 16),
+                 static_cast<std::uint32_t>(result));
+    Journal_Record(EventKind::SkillLearn, side, unit, nullptr, skillId);
+
+    if (!HasSubscribers(EventKind::SkillLearn))
+        return;
 
     SkillLearnContext ctx{};
-    ctx.map     = mc;
-    ctx.turn    = tc;
+    FillTurnContext(ctx.turn, side);
+    ctx.map     = ctx.turn.map;
     ctx.unit    = UnitHandle(unit);
     ctx.skillId = skillId;
     ctx.flags   = flags;
     ctx.result  = result;
 
-    Logf("Engine::OnUnitSkillLearn: unit=%p skill=0x%04X flags=0x%04X result=%d "
-         "gen=%u side=%s sideTurn=%u totalTurns=%u",
-         ctx.unit.Raw(),
-         static_cast<unsigned>(skillId),
-         static_cast<unsigned>(flags),
-         result,
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(tc.map.totalTurns));
-
     DispatchSkillLearn(ctx);
 }
 
@@ -359,66 +951,156 @@ void OnItemGain(void *seqHelper,
                 int   result,
                 TurnSide side)
 {
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    FATES_LOG(Info, Engine, "Engine::OnItemGain: seq=%p unit=%p itemArg=%p mode=%p result=%d "
+                            "gen=%u side=%s sideTurn=%u totalTurns=%u",
+                            seqHelper,
+                            unit,
+                            itemArg,
+                            modeOrCtx,
+                            result,
+                            static_cast<unsigned>(gMapState.generation),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(SideTurnIndex(side)),
+                            static_cast<unsigned>(gMapState.totalTurns));
+
+    Trace_Record(EventKind::ItemGain, side,
+                 TraceArg(unit),
+                 TraceArg(itemArg),
+                 TraceArg(modeOrCtx),
+                 static_cast<std::uint32_t>(result));
+    Journal_Record(EventKind::ItemGain, side, unit, nullptr, result);
+
+    if (!HasSubscribers(EventKind::ItemGain))
+        return;
 
     ItemGainContext ctx{};
-    ctx.map       = mc;
-    ctx.turn      = tc;
+    FillTurnContext(ctx.turn, side);
+    ctx.map       = ctx.turn.map;
     ctx.seq       = seqHelper;
     ctx.unit      = UnitHandle(unit);
     ctx.itemArg   = itemArg;
     ctx.modeOrCtx = modeOrCtx;
     ctx.result    = result;
 
-    Logf("Engine::OnItemGain: seq=%p unit=%p itemArg=%p mode=%p result=%d "
-         "gen=%u side=%s sideTurn=%u totalTurns=%u",
-         seqHelper,
-         ctx.unit.Raw(),
-         itemArg,
-         modeOrCtx,
-         result,
-         static_cast<unsigned>(mc.generation),
-         TurnSideToString(side),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(tc.map.totalTurns));
-
     DispatchItemGain(ctx);
 }
 
-void OnActionEnd(void *inst,
-                 void *seqMap,
-                 void *cmdData,
-                 std::uint32_t cmdId,
-                 std::uint32_t sideRaw,
-                 TurnSide side,
-                 std::uint32_t unk28)
+// ActionEnd / UnitMove / ItemUse share the context; 'row' picks the
+// family's tally row.
+static void FillActionContext(ActionContext &ctx, const ActionEvent &ev,
+                              std::uint16_t *row, TurnSide side)
 {
-    // Build map/turn snapshots so can correlate actions later.
-    TurnContext tc = BuildTurnContext(side);
-    MapContext  mc = tc.map;
+    ctx.core = ev;
+    FillTurnContext(ctx.turn, side);
+    ctx.map       = ctx.turn.map;
+    ctx.turnCount = TallyAction(row, ev.cmdId);
+}
 
-    // For now: structured, capped log only. No bus dispatch yet.
-    static int sLogCount = 0;
-    if (sLogCount >= 32)
-        return;
+void OnActionEnd(const ActionEvent &ev, TurnSide side)
+{
+    // End of a unit's action: the battle that produced any queued
+    // kill/HP/RNG events is over, so deliver them now (while the battle
+    // is still current), then close it.
+    FlushHpChanges();
+    DrainDeferredEvents();
+    OnBattleEnd(side);
+
+    // Binary trace is uncapped; the text log below is rate-limited.
+    Trace_Record(EventKind::ActionEnd, side,
+                 TraceArg(ev.inst),
+                 ev.cmdId,
+                 ev.sideRaw,
+                 ev.unk28);
+    RngRec_Mark(RngMarker::ActionEnd, side, ev.cmdId);
+    Journal_Record(EventKind::ActionEnd, side, nullptr, nullptr,
+                   static_cast<std::int32_t>(ev.cmdId));
+    PublishRuntimeSnapshot();
 
-    ++sLogCount;
-
-    Logf("Engine::OnActionEnd: inst=%p seqMap=%p cmdData=%p "
-         "cmdId=%u sideRaw=%u side=%s unk28=%u "
-         "gen=%u sideTurn=%u totalTurns=%u (n=%d)",
-         inst,
-         seqMap,
-         cmdData,
-         static_cast<unsigned>(cmdId),
-         static_cast<unsigned>(sideRaw),
-         TurnSideToString(side),
-         static_cast<unsigned>(unk28),
-         static_cast<unsigned>(mc.generation),
-         static_cast<unsigned>(tc.sideTurnIndex),
-         static_cast<unsigned>(mc.totalTurns),
-         sLogCount);
+    ActionContext ctx{};
+    FillActionContext(ctx, ev, gActionTally.actionEnd, side);
+
+    static LogGate sLogGate("Engine::OnActionEnd", 32);
+    if (FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnActionEnd: inst=%p cmdData=%p "
+                                 "cmdId=%u sideRaw=%u side=%s unk28=%u turnCount=%u "
+                                 "gen=%u sideTurn=%u totalTurns=%u (n=%u)",
+                                 ev.inst,
+                                 ev.cmdData,
+                                 static_cast<unsigned>(ev.cmdId),
+                                 static_cast<unsigned>(ev.sideRaw),
+                                 TurnSideToString(side),
+                                 static_cast<unsigned>(ev.unk28),
+                                 static_cast<unsigned>(ctx.turnCount),
+                                 static_cast<unsigned>(ctx.map.generation),
+                                 static_cast<unsigned>(ctx.turn.sideTurnIndex),
+                                 static_cast<unsigned>(ctx.map.totalTurns),
+                                 LogGate_Count(sLogGate));
+    }
+
+    if (HasSubscribers(EventKind::ActionEnd))
+        DispatchActionEnd(ctx);
+}
+
+void OnUnitMove(const ActionEvent &ev, TurnSide side)
+{
+    Trace_Record(EventKind::UnitMove, side,
+                 TraceArg(ev.inst),
+                 ev.cmdId,
+                 ev.sideRaw,
+                 ev.unk28);
+    Journal_Record(EventKind::UnitMove, side, nullptr, nullptr,
+                   static_cast<std::int32_t>(ev.cmdId));
+
+    ActionContext ctx{};
+    FillActionContext(ctx, ev, gActionTally.unitMove, side);
+
+    static LogGate sLogGate("Engine::OnUnitMove", 32);
+    if (FATES_LOG_ON(Debug, Engine) && LogGate_Allow(sLogGate))
+    {
+        FATES_LOG(Debug, Engine, "Engine::OnUnitMove: inst=%p cmdId=%u sideRaw=%u side=%s turnCount=%u (n=%u)",
+                                 ev.inst,
+                                 static_cast<unsigned>(ev.cmdId),
+                                 static_cast<unsigned>(ev.sideRaw),
+                                 TurnSideToString(side),
+                                 static_cast<unsigned>(ctx.turnCount),
+                                 LogGate_Count(sLogGate));
+    }
+
+    if (HasSubscribers(EventKind::UnitMove))
+        DispatchUnitMove(ctx);
+}
+
+void OnItemUse(const ActionEvent &ev, TurnSide side)
+{
+    Trace_Record(EventKind::ItemUse, side,
+                 TraceArg(ev.inst),
+                 TraceArg(ev.unit.Raw()),
+                 ev.cmdId,
+                 ev.sideRaw);
+    Journal_Record(EventKind::ItemUse, side, ev.unit.Raw(), nullptr,
+                   static_cast<std::int32_t>(ev.cmdId));
+
+    ActionContext ctx{};
+    FillActionContext(ctx, ev, gActionTally.itemUse, side);
+
+    FATES_LOG(Info, Engine, "Engine::OnItemUse: unit=%p inst=%p cmdId=%u side=%s turnCount=%u "
+                            "gen=%u totalTurns=%u",
+                            ev.unit.Raw(),
+                            ev.inst,
+                            static_cast<unsigned>(ev.cmdId),
+                            TurnSideToString(side),
+                            static_cast<unsigned>(ctx.turnCount),
+                            static_cast<unsigned>(ctx.map.generation),
+                            static_cast<unsigned>(ctx.map.totalTurns));
+
+    if (HasSubscribers(EventKind::ItemUse))
+        DispatchItemUse(ctx);
+}
+
+const ActionTally &GetTurnActionTally()
+{
+    return gActionTally;
 }
 
 } // namespace Engine
@@ -0,0 +1,397 @@
+// engine/history_store.cpp
+//
+// Campaign history store. See engine/history_store.hpp for the file
+// layout.
+//
+// Threading: History_OnMapEnd runs on the game thread and is the only
+// producer; it fills the next slot of a small record queue and then
+// publishes head. History_Pump (worker) and History_LoadRecent (menu)
+// take the light lock, write [tail, head) to both
+// files and publish tail. Nothing on the game thread touches the SD
+// card.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+
+#include "engine/history_store.hpp"
+#include "engine/turn_rollup.hpp"
+#include "core/runtime.hpp"
+#include "util/debug_log.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+constexpr const char *kHistoryDir       = "sdmc:/Fates3GX";
+constexpr const char *kHistoryPath      = "sdmc:/Fates3GX/history.bin";
+constexpr const char *kHistoryIndexPath = "sdmc:/Fates3GX/history.idx";
+
+// Maps finished between two pumps. The worker pumps every 50ms, so a
+// handful is plenty. Must be a power of two.
+constexpr std::uint32_t kQueueCapacity = 8;
+constexpr std::uint32_t kQueueMask     = kQueueCapacity - 1;
+
+constexpr std::uint32_t kHeaderSize = sizeof(HistoryFileHeader);
+
+HistoryRecord sQueue[kQueueCapacity];
+
+volatile std::uint32_t sHead = 0;  // records queued  (monotonic)
+volatile std::uint32_t sTail = 0;  // records written (monotonic)
+
+volatile std::uint32_t sDropped       = 0;
+std::uint32_t          sReportedDrops = 0;
+
+LightLock sLock;
+bool      sLockReady = false;
+
+File sBin;
+File sIdx;
+bool sOpen   = false;
+bool sFailed = false;  // open failed once; don't retry every pump
+
+std::uint32_t sNumRecords = 0;  // complete records in history.bin
+std::uint32_t sSession    = 0;  // this boot's session number
+
+inline void EnsureLock()
+{
+    if (sLockReady)
+        return;
+
+    LightLock_Init(&sLock);
+    sLockReady = true;
+}
+
+inline std::uint32_t RecordOffset(std::uint32_t i)
+{
+    return kHeaderSize + i * static_cast<std::uint32_t>(sizeof(HistoryRecord));
+}
+
+inline std::uint32_t IndexOffset(std::uint32_t i)
+{
+    return kHeaderSize + i * static_cast<std::uint32_t>(sizeof(HistoryIndexEntry));
+}
+
+// Open 'path' (creating it with a header if empty) and return the
+// number of complete entries in it. A torn trailing entry is ignored
+// and overwritten by the next append. Returns false if the file can't
+// be opened or belongs to a different format / version.
+bool OpenStoreFile(File &f, const char *path, std::uint32_t magic,
+                   std::uint16_t entrySize, bool truncate, std::uint32_t &outCount)
+{
+    int mode = File::READ | File::WRITE | File::CREATE;
+    if (truncate)
+        mode |= File::TRUNCATE;
+
+    if (File::Open(f, path, mode) != 0)
+    {
+        FATES_LOG(Warn, Module, "History: could not open %s", path);
+        return false;
+    }
+
+    const std::uint64_t size = f.GetSize();
+    if (size < kHeaderSize)
+    {
+        HistoryFileHeader hdr{};
+        hdr.magic     = magic;
+        hdr.version   = kHistoryVersion;
+        hdr.entrySize = entrySize;
+
+        f.Seek(0, File::SET);
+        f.Write(&hdr, sizeof(hdr));
+        outCount = 0;
+        return true;
+    }
+
+    HistoryFileHeader hdr{};
+    f.Seek(0, File::SET);
+    if (f.Read(&hdr, sizeof(hdr)) != 0 || hdr.magic != magic ||
+        hdr.version != kHistoryVersion || hdr.entrySize != entrySize)
+    {
+        FATES_LOG(Warn, Module, "History: %s has an unknown header (magic=%08X ver=%u size=%u), not touching it",
+                                path,
+                                static_cast<unsigned>(hdr.magic),
+                                static_cast<unsigned>(hdr.version),
+                                static_cast<unsigned>(hdr.entrySize));
+        f.Close();
+        return false;
+    }
+
+    outCount = static_cast<std::uint32_t>((size - kHeaderSize) / entrySize);
+    return true;
+}
+
+inline HistoryIndexEntry IndexEntryFor(const HistoryRecord &rec, std::uint32_t i)
+{
+    HistoryIndexEntry e{};
+    e.offset     = RecordOffset(i);
+    e.session    = rec.session;
+    e.generation = rec.generation;
+    e.totalTurns = rec.totalTurns;
+    return e;
+}
+
+// Rewrite history.idx from history.bin. Only needed after a crash
+// between the two appends, so it does one small read per record.
+bool RebuildIndex()
+{
+    sIdx.Close();
+
+    std::uint32_t unused = 0;
+    if (!OpenStoreFile(sIdx, kHistoryIndexPath, kHistoryIndexMagic,
+                       sizeof(HistoryIndexEntry), true, unused))
+        return false;
+
+    HistoryRecord rec{};
+    for (std::uint32_t i = 0; i < sNumRecords; ++i)
+    {
+        sBin.Seek(RecordOffset(i), File::SET);
+        if (sBin.Read(&rec, sizeof(rec)) != 0)
+            return false;
+
+        HistoryIndexEntry e = IndexEntryFor(rec, i);
+        sIdx.Write(&e, sizeof(e));
+    }
+
+    sIdx.Flush();
+    FATES_LOG(Info, Module, "History: rebuilt history.idx (%u record(s))", static_cast<unsigned>(sNumRecords));
+    return true;
+}
+
+// Caller holds sLock.
+bool EnsureOpen()
+{
+    if (sOpen)
+        return true;
+    if (sFailed)
+        return false;
+
+    Directory::Create(kHistoryDir);
+
+    std::uint32_t numIndex = 0;
+    if (!OpenStoreFile(sBin, kHistoryPath, kHistoryMagic, sizeof(HistoryRecord), false, sNumRecords))
+    {
+        sFailed = true;
+        return false;
+    }
+    if (!OpenStoreFile(sIdx, kHistoryIndexPath, kHistoryIndexMagic,
+                       sizeof(HistoryIndexEntry), false, numIndex))
+    {
+        sBin.Close();
+        sFailed = true;
+        return false;
+    }
+
+    if (numIndex != sNumRecords && !RebuildIndex())
+    {
+        sBin.Close();
+        sIdx.Close();
+        sFailed = true;
+        return false;
+    }
+
+    // Session numbers continue from the last record on the card.
+    sSession = 1;
+    if (sNumRecords > 0)
+    {
+        HistoryRecord last{};
+        sBin.Seek(RecordOffset(sNumRecords - 1), File::SET);
+        if (sBin.Read(&last, sizeof(last)) == 0)
+            sSession = last.session + 1;
+    }
+
+    sOpen = true;
+    FATES_LOG(Info, Module, "History: opened store (%u map(s) on record, session %u)",
+                            static_cast<unsigned>(sNumRecords),
+                            static_cast<unsigned>(sSession));
+    return true;
+}
+
+// Caller holds sLock.
+void DrainLocked()
+{
+    std::uint32_t tail = sTail;
+    std::uint32_t head = sHead;
+    __sync_synchronize();
+
+    if (tail != head && EnsureOpen())
+    {
+        for (; tail != head; ++tail)
+        {
+            HistoryRecord &rec = sQueue[tail & kQueueMask];
+            rec.session = sSession;
+
+            const std::uint32_t i = sNumRecords;
+            sBin.Seek(RecordOffset(i), File::SET);
+            sBin.Write(&rec, sizeof(rec));
+
+            HistoryIndexEntry e = IndexEntryFor(rec, i);
+            sIdx.Seek(IndexOffset(i), File::SET);
+            sIdx.Write(&e, sizeof(e));
+
+            ++sNumRecords;
+        }
+
+        // Record before index: after a crash the index is at worst one
+        // entry short and gets rebuilt.
+        sBin.Flush();
+        sIdx.Flush();
+
+        __sync_synchronize();
+        sTail = head;
+    }
+
+    std::uint32_t dropped = sDropped;
+    if (dropped != sReportedDrops)
+    {
+        FATES_LOG(Warn, Module, "History: dropped %u record(s) (queue full, total=%u)",
+                                static_cast<unsigned>(dropped - sReportedDrops),
+                                static_cast<unsigned>(dropped));
+        sReportedDrops = dropped;
+    }
+}
+
+inline std::uint8_t RawSide(TurnSide side)
+{
+    return static_cast<std::uint8_t>(side);
+}
+
+} // anonymous namespace
+
+// MapEnd: snapshot this map's aggregates into the queue.
+void History_OnMapEnd(const MapContext &ctx)
+{
+    const std::uint32_t head = sHead;
+    if (head - sTail >= kQueueCapacity)
+    {
+        ++sDropped;
+        return;
+    }
+
+    HistoryRecord &rec = sQueue[head & kQueueMask];
+    rec            = HistoryRecord{};
+    rec.generation = ctx.generation;
+    rec.endTimeMs  = osGetTime();
+    rec.totalTurns = ctx.totalTurns;
+    rec.killEvents = ctx.killEvents;
+    rec.startSide  = RawSide(ctx.startSide);
+    rec.endSide    = RawSide(ctx.currentSide);
+
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+
+    for (int i = 0; i < kRollupColumns; ++i)
+        rec.rngCalls += total.rngCalls[i];
+
+    for (int i = 0; i < 4; ++i)
+    {
+        rec.turns[i]          = gMapState.turnCount[i];
+        rec.damage[i]         = total.damage[i];
+        rec.heals[i]          = total.heals[i];
+        rec.kills[i]          = total.kills[i];
+        rec.rngCallsBySide[i] = total.rngCalls[i];
+    }
+
+    __sync_synchronize();
+    sHead = head + 1;
+}
+
+void History_Pump()
+{
+    if (sHead == sTail && sDropped == sReportedDrops)
+        return;
+
+    EnsureLock();
+    LightLock_Lock(&sLock);
+    DrainLocked();
+    LightLock_Unlock(&sLock);
+}
+
+bool History_TryPump()
+{
+    if (sHead == sTail && sDropped == sReportedDrops)
+        return true;
+
+    EnsureLock();
+    if (LightLock_TryLock(&sLock) != 0)
+        return false;
+    DrainLocked();
+    LightLock_Unlock(&sLock);
+    return true;
+}
+
+int History_LoadRecent(HistoryRecord *out, int max)
+{
+    if (out == nullptr || max <= 0)
+        return 0;
+
+    EnsureLock();
+    LightLock_Lock(&sLock);
+
+    // Anything still queued goes to the card first so it shows up too.
+    DrainLocked();
+
+    int n = 0;
+    if (EnsureOpen())
+    {
+        std::uint32_t count = sNumRecords;
+        std::uint32_t want  = static_cast<std::uint32_t>(max) < count
+                            ? static_cast<std::uint32_t>(max) : count;
+
+        // Walk the index tail backwards in chunks, newest first.
+        constexpr std::uint32_t kChunk = 16;
+        HistoryIndexEntry entries[kChunk];
+
+        std::uint32_t end = count;
+        while (static_cast<std::uint32_t>(n) < want)
+        {
+            std::uint32_t left  = want - static_cast<std::uint32_t>(n);
+            std::uint32_t take  = left < kChunk ? left : kChunk;
+            std::uint32_t first = end - take;
+
+            sIdx.Seek(IndexOffset(first), File::SET);
+            if (sIdx.Read(entries, take * sizeof(HistoryIndexEntry)) != 0)
+                break;
+
+            bool ok = true;
+            for (std::uint32_t k = take; k-- > 0;)
+            {
+                const HistoryIndexEntry &e = entries[k];
+                if (e.offset != RecordOffset(first + k))
+                {
+                    FATES_LOG(Warn, Module, "History: index entry %u points at %08X, expected %08X",
+                                            static_cast<unsigned>(first + k),
+                                            static_cast<unsigned>(e.offset),
+                                            static_cast<unsigned>(RecordOffset(first + k)));
+                    ok = false;
+                    break;
+                }
+
+                sBin.Seek(e.offset, File::SET);
+                if (sBin.Read(&out[n], sizeof(HistoryRecord)) != 0)
+                {
+                    ok = false;
+                    break;
+                }
+                ++n;
+            }
+
+            if (!ok)
+                break;
+            end = first;
+        }
+    }
+
+    LightLock_Unlock(&sLock);
+    return n;
+}
+
+std::uint32_t History_GetDroppedRecords()
+{
+    return sDropped;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -1,13 +1,18 @@
 // engine/hp_kill_tracker.cpp
 //
 // Small per-map HP + kill summary engine built on top of the
-// engine/bus event system. Listens to HpChange, Kill, and Map
-// begin/end events and maintains lightweight aggregates that other
-// systems (logging, logic systems, etc) can query.
+// engine/bus event system. Listens to HpChange and Map begin/end
+// events and maintains per-unit aggregates that other systems
+// (logging, logic systems, etc) can query. Per-side damage, healing
+// and kills are read from the turn rollup rather than counted here.
 
 #include "engine/hp_kill_tracker.hpp"
+#include "engine/arena.hpp"
+#include "engine/budget.hpp"
 #include "engine/bus.hpp"
 #include "engine/events.hpp"
+#include "engine/turn_rollup.hpp"
+#include "engine/unit_index.hpp"
 #include "util/debug_log.hpp"
 
 namespace Fates {
@@ -15,19 +20,31 @@ namespace Engine {
 
 namespace {
 
-// How many distinct units to track per map for per-unit stats.
-constexpr std::size_t kMaxTrackedUnits = 64;
+constexpr const char *kArenaTag = "HpKillTracker";
 
-// Per-side HP stats (indices 0..3 correspond to TurnSide::Side0..Side3).
-SideHpStats sSideStats[4] = {};
+// Per-side views handed out by the getters (indices 0..3 correspond to
+// TurnSide::Side0..Side3), filled from the rollup on each call.
+SideHpStats   sSideStats[4] = {};
+std::uint32_t sKillsBySide[4] = {};
 
-// Per-unit stats.
-UnitHpStatsSnapshot sUnitStats[kMaxTrackedUnits];
-std::size_t         sNumUnitStats = 0;
+// Per-unit stats from the Map arena: kEngineBudget.trackedUnits
+// entries, or the units carried over from the last map if that is
+// larger (allocated in ResetForMap; null before the first map or if the
+// arena is full).
+UnitHpStatsSnapshot *sUnitStats    = nullptr;
+std::size_t          sUnitCapacity = 0;
+std::size_t          sNumUnitStats = 0;
 
-// Kill counts by side (0..3) + total kills for the current map.
-std::uint32_t sKillsBySide[4] = {};
-std::uint32_t sTotalKills     = 0;
+// Unit index slot -> (sUnitStats index + 1); 0 = no entry this map.
+struct UnitStatsRef
+{
+    std::uint16_t indexPlusOne;
+};
+
+UnitSlotTable<UnitStatsRef> sUnitStatsRefs;
+
+static_assert(FATES_BUDGET_TRACKED_UNITS < 65535 && FATES_BUDGET_PREWARM_UNITS < 65535,
+              "UnitStatsRef stores index + 1 in 16 bits");
 
 // Simple metadata for summary logs.
 std::uint32_t sMapGeneration   = 0;
@@ -35,13 +52,14 @@ std::uint32_t sTotalTurnsAtEnd = 0;
 
 // Helpers ------------------------------------------------------------
 
-// Convert a TurnSide into a 0..3 index, or -1 if Unknown/out of range.
-static int SideToIndex(TurnSide side)
+static void RefreshSideViews(const RollupRow &total)
 {
-    int idx = static_cast<int>(side);
-    if (idx < 0 || idx >= 4)
-        return -1;
-    return idx;
+    for (int i = 0; i < 4; ++i)
+    {
+        sSideStats[i].damageDealt = total.damage[i];
+        sSideStats[i].healingDone = total.heals[i];
+        sKillsBySide[i]           = total.kills[i];
+    }
 }
 
 // Find or create the per-unit stats entry for a UnitHandle.
@@ -51,16 +69,22 @@ static UnitHpStatsSnapshot *FindOrCreateUnitStats(UnitHandle unit)
     if (raw == nullptr)
         return nullptr;
 
-    // Look for an existing entry.
-    for (std::size_t i = 0; i < sNumUnitStats; ++i)
+    // Look for an existing entry via the shared unit index.
+    UnitStatsRef *ref = sUnitStatsRefs.Get(UnitIndex_Acquire(raw));
+    if (ref == nullptr)
+        return nullptr;  // unit index full
+
+    if (ref->indexPlusOne != 0)
+        return &sUnitStats[ref->indexPlusOne - 1];
+
+    // Need a new entry.
+    if (sNumUnitStats >= sUnitCapacity)
     {
-        if (sUnitStats[i].unit.Raw() == raw)
-            return &sUnitStats[i];
+        Arena_NoteDrop(kArenaTag);
+        return nullptr;
     }
 
-    // Need a new entry.
-    if (sNumUnitStats >= kMaxTrackedUnits)
-        return nullptr;  // silently drop if at capacity
+    ref->indexPlusOne = static_cast<std::uint16_t>(sNumUnitStats + 1);
 
     UnitHpStatsSnapshot &slot = sUnitStats[sNumUnitStats++];
     slot.unit            = unit;
@@ -72,54 +96,64 @@ static UnitHpStatsSnapshot *FindOrCreateUnitStats(UnitHandle unit)
 // Reset all states for a new map.
 static void ResetForMap(const MapContext &ctx)
 {
-    for (int i = 0; i < 4; ++i)
-    {
-        sSideStats[i].damageDealt   = 0;
-        sSideStats[i].healingDone   = 0;
-        sKillsBySide[i]             = 0;
-    }
-
+    // Every carried-over unit can take damage; size for at least those.
+    std::size_t want = kEngineBudget.trackedUnits;
+    const int carried = GetCarriedUnits(nullptr);
+    if (carried > 0 && static_cast<std::size_t>(carried) > want)
+        want = static_cast<std::size_t>(carried);
+
+    sUnitStats        = Arena_AllocArray<UnitHpStatsSnapshot>(ArenaId::Map, kArenaTag, want);
+    sUnitCapacity     = sUnitStats ? want : 0;
     sNumUnitStats     = 0;
-    sTotalKills       = 0;
     sMapGeneration    = ctx.generation;
     sTotalTurnsAtEnd  = 0;
 
-    Logf("HpKillTracker: MapBegin gen=%u seq=%p",
-         static_cast<unsigned>(ctx.generation),
-         ctx.seqRoot);
+    FATES_LOG(Info, Module, "HpKillTracker: MapBegin gen=%u seq=%p",
+                            static_cast<unsigned>(ctx.generation),
+                            ctx.seqRoot);
 }
 
-// Bus handlers -------------------------------------------------------
+} // anonymous namespace
+
+// Bus handlers (kHpKillTrackerModule) ---------------------------------
 
 // MapBegin: reset per-map aggregates.
-static void OnMapBeginHandler(const MapContext &ctx)
+void HpKillTracker_OnMapBegin(const MapContext &ctx)
 {
     ResetForMap(ctx);
 }
 
 // MapEnd: emit a summary log of what was tracked this map.
-static void OnMapEndHandler(const MapContext &ctx)
+void HpKillTracker_OnMapEnd(const MapContext &ctx)
 {
     sTotalTurnsAtEnd = ctx.totalTurns;
 
-    Logf("HpKillTracker: MapEndSummary gen=%u totalTurns=%u totalKills=%u",
-         static_cast<unsigned>(sMapGeneration),
-         static_cast<unsigned>(sTotalTurnsAtEnd),
-         static_cast<unsigned>(sTotalKills));
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+    RefreshSideViews(total);
+
+    std::uint32_t totalKills = 0;
+    for (int i = 0; i < kRollupColumns; ++i)
+        totalKills += total.kills[i];
 
-    Logf("  KillsBySide: S0=%u S1=%u S2=%u S3=%u",
-         static_cast<unsigned>(sKillsBySide[0]),
-         static_cast<unsigned>(sKillsBySide[1]),
-         static_cast<unsigned>(sKillsBySide[2]),
-         static_cast<unsigned>(sKillsBySide[3]));
+    FATES_LOG(Info, Module, "HpKillTracker: MapEndSummary gen=%u totalTurns=%u totalKills=%u",
+                            static_cast<unsigned>(sMapGeneration),
+                            static_cast<unsigned>(sTotalTurnsAtEnd),
+                            static_cast<unsigned>(totalKills));
+
+    FATES_LOG(Info, Module, "  KillsBySide: S0=%u S1=%u S2=%u S3=%u",
+                            static_cast<unsigned>(sKillsBySide[0]),
+                            static_cast<unsigned>(sKillsBySide[1]),
+                            static_cast<unsigned>(sKillsBySide[2]),
+                            static_cast<unsigned>(sKillsBySide[3]));
 
     // Per-side HP aggregates.
     for (int i = 0; i < 4; ++i)
     {
-        Logf("  Side%d HP: dmgDealt=%d healDone=%d",
-             i,
-             static_cast<int>(sSideStats[i].damageDealt),
-             static_cast<int>(sSideStats[i].healingDone));
+        FATES_LOG(Info, Module, "  Side%d HP: dmgDealt=%d healDone=%d",
+                                i,
+                                static_cast<int>(sSideStats[i].damageDealt),
+                                static_cast<int>(sSideStats[i].healingDone));
     }
 
     // Per-unit stats: log a capped number to avoid spam.
@@ -127,86 +161,52 @@ static void OnMapEndHandler(const MapContext &ctx)
     for (std::size_t i = 0; i < sNumUnitStats && i < maxLogUnits; ++i)
     {
         const UnitHpStatsSnapshot &u = sUnitStats[i];
-        Logf("  Unit%02u: ptr=%p dmgTaken=%d healRecv=%d",
-             static_cast<unsigned>(i),
-             u.unit.Raw(),
-             static_cast<int>(u.damageTaken),
-             static_cast<int>(u.healingReceived));
+        FATES_LOG(Info, Module, "  Unit%02u: ptr=%p dmgTaken=%d healRecv=%d",
+                                static_cast<unsigned>(i),
+                                u.unit.Raw(),
+                                static_cast<int>(u.damageTaken),
+                                static_cast<int>(u.healingReceived));
     }
 }
 
-// HpChange: update per-side and per-unit aggregates.
-static void OnHpChangeHandler(const HpChangeContext &hc)
+// HpChange: update per-unit aggregates.
+void HpKillTracker_OnHpChange(const HpChangeContext &hc)
 {
     const HpEvent &ev = hc.core;
 
-    // Update per-side stats based on whose turn it is.
-    int sideIdx = SideToIndex(hc.turn.side);
-    if (sideIdx >= 0 && sideIdx < 4)
-    {
-        if (ev.amount > 0)
-        {
-            // Damage dealt by this side.
-            sSideStats[sideIdx].damageDealt += ev.amount;
-        }
-        else if (ev.amount < 0)
-        {
-            // Healing done by this side.
-            sSideStats[sideIdx].healingDone += -ev.amount;
-        }
-    }
-
-    // Update per-target stats.
+    // Gross damage / healing: a coalesced event's net amount can hide
+    // a heal and a hit in the same window.
     UnitHpStatsSnapshot *slot = FindOrCreateUnitStats(ev.target);
     if (!slot)
         return;
 
-    if (ev.amount > 0)
-    {
-        slot->damageTaken += ev.amount;
-    }
-    else if (ev.amount < 0)
-    {
-        slot->healingReceived += -ev.amount;
-    }
-}
-
-// Kill: bump total kills and per-side kill counts.
-static void OnKillHandler(const KillContext &kc)
-{
-    ++sTotalKills;
-
-    int sideIdx = SideToIndex(kc.turn.side);
-    if (sideIdx >= 0 && sideIdx < 4)
-        ++sKillsBySide[sideIdx];
+    slot->damageTaken     += hc.damage;
+    slot->healingReceived += hc.healing;
 }
 
-} // anonymous namespace
-
 // Public API ---------------------------------------------------------
 
 bool HpKillTracker_RegisterHandlers()
 {
-    bool ok = true;
-
-    ok &= RegisterMapBeginHandler(&OnMapBeginHandler);
-    ok &= RegisterMapEndHandler(&OnMapEndHandler);
-    ok &= RegisterHpChangeHandler(&OnHpChangeHandler);
-    ok &= RegisterKillHandler(&OnKillHandler);
-
-    if (ok)
-        Logf("HpKillTracker_RegisterHandlers: registered OK");
-    else
-        Logf("HpKillTracker_RegisterHandlers: FAILED to register one or more handlers");
-
-    return ok;
+    return RegisterModule(kHpKillTrackerModule);
 }
 
 const SideHpStats *HpKillTracker_GetSideStats()
 {
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+    RefreshSideViews(total);
     return sSideStats;
 }
 
+const std::uint32_t *HpKillTracker_GetSideKills()
+{
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+    RefreshSideViews(total);
+    return sKillsBySide;
+}
+
 void HpKillTracker_GetUnitStats(const UnitHpStatsSnapshot *&outArray,
                                 std::size_t               &outCount)
 {
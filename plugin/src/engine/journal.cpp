@@ -0,0 +1,170 @@
+// engine/journal.cpp
+//
+// Per-map event journal. See engine/journal.hpp.
+
+#include <3ds.h>
+
+#include "engine/journal.hpp"
+#include "engine/unit_index.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+constexpr std::uint32_t kJournalMask = kJournalCapacity - 1;
+static_assert((kJournalCapacity & kJournalMask) == 0, "kJournalCapacity must be a power of two");
+
+constexpr std::uint32_t kKindCount = static_cast<std::uint32_t>(EventKind::ItemUse) + 1;
+
+JournalEntry sRing[kJournalCapacity];
+
+// Next sequence number to hand out. 0 means "no entry", so start at 1.
+std::uint32_t sNextSeq = 1;
+
+// First sequence number of the current map; older entries are stale.
+std::uint32_t sMapFirstSeq = 1;
+
+std::uint32_t sMapOverwritten = 0;
+
+// Newest entry per kind / per unit slot.
+std::uint32_t sKindHead[kKindCount];
+
+struct UnitHead
+{
+    std::uint32_t last;
+};
+
+UnitSlotTable<UnitHead> sUnitHeads;
+
+// Still in the ring and recorded during the current map.
+inline bool IsLive(std::uint32_t seq)
+{
+    return seq != 0 && seq >= sMapFirstSeq && (sNextSeq - seq) <= kJournalCapacity;
+}
+
+inline const JournalEntry &EntryAt(std::uint32_t seq)
+{
+    return sRing[seq & kJournalMask];
+}
+
+// Link 'seq' in as the newest entry for 'slot'; returns the previous one.
+inline std::uint32_t LinkUnit(int slot, std::uint32_t seq)
+{
+    UnitHead *h = sUnitHeads.Get(slot);
+    if (h == nullptr)
+        return 0;
+
+    const std::uint32_t prev = IsLive(h->last) ? h->last : 0;
+    h->last = seq;
+    return prev;
+}
+
+} // namespace
+
+void Journal_Record(EventKind kind,
+                    TurnSide side,
+                    void *unit,
+                    void *other,
+                    std::int32_t value)
+{
+    const std::uint32_t k = static_cast<std::uint32_t>(kind);
+    if (k >= kKindCount)
+        return;
+
+    const std::uint32_t seq = sNextSeq++;
+
+    // The slot we are about to reuse held an entry of this map.
+    if (seq - sMapFirstSeq >= kJournalCapacity)
+        ++sMapOverwritten;
+
+    const int unitSlot  = unit ? UnitIndex_Acquire(unit) : kInvalidUnitSlot;
+    int       otherSlot = other ? UnitIndex_Acquire(other) : kInvalidUnitSlot;
+    if (otherSlot == unitSlot)
+        otherSlot = kInvalidUnitSlot;
+
+    JournalEntry &e = sRing[seq & kJournalMask];
+    e.tick      = svcGetSystemTick();
+    e.turn      = static_cast<std::uint16_t>(gMapState.totalTurns);
+    e.kind      = static_cast<std::uint16_t>(k);
+    e.unitSlot  = static_cast<std::int16_t>(unitSlot);
+    e.otherSlot = static_cast<std::int16_t>(otherSlot);
+    e.value     = value;
+    e.side      = static_cast<std::uint8_t>(side);
+    e.prevUnit  = (unitSlot != kInvalidUnitSlot) ? LinkUnit(unitSlot, seq) : 0;
+    e.prevOther = (otherSlot != kInvalidUnitSlot) ? LinkUnit(otherSlot, seq) : 0;
+    e.prevKind  = IsLive(sKindHead[k]) ? sKindHead[k] : 0;
+    sKindHead[k] = seq;
+}
+
+void Journal_Reset()
+{
+    sMapFirstSeq    = sNextSeq;
+    sMapOverwritten = 0;
+}
+
+void Journal_ReportMapEnd()
+{
+    const std::uint32_t entries = sNextSeq - sMapFirstSeq;
+
+    if (sMapOverwritten != 0)
+        FATES_LOG(Info, Engine, "Journal: %u entr%s this map, %u overwritten (ring holds %u)",
+                                static_cast<unsigned>(entries), entries == 1 ? "y" : "ies",
+                                static_cast<unsigned>(sMapOverwritten),
+                                static_cast<unsigned>(kJournalCapacity));
+    else
+        FATES_LOG(Info, Engine, "Journal: %u entr%s this map",
+                                static_cast<unsigned>(entries), entries == 1 ? "y" : "ies");
+}
+
+int Journal_LastForUnit(void *unit, JournalEntry *out, int max)
+{
+    if (out == nullptr || max <= 0)
+        return 0;
+
+    const int slot = UnitIndex_Find(unit);
+    const UnitHead *h = sUnitHeads.Peek(slot);
+    if (h == nullptr)
+        return 0;
+
+    int n = 0;
+    for (std::uint32_t seq = h->last; n < max && IsLive(seq);)
+    {
+        const JournalEntry &e = EntryAt(seq);
+        out[n++] = e;
+        seq = (e.unitSlot == slot) ? e.prevUnit : e.prevOther;
+    }
+    return n;
+}
+
+int Journal_ThisTurn(EventKind kind, JournalEntry *out, int max)
+{
+    const std::uint32_t k = static_cast<std::uint32_t>(kind);
+    if (out == nullptr || max <= 0 || k >= kKindCount)
+        return 0;
+
+    const std::uint16_t turn = static_cast<std::uint16_t>(gMapState.totalTurns);
+
+    int n = 0;
+    for (std::uint32_t seq = sKindHead[k]; n < max && IsLive(seq);)
+    {
+        const JournalEntry &e = EntryAt(seq);
+        if (e.turn != turn)
+            break;
+        out[n++] = e;
+        seq = e.prevKind;
+    }
+    return n;
+}
+
+void Journal_GetStats(JournalStats &out)
+{
+    out.capacity       = kJournalCapacity;
+    out.mapEntries     = sNextSeq - sMapFirstSeq;
+    out.mapOverwritten = sMapOverwritten;
+    out.totalEntries   = sNextSeq - 1;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,119 @@
+// engine/module_list.cpp
+//
+// Runtime registration of ModuleDef descriptors, and startup of the
+// built-in module list. See engine/module_list.hpp and
+// engine/builtin_modules.hpp.
+
+#include "engine/module_list.hpp"
+#include "engine/builtin_modules.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+// Modules seen by RegisterModule(), so calling it twice is harmless.
+constexpr int kMaxModules = 16;
+
+const ModuleDef *sModules[kMaxModules] = {};
+int              sNumModules = 0;
+
+bool IsKnown(const ModuleDef *m)
+{
+    for (int i = 0; i < sNumModules; ++i)
+    {
+        if (sModules[i] == m)
+            return true;
+    }
+    return false;
+}
+
+inline std::uint32_t FlagsFor(const ModuleDef &m, EventKind kind)
+{
+    return (m.syncMask & EventBit(kind)) ? HandlerFlag_Sync : HandlerFlag_None;
+}
+
+} // anonymous namespace
+
+bool RegisterModule(const ModuleDef &m)
+{
+    const char *tag = m.tag ? m.tag : "(untagged)";
+
+    if (IsKnown(&m))
+        return true;
+
+    if (sNumModules >= kMaxModules)
+    {
+        FATES_LOG(Warn, Engine, "Engine::RegisterModule: capacity full (%d), %s not registered", kMaxModules, tag);
+        return false;
+    }
+    sModules[sNumModules++] = &m;
+
+    if (m.init)
+        m.init();
+
+#if FATES_STATIC_MODULES
+    // Dispatched directly by the bus; don't add a second, runtime copy.
+    if (BuiltinModuleList::Contains(&m))
+    {
+        FATES_LOG(Info, Engine, "Engine::RegisterModule: %s is built in (static dispatch)", tag);
+        return true;
+    }
+#endif
+
+    bool ok = true;
+    if (m.onMapBegin)
+        ok &= RegisterMapBeginHandler(m.onMapBegin, FlagsFor(m, EventKind::MapBegin), m.tag);
+    if (m.onMapEnd)
+        ok &= RegisterMapEndHandler(m.onMapEnd, FlagsFor(m, EventKind::MapEnd), m.tag);
+    if (m.onTurnBegin)
+        ok &= RegisterTurnBeginHandler(m.onTurnBegin, FlagsFor(m, EventKind::TurnBegin), m.tag);
+    if (m.onTurnEnd)
+        ok &= RegisterTurnEndHandler(m.onTurnEnd, FlagsFor(m, EventKind::TurnEnd), m.tag);
+    if (m.onKill)
+        ok &= RegisterKillHandler(m.onKill, FlagsFor(m, EventKind::Kill), m.tag);
+    if (m.onHpChange)
+        ok &= RegisterHpChangeHandler(m.onHpChange, FlagsFor(m, EventKind::HpChange), m.tag);
+    if (m.onRng)
+        ok &= RegisterRngHandler(m.onRng, FlagsFor(m, EventKind::RngCall), m.tag);
+    if (m.onLevelUp)
+        ok &= RegisterLevelUpHandler(m.onLevelUp, FlagsFor(m, EventKind::LevelUp), m.tag);
+    if (m.onSkillLearn)
+        ok &= RegisterSkillLearnHandler(m.onSkillLearn, FlagsFor(m, EventKind::SkillLearn), m.tag);
+    if (m.onItemGain)
+        ok &= RegisterItemGainHandler(m.onItemGain, FlagsFor(m, EventKind::ItemGain), m.tag);
+    if (m.onBattleBegin)
+        ok &= RegisterBattleBeginHandler(m.onBattleBegin, FlagsFor(m, EventKind::BattleBegin), m.tag);
+    if (m.onBattleEnd)
+        ok &= RegisterBattleEndHandler(m.onBattleEnd, FlagsFor(m, EventKind::BattleEnd), m.tag);
+    if (m.onHpSync)
+        ok &= RegisterHpSyncHandler(m.onHpSync, FlagsFor(m, EventKind::HpSync), m.tag);
+    if (m.onActionEnd)
+        ok &= RegisterActionEndHandler(m.onActionEnd, FlagsFor(m, EventKind::ActionEnd), m.tag);
+    if (m.onUnitMove)
+        ok &= RegisterUnitMoveHandler(m.onUnitMove, FlagsFor(m, EventKind::UnitMove), m.tag);
+    if (m.onItemUse)
+        ok &= RegisterItemUseHandler(m.onItemUse, FlagsFor(m, EventKind::ItemUse), m.tag);
+
+    if (!ok)
+        FATES_LOG(Error, Engine, "Engine::RegisterModule: WARNING: some %s registrations failed", tag);
+    return ok;
+}
+
+bool BuiltinModules_RegisterHandlers()
+{
+    bool ok = true;
+    BuiltinModuleList::ForEach([&ok](const ModuleDef &m) {
+        ok &= RegisterModule(m);
+    });
+
+    FATES_LOG(Info, Engine, "BuiltinModules_RegisterHandlers: %u module(s), %s dispatch%s",
+                            static_cast<unsigned>(BuiltinModuleList::kCount),
+                            FATES_STATIC_MODULES ? "static" : "runtime",
+                            ok ? "" : " (some registrations FAILED)");
+    return ok;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,319 @@
+// engine/rng_recorder.cpp
+//
+// RNG stream recorder sink. See engine/rng_recorder.hpp for the
+// encoding.
+//
+// Same threading model as engine/trace.cpp: producers (OnRngCall and
+// the map/turn/action entrypoints) only run on the game thread, so the
+// byte ring is single-producer. A record is encoded at head and head is
+// published once the whole record is in; the drain writes [tail, head)
+// in at most two contiguous chunks and then publishes tail. The light
+// lock only serialises drains (RngRec_Pump from the worker's periodic
+// pass vs. RngRec_Flush from a posted job or plugin exit).
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+
+#include "engine/rng_recorder.hpp"
+#include "util/debug_log.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace Fates {
+namespace Engine {
+
+volatile bool gRngRecEnabled = false;
+
+namespace {
+
+constexpr const char *kRngDir  = "sdmc:/Fates3GX";
+constexpr const char *kRngPath = "sdmc:/Fates3GX/fates_rng.bin";
+
+// 64 KB holds ~13k typical calls; the worker drains every 50ms. Must
+// be a power of two.
+constexpr std::uint32_t kRingSize = 64 * 1024;
+constexpr std::uint32_t kRingMask = kRingSize - 1;
+
+// Upper bound on one encoded record plus a pending gap record.
+constexpr std::uint32_t kMaxRecordBytes = 32;
+
+constexpr std::uint8_t kTagCall         = 0x00;
+constexpr std::uint8_t kTagBoundChanged = 0x01;
+constexpr std::uint8_t kTagStateChanged = 0x02;
+constexpr std::uint8_t kTagMarker       = 0x10;
+constexpr std::uint8_t kTagGap          = 0x20;
+constexpr std::uint8_t kTagHeader       = 0xFF;
+
+// svcGetSystemTick() frequency on 3DS/New 3DS.
+constexpr std::uint32_t kTickHz = 268111856u;
+
+std::uint8_t sRing[kRingSize];
+
+volatile std::uint32_t sHead = 0;  // bytes produced (monotonic)
+volatile std::uint32_t sTail = 0;  // bytes written  (monotonic)
+
+// Producer-side delta state. Only updated for records that made it into
+// the ring, so it always matches what the decoder has seen.
+std::uint32_t sLastBound    = 0;
+std::uint32_t sLastState    = 0;
+std::uint64_t sSessionTick  = 0;
+std::uint64_t sLastMarkTick = 0;
+
+std::uint32_t          sRecordedCalls = 0;
+std::uint32_t          sPendingGap    = 0;
+volatile std::uint32_t sDropped       = 0;
+std::uint32_t          sReportedDrops = 0;
+
+LightLock sDrainLock;
+bool      sLockReady = false;
+
+File sFile;
+bool sFileOpen = false;
+
+inline void EnsureLock()
+{
+    if (sLockReady)
+        return;
+
+    LightLock_Init(&sDrainLock);
+    sLockReady = true;
+}
+
+// --- encoding helpers (producer only) ----------------------------------
+
+inline void Put8(std::uint32_t &h, std::uint8_t v)
+{
+    sRing[h & kRingMask] = v;
+    ++h;
+}
+
+inline void Put32(std::uint32_t &h, std::uint32_t v)
+{
+    Put8(h, static_cast<std::uint8_t>(v));
+    Put8(h, static_cast<std::uint8_t>(v >> 8));
+    Put8(h, static_cast<std::uint8_t>(v >> 16));
+    Put8(h, static_cast<std::uint8_t>(v >> 24));
+}
+
+inline void PutVarint(std::uint32_t &h, std::uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        Put8(h, static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    Put8(h, static_cast<std::uint8_t>(v));
+}
+
+// Reserve room for one record. Returns false (and counts the loss) if
+// the ring is full; otherwise emits any pending gap record first.
+inline bool BeginRecord(std::uint32_t &h)
+{
+    h = sHead;
+    if (kRingSize - (h - sTail) < kMaxRecordBytes)
+    {
+        ++sPendingGap;
+        ++sDropped;
+        return false;
+    }
+
+    if (sPendingGap != 0)
+    {
+        Put8(h, kTagGap);
+        PutVarint(h, sPendingGap);
+        sPendingGap = 0;
+    }
+    return true;
+}
+
+inline void CommitRecord(std::uint32_t h)
+{
+    __sync_synchronize();
+    sHead = h;
+}
+
+// --- file side ---------------------------------------------------------
+
+bool EnsureFile()
+{
+    if (sFileOpen)
+        return true;
+
+    Directory::Create(kRngDir);
+
+    if (File::Open(sFile, kRngPath, File::WRITE | File::CREATE) != 0)
+        return false;
+
+    sFile.Seek(0, File::END);
+    sFileOpen = true;
+
+    // Session header so the decoder can split multiple boots.
+    std::uint8_t hdr[18];
+    std::uint32_t hz = kTickHz;
+    hdr[0] = kTagHeader;
+    for (int i = 0; i < 4; ++i)
+        hdr[1 + i] = static_cast<std::uint8_t>(kRngRecMagic >> (8 * i));
+    hdr[5] = kRngRecVersion;
+    for (int i = 0; i < 4; ++i)
+        hdr[6 + i] = static_cast<std::uint8_t>(hz >> (8 * i));
+    for (int i = 0; i < 8; ++i)
+        hdr[10 + i] = static_cast<std::uint8_t>(sSessionTick >> (8 * i));
+    sFile.Write(hdr, sizeof(hdr));
+
+    return true;
+}
+
+// Caller holds sDrainLock.
+void DrainLocked(bool flushHandle)
+{
+    if (!EnsureFile())
+        return;
+
+    std::uint32_t tail = sTail;
+    std::uint32_t head = sHead;
+    __sync_synchronize();
+
+    std::uint32_t pending = head - tail;
+    if (pending != 0)
+    {
+        std::uint32_t off   = tail & kRingMask;
+        std::uint32_t first = kRingSize - off;
+        if (first > pending)
+            first = pending;
+
+        sFile.Write(&sRing[off], first);
+        if (pending > first)
+            sFile.Write(&sRing[0], pending - first);
+
+        __sync_synchronize();
+        sTail = head;
+    }
+
+    if (flushHandle)
+        sFile.Flush();
+
+    std::uint32_t dropped = sDropped;
+    if (dropped != sReportedDrops)
+    {
+        FATES_LOG(Warn, Engine, "RngRec: dropped %u record(s) (ring full, total=%u)",
+                                static_cast<unsigned>(dropped - sReportedDrops),
+                                static_cast<unsigned>(dropped));
+        sReportedDrops = dropped;
+    }
+}
+
+} // anonymous namespace
+
+void RngRec_SetEnabled(bool enabled)
+{
+    // Marker ticks are deltas from the session start; pin it the first
+    // time recording is switched on.
+    if (enabled && sSessionTick == 0)
+    {
+        sSessionTick  = svcGetSystemTick();
+        sLastMarkTick = sSessionTick;
+    }
+
+    gRngRecEnabled = enabled;
+    FATES_LOG(Info, Engine, "RngRec: RNG stream recorder %s (calls=%u dropped=%u)",
+                            enabled ? "ENABLED" : "DISABLED",
+                            static_cast<unsigned>(sRecordedCalls),
+                            static_cast<unsigned>(sDropped));
+}
+
+void RngRec_AppendCall(void *state, std::uint32_t raw, std::uint32_t bound)
+{
+    std::uint32_t h;
+    if (!BeginRecord(h))
+        return;
+
+    std::uint32_t st = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(state));
+
+    std::uint8_t tag = kTagCall;
+    if (bound != sLastBound)
+        tag |= kTagBoundChanged;
+    if (st != sLastState)
+        tag |= kTagStateChanged;
+
+    Put8(h, tag);
+    if (tag & kTagBoundChanged)
+    {
+        PutVarint(h, bound);
+        sLastBound = bound;
+    }
+    if (tag & kTagStateChanged)
+    {
+        Put32(h, st);
+        sLastState = st;
+    }
+    Put32(h, raw);
+
+    ++sRecordedCalls;
+    CommitRecord(h);
+}
+
+void RngRec_AppendMarker(RngMarker marker, TurnSide side, std::uint32_t arg)
+{
+    std::uint32_t h;
+    if (!BeginRecord(h))
+        return;
+
+    std::uint64_t now = svcGetSystemTick();
+
+    Put8(h, static_cast<std::uint8_t>(kTagMarker | (static_cast<std::uint8_t>(marker) & 0x0F)));
+    Put8(h, static_cast<std::uint8_t>(side));
+    PutVarint(h, now - sLastMarkTick);
+    PutVarint(h, arg);
+    sLastMarkTick = now;
+
+    CommitRecord(h);
+}
+
+void RngRec_Pump()
+{
+    if (sHead - sTail < kRingSize / 2)
+        return;
+
+    EnsureLock();
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(false);
+    LightLock_Unlock(&sDrainLock);
+}
+
+void RngRec_Flush()
+{
+    // Nothing was ever recorded this session: don't create the file.
+    if (!sFileOpen && sHead == sTail)
+        return;
+
+    EnsureLock();
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+}
+
+bool RngRec_TryFlush()
+{
+    if (!sFileOpen && sHead == sTail)
+        return true;
+
+    EnsureLock();
+    if (LightLock_TryLock(&sDrainLock) != 0)
+        return false;
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+    return true;
+}
+
+std::uint32_t RngRec_GetRecordedCalls()
+{
+    return sRecordedCalls;
+}
+
+std::uint32_t RngRec_GetDroppedRecords()
+{
+    return sDropped;
+}
+
+} // namespace Engine
+} // namespace Fates
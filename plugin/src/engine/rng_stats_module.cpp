@@ -1,18 +1,23 @@
 // rng_stats_module.cpp
 //
 // Example engine module that listens to MapBegin/MapEnd and Rng
-// events. It aggregates simple stats:
+// events. It reports simple stats:
 //
-//   * Total RNG calls this map.
-//   * RNG calls per side (by turn owner).
-//   * A small histogram of distinct "bound" values requested.
+//   * Total RNG calls this map and per side (by turn owner), read from
+//     the turn rollup, plus a derived "RngPerTurn" metric.
+//   * A small histogram of distinct "bound" values requested, which a
+//     per-side sum can't express, so the module keeps that itself.
 //
 // This is another self-contained reference for SDK users who want to
 // build telemetry-style modules.
 
 #include <cstdint>
 
-#include "engine/bus.hpp"       // Register*Handler, context types
+#include "engine/rng_stats_module.hpp"  // kRngStatsModule, handler decls
+#include "engine/arena.hpp"     // Arena_AllocArray, Arena_NoteDrop
+#include "engine/budget.hpp"    // kEngineBudget.rngBounds
+#include "engine/turn_rollup.hpp"  // TurnRollup_MapTotals, metrics
+#include "engine/bus.hpp"       // context types
 #include "util/debug_log.hpp"   // Logf
 
 namespace Fates {
@@ -20,8 +25,7 @@ namespace Engine {
 
 namespace {
 
-constexpr int kMaxSides   = 4;
-constexpr int kMaxBounds  = 8;  // cap on distinct bound values we track
+constexpr const char *kArenaTag = "RngStats";
 
 struct BoundBucket
 {
@@ -31,58 +35,49 @@ struct BoundBucket
 
 struct RngStats
 {
-    std::uint32_t totalCalls;              // total RNG calls this map
-    std::uint32_t callsPerSide[kMaxSides]; // indexed by TurnSide 0..3
-
-    BoundBucket   bounds[kMaxBounds];
+    BoundBucket  *bounds;     // kEngineBudget.rngBounds entries, Map arena
+    int           capacity;   // 0 before the first map / if the arena is full
     int           numBounds;
 };
 
 static RngStats gRngStats{};
 
-// Convert TurnSide to 0..3 index, or -1 if Unknown/out of range.
-static int SideIndex(TurnSide side)
+// RNG calls during the side's turns divided by its closed turns.
+static std::int32_t RngPerTurn(const RollupRow &r, int col)
 {
-    int idx = static_cast<int>(side);
-    if (0 <= idx && idx < kMaxSides)
-        return idx;
-    return -1;
+    return r.turns[col] ? static_cast<std::int32_t>(r.rngCalls[col] / r.turns[col]) : 0;
 }
 
+// The Map arena was just emptied; take a fresh (zeroed) histogram.
 static void ResetStats()
 {
-    gRngStats.totalCalls = 0;
-    gRngStats.numBounds  = 0;
+    gRngStats.bounds    = Arena_AllocArray<BoundBucket>(ArenaId::Map, kArenaTag,
+                                                        kEngineBudget.rngBounds);
+    gRngStats.capacity  = gRngStats.bounds ? kEngineBudget.rngBounds : 0;
+    gRngStats.numBounds = 0;
+}
+
+} // anonymous namespace
 
-    for (int i = 0; i < kMaxSides; ++i)
-        gRngStats.callsPerSide[i] = 0;
+// Bus handlers (kRngStatsModule) ------------------------------------
 
-    for (int i = 0; i < kMaxBounds; ++i)
-    {
-        gRngStats.bounds[i].bound = 0;
-        gRngStats.bounds[i].count = 0;
-    }
+void RngStatsModule_Init()
+{
+    TurnRollup_RegisterMetric("RngPerTurn", &RngPerTurn);
 }
 
-static void HandleMapBegin(const MapContext &ctx)
+void RngStatsModule_OnMapBegin(const MapContext &ctx)
 {
     ResetStats();
 
-    Logf("RngStatsModule: reset for new map (gen=%u, startSide=%s)",
-         static_cast<unsigned>(ctx.generation),
-         TurnSideToString(ctx.startSide));
+    FATES_LOG(Info, Module, "RngStatsModule: reset for new map (gen=%u, startSide=%s)",
+                            static_cast<unsigned>(ctx.generation),
+                            TurnSideToString(ctx.startSide));
 }
 
-static void HandleRng(const RngContext &ctx)
+void RngStatsModule_OnRng(const RngContext &ctx)
 {
-    ++gRngStats.totalCalls;
-
-    // Attribute call to the current side if known.
-    int idx = SideIndex(ctx.turn.side);
-    if (idx >= 0)
-        ++gRngStats.callsPerSide[idx];
-
-    // Track distinct bound values, capped at kMaxBounds.
+    // Track distinct bound values, capped at the budget.
     std::uint32_t bound = ctx.bound;
     int found = -1;
 
@@ -99,70 +94,72 @@ static void HandleRng(const RngContext &ctx)
     {
         ++gRngStats.bounds[found].count;
     }
-    else if (gRngStats.numBounds < kMaxBounds)
+    else if (gRngStats.numBounds < gRngStats.capacity)
     {
         int slot = gRngStats.numBounds++;
         gRngStats.bounds[slot].bound = bound;
         gRngStats.bounds[slot].count = 1;
     }
-    // If we exceed kMaxBounds distinct bounds, we silently drop new ones.
-    // This keeps memory usage predictable and small.
+    else
+    {
+        // Past the budget new bounds are dropped, but counted so the
+        // map-end memory report shows the budget is too small.
+        Arena_NoteDrop(kArenaTag);
+    }
 }
 
-static void HandleMapEnd(const MapContext &ctx)
+void RngStatsModule_OnMapEnd(const MapContext &ctx)
 {
-    Logf("RngStatsModule: map summary gen=%u totalTurns=%u totalRngCalls=%u",
-         static_cast<unsigned>(ctx.generation),
-         static_cast<unsigned>(ctx.totalTurns),
-         static_cast<unsigned>(gRngStats.totalCalls));
+    RngStatsTotals totals;
+    RngStatsModule_GetTotals(totals);
+
+    FATES_LOG(Info, Module, "RngStatsModule: map summary gen=%u totalTurns=%u totalRngCalls=%u",
+                            static_cast<unsigned>(ctx.generation),
+                            static_cast<unsigned>(ctx.totalTurns),
+                            static_cast<unsigned>(totals.totalCalls));
 
     // Per-side calls
-    for (int i = 0; i < kMaxSides; ++i)
+    for (int i = 0; i < kRollupSides; ++i)
     {
-        if (gRngStats.callsPerSide[i] == 0)
+        if (totals.callsPerSide[i] == 0)
             continue;
 
         TurnSide side = static_cast<TurnSide>(i);
 
-        Logf("  [%s] rngCalls=%u",
-             TurnSideToString(side),
-             static_cast<unsigned>(gRngStats.callsPerSide[i]));
+        FATES_LOG(Info, Module, "  [%s] rngCalls=%u",
+                                TurnSideToString(side),
+                                static_cast<unsigned>(totals.callsPerSide[i]));
     }
 
     // Bound histogram
     if (gRngStats.numBounds > 0)
     {
-        Logf("  Bounds seen this map (capped at %d distinct):", kMaxBounds);
+        FATES_LOG(Info, Module, "  Bounds seen this map (capped at %d distinct):", gRngStats.capacity);
         for (int i = 0; i < gRngStats.numBounds; ++i)
         {
             const BoundBucket &b = gRngStats.bounds[i];
-            Logf("    bound=%u calls=%u",
-                 static_cast<unsigned>(b.bound),
-                 static_cast<unsigned>(b.count));
+            FATES_LOG(Info, Module, "    bound=%u calls=%u",
+                                    static_cast<unsigned>(b.bound),
+                                    static_cast<unsigned>(b.count));
         }
     }
 }
 
-} // anonymous namespace
+void RngStatsModule_GetTotals(RngStatsTotals &out)
+{
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+
+    out.totalCalls = 0;
+    for (int i = 0; i < kRollupColumns; ++i)
+        out.totalCalls += total.rngCalls[i];
+    for (int i = 0; i < kRollupSides; ++i)
+        out.callsPerSide[i] = total.rngCalls[i];
+}
 
 bool RngStatsModule_RegisterHandlers()
 {
-    bool ok = true;
-
-    ok = ok && RegisterMapBeginHandler(&HandleMapBegin);
-    ok = ok && RegisterMapEndHandler(&HandleMapEnd);
-    ok = ok && RegisterRngHandler(&HandleRng);
-
-    if (ok)
-    {
-        Logf("RngStatsModule_RegisterHandlers: handlers registered");
-    }
-    else
-    {
-        Logf("RngStatsModule_RegisterHandlers: WARNING: some registrations failed");
-    }
-
-    return ok;
+    return RegisterModule(kRngStatsModule);
 }
 
 } // namespace Engine
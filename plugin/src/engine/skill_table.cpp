@@ -0,0 +1,62 @@
+// engine/skill_table.cpp
+//
+// Static skill effect table for the skill engine (engine/skills.hpp).
+//
+// To add a skill: write its effect handler(s) below and append a row to
+// kSkillDefs. Rows are bits in every unit's SkillMask, so keep the
+// table at or under kMaxTrackedSkills entries and don't list a skill
+// id twice (Skills::Init() logs and skips duplicates).
+
+#include "engine/skills.hpp"
+#include "util/debug_log.hpp"
+#include "util/log_gate.hpp"
+
+namespace Fates {
+namespace Engine {
+namespace Skills {
+
+namespace {
+
+// == Debug skill ======================================================
+//
+// "HP Change Logging for Debug Skill": any unit that learns
+// kDebugSkillId has its HP change events logged. Purely observational;
+// proves Unit_AddEquipSkill -> OnUnitSkillLearn -> mask and
+// UNIT_UpdateCloneHP -> OnHpChange -> effect end to end.
+
+// 64 lines per map, then sampled. Reset by Engine::OnMapBegin.
+LogGate sHpLogGate("SkillEngine[Debug]:HpChange", 64);
+
+void Debug_OnHpChange(const SkillDef &skill, const HpChangeContext &ctx, void *unit)
+{
+    (void)skill;
+
+    if (!(FATES_LOG_ON(Debug, Module) && LogGate_Allow(sHpLogGate)))
+        return;
+
+    const HpEvent &ev = ctx.core;
+    FATES_LOG(Debug, Module, "SkillEngine[Debug]: HpChange unit=%p amt=%d flags=0x%08X gen=%u side=%s sideTurn=%u (n=%u)",
+                             unit,
+                             ev.amount,
+                             static_cast<unsigned>(ev.flags),
+                             static_cast<unsigned>(ctx.map.generation),
+                             TurnSideToString(ctx.turn.side),
+                             static_cast<unsigned>(ctx.turn.sideTurnIndex),
+                             LogGate_Count(sHpLogGate));
+}
+
+} // anonymous namespace
+
+const SkillDef kSkillDefs[] = {
+    //  skillId        name            onHpChange         onKill   onTurnBegin
+    { kDebugSkillId, "Debug:HpLog", &Debug_OnHpChange,  nullptr, nullptr },
+};
+
+const std::size_t kNumSkillDefs = sizeof(kSkillDefs) / sizeof(kSkillDefs[0]);
+
+static_assert(sizeof(kSkillDefs) / sizeof(kSkillDefs[0]) <= kMaxTrackedSkills,
+              "kSkillDefs has more rows than SkillMask has bits");
+
+} // namespace Skills
+} // namespace Engine
+} // namespace Fates
@@ -1,28 +1,27 @@
 // engine/skills.cpp
 //
-// First-pass skill engine wiring for Fates-3GX-SDK.
+// Skill engine core for Fates-3GX-SDK. See engine/skills.hpp.
 //
-// This module registers handlers with the engine event bus and
-// implements a single debug feature:
+//   - Unit_AddEquipSkill -> OnUnitSkillLearn -> set the skill's bit in
+//     the unit's SkillMask (per-map, on the shared unit index slot).
+//   - HpChange / Kill / TurnBegin -> AND the unit's mask with that
+//     event's mask -> run the effect handler of every set bit.
 //
-//   "HP Change Logging for Debug Skill":
-//       Any unit that learns a specific debug skill ID will have
-//       its HP change events logged via the engine event bus.
+// The effects themselves live in engine/skill_table.cpp.
 //
-// The goal is to prove end-to-end wiring without mutating HP:
-//   - Unit_AddEquipSkill -> OnUnitSkillLearn -> skill table
-//   - UNIT_UpdateCloneHP -> OnUnitHpSync -> OnHpChange
-//   - Skill engine handler filters by skill and logs context.
-//
-// No gameplay behavior is changed; this is purely observational.
-//
-// v0.1: The HP logging is now tracked *per-map* using the
-//       map generation index, so this module also serves as an
-//       example of how to keep lightweight per-map state.
+// Masks are tracked *per map*: they hang off the unit index, which is
+// reset at map begin. Learns seen while no map is open (data load
+// before the first map, or between maps) are parked in a small pending
+// list and applied at the next MapBegin. At MapEnd the map's masks are
+// parked there too, and carried into the next map for the units its
+// carry-over (Engine::GetCarriedUnits) brings back.
 
 #include "engine/skills.hpp"
+#include "engine/arena.hpp"
+#include "engine/budget.hpp"
 #include "engine/bus.hpp"
 #include "engine/events.hpp"
+#include "engine/unit_index.hpp"
 #include "util/debug_log.hpp"
 
 #include <cstdint>
@@ -32,202 +31,361 @@ namespace Engine {
 
 namespace {
 
-// TEMP: Debug skill ID that marks units whose HP changes log.
-// Feel free to change this to a proper custom skill ID.
-constexpr std::uint16_t kDebugSkillId = 0x000E;
+using namespace Skills;
 
-// Tiny side-table of units that have the debug skill.
-// Track raw unit pointers (UnitHandle::Raw()) and do a linear scan.
-// This is intentionally small and simple.
-constexpr int kMaxDebugSkillUnits = 64;
+enum SkillEvent
+{
+    SkillEvent_HpChange,
+    SkillEvent_Kill,
+    SkillEvent_TurnBegin,
+    SkillEvent_Count
+};
 
-void *sDebugSkillUnits[kMaxDebugSkillUnits] = {};
-int   sNumDebugSkillUnits = 0;
+struct UnitSkills
+{
+    SkillMask bits;
+};
 
-// One-time initialisation guard for Skills::InitDebugSkills().
-bool sInitialized = false;
+UnitSlotTable<UnitSkills> sUnitSkills;
 
-// Per-map logging state for HP-change events.
-// We track which map generation we've seen and how many lines
-// we've logged for that generation, then cap at 64 per map.
-struct DebugHpLogState
+// Learns outside map play. Only touched then, so a linear scan is fine.
+// kEngineBudget.pendingLearns entries from the Plugin arena, allocated
+// by Init().
+constexpr const char *kArenaTag = "SkillEngine";
+
+struct PendingLearns
 {
-    unsigned int lastGeneration;
-    int          countThisMap;
+    void     *unit;
+    SkillMask bits;
+    bool      carried;  // parked at MapEnd, not learned since
 };
 
-DebugHpLogState sHpLogState = { 0u, 0 };
+PendingLearns *sPending         = nullptr;
+int            sPendingCapacity = 0;
+int            sNumPending      = 0;
+
+// Rows of kSkillDefs that handle each event kind, and all usable rows
+// (duplicates and rows past kMaxTrackedSkills excluded).
+SkillMask sEventMask[SkillEvent_Count] = {};
+SkillMask sValidMask = 0;
+
+// True between MapBegin and MapEnd (in bus delivery order).
+bool sMapOpen = false;
+
+// One-time initialisation guard for Skills::Init().
+bool sInitialized = false;
+
+inline SkillMask Bit(std::size_t row)
+{
+    return SkillMask(1) << row;
+}
+
+// Row (== bit) for a skill id, or -1 if it isn't tracked. Learns are
+// rare, so a scan over the table is fine here.
+int RowForSkill(std::uint16_t skillId)
+{
+    for (std::size_t i = 0; i < kNumSkillDefs && i < kMaxTrackedSkills; ++i)
+    {
+        if ((sValidMask & Bit(i)) && kSkillDefs[i].skillId == skillId)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
 
-void ClearDebugSkillUnits()
+PendingLearns *FindPending(void *unitRaw)
 {
-    sNumDebugSkillUnits = 0;
+    for (int i = 0; i < sNumPending; ++i)
+    {
+        if (sPending[i].unit == unitRaw)
+            return &sPending[i];
+    }
+    return nullptr;
 }
 
-// Add a unit to the debug-skill table if there's room. No-op if
-// it's already present.
-void RegisterDebugSkillUnit(void *unitRaw)
+SkillMask LookupMask(void *unitRaw)
 {
     if (unitRaw == nullptr)
+        return 0;
+
+    if (!sMapOpen)
+    {
+        const PendingLearns *p = FindPending(unitRaw);
+        return p ? p->bits : 0;
+    }
+
+    const UnitSkills *s = sUnitSkills.Peek(UnitIndex_Find(unitRaw));
+    return s ? s->bits : 0;
+}
+
+// Add 'bits' to the unit's mask in the current map's slot table.
+// Returns false if the unit index is full.
+bool AddToSlot(void *unitRaw, SkillMask bits)
+{
+    UnitSkills *s = sUnitSkills.Get(UnitIndex_Acquire(unitRaw));
+    if (s == nullptr)
+        return false;
+
+    s->bits |= bits;
+    return true;
+}
+
+// Record learned skill bits: directly if a map is open, otherwise in
+// the pending list.
+void AddUnitSkills(void *unitRaw, SkillMask bits)
+{
+    if (sMapOpen)
+    {
+        AddToSlot(unitRaw, bits);
         return;
+    }
 
-    // Already tracked?
-    for (int i = 0; i < sNumDebugSkillUnits; ++i)
+    if (PendingLearns *p = FindPending(unitRaw))
     {
-        if (sDebugSkillUnits[i] == unitRaw)
-            return;
+        p->bits   |= bits;
+        p->carried = false;
+        return;
     }
 
-    if (sNumDebugSkillUnits >= kMaxDebugSkillUnits)
+    if (sNumPending >= sPendingCapacity)
     {
         static bool sLogged = false;
         if (!sLogged)
         {
-            Logf("SkillEngine[Debug]: debug-skill table full (cap=%d)", kMaxDebugSkillUnits);
+            FATES_LOG(Warn, Module, "SkillEngine: pending learn list full (cap=%d)", sPendingCapacity);
             sLogged = true;
         }
+        Arena_NoteDrop(kArenaTag);
         return;
     }
 
-    sDebugSkillUnits[sNumDebugSkillUnits++] = unitRaw;
-
-    Logf("SkillEngine[Debug]: unit=%p marked as having debug skill (count=%d)",
-         unitRaw,
-         sNumDebugSkillUnits);
+    sPending[sNumPending].unit    = unitRaw;
+    sPending[sNumPending].bits    = bits;
+    sPending[sNumPending].carried = false;
+    ++sNumPending;
 }
 
-// Check if a unit is in the debug-skill table.
-bool UnitHasDebugSkill(void *unitRaw)
+void Kill_DispatchFor(const KillContext &ctx, void *unit)
 {
-    if (unitRaw == nullptr)
-        return false;
+    SkillMask m = LookupMask(unit) & sEventMask[SkillEvent_Kill];
+    while (m != 0)
+    {
+        const int row = __builtin_ctzll(m);
+        m &= m - 1;
+        kSkillDefs[row].onKill(kSkillDefs[row], ctx, unit);
+    }
+}
 
-    for (int i = 0; i < sNumDebugSkillUnits; ++i)
+// Fill sValidMask / sEventMask from kSkillDefs.
+void BuildMasks()
+{
+    for (std::size_t i = 0; i < kNumSkillDefs; ++i)
     {
-        if (sDebugSkillUnits[i] == unitRaw)
-            return true;
+        const SkillDef &def = kSkillDefs[i];
+
+        if (i >= kMaxTrackedSkills)
+        {
+            FATES_LOG(Info, Module, "SkillEngine: skill 0x%04X (%s) ignored, more than %u skills",
+                                    static_cast<unsigned>(def.skillId), def.name,
+                                    static_cast<unsigned>(kMaxTrackedSkills));
+            continue;
+        }
+
+        if (RowForSkill(def.skillId) >= 0)
+        {
+            FATES_LOG(Info, Module, "SkillEngine: skill 0x%04X (%s) listed twice, row %u ignored",
+                                    static_cast<unsigned>(def.skillId), def.name,
+                                    static_cast<unsigned>(i));
+            continue;
+        }
+
+        sValidMask |= Bit(i);
+        if (def.onHpChange)
+            sEventMask[SkillEvent_HpChange] |= Bit(i);
+        if (def.onKill)
+            sEventMask[SkillEvent_Kill] |= Bit(i);
+        if (def.onTurnBegin)
+            sEventMask[SkillEvent_TurnBegin] |= Bit(i);
     }
-    return false;
 }
 
-// == Bus handlers ====================================================
+} // anonymous namespace
+
+namespace Skills {
+
+// == Bus handlers (kSkillEngineModule) ==============================
+
+// Map begin: the unit index was just reset and the carried-over units
+// re-indexed; move learns that happened outside the map into this map's
+// slot table. Masks carried from the last map only follow units that
+// were carried over.
+void OnMapBegin(const MapContext &ctx)
+{
+    sMapOpen = true;
+
+    int applied = 0;
+    int left    = 0;
+    for (int i = 0; i < sNumPending; ++i)
+    {
+        const PendingLearns &p = sPending[i];
+        if (p.carried && UnitIndex_Find(p.unit) == kInvalidUnitSlot)
+        {
+            ++left;
+            continue;
+        }
+        if (AddToSlot(p.unit, p.bits))
+            ++applied;
+    }
+    sNumPending = 0;
+
+    if (applied > 0 || left > 0)
+    {
+        FATES_LOG(Info, Module, "SkillEngine: MapBegin gen=%u -> applied pending skills for %d unit(s), %d carried unit(s) left behind",
+                                static_cast<unsigned>(ctx.generation),
+                                applied, left);
+    }
+}
 
-// Map end: clear per-map skill state.
-void MapEnd_DebugSkillReset(const MapContext &ctx)
+// Map end: per-map masks go away with the next index reset, so park
+// them (as carried) with whatever learns come in before the next map.
+void OnMapEnd(const MapContext &ctx)
 {
     (void)ctx;
 
-    ClearDebugSkillUnits();
-    sHpLogState.countThisMap = 0;
-    sHpLogState.lastGeneration = 0u;
+    sMapOpen    = false;
+    sNumPending = 0;
+
+    const int n = UnitIndex_Count();
+    for (int slot = 0; slot < n; ++slot)
+    {
+        const UnitSkills *s = sUnitSkills.Peek(slot);
+        if (s == nullptr || s->bits == 0)
+            continue;
+
+        if (sNumPending >= sPendingCapacity)
+        {
+            Arena_NoteDrop(kArenaTag);
+            continue;
+        }
 
-    Logf("SkillEngine[Debug]: MapEnd -> cleared debug-skill table and reset HP log state");
+        PendingLearns &p = sPending[sNumPending++];
+        p.unit    = UnitIndex_GetUnit(slot);
+        p.bits    = s->bits;
+        p.carried = true;
+    }
 }
 
-// Skill learn: if a unit successfully learns the debug skill, track it.
-void SkillLearn_DebugTrackUnit(const SkillLearnContext &ctx)
+// Skill learn: set the skill's bit if it is tracked.
+void OnSkillLearn(const SkillLearnContext &ctx)
 {
     // Only care about successful learns.
     if (ctx.result <= 0)
         return;
 
-    if (ctx.skillId != kDebugSkillId)
+    void *unitRaw = ctx.unit.Raw();
+    if (unitRaw == nullptr)
         return;
 
-    void *unitRaw = ctx.unit.Raw();
-    RegisterDebugSkillUnit(unitRaw);
+    int row = RowForSkill(ctx.skillId);
+    if (row < 0)
+        return;
+
+    if (LookupMask(unitRaw) & Bit(static_cast<std::size_t>(row)))
+        return;
+
+    AddUnitSkills(unitRaw, Bit(static_cast<std::size_t>(row)));
+    FATES_LOG(Info, Module, "SkillEngine: unit=%p learned tracked skill 0x%04X (%s)",
+                            unitRaw,
+                            static_cast<unsigned>(ctx.skillId),
+                            kSkillDefs[row].name);
 }
 
-// HP change: log HP changes only if the *target* has the debug skill.
-// Logging is capped *per map* using the generation index.
-void HpChange_DebugLogForMarkedUnit(const HpChangeContext &ctx)
+void OnHpChange(const HpChangeContext &ctx)
 {
-    const HpEvent &ev = ctx.core;
-
-    void *targetUnit = ev.target.Raw();
-    if (targetUnit == nullptr)
+    if (sEventMask[SkillEvent_HpChange] == 0)
         return;
 
-    if (!UnitHasDebugSkill(targetUnit))
-        return;
+    void *target = ctx.core.target.Raw();
 
-    // Handle map-generation boundaries. If the generation changes,
-    // treat it as a new map and reset the per-map log counter.
-    unsigned int gen = static_cast<unsigned int>(ctx.map.generation);
-    if (gen != sHpLogState.lastGeneration)
+    SkillMask m = LookupMask(target) & sEventMask[SkillEvent_HpChange];
+    while (m != 0)
     {
-        sHpLogState.lastGeneration = gen;
-        sHpLogState.countThisMap   = 0;
+        const int row = __builtin_ctzll(m);
+        m &= m - 1;
+        kSkillDefs[row].onHpChange(kSkillDefs[row], ctx, target);
     }
+}
 
-    // Lightweight logging so that the handler is firing, but capped
-    // per map so it won't spam the log indefinitely.
-    if (sHpLogState.countThisMap >= 64)
+void OnKill(const KillContext &ctx)
+{
+    if (sEventMask[SkillEvent_Kill] == 0)
         return;
 
-    ++sHpLogState.countThisMap;
-
-    Logf("SkillEngine[Debug]: HpChange unit=%p amt=%d flags=0x%08X gen=%u side=%s sideTurn=%u (log=%d/64)",
-         targetUnit,
-         ev.amount,
-         static_cast<unsigned>(ev.flags),
-         static_cast<unsigned>(ctx.map.generation),
-         TurnSideToString(ctx.turn.side),
-         static_cast<unsigned>(ctx.turn.sideTurnIndex),
-         sHpLogState.countThisMap);
+    Kill_DispatchFor(ctx, ctx.core.dead0);
+    if (ctx.core.dead1 != ctx.core.dead0)
+        Kill_DispatchFor(ctx, ctx.core.dead1);
 }
 
-} // anonymous namespace
-
-namespace Skills {
-
-void InitDebugSkills()
+void OnTurnBegin(const TurnContext &ctx)
 {
-    if (sInitialized)
+    const SkillMask want = sEventMask[SkillEvent_TurnBegin];
+    if (!sMapOpen || want == 0)
         return;
 
-    sInitialized = true;
-    ClearDebugSkillUnits();
-    sHpLogState.lastGeneration = 0u;
-    sHpLogState.countThisMap   = 0;
+    const int n = UnitIndex_Count();
+    for (int slot = 0; slot < n; ++slot)
+    {
+        const UnitSkills *s = sUnitSkills.Peek(slot);
+        if (s == nullptr)
+            continue;
 
-    bool okEnd   = RegisterMapEndHandler(&MapEnd_DebugSkillReset);
-    bool okLearn = RegisterSkillLearnHandler(&SkillLearn_DebugTrackUnit);
-    bool okHp    = RegisterHpChangeHandler(&HpChange_DebugLogForMarkedUnit);
+        SkillMask m = s->bits & want;
+        if (m == 0)
+            continue;
 
-    if (!okEnd || !okLearn || !okHp)
-    {
-        Logf("SkillEngine[Debug]: InitDebugSkills FAILED (end=%d learn=%d hp=%d)",
-             okEnd ? 1 : 0,
-             okLearn ? 1 : 0,
-             okHp ? 1 : 0);
-    }
-    else
-    {
-        Logf("SkillEngine[Debug]: InitDebugSkills complete (debugSkillId=0x%04X, hpLogCapPerMap=%d)",
-             static_cast<unsigned>(kDebugSkillId),
-             64);
+        void *unit = UnitIndex_GetUnit(slot);
+        while (m != 0)
+        {
+            const int row = __builtin_ctzll(m);
+            m &= m - 1;
+            kSkillDefs[row].onTurnBegin(kSkillDefs[row], ctx, unit);
+        }
     }
 }
 
-} // namespace Skills
+void Init()
+{
+    if (sInitialized)
+        return;
 
-namespace {
+    sInitialized     = true;
+    sPending         = Arena_AllocArray<PendingLearns>(ArenaId::Plugin, kArenaTag,
+                                                       kEngineBudget.pendingLearns);
+    sPendingCapacity = sPending ? kEngineBudget.pendingLearns : 0;
+    sNumPending      = 0;
 
-// Static bootstrap so debug skill is registered automatically
-// when the plugin is loaded. If you ever prefer explicit initialisation,
-// you can remove this and instead call
-// Fates::Engine::Skills::InitDebugSkills();
-struct SkillEngineBootstrap
+    BuildMasks();
+
+    FATES_LOG(Info, Module, "SkillEngine: Init complete (%u skill(s), hp=0x%llX kill=0x%llX turnBegin=0x%llX)",
+                            static_cast<unsigned>(__builtin_popcountll(sValidMask)),
+                            static_cast<unsigned long long>(sEventMask[SkillEvent_HpChange]),
+                            static_cast<unsigned long long>(sEventMask[SkillEvent_Kill]),
+                            static_cast<unsigned long long>(sEventMask[SkillEvent_TurnBegin]));
+}
+
+SkillMask GetUnitSkills(void *unitRaw)
 {
-    SkillEngineBootstrap()
-    {
-        Skills::InitDebugSkills();
-    }
-};
+    return LookupMask(unitRaw);
+}
 
-static SkillEngineBootstrap sSkillEngineBootstrap;
+bool UnitHasSkill(void *unitRaw, std::uint16_t skillId)
+{
+    int row = RowForSkill(skillId);
+    if (row < 0)
+        return false;
+    return (LookupMask(unitRaw) & Bit(static_cast<std::size_t>(row))) != 0;
+}
 
-} // anonymous namespace
+} // namespace Skills
 
 } // namespace Engine
 } // namespace Fates
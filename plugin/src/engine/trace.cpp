@@ -0,0 +1,205 @@
+// engine/trace.cpp
+//
+// Binary event trace sink. See engine/trace.hpp for the record format.
+//
+// All producers are Engine::On* entrypoints, which only run on the game
+// thread, so the ring is single-producer: the producer fills the slot
+// at head and then publishes head; the drain writes [tail, head) in at
+// most two contiguous chunks and then publishes tail. A light lock only
+// serialises the drain itself (Trace_Pump from the worker's periodic
+// pass vs. Trace_Flush from a posted job or plugin exit).
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+
+#include "engine/trace.hpp"
+#include "util/debug_log.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace Fates {
+namespace Engine {
+
+volatile bool gTraceEnabled = false;
+
+namespace {
+
+constexpr const char *kTraceDir  = "sdmc:/Fates3GX";
+constexpr const char *kTracePath = "sdmc:/Fates3GX/fates_trace.bin";
+
+// 512 records = 16 KB. Must be a power of two.
+constexpr std::uint32_t kTraceCapacity = 512;
+constexpr std::uint32_t kTraceMask     = kTraceCapacity - 1;
+
+// svcGetSystemTick() frequency on 3DS/New 3DS.
+constexpr std::uint32_t kTickHz = 268111856u;
+
+TraceRecord sRing[kTraceCapacity];
+
+volatile std::uint32_t sHead = 0;  // records produced (monotonic)
+volatile std::uint32_t sTail = 0;  // records written  (monotonic)
+
+volatile std::uint32_t sDropped       = 0;
+std::uint32_t          sReportedDrops = 0;
+
+LightLock sDrainLock;
+bool      sLockReady = false;
+
+File sFile;
+bool sFileOpen = false;
+
+inline void EnsureLock()
+{
+    if (sLockReady)
+        return;
+
+    LightLock_Init(&sDrainLock);
+    sLockReady = true;
+}
+
+bool EnsureFile()
+{
+    if (sFileOpen)
+        return true;
+
+    Directory::Create(kTraceDir);
+
+    if (File::Open(sFile, kTracePath, File::WRITE | File::CREATE) != 0)
+        return false;
+
+    sFile.Seek(0, File::END);
+    sFileOpen = true;
+
+    // Session header so the decoder can split multiple boots.
+    TraceRecord hdr{};
+    hdr.tick       = svcGetSystemTick();
+    hdr.kind       = kTraceKindHeader;
+    hdr.side       = static_cast<std::uint8_t>(TurnSide::Unknown);
+    hdr.generation = sizeof(TraceRecord);
+    hdr.arg[0]     = kTraceMagic;
+    hdr.arg[1]     = kTraceVersion;
+    hdr.arg[2]     = kTickHz;
+    sFile.Write(&hdr, sizeof(hdr));
+
+    return true;
+}
+
+// Caller holds sDrainLock.
+void DrainLocked(bool flushHandle)
+{
+    if (!EnsureFile())
+        return;
+
+    std::uint32_t tail = sTail;
+    std::uint32_t head = sHead;
+    __sync_synchronize();
+
+    std::uint32_t pending = head - tail;
+    if (pending != 0)
+    {
+        std::uint32_t off   = tail & kTraceMask;
+        std::uint32_t first = kTraceCapacity - off;
+        if (first > pending)
+            first = pending;
+
+        sFile.Write(&sRing[off], first * sizeof(TraceRecord));
+        if (pending > first)
+            sFile.Write(&sRing[0], (pending - first) * sizeof(TraceRecord));
+
+        __sync_synchronize();
+        sTail = head;
+    }
+
+    if (flushHandle)
+        sFile.Flush();
+
+    std::uint32_t dropped = sDropped;
+    if (dropped != sReportedDrops)
+    {
+        FATES_LOG(Warn, Engine, "Trace: dropped %u record(s) (ring full, total=%u)",
+                                static_cast<unsigned>(dropped - sReportedDrops),
+                                static_cast<unsigned>(dropped));
+        sReportedDrops = dropped;
+    }
+}
+
+} // anonymous namespace
+
+void Trace_SetEnabled(bool enabled)
+{
+    gTraceEnabled = enabled;
+    FATES_LOG(Info, Engine, "Trace: binary event trace %s", enabled ? "ENABLED" : "DISABLED");
+}
+
+void Trace_Append(EventKind kind,
+                  TurnSide side,
+                  std::uint32_t a0,
+                  std::uint32_t a1,
+                  std::uint32_t a2,
+                  std::uint32_t a3)
+{
+    std::uint32_t head = sHead;
+    if (head - sTail >= kTraceCapacity)
+    {
+        ++sDropped;
+        return;
+    }
+
+    TraceRecord &r = sRing[head & kTraceMask];
+    r.tick       = svcGetSystemTick();
+    r.kind       = static_cast<std::uint16_t>(kind);
+    r.side       = static_cast<std::uint8_t>(side);
+    r.flags      = 0;
+    r.generation = gMapState.generation;
+    r.arg[0]     = a0;
+    r.arg[1]     = a1;
+    r.arg[2]     = a2;
+    r.arg[3]     = a3;
+
+    __sync_synchronize();
+    sHead = head + 1;
+}
+
+void Trace_Pump()
+{
+    if (sHead - sTail < kTraceCapacity / 2)
+        return;
+
+    EnsureLock();
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(false);
+    LightLock_Unlock(&sDrainLock);
+}
+
+void Trace_Flush()
+{
+    // Nothing was ever traced this session: don't create the file.
+    if (!sFileOpen && sHead == sTail)
+        return;
+
+    EnsureLock();
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+}
+
+bool Trace_TryFlush()
+{
+    if (!sFileOpen && sHead == sTail)
+        return true;
+
+    EnsureLock();
+    if (LightLock_TryLock(&sDrainLock) != 0)
+        return false;
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+    return true;
+}
+
+std::uint32_t Trace_GetDroppedRecords()
+{
+    return sDropped;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,263 @@
+// engine/turn_rollup.cpp
+//
+// Per-turn prefix-sum aggregates. See engine/turn_rollup.hpp.
+//
+// sPrefix[n] is the sum of closed turns 0..n-1 (sPrefix[0] stays zero),
+// so a range is sPrefix[last + 1] - sPrefix[first]. MapBegin only resets
+// the open row and the close count; stale prefix rows are overwritten
+// before they are read again.
+
+#include <cstring>
+
+#include "engine/turn_rollup.hpp"
+#include "engine/bus.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+RollupRow      sPrefix[kRollupMaxTurns + 1];
+RollupTurnInfo sTurnInfo[kRollupMaxTurns];
+RollupRow      sOpen{};
+
+int           sClosed        = 0;
+std::uint32_t sOverflowTurns = 0;  // closes past kRollupMaxTurns this map
+int           sLastTurnOf[kRollupSides] = { -1, -1, -1, -1 };
+
+struct MetricDef
+{
+    const char    *name;
+    RollupMetricFn fn;
+};
+
+MetricDef sMetrics[kRollupMaxMetrics];
+int       sNumMetrics = 0;
+
+inline int Column(TurnSide side)
+{
+    const int idx = static_cast<int>(side);
+    return (0 <= idx && idx < kRollupSides) ? idx : kRollupUnattributed;
+}
+
+void AddRow(RollupRow &dst, const RollupRow &a, const RollupRow &b)
+{
+    for (int c = 0; c < kRollupColumns; ++c)
+    {
+        dst.damage[c]   = a.damage[c]   + b.damage[c];
+        dst.heals[c]    = a.heals[c]    + b.heals[c];
+        dst.kills[c]    = a.kills[c]    + b.kills[c];
+        dst.rngCalls[c] = a.rngCalls[c] + b.rngCalls[c];
+        dst.hpEvents[c] = a.hpEvents[c] + b.hpEvents[c];
+        dst.turns[c]    = a.turns[c]    + b.turns[c];
+    }
+}
+
+void SubRow(RollupRow &dst, const RollupRow &a, const RollupRow &b)
+{
+    for (int c = 0; c < kRollupColumns; ++c)
+    {
+        dst.damage[c]   = a.damage[c]   - b.damage[c];
+        dst.heals[c]    = a.heals[c]    - b.heals[c];
+        dst.kills[c]    = a.kills[c]    - b.kills[c];
+        dst.rngCalls[c] = a.rngCalls[c] - b.rngCalls[c];
+        dst.hpEvents[c] = a.hpEvents[c] - b.hpEvents[c];
+        dst.turns[c]    = a.turns[c]    - b.turns[c];
+    }
+}
+
+} // anonymous namespace
+
+// Bus handlers (kTurnRollupModule) ----------------------------------
+
+void TurnRollup_OnMapBegin(const MapContext &ctx)
+{
+    (void)ctx;
+
+    sOpen          = RollupRow{};
+    sClosed        = 0;
+    sOverflowTurns = 0;
+    for (int i = 0; i < kRollupSides; ++i)
+        sLastTurnOf[i] = -1;
+}
+
+void TurnRollup_OnTurnEnd(const TurnContext &ctx)
+{
+    const int col = Column(ctx.side);
+    ++sOpen.turns[col];
+
+    if (sClosed >= kRollupMaxTurns)
+    {
+        // Table full: keep accumulating so map totals stay exact.
+        ++sOverflowTurns;
+        return;
+    }
+
+    AddRow(sPrefix[sClosed + 1], sPrefix[sClosed], sOpen);
+
+    RollupTurnInfo &info = sTurnInfo[sClosed];
+    info.side          = ctx.side;
+    info.sideTurnIndex = ctx.sideTurnIndex;
+    info.totalTurns    = ctx.map.totalTurns;
+
+    if (col < kRollupSides)
+        sLastTurnOf[col] = sClosed;
+
+    ++sClosed;
+    sOpen = RollupRow{};
+}
+
+void TurnRollup_OnHpChange(const HpChangeContext &ctx)
+{
+    // Gross breakdown: a coalesced event's net amount can hide a heal
+    // and a hit that cancel out.
+    if (ctx.damage == 0 && ctx.healing == 0)
+        return;
+
+    const int col = Column(ctx.turn.side);
+    ++sOpen.hpEvents[col];
+    sOpen.damage[col] += ctx.damage;
+    sOpen.heals[col]  += ctx.healing;
+}
+
+void TurnRollup_OnKill(const KillContext &ctx)
+{
+    ++sOpen.kills[Column(ctx.turn.side)];
+}
+
+void TurnRollup_OnRng(const RngContext &ctx)
+{
+    ++sOpen.rngCalls[Column(ctx.turn.side)];
+}
+
+void TurnRollup_OnMapEnd(const MapContext &ctx)
+{
+    if (sOverflowTurns != 0)
+        FATES_LOG(Info, Module, "TurnRollup: gen=%u closedTurns=%d, %u more past the %d-turn table (totals only)",
+                                static_cast<unsigned>(ctx.generation), sClosed,
+                                static_cast<unsigned>(sOverflowTurns), kRollupMaxTurns);
+    else
+        FATES_LOG(Info, Module, "TurnRollup: gen=%u closedTurns=%d metrics=%d",
+                                static_cast<unsigned>(ctx.generation), sClosed, sNumMetrics);
+
+    if (sNumMetrics == 0)
+        return;
+
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+
+    for (int i = 0; i < sNumMetrics; ++i)
+    {
+        const MetricDef &m = sMetrics[i];
+        FATES_LOG(Info, Module, "  %s: S0=%d S1=%d S2=%d S3=%d",
+                                m.name,
+                                static_cast<int>(m.fn(total, 0)),
+                                static_cast<int>(m.fn(total, 1)),
+                                static_cast<int>(m.fn(total, 2)),
+                                static_cast<int>(m.fn(total, 3)));
+    }
+}
+
+// Public API ---------------------------------------------------------
+
+bool TurnRollup_RegisterHandlers()
+{
+    return RegisterModule(kTurnRollupModule);
+}
+
+int TurnRollup_ClosedTurns()
+{
+    return sClosed;
+}
+
+bool TurnRollup_Range(int first, int last, RollupRow &out)
+{
+    if (first < 0)
+        first = 0;
+    if (last >= sClosed)
+        last = sClosed - 1;
+
+    if (first > last)
+    {
+        out = RollupRow{};
+        return false;
+    }
+
+    SubRow(out, sPrefix[last + 1], sPrefix[first]);
+    return true;
+}
+
+void TurnRollup_Open(RollupRow &out)
+{
+    out = sOpen;
+}
+
+void TurnRollup_MapTotals(RollupRow &out)
+{
+    AddRow(out, sPrefix[sClosed], sOpen);
+}
+
+int TurnRollup_LastTurnOf(TurnSide side)
+{
+    const int col = Column(side);
+    return (col < kRollupSides) ? sLastTurnOf[col] : -1;
+}
+
+bool TurnRollup_GetTurnInfo(int turn, RollupTurnInfo &out)
+{
+    if (turn < 0 || turn >= sClosed)
+        return false;
+
+    out = sTurnInfo[turn];
+    return true;
+}
+
+int TurnRollup_RegisterMetric(const char *name, RollupMetricFn fn)
+{
+    if (name == nullptr || fn == nullptr)
+        return -1;
+
+    const int existing = TurnRollup_FindMetric(name);
+    if (existing >= 0)
+        return existing;
+
+    if (sNumMetrics >= kRollupMaxMetrics)
+    {
+        FATES_LOG(Warn, Module, "TurnRollup_RegisterMetric: capacity full (%d), %s not registered",
+                                kRollupMaxMetrics, name);
+        return -1;
+    }
+
+    sMetrics[sNumMetrics] = MetricDef{ name, fn };
+    return sNumMetrics++;
+}
+
+int TurnRollup_FindMetric(const char *name)
+{
+    if (name == nullptr)
+        return -1;
+
+    for (int i = 0; i < sNumMetrics; ++i)
+    {
+        if (std::strcmp(sMetrics[i].name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+bool TurnRollup_QueryMetric(int id, int first, int last, int column, std::int32_t &out)
+{
+    if (id < 0 || id >= sNumMetrics || column < 0 || column >= kRollupColumns)
+        return false;
+
+    RollupRow range;
+    if (!TurnRollup_Range(first, last, range))
+        return false;
+
+    out = sMetrics[id].fn(range, column);
+    return true;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -0,0 +1,166 @@
+// engine/unit_index.cpp
+//
+// Open-addressed Unit* index. See engine/unit_index.hpp.
+//
+// The bucket table is twice the slot capacity so the load factor stays
+// at or below 0.5 and probe chains stay short. A bucket is live only if
+// its stamp equals sStamp; every other bucket reads as empty.
+
+#include "engine/unit_index.hpp"
+#include "engine/unit_layout.hpp"
+#include "util/debug_log.hpp"
+#include "util/safe_read.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+constexpr std::uint32_t kBucketCount = kUnitIndexCapacity * 2;
+constexpr std::uint32_t kBucketMask  = kBucketCount - 1;
+
+static_assert((kUnitIndexCapacity & (kUnitIndexCapacity - 1)) == 0,
+              "kUnitIndexCapacity must be a power of two");
+
+struct Bucket
+{
+    void         *unit;
+    std::uint32_t stamp;
+    std::int32_t  slot;
+};
+
+Bucket sBuckets[kBucketCount] = {};
+void  *sSlotUnits[kUnitIndexCapacity] = {};
+int    sCount = 0;
+
+// Start at 1 so zero-initialised buckets/tables read as stale.
+std::uint32_t sStamp = 1;
+
+inline std::uint32_t HashUnit(void *unit)
+{
+    // Unit objects are at least word aligned; drop the low bits, then
+    // Fibonacci-hash into the bucket range.
+    std::uint32_t v = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(unit)) >> 2;
+    return (v * 0x9E3779B1u) & kBucketMask;
+}
+
+// Returns the bucket holding 'unit', or the first stale bucket on its
+// probe chain (where it would be inserted).
+inline Bucket &Probe(void *unit)
+{
+    std::uint32_t i = HashUnit(unit);
+    for (;;)
+    {
+        Bucket &b = sBuckets[i];
+        if (b.stamp != sStamp || b.unit == unit)
+            return b;
+        i = (i + 1) & kBucketMask;
+    }
+}
+
+} // anonymous namespace
+
+int UnitIndex_Acquire(void *unit)
+{
+    if (unit == nullptr)
+        return kInvalidUnitSlot;
+
+    Bucket &b = Probe(unit);
+    if (b.stamp == sStamp)
+        return b.slot;
+
+    if (sCount >= kUnitIndexCapacity)
+    {
+        static std::uint32_t sLoggedStamp = 0;
+        if (sLoggedStamp != sStamp)
+        {
+            FATES_LOG(Warn, Engine, "Engine::UnitIndex: full (cap=%d), unit=%p not indexed",
+                                    kUnitIndexCapacity, unit);
+            sLoggedStamp = sStamp;
+        }
+        return kInvalidUnitSlot;
+    }
+
+    int slot = sCount++;
+    b.unit  = unit;
+    b.stamp = sStamp;
+    b.slot  = slot;
+    sSlotUnits[slot] = unit;
+    return slot;
+}
+
+int UnitIndex_Find(void *unit)
+{
+    if (unit == nullptr)
+        return kInvalidUnitSlot;
+
+    const Bucket &b = Probe(unit);
+    return (b.stamp == sStamp) ? b.slot : kInvalidUnitSlot;
+}
+
+void *UnitIndex_GetUnit(int slot)
+{
+    if (slot < 0 || slot >= sCount)
+        return nullptr;
+    return sSlotUnits[slot];
+}
+
+int UnitIndex_Count()
+{
+    return sCount;
+}
+
+std::uint32_t UnitIndex_Generation()
+{
+    return sStamp;
+}
+
+void UnitIndex_Reset()
+{
+    sCount = 0;
+
+    // A stamp wrap would resurrect buckets from 2^32 maps ago; clear
+    // them once instead (never happens in practice).
+    if (++sStamp == 0)
+    {
+        for (std::uint32_t i = 0; i < kBucketCount; ++i)
+            sBuckets[i].stamp = 0;
+        sStamp = 1;
+    }
+}
+
+int UnitIndex_ReadSummaries(UnitSummary *out, int max)
+{
+    if (out == nullptr || max <= 0)
+        return 0;
+
+    int written = 0;
+    for (int i = 0; i < sCount && written < max; ++i)
+    {
+        void *unit = sSlotUnits[i];
+
+        // level and curHp share a cache line; start loading the
+        // next unit's while this one is read. PLD never faults, so the
+        // next pointer needn't be checked first.
+        if (i + 1 < sCount)
+            __builtin_prefetch(static_cast<const std::uint8_t *>(sSlotUnits[i + 1]) + gUnitLayout.level);
+
+        // Slots can outlive the unit (a pointer indexed on an earlier
+        // map, or a freed clone); only read ones whose whole field span
+        // is still in the heap.
+        if (!SafeRead_InHeap(unit, kUnitReadSpan))
+            continue;
+
+        UnitSummary &s = out[written++];
+        s.unit    = unit;
+        s.slot    = static_cast<std::int16_t>(i);
+        s.hp      = static_cast<std::int16_t>(Unit_GetCurrentHp(unit));
+        s.maxHp   = static_cast<std::int16_t>(Unit_GetMaxHp(unit));
+        s.level   = static_cast<std::uint8_t>(Unit_GetLevel(unit));
+        s.sideRaw = static_cast<std::int8_t>(Unit_GetSideRaw(unit));
+    }
+    return written;
+}
+
+} // namespace Engine
+} // namespace Fates
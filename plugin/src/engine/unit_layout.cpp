@@ -0,0 +1,55 @@
+// engine/unit_layout.cpp
+//
+// Active struct layout. See engine/unit_layout.hpp.
+
+#include "engine/unit_layout.hpp"
+#include "util/debug_log.hpp"
+
+namespace Fates {
+namespace Engine {
+
+namespace {
+
+constexpr UnitLayout kUnmappedUnit = {
+    kUnmappedField, kUnmappedField, kUnmappedField, kUnmappedField, kUnmappedField,
+};
+
+constexpr SeqBattleLayout kUnmappedSeqBattle = {
+    kUnmappedField, kUnmappedField, kUnmappedField,
+};
+
+constexpr BattleLayout kUnmappedBattle = {
+    kUnmappedField, kUnmappedField, kUnmappedField, kUnmappedField,
+};
+
+} // anonymous namespace
+
+UnitLayout      gUnitLayout      = kUnmappedUnit;
+SeqBattleLayout gSeqBattleLayout = kUnmappedSeqBattle;
+BattleLayout    gBattleLayout    = kUnmappedBattle;
+
+bool UnitLayout_Select(const GameLayout &layout, const char *region)
+{
+    if (!IsValidLayout(layout))
+    {
+        gUnitLayout      = kUnmappedUnit;
+        gSeqBattleLayout = kUnmappedSeqBattle;
+        gBattleLayout    = kUnmappedBattle;
+        FATES_LOG(Warn, Engine, "UnitLayout: %s layout fails validation; unit fields read as unknown",
+                                region ? region : "?");
+        return false;
+    }
+
+    gUnitLayout      = layout.unit;
+    gSeqBattleLayout = layout.seqBattle;
+    gBattleLayout    = layout.battle;
+    FATES_LOG(Info, Engine, "UnitLayout: %s (level+0x%X hp+0x%X clone+0x%X)",
+                            region ? region : "?",
+                            static_cast<unsigned>(layout.unit.level),
+                            static_cast<unsigned>(layout.unit.curHp),
+                            static_cast<unsigned>(layout.unit.clone));
+    return true;
+}
+
+} // namespace Engine
+} // namespace Fates
@@ -1,31 +1,55 @@
 #include "hook_debug.hpp"
+#include "stats_overlay.hpp"
 #include "core/runtime.hpp"
 #include "core/hooks.hpp"
+#include "core/hook_profiler.hpp"
+#include "core/hook_config.hpp"
+#include "core/hook_manager.hpp"
+#include "engine/arena.hpp"
+#include "engine/history_store.hpp"
 #include "util/debug_log.hpp"
+#include "util/worker.hpp"
 #include <CTRPluginFramework.hpp>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 using namespace CTRPluginFramework;
 using namespace Fates;
 
+// Readers below run outside the game thread, so they work on the last
+// published RuntimeSnapshot instead of the live globals. Static: the
+// snapshot is too big for the debug thread's stack. The dumps run as
+// worker jobs (util/worker.hpp) and the OSD view on the UI thread, so
+// each side has its own copy.
+static RuntimeSnapshot sSnap;       // ShowHookCountsOSD (UI thread)
+static RuntimeSnapshot sDumpSnap;   // Dump* (worker thread)
+
 void DumpKillEventsToLog()
 {
-    Logf("=== DumpKillEventsToLog ===");
-    Logf("Total kill events: %d", gKillEventCount);
+    if (!ReadRuntimeSnapshot(sDumpSnap))
+    {
+        FATES_LOG(Info, RE, "DumpKillEventsToLog: no runtime snapshot yet");
+        return;
+    }
+
+    FATES_LOG(Info, RE, "=== DumpKillEventsToLog ===");
+    FATES_LOG(Info, RE, "Total kill events: %d (snapshot #%u)",
+                        sDumpSnap.killEventCount, (unsigned)sDumpSnap.version);
 
-    for (int i = 0; i < gKillEventCount; ++i)
+    for (int i = 0; i < sDumpSnap.killEventCount; ++i)
     {
-        const KillEvent &ev = gKillEvents[i];
+        const KillEvent &ev = sDumpSnap.killEvents[i];
 
-        Logf("[%d] seq=%p dead0=%p dead1=%p flags=0x%08X",
-             i,
-             ev.seq,
-             ev.dead0,
-             ev.dead1,
-             ev.flags);
+        FATES_LOG(Info, RE, "[%d] seq=%p dead0=%p dead1=%p flags=0x%08X",
+                            i,
+                            ev.seq,
+                            ev.dead0,
+                            ev.dead1,
+                            ev.flags);
     }
 
-    Logf("=== End DumpKillEventsToLog ===");
+    FATES_LOG(Info, RE, "=== End DumpKillEventsToLog ===");
 }
 
 // namespace Fates
@@ -41,12 +65,30 @@ void ShowHookCountsOSD() {
     char buf[160];
     int shown = 0;
 
+    if (!ReadRuntimeSnapshot(sSnap)) {
+        OSD::Notify("No hook counts published yet");
+        return;
+    }
+    const std::uint32_t *counts = sSnap.hookCount;
+
     for (std::uint32_t i = 0; i < kNumHooks; ++i) {
-        if (gHookCount[i] == 0)
+        if (counts[i] == 0)
             continue;
         const char *name = kHooks[i].name;
+#if FATES_HOOK_PROFILER
+        // Per-call average total / own time and worst case.
+        const HookProfileStats &p = gHookProfile[kHooks[i].id];
+        if (p.calls != 0) {
+            std::uint64_t own = p.totalTicks - p.originalTicks;
+            std::snprintf(buf, sizeof(buf), "%s: %u avg=%uus own=%uus max=%uus",
+                          name ? name : "(unnamed)", (unsigned)counts[i],
+                          (unsigned)HookProfiler_TicksToUs(p.totalTicks / p.calls),
+                          (unsigned)HookProfiler_TicksToUs(own / p.calls),
+                          (unsigned)HookProfiler_TicksToUs(p.maxTotalTicks));
+        } else
+#endif
         std::snprintf(buf, sizeof(buf), "%s: %u",
-                      name ? name : "(unnamed)", (unsigned)gHookCount[i]);
+                      name ? name : "(unnamed)", (unsigned)counts[i]);
         OSD::Notify(buf);
 
         if (++shown > 10)
@@ -71,6 +113,12 @@ void DumpHookCountsToFile() {
     // Append to end of file
     f.Seek(0, File::END);
 
+    if (!ReadRuntimeSnapshot(sDumpSnap)) {
+        f.Close();
+        OSD::Notify("No hook counts published yet");
+        return;
+    }
+
     for (std::uint32_t i = 0; i < kNumHooks; ++i) {
         const char *name = kHooks[i].name;
         char line[128];
@@ -78,27 +126,287 @@ void DumpHookCountsToFile() {
                               "%02u %s = %u\r\n",
                               (unsigned)i,
                               name ? name : "(unnamed)",
-                              (unsigned)gHookCount[i]);
+                              (unsigned)sDumpSnap.hookCount[i]);
         f.Write(line, (u32)n);
+
+#if FATES_HOOK_PROFILER
+        const HookProfileStats &p = gHookProfile[kHooks[i].id];
+        if (p.calls == 0)
+            continue;
+
+        std::uint64_t own = p.totalTicks - p.originalTicks;
+        char prof[256];
+        n = std::snprintf(prof, sizeof(prof),
+                          "   calls=%u total=%uus orig=%uus own=%uus "
+                          "own[min=%uus max=%uus] maxTotal=%uus\r\n"
+                          "   hist(log2 ticks, 2^%d..):",
+                          (unsigned)p.calls,
+                          (unsigned)HookProfiler_TicksToUs(p.totalTicks),
+                          (unsigned)HookProfiler_TicksToUs(p.originalTicks),
+                          (unsigned)HookProfiler_TicksToUs(own),
+                          (unsigned)HookProfiler_TicksToUs(p.minOwnTicks),
+                          (unsigned)HookProfiler_TicksToUs(p.maxOwnTicks),
+                          (unsigned)HookProfiler_TicksToUs(p.maxTotalTicks),
+                          kHookProfileHistShift);
+        for (int b = 0; b < kHookProfileHistBuckets && n > 0 && n < (int)sizeof(prof); ++b)
+            n += std::snprintf(prof + n, sizeof(prof) - n, " %u", (unsigned)p.hist[b]);
+        if (n > 0 && n < (int)sizeof(prof) - 2)
+            n += std::snprintf(prof + n, sizeof(prof) - n, "\r\n");
+        if (n > (int)sizeof(prof) - 1)
+            n = (int)sizeof(prof) - 1;
+        if (n > 0)
+            f.Write(prof, (u32)n);
+#endif
     }
 
     f.Close();
     OSD::Notify("Wrote sdmc:/Fates3GX/hook_hits.log");
 }
 
+#if FATES_HOOK_CALLTREE
+// Folded stacks ("outer;inner;leaf <exclusive us>") for flamegraph.pl /
+// speedscope, plus a per-node summary in the debug log.
+void DumpHookCallTreeToFile() {
+    _EnsureDir();
+
+    File f;
+    if (File::Open(f, "sdmc:/Fates3GX/hook_calltree.folded",
+                   File::WRITE | File::CREATE | File::TRUNCATE) != 0)
+    {
+        OSD::Notify("Couldn't open hook_calltree.folded");
+        return;
+    }
+
+    const CallTree &t = gCallTree;
+    const unsigned count = t.nodeCount;
+    FATES_LOG(Info, Hook, "CallTree: nodes=%u/%d dropped=%u maxDepth=%u",
+              count, kCallTreeMaxNodes, (unsigned)t.dropped, (unsigned)t.maxDepth);
+
+    for (unsigned i = 0; i < count; ++i) {
+        const CallTreeNode &node = t.nodes[i];
+        if (node.calls == 0)
+            continue;
+
+        // Walk up to the root, then print outermost first.
+        std::uint16_t path[kCallTreeMaxDepth];
+        int depth = 0;
+        for (std::uint16_t n = (std::uint16_t)i;
+             n != kCallTreeNone && depth < kCallTreeMaxDepth;
+             n = t.nodes[n].parent)
+            path[depth++] = n;
+
+        char line[256];
+        int len = 0;
+        for (int d = depth - 1; d >= 0 && len < (int)sizeof(line); --d) {
+            const std::uint16_t hook = t.nodes[path[d]].hook;
+            len += std::snprintf(line + len, sizeof(line) - len, "%s%s",
+                                 d == depth - 1 ? "" : ";",
+                                 hook < HookId_Count ? kHookIdNames[hook] : "?");
+        }
+        if (len < (int)sizeof(line))
+            len += std::snprintf(line + len, sizeof(line) - len, " %u\n",
+                                 (unsigned)HookProfiler_TicksToUs(node.exclusiveTicks));
+        if (len > (int)sizeof(line) - 1)
+            len = (int)sizeof(line) - 1;
+        f.Write(line, (u32)len);
+
+        FATES_LOG(Info, Hook, "  %*s%s: calls=%u incl=%uus excl=%uus",
+                  (depth - 1) * 2, "",
+                  node.hook < HookId_Count ? kHookIdNames[node.hook] : "?",
+                  (unsigned)node.calls,
+                  (unsigned)HookProfiler_TicksToUs(node.inclusiveTicks),
+                  (unsigned)HookProfiler_TicksToUs(node.exclusiveTicks));
+    }
+
+    f.Close();
+    OSD::Notify("Wrote sdmc:/Fates3GX/hook_calltree.folded");
+}
+
+static void _JobDumpHookCallTree(void*) {
+    DumpHookCallTreeToFile();
+}
+
+static void _EntryDumpCallTree(MenuEntry* e) {
+    (void)e;
+    Worker_Post(&_JobDumpHookCallTree, nullptr, "DumpHookCallTree");
+}
+#endif
+
 static void _EntryShow(MenuEntry* e) {
     (void)e;
     ShowHookCountsOSD();
 }
 
-static void _EntryDump(MenuEntry* e) {
+static void _EntryOverlay(MenuEntry* e) {
     (void)e;
+    StatsOverlay_SetEnabled(!StatsOverlay_IsEnabled());
+}
+
+static void _JobDumpHookCounts(void*) {
     DumpHookCountsToFile();
 }
 
+static void _EntryDump(MenuEntry* e) {
+    (void)e;
+    Worker_Post(&_JobDumpHookCounts, nullptr, "DumpHookCounts");
+}
+
+// Pick a hook profile; applied immediately and saved to hooks.cfg.
+static void _EntryProfile(MenuEntry* e) {
+    (void)e;
+
+    std::vector<std::string> items;
+    for (int p = 0; p < (int)HookProfile::Count; ++p) {
+        std::string label = HookProfile_Label((HookProfile)p);
+        if ((HookProfile)p == HookConfig_GetProfile())
+            label += "  (active)";
+        items.push_back(label);
+    }
+
+    Keyboard kb("Hook profile");
+    kb.Populate(items);
+    int choice = kb.Open();
+    if (choice < 0)
+        return;
+
+    HookConfig_SetProfile((HookProfile)choice);
+    OSD::Notify(std::string("Hook profile: ") + HookProfile_Label((HookProfile)choice));
+}
+
+// Flip one hook on/off on top of the profile; saved to hooks.cfg.
+static void _EntryToggleHook(MenuEntry* e) {
+    (void)e;
+
+    std::vector<std::string> items;
+    for (std::size_t i = 0; i < kNumHooks; ++i) {
+        const HookId id = (HookId)i;
+        const char *state = HookManager::IsHookEnabled(id) ? "[on ] " : "[off] ";
+        std::string label = state;
+        label += kHookIdNames[i];
+        if (HookConfig_GetOverride(id) != HookOverride::Default)
+            label += " *";
+        if (kHooks[i].targetVA == 0)
+            label += " (unmapped)";
+        items.push_back(label);
+    }
+
+    Keyboard kb("Toggle hook (* = overrides profile)");
+    kb.Populate(items);
+    int choice = kb.Open();
+    if (choice < 0)
+        return;
+
+    const HookId id = (HookId)choice;
+    const bool   on = !HookConfig_Wants(id);
+
+    // Back to Default if that already gives the new state.
+    HookOverride ov = on ? HookOverride::On : HookOverride::Off;
+    if (HookProfile_Wants(HookConfig_GetProfile(), kHooks[choice]) == on)
+        ov = HookOverride::Default;
+
+    HookConfig_SetOverride(id, ov);
+    OSD::Notify(std::string(kHookIdNames[choice]) +
+                (HookManager::IsHookEnabled(id) ? ": ON" : ": OFF"));
+}
+
+// Flip one log category on/off for the session. Categories compiled
+// out (FATES_LOG_CATEGORIES) are listed but stay silent.
+static void _EntryLogCategories(MenuEntry* e) {
+    (void)e;
+
+    std::vector<std::string> items;
+    for (std::uint32_t bit = 1; bit & FATES_LOG_CAT_ALL; bit <<= 1) {
+        std::string label = (Log_GetCategoryMask() & bit) ? "[on ] " : "[off] ";
+        label += Log_CategoryName(bit);
+        if ((FATES_LOG_CATEGORIES & bit) == 0)
+            label += " (compiled out)";
+        items.push_back(label);
+    }
+
+    Keyboard kb("Log categories");
+    kb.Populate(items);
+    int choice = kb.Open();
+    if (choice < 0)
+        return;
+
+    const std::uint32_t bit  = 1u << choice;
+    const std::uint32_t mask = Log_GetCategoryMask() ^ bit;
+    Log_SetCategoryMask(mask);
+    OSD::Notify(std::string("Log ") + Log_CategoryName(bit) +
+                ((mask & bit) ? ": ON" : ": OFF"));
+}
+
+// Last few maps from sdmc:/Fates3GX/history.bin, newest first.
+static void _EntryHistory(MenuEntry* e) {
+    (void)e;
+
+    constexpr int kShown = 8;
+    static Engine::HistoryRecord recs[kShown];
+    const int n = Engine::History_LoadRecent(recs, kShown);
+    if (n == 0) {
+        MessageBox("Campaign history", "No maps on record yet")();
+        return;
+    }
+
+    std::string text;
+    char line[128];
+    for (int i = 0; i < n; ++i) {
+        const Engine::HistoryRecord &r = recs[i];
+        std::snprintf(line, sizeof(line),
+                      "S%u map %u: %u turns, dmg %d/%d, kills %u/%u, rng %u\n",
+                      (unsigned)r.session, (unsigned)r.generation,
+                      (unsigned)r.totalTurns,
+                      (int)r.damage[0], (int)r.damage[1],
+                      (unsigned)r.kills[0], (unsigned)r.kills[1],
+                      (unsigned)r.rngCalls);
+        text += line;
+    }
+
+    MessageBox("Campaign history (Side0/Side1)", text)();
+}
+
+// Engine arenas and every tag's share: current map, high-water, drops.
+static void _EntryMemory(MenuEntry* e) {
+    (void)e;
+
+    std::string text;
+    char line[128];
+    for (int a = 0; a < (int)Engine::ArenaId::Count; ++a) {
+        Engine::ArenaStats st;
+        Engine::Arena_GetStats((Engine::ArenaId)a, st);
+        std::snprintf(line, sizeof(line), "%s: %u / %u B (hw %u B), %u failed\n",
+                      st.name, (unsigned)st.used, (unsigned)st.capacity,
+                      (unsigned)st.highWater, (unsigned)st.failedAllocs);
+        text += line;
+    }
+
+    static Engine::ArenaTagStats tags[Engine::kArenaMaxTags];
+    const int n = Engine::Arena_GetTagStats(tags, Engine::kArenaMaxTags);
+    if (n > 0)
+        text += "\n";
+    for (int i = 0; i < n; ++i) {
+        const Engine::ArenaTagStats &t = tags[i];
+        std::snprintf(line, sizeof(line), "%s [%s]: %u B (hw %u B), %u dropped\n",
+                      t.tag, t.arena == Engine::ArenaId::Map ? "map" : "plugin",
+                      (unsigned)t.bytes, (unsigned)t.highWater, (unsigned)t.drops);
+        text += line;
+    }
+
+    MessageBox("Engine memory (arena high-water)", text)();
+}
+
 void InstallHookDebugMenu(PluginMenu& menu) {
     auto *folder = new MenuFolder("Fates 3GX Debug");
     folder->Append(new MenuEntry("Show hook counts (OSD)", nullptr, _EntryShow));
+    folder->Append(new MenuEntry("Live stats overlay (toggle)", nullptr, _EntryOverlay));
     folder->Append(new MenuEntry("Dump hook counts to file", nullptr, _EntryDump));
+#if FATES_HOOK_CALLTREE
+    folder->Append(new MenuEntry("Dump hook call tree (folded)", nullptr, _EntryDumpCallTree));
+#endif
+    folder->Append(new MenuEntry("Hook profile...", nullptr, _EntryProfile));
+    folder->Append(new MenuEntry("Toggle a single hook...", nullptr, _EntryToggleHook));
+    folder->Append(new MenuEntry("Campaign history (last 8 maps)", nullptr, _EntryHistory));
+    folder->Append(new MenuEntry("Log categories...", nullptr, _EntryLogCategories));
+    folder->Append(new MenuEntry("Engine memory", nullptr, _EntryMemory));
     menu.Append(folder);
 }
@@ -1,4 +1,5 @@
 #include "core/hooks.hpp"
+#include "core/hook_manager.hpp"
 #include "util/debug_log.hpp"
 #include <CTRPluginFramework.hpp>
 #include <cstdint>
@@ -11,11 +12,23 @@ using namespace Fates;
 
 void DumpHookSites()
 {
-    Logf("DumpHookSites: begin (kNumHooks=%u)", (unsigned)kNumHooks);
+    FATES_LOG(Info, RE, "DumpHookSites: begin (kNumHooks=%u)", (unsigned)kNumHooks);
 
     for (std::size_t i = 0; i < kNumHooks; ++i) {
         const HookEntry &e = kHooks[i];
         u32 siteVA = e.targetVA;
+        if (siteVA == 0) {
+            FATES_LOG(Info, RE, "Site[%02u] %s: not mapped for this region", (unsigned)i,
+                                (e.name != nullptr) ? e.name : "<noname>");
+            continue;
+        }
+        const u32 resolved = HookManager::GetSiteVA(e.id);
+        if (resolved != 0 && resolved != (siteVA & ~1u)) {
+            FATES_LOG(Info, RE, "Site[%02u] %s: relocated 0x%08X -> 0x%08X", (unsigned)i,
+                                (e.name != nullptr) ? e.name : "<noname>",
+                                (unsigned)siteVA, (unsigned)resolved);
+            siteVA = resolved;
+        }
         uint8_t current[8] = {0};
         const uint8_t *p = reinterpret_cast<const uint8_t *>(siteVA);
         std::memcpy(current, p, sizeof(current));
@@ -36,8 +49,8 @@ void DumpHookSites()
             }
         }
         const char *name = (e.name != nullptr) ? e.name : "<noname>";
-        Logf("Site[%02u] %s @VA=0x%08X: cur=[%s] guard=[%s]",
-             (unsigned)i, name, (unsigned)siteVA, curHex, guardHex);
+        FATES_LOG(Info, RE, "Site[%02u] %s @VA=0x%08X: cur=[%s] guard=[%s]",
+                            (unsigned)i, name, (unsigned)siteVA, curHex, guardHex);
     }
-    Logf("DumpHookSites: end");
+    FATES_LOG(Info, RE, "DumpHookSites: end");
 }
@@ -1,4 +1,5 @@
 #include "core/hooks.hpp"
+#include "core/hook_manager.hpp"
 #include "core/runtime.hpp"
 #include "util/debug_log.hpp"
 #include <CTRPluginFramework.hpp>
@@ -11,10 +12,10 @@ using namespace Fates;
 void DumpHookTable()
 {
 
-    Logf("DumpHookTable: begin (kNumHooks=%u)", (unsigned)kNumHooks);
+    FATES_LOG(Info, RE, "DumpHookTable: begin (kNumHooks=%u)", (unsigned)kNumHooks);
 
     if (kNumHooks == 0) {
-        Logf("DumpHookTable: kHooks is empty");
+        FATES_LOG(Info, RE, "DumpHookTable: kHooks is empty");
         return;
     }
 
@@ -22,16 +23,20 @@ void DumpHookTable()
         const HookEntry &e = kHooks[i];
         const char *name = (e.name != nullptr) ? e.name : "<noname>";
         // Print the target virtual address and file offset, guard words,
-        // Thumb flag and stability class.
-        Logf("Hook[%02u]: %s VA=0x%08X fileOff=0x%08X guard={%08X,%08X,%08X} thumb=%s stability=%u",
-             (unsigned)i,
-             name,
-             (unsigned)e.targetVA,
-             (unsigned)e.fileOffset,
-             (unsigned)e.guard[0], (unsigned)e.guard[1], (unsigned)e.guard[2],
-             e.isThumb ? "yes" : "no",
-             (unsigned)e.stability);
+        // Thumb flag, stability class and backend (table / installed).
+        FATES_LOG(Info, RE, "Hook[%02u]: %s VA=0x%08X fileOff=0x%08X guard={%08X,%08X,%08X} thumb=%s stability=%u "
+                            "backend=%s/%s",
+                            (unsigned)i,
+                            name,
+                            (unsigned)e.targetVA,
+                            (unsigned)e.fileOffset,
+                            (unsigned)e.guard[0], (unsigned)e.guard[1], (unsigned)e.guard[2],
+                            e.isThumb ? "yes" : "no",
+                            (unsigned)e.stability,
+                            e.backend == HookBackend::Inline ? "inline" : "mitm",
+                            !HookManager::IsHookInstalled(e.id) ? "-" :
+                            HookManager::GetBackend(e.id) == HookBackend::Inline ? "inline" : "mitm");
     }
 
-    Logf("DumpHookTable: end");
+    FATES_LOG(Info, RE, "DumpHookTable: end");
 }
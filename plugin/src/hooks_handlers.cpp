@@ -12,13 +12,23 @@
 
 #include <CTRPluginFramework.hpp>
 #include <cstdint>
+#include <cstring>
 
 #include "core/hooks.hpp"
 #include "core/runtime.hpp"
 #include "core/handlers.hpp"
+#include "core/hook_profiler.hpp"  // FATES_HOOK_PROFILE / FATES_HOOK_ORIGINAL
+#include "core/inline_hook.hpp"    // HookCallOriginal
+#include "core/turn_state.hpp"     // TurnState_Resolve / TurnState_GetSide
 #include "util/debug_log.hpp"
+#include "util/log_gate.hpp"
+#include "util/safe_read.hpp"
 #include "hook_debug.hpp"   // DumpHookCountsToFile / DumpKillEventsToLog
+#include "stats_overlay.hpp"   // StatsOverlay_Sample
 #include "engine/events.hpp"
+#include "engine/skills.hpp"    // Skills::UnitHasDebugSkill
+#include "engine/unit_index.hpp"   // map-start carry-over
+#include "engine/unit_layout.hpp"
 
 using namespace CTRPluginFramework;
 
@@ -41,22 +51,8 @@ namespace Fates
         u32   unk1C;     // 0x1C, small ints
     };
 
-    // Minimal view of BattleCalculator: only care that [0] is BattleRoot*.
-    struct BattleCalculator
-    {
-        BattleRoot *root;  // 0x00
-        // Remaining fields currently unknown / unused.
-    };
-
-    // Convenience helper to safely peel the BattleRoot* off a raw calc ptr.
-    static inline BattleRoot *GetBattleRoot(void *calcRaw)
-    {
-        if (calcRaw == nullptr)
-            return nullptr;
-
-        auto *calc = reinterpret_cast<BattleCalculator *>(calcRaw);
-        return calc->root;
-    }
+    // BattleCalculator -> BattleRoot is read through
+    // Engine::BattleCalc_GetRoot (engine/unit_layout.hpp, BattleLayout).
 
     // Convenience: index into gHookCount from a HookId.
     static inline std::size_t IndexOf(HookId id)
@@ -65,41 +61,34 @@ namespace Fates
     }
 
     // -----------------------------------------------------------------
-    // Global turn-side helper (Player / Enemy / Other)
+    // Pointer guards
     // -----------------------------------------------------------------
-
-    // Base VA for the branch/turn-state pointer chain discovered earlier.
-    static constexpr std::uintptr_t kTurnBranchStateVA = 0x003A4944;
-	
-	// Approximate battle/map heap range, based on observed pointers like
-    // 0x32626E90, 0x328A3DD0, 0x3291F9C0, etc. Use this as a guard
-    // before dereferencing pointers from hooks.
-    static constexpr std::uintptr_t kHeapMinVA = 0x32000000;
-    static constexpr std::uintptr_t kHeapMaxVA = 0x33FFFFFF;
-
-    // Raw helper: returns 0..3 on success, 0xFF on error/unknown.
-    static inline std::uint8_t GetTurnSideIndexRaw()
+    // The turn-side chain is resolved and cached by core/turn_state.hpp
+    // (TurnState_Resolve at SEQ_MapStart / SEQ_TurnBegin).
+    //
+    // A game pointer is only handed to the engine's layout accessors if
+    // the whole span they may read (Engine::k*ReadSpan,
+    // engine/unit_layout.hpp) is in the heap (util/safe_read.hpp).
+    using Engine::kUnitReadSpan;
+    using Engine::kSeqBattleReadSpan;
+    using Engine::kBattleRootReadSpan;
+
+    static inline bool IsUnitReadable(const void *unit)
     {
-        // Step 1: r1 = *(u32*)0x003A4944;
-        auto ptr1 = *reinterpret_cast<std::uintptr_t const *>(kTurnBranchStateVA);
-        if (ptr1 == 0)
-            return 0xFF;
-
-        // Step 2: r2 = *(u32*)(ptr1 + 0);
-        auto ptr2 = *reinterpret_cast<std::uintptr_t const *>(ptr1);
-        if (ptr2 == 0)
-            return 0xFF;
-
-        auto base = reinterpret_cast<std::uint8_t const *>(ptr2);
-
-        std::uint8_t idx  = base[0x08];
-        std::uint8_t side = base[idx];
+        return SafeRead_InHeap(unit, kUnitReadSpan);
+    }
 
-        return (side <= 3) ? side : 0xFF;
+    // Calculator and the root it points at (null root is fine: the
+    // engine decodes an empty battle).
+    static inline bool IsBattleCalcReadable(const void *calc)
+    {
+        std::uint32_t root = 0;
+        const auto *base = static_cast<const std::uint8_t *>(calc);
+        if (!Engine::IsMapped(Engine::gBattleLayout.calcRoot) ||
+            !SafeRead(base + Engine::gBattleLayout.calcRoot, root))
+            return false;
+        return root == 0 || SafeRead_InHeap(static_cast<std::uintptr_t>(root), kBattleRootReadSpan);
     }
-	// Forward declaration so MapLife_OnNewMap can call this helper.
-    static inline void DebugSkills_Reset();
-	
 // Called when detect a NEW map root in Hook_SEQ_MapStart.
 static inline void MapLife_OnNewMap(void *seq, TurnSide side)
 {
@@ -123,14 +112,42 @@ static inline void MapLife_OnNewMap(void *seq, TurnSide side)
     ResetMapStats();
 
     // NOTE:
-    // I intentionally *do not* reset the debug-skill table here.
-    // Units that were given the debug skill (0x000E) during data
-    // load *before* the first map should still be visible during
-    // combat on that map.
-    // If you are reading this, in first public release these most
-	// likely are disabled and just serve as docs to clean 
-	// up later.
-    // DebugSkills_Reset();
+    // Debug-skill marks live in the engine skill module now
+    // (Engine::Skills::UnitHasDebugSkill). Units that were given the
+    // debug skill (0x000E) during data load *before* the first map are
+    // parked there and applied at Engine::OnMapBegin, so they are still
+    // visible during combat on that map.
+}
+
+// Called from Hook_SEQ_MapStart for a new map, before the engine resets
+// the unit index. Hands every unit the engine indexed since the last map
+// began (the previous map's army, plus anything seen between maps) that
+// still reads as a live unit to Engine::OnUnitCarryOver, so per-unit
+// state that follows a unit between maps survives the reset. These are
+// old pointers, not the new map's unit list (not mapped yet), and the
+// first map after boot has none. Engine::UnitIndex_ReadSummaries reads
+// them in one sweep and skips slots that no longer cover a readable
+// unit.
+static void MapLife_CarryOverUnits()
+{
+    // Game thread only; one summary per index slot at most.
+    static Engine::UnitSummary sSummaries[Engine::kUnitIndexCapacity];
+
+    const int n = Engine::UnitIndex_ReadSummaries(sSummaries, Engine::kUnitIndexCapacity);
+    int carried = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        // Dead, or the memory no longer holds a unit.
+        const Engine::UnitSummary &u = sSummaries[i];
+        if (u.hp <= 0 || u.level == 0 || u.level > 99)
+            continue;
+
+        Engine::OnUnitCarryOver(u.unit, u.hp, u.level, u.sideRaw);
+        ++carried;
+    }
+
+    FATES_LOG(Debug, Hook, "MapLife_CarryOverUnits: %d of %d indexed unit(s) still live",
+                           carried, Engine::UnitIndex_Count());
 }
 
     // Called by Hook_SEQ_TurnBegin.
@@ -152,19 +169,6 @@ static inline void MapLife_OnNewMap(void *seq, TurnSide side)
     }
 
 
-    // Enum wrapper: convert raw 0..3 into TurnSide.
-    static inline TurnSide GetTurnSideEnum()
-    {
-        std::uint8_t raw = GetTurnSideIndexRaw();
-        switch (raw)
-        {
-        case 0: return TurnSide::Side0;
-        case 1: return TurnSide::Side1;
-        case 2: return TurnSide::Side2;
-        case 3: return TurnSide::Side3;
-        default: return TurnSide::Unknown;
-        }
-    }
 	
 	struct LevelUpPayload
     {
@@ -180,84 +184,6 @@ static inline void MapLife_OnNewMap(void *seq, TurnSide side)
         std::uint16_t   flags;    // reserved (source: level, scroll, script, etc.)
     };
 	
-    // -----------------------------------------------------------------
-    // LEGACY debug-skill tracking (per-map, Unit* -> "has debug skill").
-    //
-    // NOTE: This table is only used for extra logging in
-    // Hook_BTL_FinalDamage_Pre and Hook_UNIT_SkillLearn. The *recommended*
-    // way to work with skills at the SDK layer is via engine/skills.cpp
-    // and the event bus (Engine::Skills::InitDebugSkills, HpChange handlers).
-    //
-    // Left in place for ongoing RE and will likely be replaced or removed
-    // once the skill engine stabilises.
-    // -----------------------------------------------------------------   
-
-    // Hard-coded debug skill ID for now; messy and serves only for testing
-    static constexpr std::uint16_t kDebugSkillId  = 0x000E;
-    static constexpr std::size_t   kDebugMaxUnits = 256;
-
-    struct DebugSkillEntry
-    {
-        Unit *unit;
-        bool  hasSkill;
-    };
-
-    static DebugSkillEntry gDebugSkillTable[kDebugMaxUnits];
-    static std::size_t     gDebugSkillCount = 0;
-
-    // Clear all debug-skill state (called on new map).
-    static inline void DebugSkills_Reset()
-    {
-        gDebugSkillCount = 0;
-        for (std::size_t i = 0; i < kDebugMaxUnits; ++i)
-        {
-            gDebugSkillTable[i].unit     = nullptr;
-            gDebugSkillTable[i].hasSkill = false;
-        }
-    }
-
-    // Record that a unit has learned debug skill.
-    static inline void DebugSkills_OnSkillLearn(Unit *unit,
-                                                std::uint16_t skillId)
-    {
-        if (unit == nullptr)
-            return;
-
-        if (skillId != kDebugSkillId)
-            return;
-
-        // Look for an existing entry first.
-        for (std::size_t i = 0; i < gDebugSkillCount; ++i)
-        {
-            if (gDebugSkillTable[i].unit == unit)
-            {
-                gDebugSkillTable[i].hasSkill = true;
-                return;
-            }
-        }
-
-        // Otherwise append a new one, if we have room.
-        if (gDebugSkillCount < kDebugMaxUnits)
-        {
-            gDebugSkillTable[gDebugSkillCount].unit     = unit;
-            gDebugSkillTable[gDebugSkillCount].hasSkill = true;
-            ++gDebugSkillCount;
-        }
-    }
-
-    // Does this unit have debug skill?
-    static inline bool DebugSkills_Has(Unit *unit)
-    {
-        if (unit == nullptr)
-            return false;
-
-        for (std::size_t i = 0; i < gDebugSkillCount; ++i)
-        {
-            if (gDebugSkillTable[i].unit == unit)
-                return gDebugSkillTable[i].hasSkill;
-        }
-        return false;
-    }
 	    struct UnitCommandEvent
     {
         void *vtable;       // [0x00]
@@ -278,6 +204,26 @@ static inline void MapLife_OnNewMap(void *seq, TurnSide side)
         void *unk3C;        // [0x3C]
     };
 
+    // Decode a command event instance into the engine's ActionEvent. An
+    // unreadable instance still yields ev.inst with the other fields zeroed,
+    // so the engine is notified either way.
+    static bool DecodeCommandEvent(void *inst, Engine::ActionEvent &out)
+    {
+        out = Engine::ActionEvent();
+        out.inst = inst;
+
+        UnitCommandEvent ev{};
+        if (inst == nullptr ||
+            !SafeRead_Words(inst, reinterpret_cast<std::uint32_t *>(&ev), sizeof(ev) / 4))
+            return false;
+
+        out.cmdData = ev.cmdData;
+        out.cmdId   = ev.cmdId;
+        out.sideRaw = ev.side;
+        out.unk28   = ev.unk28;
+        return true;
+    }
+
 } // namespace Fates
 
 
@@ -285,8 +231,8 @@ static inline void MapLife_OnNewMap(void *seq, TurnSide side)
 // Internal state for post-battle HP experiments
 // ---------------------------------------------------------------------
 
-// Tracks the most recent battle root observed in BTL_FinalDamage_Pre.
-static Fates::BattleRoot *sLastBattleRoot = nullptr;
+// The battle itself (calc, root, participants) is decoded and cached by
+// Engine::OnBattleCalc; see Engine::GetCurrentBattle().
 
 // Debug knobs for the HP overlay.
 //
@@ -311,23 +257,21 @@ extern "C" {
 int Hook_BTL_HitCalc_Main(int hitRate)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Telemetry: track how often the hit RNG is called.
     std::size_t idx = IndexOf(HookId_BTL_HitCalc_Main);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_HitCalc_Main);
 
     // Call the original RandomCalculateHit(int).
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, int>(hitRate);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, int>(HookId_BTL_HitCalc_Main, hitRate));
 
     // Light logging window 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("BTL_HitCalc_Main", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_HitCalc_Main(RandomCalculateHit): rate=%d -> %d (n=%d)",
-             hitRate, result, sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_HitCalc_Main(RandomCalculateHit): rate=%d -> %d (n=%u)",
+                               hitRate, result, LogGate_Count(sLogGate));
     }
 
     return result;
@@ -337,25 +281,19 @@ std::uint32_t Hook_SYS_Rng32(void *rngState,
                              std::uint32_t upperBound)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Telemetry: track how often the global RNG is called.
     std::size_t idx = IndexOf(HookId_SYS_Rng32);
     gHookCount[idx]++;
-
-    // Local toggle: set to true temporarily if you ever want RNG log spam.
-    static bool sRngDebug = false;
-
-    HookContext &ctx = HookContext::GetCurrent();
-    (void)ctx;  // currently unused, but kept for consistency.
+    FATES_HOOK_PROFILE(HookId_SYS_Rng32);
 
     using CoreFn = std::uint32_t (*)(void *state);
 
-    // Core RNG-step function 
-    CoreFn core = reinterpret_cast<CoreFn>(0x0044AE14);
+    // Core RNG-step function (the region's rng_core).
+    CoreFn core = reinterpret_cast<CoreFn>(gRngCoreVA);
 
     // Step the RNG state and get the raw 31-bit value.
-    std::uint32_t raw = core(rngState);
+    std::uint32_t raw = FATES_HOOK_ORIGINAL(core(rngState));
 
     // Final value to return to the game.
     std::uint32_t result = 0u;
@@ -371,17 +309,16 @@ std::uint32_t Hook_SYS_Rng32(void *rngState,
         result = static_cast<std::uint32_t>(product >> 32);
     }
 
-    // Optional: only log if sRngDebug is enabled.
-    static int sLogCount = 0;
-    if (sRngDebug && sLogCount < 32)
+    // Per-call RNG spam: only in FATES_LOG_LEVEL_TRACE builds.
+    static LogGate sLogGate("SYS_Rng32", 32);
+    if (FATES_LOG_ON(Trace, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SYS_Rng32: state=%p raw=%08X bound=%u -> %u (n=%d)",
-             rngState,
-             raw,
-             upperBound,
-             result,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Trace, Hook, "Hook_SYS_Rng32: state=%p raw=%08X bound=%u -> %u (n=%u)",
+                               rngState,
+                               raw,
+                               upperBound,
+                               result,
+                               LogGate_Count(sLogGate));
     }
 
     // Engine-level summary (map/turn-aware).
@@ -396,27 +333,24 @@ int Hook_BTL_CritCalc_Main(void * unit,
                            int   indexOrFlag)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Telemetry
     std::size_t idx = IndexOf(HookId_BTL_CritCalc_Main);
     gHookCount[idx]++;
-
-    HookContext &ctx = HookContext::GetCurrent();
+    FATES_HOOK_PROFILE(HookId_BTL_CritCalc_Main);
 
     // Call the original Unit__GetCritical.
-    int crit = ctx.OriginalFunction<int, void *, int>(unit, indexOrFlag);
+    int crit = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, int>(HookId_BTL_CritCalc_Main, unit, indexOrFlag));
 
     // Light logging 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("BTL_CritCalc_Main", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_CritCalc_Main(Unit__GetCritical): unit=%p idx=%d -> crit=%d (n=%d)",
-             unit,
-             indexOrFlag,
-             crit,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_CritCalc_Main(Unit__GetCritical): unit=%p idx=%d -> crit=%d (n=%u)",
+                               unit,
+                               indexOrFlag,
+                               crit,
+                               LogGate_Count(sLogGate));
     }
 
     return crit;
@@ -429,62 +363,56 @@ void Hook_BTL_FinalDamage_Pre(void *calcRaw,
                               void *arg3)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Count invocations for telemetry.
     std::size_t idx = IndexOf(HookId_BTL_FinalDamage_Pre);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_FinalDamage_Pre);
+
+    // First strike of a battle: the engine decodes and caches the
+    // BattleContext (and emits BattleBegin). Later strikes are a compare.
+    if (IsBattleCalcReadable(calcRaw))
+        Engine::OnBattleCalc(calcRaw, gCurrentTurnSide);
 
-    // Peel the BattleRoot off the calculator and remember it for the
-    // upcoming SEQ_Battle_UpdateHp / SEQ_HpDamage pass.
-    BattleRoot *root = GetBattleRoot(calcRaw);
-    sLastBattleRoot  = root;
+    const Engine::BattleContext *battle = Engine::GetCurrentBattle();
+    BattleRoot *root = battle ? static_cast<BattleRoot *>(battle->root) : nullptr;
 
     // Only do deep logging for the first few calls so log will be readable.
-    static int sLogCount = 0;
-    if (sLogCount < 16)
+    static LogGate sLogGate("BTL_FinalDamage_Pre", 16);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_FinalDamage_Pre: calc=%p root=%p arg1=%p arg2=%p arg3=%p (n=%d)",
-             calcRaw, root, arg1, arg2, arg3, sLogCount + 1);
+        FATES_LOG(Debug, Hook, "Hook_BTL_FinalDamage_Pre: calc=%p root=%p arg1=%p arg2=%p arg3=%p (n=%u)",
+                               calcRaw, root, arg1, arg2, arg3, LogGate_Count(sLogGate));
 
-        if (root != nullptr)
+        std::uint32_t w[16];
+        if (root != nullptr && SafeRead_Words(root, w, 16))
         {
-            u32 *w = reinterpret_cast<u32 *>(root);
-
-            Logf("  root[0x00..0x3C] = "
-                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
-                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
-                 w[0],  w[1],  w[2],  w[3],
-                 w[4],  w[5],  w[6],  w[7],
-                 w[8],  w[9],  w[10], w[11],
-                 w[12], w[13], w[14], w[15]);
-
-            Unit *mainUnit = root->mainUnit;
-            u32   flags    = root->flags;
-            int   unk14    = root->unk14;
-            u32   unk18    = root->unk18;
-            u32   unk1C    = root->unk1C;
-
-            Logf("  root view: main=%p flags=%08X unk14=%d unk18=%u unk1C=%u",
-                 mainUnit, flags, unk14, unk18, unk1C);
+            FATES_LOG(Debug, RE, "  root[0x00..0x3C] = "
+                                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
+                                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
+                                 w[0],  w[1],  w[2],  w[3],
+                                 w[4],  w[5],  w[6],  w[7],
+                                 w[8],  w[9],  w[10], w[11],
+                                 w[12], w[13], w[14], w[15]);
+
+            FATES_LOG(Debug, Hook, "  root view: main=%p flags=%08X unk14=%d unk18=%u unk1C=%u",
+                                   battle->attacker.Raw(), battle->flags,
+                                   static_cast<int>(w[5]), w[6], w[7]);
 
             // NEW: see whether this main unit is marked as having the
             // debug skill 0x000E for this map. (see above on for debug skill info)
-            if (DebugSkills_Has(mainUnit))
+            if (Engine::Skills::UnitHasDebugSkill(battle->attacker.Raw()))
             {
-                Logf("  [DebugSkill] main unit %p has debug skill 0x%04X (BTL_FinalDamage_Pre)",
-                     mainUnit,
-                     static_cast<unsigned>(kDebugSkillId));
+                FATES_LOG(Debug, Hook, "  [DebugSkill] main unit %p has debug skill 0x%04X (BTL_FinalDamage_Pre)",
+                                       battle->attacker.Raw(),
+                                       static_cast<unsigned>(Engine::Skills::kDebugSkillId));
             }
         }
-
-        ++sLogCount;
     }
 
     // Pure MITM pass-through for now.
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *, void *, void *>(
-        calcRaw, arg1, arg2, arg3);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *, void *, void *>(
+        HookId_BTL_FinalDamage_Pre, calcRaw, arg1, arg2, arg3));
 }
 
 // Depricated, do not rely on or use, left only as a named concept.
@@ -494,22 +422,20 @@ void Hook_BTL_FinalDamage_Post(void *battleContext,
                                void *defender)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_BTL_FinalDamage_Post);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_FinalDamage_Post);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("BTL_FinalDamage_Post", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_FinalDamage_Post: ctx=%p atk=%p def=%p (n=%d)",
-             battleContext, attacker, defender, sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_FinalDamage_Post: ctx=%p atk=%p def=%p (n=%u)",
+                               battleContext, attacker, defender, LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *, void *>(
-        battleContext, attacker, defender);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *, void *>(
+        HookId_BTL_FinalDamage_Post, battleContext, attacker, defender));
 }
 
 // Not functional, will be revisited later, reserved for now.
@@ -519,14 +445,13 @@ void Hook_BTL_GuardGauge_Add(void * battleContext,
                              void * defender)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_BTL_GuardGauge_Add);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_GuardGauge_Add);
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *, void *>(
-        battleContext, attacker, defender);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *, void *>(
+        HookId_BTL_GuardGauge_Add, battleContext, attacker, defender));
 }
 
 // Not functional, will be revisited later, reserved for now.
@@ -536,14 +461,13 @@ void Hook_BTL_GuardGauge_Spend(void * battleContext,
                                void * defender)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_BTL_GuardGauge_Spend);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_GuardGauge_Spend);
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *, void *>(
-        battleContext, attacker, defender);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *, void *>(
+        HookId_BTL_GuardGauge_Spend, battleContext, attacker, defender));
 }
 
 // ---------------------------------------------------------------------
@@ -561,9 +485,10 @@ static std::uint32_t ApplyPostBattleHpDebug(void *seq,
     //
     // 1) Future: real post-battle HP effects (currently a no-op)
     //
-    if (mode == 0 && sLastBattleRoot != nullptr)
+    const Fates::Engine::BattleContext *battle = Fates::Engine::GetCurrentBattle();
+    if (mode == 0 && battle != nullptr)
     {
-        // TODO: inspect sLastBattleRoot and apply
+        // TODO: inspect the current battle and apply
         // real post-battle auras / poison / regen etc here 
     }
 
@@ -598,13 +523,13 @@ static std::uint32_t ApplyPostBattleHpDebug(void *seq,
     {
         ++sModCount;
 
-        Logf("    [MOD] slot=%d oldHp=%u newHp=%u (mode=%d root=%p main=%p)",
-             slot,
-             oldHp,
-             newHp,
-             mode,
-             sLastBattleRoot,
-             sLastBattleRoot ? sLastBattleRoot->mainUnit : nullptr);
+        FATES_LOG(Debug, Hook, "    [MOD] slot=%d oldHp=%u newHp=%u (mode=%d root=%p main=%p)",
+                               slot,
+                               oldHp,
+                               newHp,
+                               mode,
+                               battle ? battle->root : nullptr,
+                               battle ? battle->attacker.Raw() : nullptr);
     }
 
     return newHp;
@@ -614,29 +539,35 @@ void Hook_SEQ_HpDamage(void *seq,
                        int   mode)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_HpDamage);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_HpDamage);
 
-    static int sLogCount = 0;
+    // New HP pass: outside a battle this closes the HP coalescing window.
+    Engine::OnHpSequenceBoundary();
 
-    auto *self = reinterpret_cast<std::uint8_t *>(seq);
+    static LogGate sLogGate("SEQ_HpDamage", 64);
+
+    auto *self = static_cast<std::uint8_t *>(seq);
+
+    // Result block pointer at seq+0x254; its four HP words at +0x20.
+    std::uintptr_t resultAddr = 0;
+    if (seq != nullptr)
+        SafeRead_HeapPtr(self + 0x254, resultAddr);
 
-    auto **resultBasePtr =
-        reinterpret_cast<std::uint8_t **>(self + 0x254);
-    std::uint8_t *resultBase =
-        (resultBasePtr != nullptr) ? *resultBasePtr : nullptr;
+    auto *resultBase = reinterpret_cast<std::uint8_t *>(resultAddr);
 
-    if (resultBase != nullptr)
+    if (resultBase != nullptr && SafeRead_InHeap(resultBase + 0x20, 4 * 4))
     {
         // Optional logging of the header, gated by the HP debug toggle.
 		// Need to phase out *all* current hotkey toggles, this included.
-        if (gHpApplyLogEnabled && sLogCount < 64)
+        bool logThis = gHpApplyLogEnabled && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate);
+        if (logThis)
         {
-            Logf("Hook_SEQ_HpDamage/UpdateHp: seq=%p mode=%d (hit=%d)",
-                 seq, mode, sLogCount + 1);
-            Logf("  resultBase=%p", resultBase);
+            FATES_LOG(Debug, Hook, "Hook_SEQ_HpDamage/UpdateHp: seq=%p mode=%d (hit=%u)",
+                                   seq, mode, LogGate_Count(sLogGate));
+            FATES_LOG(Debug, Hook, "  resultBase=%p", resultBase);
         }
 
         for (int slot = 0; slot < 4; ++slot)
@@ -658,70 +589,65 @@ void Hook_SEQ_HpDamage(void *seq,
 
             // Per-slot logging, gated by HP debug toggle.
 			// Phase out hotkey toggle!!
-            if (gHpApplyLogEnabled && sLogCount < 64)
+            if (logThis)
             {
-                Logf("    slot=%d hpWord=%08X (%u) @%p",
-                     slot,
-                     hpWord,
-                     hpWord,
-                     hpWordPtr);
+                FATES_LOG(Debug, Hook, "    slot=%d hpWord=%08X (%u) @%p",
+                                       slot,
+                                       hpWord,
+                                       hpWord,
+                                       hpWordPtr);
             }
         }
-
-        if (gHpApplyLogEnabled && sLogCount < 64)
-            ++sLogCount;
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, int>(seq, mode);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, int>(HookId_SEQ_HpDamage, seq, mode));
 }
 
 void Hook_UNIT_UpdateCloneHP(void *unit)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_UNIT_UpdateCloneHP);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_UNIT_UpdateCloneHP);
 
-    // First, run the real implementation so HP actually gets copied.
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(unit);
-
-    if (unit != nullptr)
+    // Until the original runs, the clone still holds the HP of the last
+    // sync: the baseline for a unit the engine hasn't seen this map.
+    const bool readable = IsUnitReadable(unit);
+    int prevHpInt = -1;
+    if (readable)
     {
-        u32 base = reinterpret_cast<u32>(unit);
+        void *clone = Engine::Unit_GetClone(unit);
+        if (clone != nullptr && IsUnitReadable(clone))
+            prevHpInt = Engine::Unit_GetCurrentHp(clone);
+    }
 
-        // Source HP: signed 8-bit value at +0xF3.
-        s8  srcHp    = *reinterpret_cast<signed char *>(base + 0xF3);
-        int srcHpInt = static_cast<int>(srcHp);
+    // Run the real implementation so HP actually gets copied.
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_UNIT_UpdateCloneHP, unit));
+
+    if (readable)
+    {
+        int srcHpInt = Engine::Unit_GetCurrentHp(unit);
 
         // Engine-level: treat this as “unit HP has just been synced”.
         // This is now the canonical driver for HpChange events.
-        Engine::OnUnitHpSync(unit, srcHpInt);
-
-        // Clone pointer lives at +0xAC. You will most likely never touch this.
-        void *clone = *reinterpret_cast<void * *>(base + 0xAC);
-
-        int cloneHpInt = -1;
-        if (clone != nullptr)
-        {
-            u32 cloneBase = reinterpret_cast<u32>(clone);
-            s8  cloneHp   = *reinterpret_cast<signed char *>(cloneBase + 0xF3);
-            cloneHpInt    = static_cast<int>(cloneHp);
-        }
+        Engine::OnUnitHpSync(unit, srcHpInt, prevHpInt);
 
         // Keep the lightweight debug log, but gate it behind HP toggle.
-        static int sLogCount = 0;
-        if (gHpApplyLogEnabled && sLogCount < 64)
+        static LogGate sLogGate("UNIT_UpdateCloneHP", 64);
+        if (gHpApplyLogEnabled && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
         {
-            Logf("UNIT_UpdateCloneHP: src=%p hp=%d clone=%p hpClone=%d (n=%d)",
-                 unit,
-                 srcHpInt,
-                 clone,
-                 cloneHpInt,
-                 sLogCount + 1);
-            ++sLogCount;
+            // Clone is only needed for the log line. You will most
+            // likely never touch it.
+            void *clone      = Engine::Unit_GetClone(unit);
+            int   cloneHpInt = IsUnitReadable(clone) ? Engine::Unit_GetCurrentHp(clone) : -1;
+
+            FATES_LOG(Debug, Hook, "UNIT_UpdateCloneHP: src=%p hp=%d clone=%p hpClone=%d (n=%u)",
+                                   unit,
+                                   srcHpInt,
+                                   clone,
+                                   cloneHpInt,
+                                   LogGate_Count(sLogGate));
         }
     }
 }
@@ -732,26 +658,24 @@ int Hook_UNIT_HpDamage(void *a0,
                        void *a3)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_UNIT_HpDamage);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_UNIT_HpDamage);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
     int unitIndex = static_cast<int>(reinterpret_cast<std::intptr_t>(a1));
     int dmgAmount = static_cast<int>(reinterpret_cast<std::intptr_t>(a2));
 
-    static int sLogCount = 0;
-    if (gHpApplyLogEnabled && sLogCount < 64)
+    static LogGate sLogGate("UNIT_HpDamage", 64);
+    if (gHpApplyLogEnabled && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_UNIT_HpDamage: total=%u idx=%d dmg=%d a0=%p a3=%p (n=%d)",
-             total, unitIndex, dmgAmount, a0, a3, sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_UNIT_HpDamage: total=%u idx=%d dmg=%d a0=%p a3=%p (n=%u)",
+                               total, unitIndex, dmgAmount, a0, a3, LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *, void *, void *, void *>(
-        a0, a1, a2, a3);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, void *, void *, void *>(
+        HookId_UNIT_HpDamage, a0, a1, a2, a3));
 
     return result;
 }
@@ -760,28 +684,24 @@ void Hook_HP_KillCheck(void *calc,
                        void *contextOrFlags)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Count how many times this hook fires.
     std::size_t idx = IndexOf(HookId_HP_KillCheck);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_HP_KillCheck);
 
     // Run the real ProcSequence::DeadEvent first so that all of its
     // side-effects are committed before the sequence is inspected.
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *>(calc, contextOrFlags);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *>(HookId_HP_KillCheck, calc, contextOrFlags));
 
-    if (calc == nullptr)
+    if (!SafeRead_InHeap(calc, kSeqBattleReadSpan))
         return;
 
-    // Extract Logging fields:
-    //   +0x280 = flags bitfield
-    //   +0x284 = dead slot 0 (pointer or nullptr)
-    //   +0x288 = dead slot 1 (pointer or nullptr)
-    u32 base          = reinterpret_cast<u32>(calc);
-    unsigned int flags = *reinterpret_cast<unsigned int *>(base + 0x280);
-    void *dead0        = *reinterpret_cast<void * *>(base + 0x284);
-    void *dead1        = *reinterpret_cast<void * *>(base + 0x288);
+    // Dead-event block (engine/unit_layout.hpp, SeqBattleLayout):
+    // flags bitfield + two dead slots (pointer or nullptr).
+    unsigned int flags = Engine::SeqBattle_GetDeadFlags(calc);
+    void *dead0        = Engine::SeqBattle_GetDead0(calc);
+    void *dead1        = Engine::SeqBattle_GetDead1(calc);
 
     // Only treat this as a "real" kill event if there is actually
     // something meaningful: non-zero flags or at least one dead slot.
@@ -821,28 +741,27 @@ void Hook_HP_KillCheck(void *calc,
         Engine::OnKill(ev, side);
 
         // Light logging windows
-        static int sLogCount = 0;
-        if (sLogCount < 64)
+        static LogGate sLogGate("HP_KillCheck", 64);
+        if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
         {
-            Logf("Hook_HP_KillCheck: seq=%p flags=0x%08X dead0=%p dead1=%p "
-                 "ctx=%p pushed=%d (eventIdx=%d, mapGen=%u mapKills=%u, "
-                 "totalKills=%u [S0=%u S1=%u S2=%u S3=%u], n=%d)",
-                 calc,
-                 flags,
-                 dead0,
-                 dead1,
-                 contextOrFlags,
-                 pushed ? 1 : 0,
-                 pushed ? (gKillEventCount - 1) : -1,
-                 static_cast<unsigned>(gMapState.generation),
-                 static_cast<unsigned>(gMapState.killEvents),
-                 gMapStats.totalKills,
-                 gMapStats.killsBySide[0],
-                 gMapStats.killsBySide[1],
-                 gMapStats.killsBySide[2],
-                 gMapStats.killsBySide[3],
-                 sLogCount + 1);
-            ++sLogCount;
+            FATES_LOG(Debug, Hook, "Hook_HP_KillCheck: seq=%p flags=0x%08X dead0=%p dead1=%p "
+                                   "ctx=%p pushed=%d (eventIdx=%d, mapGen=%u mapKills=%u, "
+                                   "totalKills=%u [S0=%u S1=%u S2=%u S3=%u], n=%u)",
+                                   calc,
+                                   flags,
+                                   dead0,
+                                   dead1,
+                                   contextOrFlags,
+                                   pushed ? 1 : 0,
+                                   pushed ? (gKillEventCount - 1) : -1,
+                                   static_cast<unsigned>(gMapState.generation),
+                                   static_cast<unsigned>(gMapState.killEvents),
+                                   gMapStats.totalKills,
+                                   gMapStats.killsBySide[0],
+                                   gMapStats.killsBySide[1],
+                                   gMapStats.killsBySide[2],
+                                   gMapStats.killsBySide[3],
+                                   LogGate_Count(sLogGate));
         }
     }
 }
@@ -853,37 +772,35 @@ int Hook_SEQ_HpDamage_Helper(void *a0,
                              void *a3)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Count how many times this hook fires.
     std::size_t idx = IndexOf(HookId_SEQ_HpDamage_Helper);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_HpDamage_Helper);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
     // Third argument is the raw heal amount (positive int) passed in a2.
     int healAmount = static_cast<int>(reinterpret_cast<std::intptr_t>(a2));
 
-    static int sLogCount = 0;
-    if (gHpApplyLogEnabled && sLogCount < 64)
+    static LogGate sLogGate("SEQ_HpDamage_Helper", 64);
+    if (gHpApplyLogEnabled && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SEQ_HpDamageHelper: total=%u heal=%d a0=%p a1=%p a3=%p (n=%d)",
-             total,
-             healAmount,
-             a0,
-             a1,
-             a3,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_SEQ_HpDamageHelper: total=%u heal=%d a0=%p a1=%p a3=%p (n=%u)",
+                               total,
+                               healAmount,
+                               a0,
+                               a1,
+                               a3,
+                               LogGate_Count(sLogGate));
     }
 
     // IMPORTANT: no modification here. Just observe and forward. (Does this need to removed? Future me revisit!!)
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *, void *, void *, void *>(
-        a0,  // SequenceHelper* / context
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, void *, void *, void *>(
+        HookId_SEQ_HpDamage_Helper, a0,  // SequenceHelper* / context
         a1,  // Unit*
         a2,  // original heal amount (positive)
         a3   // flags / mode
-    );
+    ));
 
     // Canonical HP-change events are now derived from
     // UNIT_UpdateCloneHP via Engine::OnUnitHpSync, don't emit
@@ -898,29 +815,27 @@ int Hook_SEQ_ItemGain(void *seqHelper,
                       void *modeOrCtx)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Count how many times this hook fires.
     std::size_t idx = IndexOf(HookId_SEQ_ItemGain);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_ItemGain);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("SEQ_ItemGain", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SEQ_ItemGain: total=%u seq=%p unit=%p itemArg=%p mode=%p (n=%d)",
-             total,
-             seqHelper,
-             unit,
-             itemArg,
-             modeOrCtx,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_SEQ_ItemGain: total=%u seq=%p unit=%p itemArg=%p mode=%p (n=%u)",
+                               total,
+                               seqHelper,
+                               unit,
+                               itemArg,
+                               modeOrCtx,
+                               LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *, void *, void *, void *>(
-        seqHelper, unit, itemArg, modeOrCtx);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, void *, void *, void *>(
+        HookId_SEQ_ItemGain, seqHelper, unit, itemArg, modeOrCtx));
 
     // Engine notification (map/turn aware).
     Engine::OnItemGain(seqHelper,
@@ -937,64 +852,58 @@ int Hook_SEQ_ItemGain(void *seqHelper,
 void Hook_MAP_ProcSkillDamage(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_MAP_ProcSkillDamage);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_MAP_ProcSkillDamage);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("MAP_ProcSkillDamage", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_MAP_ProcSkillDamage (TerrainHeal): seq=%p (n=%d)",
-             seq,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_MAP_ProcSkillDamage (TerrainHeal): seq=%p (n=%u)",
+                               seq,
+                               LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_MAP_ProcSkillDamage, seq));
 }
 
 void Hook_MAP_ProcTerrainDamage(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_MAP_ProcTerrainDamage);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_MAP_ProcTerrainDamage);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("MAP_ProcTerrainDamage", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_MAP_ProcTerrainDamage (TrickStatueHeal): seq=%p (n=%d)",
-             seq,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_MAP_ProcTerrainDamage (TrickStatueHeal): seq=%p (n=%u)",
+                               seq,
+                               LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_MAP_ProcTerrainDamage, seq));
 }
 
 void Hook_MAP_ProcTrickDamage(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_MAP_ProcTrickDamage);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_MAP_ProcTrickDamage);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("MAP_ProcTrickDamage", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_MAP_ProcTrickDamage (SkillCannonEffect): seq=%p (n=%d)",
-             seq,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_MAP_ProcTrickDamage (SkillCannonEffect): seq=%p (n=%u)",
+                               seq,
+                               LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_MAP_ProcTrickDamage, seq));
 }
 
 // ---------------------------------------------------------------------
@@ -1004,103 +913,92 @@ void Hook_MAP_ProcTrickDamage(void *seq)
 int Hook_EVENT_ActionEnd(void *eventInstance)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Telemetry
     std::size_t idx = IndexOf(HookId_EVENT_ActionEnd);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_EVENT_ActionEnd);
 
-    static int sLogCount = 0;
+    // One gate decision per call covers both the pre and post lines.
+    static LogGate sLogGate("EVENT_ActionEnd", 16);
+    bool logThis = FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate);
 
     // -------------------------------------------------------------
     // PRE: keep the existing structural logging (limited spam).
     // -------------------------------------------------------------
-    if (sLogCount < 16 && eventInstance != nullptr)
+    std::uint32_t w[32];
+    if (logThis && eventInstance != nullptr && SafeRead_Words(eventInstance, w, 32))
     {
-        auto *ev    = reinterpret_cast<UnitCommandEvent *>(eventInstance);
-        auto *base8 = reinterpret_cast<std::uint8_t *>(eventInstance);
-        auto *w     = reinterpret_cast<std::uint32_t *>(eventInstance);
-
-        Logf("Hook_EVENT_ActionEnd(pre): inst=%p cmdId=%u side=%u seqMap=%p cmdData=%p unk28=%u",
-             ev,
-             ev->cmdId,
-             ev->side,
-             ev->seqMap,
-             ev->cmdData,
-             ev->unk28);
+        UnitCommandEvent ev;
+        std::memcpy(&ev, w, sizeof(ev));
+
+        FATES_LOG(Debug, Hook, "Hook_EVENT_ActionEnd(pre): inst=%p cmdId=%u side=%u seqMap=%p cmdData=%p unk28=%u",
+                               eventInstance,
+                               ev.cmdId,
+                               ev.side,
+                               ev.seqMap,
+                               ev.cmdData,
+                               ev.unk28);
 
         // First 0x40 bytes (words 0..15)
-        Logf("  inst[0x00..0x3C] = "
-             "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
-             "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
-             w[0],  w[1],  w[2],  w[3],
-             w[4],  w[5],  w[6],  w[7],
-             w[8],  w[9],  w[10], w[11],
-             w[12], w[13], w[14], w[15]);
+        FATES_LOG(Debug, RE, "  inst[0x00..0x3C] = "
+                             "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
+                             "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
+                             w[0],  w[1],  w[2],  w[3],
+                             w[4],  w[5],  w[6],  w[7],
+                             w[8],  w[9],  w[10], w[11],
+                             w[12], w[13], w[14], w[15]);
 
         // Next 0x40 bytes (words 16..31)
-        std::uint32_t *w2 = reinterpret_cast<std::uint32_t *>(base8 + 0x40);
-        Logf("  inst[0x40..0x7C] = "
-             "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
-             "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
-             w2[0],  w2[1],  w2[2],  w2[3],
-             w2[4],  w2[5],  w2[6],  w2[7],
-             w2[8],  w2[9],  w2[10], w2[11],
-             w2[12], w2[13], w2[14], w2[15]);
+        const std::uint32_t *w2 = w + 16;
+        FATES_LOG(Debug, RE, "  inst[0x40..0x7C] = "
+                             "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
+                             "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
+                             w2[0],  w2[1],  w2[2],  w2[3],
+                             w2[4],  w2[5],  w2[6],  w2[7],
+                             w2[8],  w2[9],  w2[10], w2[11],
+                             w2[12], w2[13], w2[14], w2[15]);
 
         // Peek into cmdData, if present – likely where the acting unit lives.
-        if (ev->cmdData != nullptr)
+        std::uint32_t cmd[16];
+        if (ev.cmdData != nullptr && SafeRead_Words(ev.cmdData, cmd, 16))
         {
-            auto *cmd = reinterpret_cast<std::uint32_t *>(ev->cmdData);
-            Logf("  cmdData[0x00..0x3C] = "
-                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
-                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
-                 cmd[0],  cmd[1],  cmd[2],  cmd[3],
-                 cmd[4],  cmd[5],  cmd[6],  cmd[7],
-                 cmd[8],  cmd[9],  cmd[10], cmd[11],
-                 cmd[12], cmd[13], cmd[14], cmd[15]);
+            FATES_LOG(Debug, RE, "  cmdData[0x00..0x3C] = "
+                                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
+                                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
+                                 cmd[0],  cmd[1],  cmd[2],  cmd[3],
+                                 cmd[4],  cmd[5],  cmd[6],  cmd[7],
+                                 cmd[8],  cmd[9],  cmd[10], cmd[11],
+                                 cmd[12], cmd[13], cmd[14], cmd[15]);
         }
     }
 
     // -------------------------------------------------------------
     // Call the original event handler so the game does its work.
     // -------------------------------------------------------------
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *>(eventInstance);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *>(HookId_EVENT_ActionEnd, eventInstance));
 
     // -------------------------------------------------------------
     // Engine-level notification: generic "action has ended" event.
     // -------------------------------------------------------------
     if (eventInstance != nullptr)
     {
-        auto *ev = reinterpret_cast<UnitCommandEvent *>(eventInstance);
-
-        // Raw side value from the struct (1 = Side1, 2 = Side2, etc.).
-        std::uint32_t sideRaw = ev->side;
-
-        // Canonical side from our global turn tracker.
-        TurnSide sideEnum = gCurrentTurnSide;
-
-        // Feed a minimal, future-proof payload into the engine.
-        Engine::OnActionEnd(
-            eventInstance,   // inst
-            ev->seqMap,      // seqMap (same as SEQ_MapStart seq)
-            ev->cmdData,     // cmdData pointer
-            ev->cmdId,       // raw command id
-            sideRaw,         // sideRaw from struct
-            sideEnum,        // canonical TurnSide
-            ev->unk28        // extra mode/flags word
-        );
+        // The action ended either way: an unreadable instance still
+        // notifies the engine, just with empty fields. The side passed
+        // on is the canonical one from our turn tracker; the struct's
+        // raw side travels in ev.sideRaw.
+        Engine::ActionEvent ev;
+        DecodeCommandEvent(eventInstance, ev);
+        Engine::OnActionEnd(ev, gCurrentTurnSide);
     }
 
     // -------------------------------------------------------------
     // POST log (once per call pair).
     // -------------------------------------------------------------
-    if (sLogCount < 16)
+    if (logThis)
     {
-        Logf("Hook_EVENT_ActionEnd(post): inst=%p -> %d (n=%d)",
-             eventInstance, result, sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_EVENT_ActionEnd(post): inst=%p -> %d (n=%u)",
+                               eventInstance, result, LogGate_Count(sLogGate));
     }
 
     return result;
@@ -1114,51 +1012,45 @@ int Hook_BTL_AttackStance_Check(void *situation,
                                 int   index)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idxCount = IndexOf(HookId_BTL_AttackStance_Check);
     gHookCount[idxCount]++;
-
-    HookContext &ctx = HookContext::GetCurrent();
+    FATES_HOOK_PROFILE(HookId_BTL_AttackStance_Check);
 
     // bool map__Situation__CanDual(Situation* self, int index)
-    int result = ctx.OriginalFunction<int, void *, int>(
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, int>(
+        HookId_BTL_AttackStance_Check,
         situation,
         index
-    );
+    ));
 
-    static int sLogCount  = 0;
-    static int sDumpCount = 0;
+    static LogGate sLogGate("BTL_AttackStance_Check", 16);
+    static LogGate sDumpGate("BTL_AttackStance_Check.Dump", 8);
 
     // Lightweight logging
-    if (sLogCount < 16)
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_AttackStance_Check(CanDual): sit=%p idx=%d -> %d (n=%d)",
-             situation,
-             index,
-             result,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_AttackStance_Check(CanDual): sit=%p idx=%d -> %d (n=%u)",
+                               situation,
+                               index,
+                               result,
+                               LogGate_Count(sLogGate));
     }
 
     // Extra: limited hexdump of the situation struct for RE.
-    // Only dump for heap-like addresses, and only a few times.
-    if (situation != nullptr && sDumpCount < 8)
+    // Only dump for heap-like addresses, and only a few times per map.
+    if (situation != nullptr && FATES_LOG_ON(Debug, RE) && LogGate_Allow(sDumpGate))
     {
-        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(situation);
-        if (addr >= kHeapMinVA && addr <= kHeapMaxVA)
+        std::uint32_t w[16];
+        if (SafeRead_InHeap(situation, sizeof(w)) && SafeRead_Words(situation, w, 16))
         {
-            auto *w = reinterpret_cast<std::uint32_t *>(situation);
-
-            Logf("  sit[0x00..0x3C] = "
-                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
-                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
-                 w[0],  w[1],  w[2],  w[3],
-                 w[4],  w[5],  w[6],  w[7],
-                 w[8],  w[9],  w[10], w[11],
-                 w[12], w[13], w[14], w[15]);
-
-            ++sDumpCount;
+            FATES_LOG(Debug, RE, "  sit[0x00..0x3C] = "
+                                 "{%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X,"
+                                 "%08X,%08X,%08X,%08X,%08X,%08X,%08X,%08X}",
+                                 w[0],  w[1],  w[2],  w[3],
+                                 w[4],  w[5],  w[6],  w[7],
+                                 w[8],  w[9],  w[10], w[11],
+                                 w[12], w[13], w[14], w[15]);
         }
     }
 
@@ -1169,32 +1061,27 @@ int Hook_BTL_AttackStance_Check(void *situation,
 void Hook_BTL_AttackStance_ApplySupport(void *battleInfo)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_BTL_AttackStance_ApplySupport);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_AttackStance_ApplySupport);
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(battleInfo);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_BTL_AttackStance_ApplySupport, battleInfo));
 
-    static int sLogCount = 0;
-    if (sLogCount < 16 && battleInfo != nullptr)
+    static LogGate sLogGate("BTL_AttackStance_ApplySupport", 16);
+    // BattleRoot words 0..7 (see struct BattleRoot above).
+    std::uint32_t w[8];
+    if (battleInfo != nullptr && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate) && SafeRead_Words(battleInfo, w, 8))
     {
-        auto *root = reinterpret_cast<BattleRoot *>(battleInfo);
-
-        u32 *w = reinterpret_cast<u32 *>(root);
-
-        Logf("Hook_BTL_AttackStance_ApplySupport(CalculateDual): root=%p "
-             "w0=%08X w1=%08X flags=%08X unk14=%d unk18=%u unk1C=%u (n=%d)",
-             root,
-             w[0], w[1],
-             root->flags,
-             root->unk14,
-             root->unk18,
-             root->unk1C,
-             sLogCount + 1);
-
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_AttackStance_ApplySupport(CalculateDual): root=%p "
+                               "w0=%08X w1=%08X flags=%08X unk14=%d unk18=%u unk1C=%u (n=%u)",
+                               battleInfo,
+                               w[0], w[1],
+                               w[4],
+                               static_cast<int>(w[5]),
+                               w[6],
+                               w[7],
+                               LogGate_Count(sLogGate));
     }
 }
 
@@ -1202,19 +1089,22 @@ void Hook_BTL_AttackStance_ApplySupport(void *battleInfo)
 // HUD and skill hooks
 // ---------------------------------------------------------------------
 // THIS IS CURRENTLY NONFUNCTIONAL, DO NOT USE, ONLY RESERVED.
+// Exception: when the HPGaugeUpdate hook is installed it also samples
+// the live stats overlay (stats_overlay.hpp) while a battle is shown.
 //
 
 void Hook_HUD_Battle_HPGaugeUpdate(void * hudContext,
                                    void * unit)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_HUD_Battle_HPGaugeUpdate);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_HUD_Battle_HPGaugeUpdate);
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *, void *>(hudContext, unit);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *, void *>(HookId_HUD_Battle_HPGaugeUpdate, hudContext, unit));
+
+    StatsOverlay_Sample();
 }
 
 int Hook_BTL_SkillEffect_Apply(void *battleContext,
@@ -1223,22 +1113,20 @@ int Hook_BTL_SkillEffect_Apply(void *battleContext,
                                std::uint32_t skillIdOrFlags)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_BTL_SkillEffect_Apply);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_BTL_SkillEffect_Apply);
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("BTL_SkillEffect_Apply", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_BTL_SkillEffect_Apply: bc=%p atk=%p def=%p skill=0x%08X (n=%d)",
-             battleContext, attacker, defender, skillIdOrFlags, sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_BTL_SkillEffect_Apply: bc=%p atk=%p def=%p skill=0x%08X (n=%u)",
+                               battleContext, attacker, defender, skillIdOrFlags, LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *, void *, void *, std::uint32_t>(
-        battleContext, attacker, defender, skillIdOrFlags);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, void *, void *, std::uint32_t>(
+        HookId_BTL_SkillEffect_Apply, battleContext, attacker, defender, skillIdOrFlags));
 
     return result;
 }
@@ -1250,12 +1138,14 @@ int Hook_BTL_SkillEffect_Apply(void *battleContext,
 void Hook_SEQ_TurnBegin()
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_TurnBegin);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_TurnBegin);
 
-	TurnSide side = GetTurnSideEnum();
+	// Side index may move at every turn: re-resolve, then one load.
+	TurnState_Resolve();
+	TurnSide side = TurnState_GetSide();
 	gCurrentTurnSide = side;
 
 	// Feed into map lifecycle summary.
@@ -1264,33 +1154,29 @@ void Hook_SEQ_TurnBegin()
 	// Engine notification: a new turn has started.
 	Engine::OnTurnBegin(side);
 
-	HookContext &ctx = HookContext::GetCurrent();
-	ctx.OriginalFunction<void>();
+	FATES_HOOK_ORIGINAL(HookCallOriginal<void>(HookId_SEQ_TurnBegin));
 
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("SEQ_TurnBegin", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        std::uint8_t raw = GetTurnSideIndexRaw();
-        Logf("Hook_SEQ_TurnBegin: sideRaw=%u side=%s (n=%d)",
-             static_cast<unsigned>(raw),
-             TurnSideToString(side),
-             sLogCount + 1);
-        ++sLogCount;
+        std::uint8_t raw = TurnState_GetSideRaw();
+        FATES_LOG(Debug, Hook, "Hook_SEQ_TurnBegin: sideRaw=%u side=%s (n=%u)",
+                               static_cast<unsigned>(raw),
+                               TurnSideToString(side),
+                               LogGate_Count(sLogGate));
     }
 }
 
 int Hook_SEQ_TurnEnd(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_TurnEnd);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_TurnEnd);
 
-	HookContext &ctx = HookContext::GetCurrent();
-
-	int result = ctx.OriginalFunction<int, void *>(seq);
+	int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *>(HookId_SEQ_TurnEnd, seq));
 
 	// Use the last turn side
 	// maintained in Hook_SEQ_TurnBegin.
@@ -1299,15 +1185,14 @@ int Hook_SEQ_TurnEnd(void *seq)
 	// Engine notification: a turn just ended.
 	Engine::OnTurnEnd(side, seq);
 
-	static int sLogCount = 0;
-	if (sLogCount < 64)
+	static LogGate sLogGate("SEQ_TurnEnd", 64);
+	if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
 	{
-		Logf("Hook_SEQ_TurnEnd: seq=%p side=%s -> %d (n=%d)",
+		FATES_LOG(Debug, Hook, "Hook_SEQ_TurnEnd: seq=%p side=%s -> %d (n=%u)",
 			seq,
 			TurnSideToString(gCurrentTurnSide),
 			result,
-			sLogCount + 1);
-		++sLogCount;
+			LogGate_Count(sLogGate));
 	}
 
 
@@ -1317,41 +1202,52 @@ int Hook_SEQ_TurnEnd(void *seq)
 int Hook_SEQ_MapEnd(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_MapEnd);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_MapEnd);
 
-    HookContext &ctx = HookContext::GetCurrent();
-    int result = ctx.OriginalFunction<int, void *>(seq);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *>(HookId_SEQ_MapEnd, seq));
 
-    // Use the same helper as elsewhere to derive side.
-    TurnSide side = GetTurnSideEnum();
+    // Cached side byte from the last SEQ_TurnBegin.
+    TurnSide side = TurnState_GetSide();
 
     // Notify the engine that the map has ended / completed.
     Engine::OnMapEnd(seq, side);
 
-    // Mark map as inactive in the lifecycle summary.
+    // Mark map as inactive in the lifecycle summary. The map's turn
+    // state goes away with it; the next map resolves the chain again.
     MapLife_OnMapEnd();
+    TurnState_Invalidate();
+
+    // Bad pointers rejected by the hook guards, once per map.
+    static std::uint32_t sReportedRejects = 0;
+    const std::uint32_t rejects = SafeRead_GetRejects();
+    if (rejects != sReportedRejects)
+    {
+        FATES_LOG(Warn, Hook, "Hook_SEQ_MapEnd: %u guarded read(s) rejected this map (%u total)",
+                              static_cast<unsigned>(rejects - sReportedRejects),
+                              static_cast<unsigned>(rejects));
+        sReportedRejects = rejects;
+    }
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("SEQ_MapEnd", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SEQ_MapEnd(Complete): seq=%p side=%s -> %d "
-             "(n=%d, gen=%u totalTurns=%u totalKills=%u "
-             "[S0=%u S1=%u S2=%u S3=%u])",
-             seq,
-             TurnSideToString(side),
-             result,
-             sLogCount + 1,
-             static_cast<unsigned>(gMapState.generation),
-             gMapState.totalTurns,
-             gMapStats.totalKills,
-             gMapStats.killsBySide[0],
-             gMapStats.killsBySide[1],
-             gMapStats.killsBySide[2],
-             gMapStats.killsBySide[3]);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_SEQ_MapEnd(Complete): seq=%p side=%s -> %d "
+                               "(n=%u, gen=%u totalTurns=%u totalKills=%u "
+                               "[S0=%u S1=%u S2=%u S3=%u])",
+                               seq,
+                               TurnSideToString(side),
+                               result,
+                               LogGate_Count(sLogGate),
+                               static_cast<unsigned>(gMapState.generation),
+                               gMapState.totalTurns,
+                               gMapStats.totalKills,
+                               gMapStats.killsBySide[0],
+                               gMapStats.killsBySide[1],
+                               gMapStats.killsBySide[2],
+                               gMapStats.killsBySide[3]);
     }
 
     return result;
@@ -1360,24 +1256,27 @@ int Hook_SEQ_MapEnd(void *seq)
 void Hook_SEQ_MapStart(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_MapStart);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_MapStart);
 
-    static void    *sLastSeq            = nullptr;
-    static unsigned sMapGeneration      = 0;
-    static int      sPersistentLogCount = 0;
+    static void    *sLastSeq       = nullptr;
+    static unsigned sMapGeneration = 0;
+    static LogGate  sPersistentGate("SEQ_MapStart.Persistent", 8);
 
     bool isNewMap = (seq != sLastSeq);
 
     if (isNewMap)
     {
         ++sMapGeneration;
-        sLastSeq            = seq;
-        sPersistentLogCount = 0;
+        sLastSeq = seq;
 
-		TurnSide side = GetTurnSideEnum();
+		TurnState_Resolve();
+		TurnSide side = TurnState_GetSide();
+
+		// Last map's units first: OnMapBegin re-indexes them right after its reset.
+		MapLife_CarryOverUnits();
 
 		// Update global map state.
 		MapLife_OnNewMap(seq, side);
@@ -1385,38 +1284,36 @@ void Hook_SEQ_MapStart(void *seq)
 		// Tell the engine a new map has begun.
 		Engine::OnMapBegin(seq, side);
 
-		Logf("Hook_SEQ_MapStart: NEW MAP gen=%u seq=%p side=%s",
+		FATES_LOG(Info, Hook, "Hook_SEQ_MapStart: NEW MAP gen=%u seq=%p side=%s",
 			static_cast<unsigned>(sMapGeneration),
 			seq,
 			TurnSideToString(side));
     }
-    else if (sPersistentLogCount < 8)
+    else if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sPersistentGate))
     {
-        ++sPersistentLogCount;
-
-        TurnSide side = GetTurnSideEnum();
+        TurnSide side = TurnState_GetSide();
 
-        Logf("Hook_SEQ_MapStart(Persistent): seq=%p tick=%d side=%s",
-             seq,
-             sPersistentLogCount,
-             TurnSideToString(side));
+        FATES_LOG(Debug, Hook, "Hook_SEQ_MapStart(Persistent): seq=%p tick=%d side=%s",
+                               seq,
+                               static_cast<int>(LogGate_Count(sPersistentGate)),
+                               TurnSideToString(side));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_SEQ_MapStart, seq));
 }
 
 void Hook_SEQ_ItemUse(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_SEQ_ItemUse);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_ItemUse);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
     void *unit   = nullptr;
     void *useCtx = nullptr;
+    Engine::ActionEvent ev;
 
     // Mirror what ProcSequence__Use does:
     //   r4 = seq
@@ -1425,61 +1322,61 @@ void Hook_SEQ_ItemUse(void *seq)
     if (seq != nullptr)
     {
         auto *base = static_cast<std::uint8_t *>(seq);
-        unit       = *reinterpret_cast<void **>(base + 0x30);
+        std::uintptr_t unitAddr = 0;
+        SafeRead_HeapPtr(base + 0x30, unitAddr);
+        unit       = reinterpret_cast<void *>(unitAddr);
         useCtx     = base + 0x34;
+
+        // Same command header as the UnitMove / ActionEnd instance.
+        DecodeCommandEvent(seq, ev);
+        ev.unit = Engine::UnitHandle(unit);
     }
 
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("SEQ_ItemUse", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SEQ_ItemUse(ProcSequence__Use): total=%u seq=%p unit=%p useCtx=%p (n=%d)",
-             total,
-             seq,
-             unit,
-             useCtx,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_SEQ_ItemUse(ProcSequence__Use): total=%u seq=%p unit=%p useCtx=%p (n=%u)",
+                               total,
+                               seq,
+                               unit,
+                               useCtx,
+                               LogGate_Count(sLogGate));
     }
 
-    HookContext &ctx = HookContext::GetCurrent();
     // Actual signature is void (void *seq)
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_SEQ_ItemUse, seq));
+
+    if (seq != nullptr)
+        Engine::OnItemUse(ev, gCurrentTurnSide);
 }
 
 void Hook_UNIT_LevelUp(void *unitRaw)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_UNIT_LevelUp);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_UNIT_LevelUp);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
-    HookContext &ctx = HookContext::GetCurrent();
-
     // Let the game actually perform the level-up first.
-    ctx.OriginalFunction<void, void *>(unitRaw);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_UNIT_LevelUp, unitRaw));
 
     LevelUpPayload payload{};
     payload.unit  = reinterpret_cast<Unit *>(unitRaw);
     payload.level = 0;
 
-    if (unitRaw != nullptr)
-    {
-        // Level is the byte at +0xF1 (from Unit__LevelUp disasm).
-        std::uint32_t base = reinterpret_cast<std::uint32_t>(unitRaw);
-        payload.level = *reinterpret_cast<std::uint8_t *>(base + 0xF1);
-    }
+    if (IsUnitReadable(unitRaw))
+        payload.level = static_cast<std::uint8_t>(Engine::Unit_GetLevel(unitRaw));
 
-    static int sLogCount = 0;
-    if (sLogCount < 32)
+    static LogGate sLogGate("UNIT_LevelUp", 32);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_UNIT_LevelUp: total=%u unit=%p level=%u (n=%d)",
-             total,
-             payload.unit,
-             static_cast<unsigned>(payload.level),
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_UNIT_LevelUp: total=%u unit=%p level=%u (n=%u)",
+                               total,
+                               payload.unit,
+                               static_cast<unsigned>(payload.level),
+                               LogGate_Count(sLogGate));
     }
 
     // Engine notification (map/turn aware).
@@ -1492,45 +1389,40 @@ int Hook_UNIT_SkillLearn(void          *unitRaw,
                          std::uint32_t  skillIdRaw)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     std::size_t idx = IndexOf(HookId_UNIT_SkillLearn);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_UNIT_SkillLearn);
     unsigned total = static_cast<unsigned>(gHookCount[idx]);
 
-    HookContext &ctx = HookContext::GetCurrent();
-
     // int Unit__AddEquipSkill(Unit* unit, int skillId)
-    int result = ctx.OriginalFunction<int, void *, std::uint32_t>(
-        unitRaw, skillIdRaw);
+    int result = FATES_HOOK_ORIGINAL(HookCallOriginal<int, void *, std::uint32_t>(
+        HookId_UNIT_SkillLearn, unitRaw, skillIdRaw));
 
     SkillLearnPayload payload{};
     payload.unit    = reinterpret_cast<Unit *>(unitRaw);
     payload.skillId = static_cast<std::uint16_t>(skillIdRaw);
     payload.flags   = 0; // future: set bits for source (level-up / scroll / script)
 
-    static int sLogCount = 0;
-    // Filter out the noisy "skillId == 0" + "result == 0" loader churn.
-    if (sLogCount < 32 && skillIdRaw != 0 && result != 0)
+    // Filter out the noisy "skillId == 0" + "result == 0" loader churn
+    // before asking the gate, so the churn doesn't eat the burst.
+    static LogGate sLogGate("UNIT_SkillLearn", 32);
+    if (skillIdRaw != 0 && result != 0 && FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_UNIT_SkillLearn(Unit__AddEquipSkill): "
-             "total=%u unit=%p skill=0x%04X result=%d (n=%d)",
-             total,
-             payload.unit,
-             static_cast<unsigned>(payload.skillId),
-             result,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_UNIT_SkillLearn(Unit__AddEquipSkill): "
+                               "total=%u unit=%p skill=0x%04X result=%d (n=%u)",
+                               total,
+                               payload.unit,
+                               static_cast<unsigned>(payload.skillId),
+                               result,
+                               LogGate_Count(sLogGate));
     }
 
     // Only treat real, successful learns as meaningful.
     if (skillIdRaw != 0 && result != 0)
     {
-        // 1) Feed our per-map debug skill tracker.
-        DebugSkills_OnSkillLearn(payload.unit,
-                                 payload.skillId);
-
-        // 2) Engine notification (map/turn aware, as before).
+        // Engine notification (map/turn aware). The skill engine's debug
+        // tracker listens for this synchronously.
         Engine::OnUnitSkillLearn(unitRaw,
                                  payload.skillId,
                                  payload.flags,
@@ -1545,25 +1437,31 @@ int Hook_UNIT_SkillLearn(void          *unitRaw,
 void Hook_SEQ_UnitMove(void *seq)
 {
     using namespace Fates;
-    using CTRPluginFramework::HookContext;
 
     // Telemetry: count how often player unit actions begin.
     std::size_t idx = IndexOf(HookId_SEQ_UnitMove);
     gHookCount[idx]++;
+    FATES_HOOK_PROFILE(HookId_SEQ_UnitMove);
 
-    HookContext &ctx = HookContext::GetCurrent();
+    // Decode the command header before the game runs the sequence; the
+    // engine is notified once it returns.
+    Engine::ActionEvent ev;
+    if (seq != nullptr)
+        DecodeCommandEvent(seq, ev);
 
     // Call the original ProcSequence__UnitMove(seq).
-    ctx.OriginalFunction<void, void *>(seq);
+    FATES_HOOK_ORIGINAL(HookCallOriginal<void, void *>(HookId_SEQ_UnitMove, seq));
+
+    if (seq != nullptr)
+        Engine::OnUnitMove(ev, gCurrentTurnSide);
 
     // Light logging window
-    static int sLogCount = 0;
-    if (sLogCount < 64)
+    static LogGate sLogGate("SEQ_UnitMove", 64);
+    if (FATES_LOG_ON(Debug, Hook) && LogGate_Allow(sLogGate))
     {
-        Logf("Hook_SEQ_UnitMove(ProcSequence__UnitMove): seq=%p (n=%d)",
-             seq,
-             sLogCount + 1);
-        ++sLogCount;
+        FATES_LOG(Debug, Hook, "Hook_SEQ_UnitMove(ProcSequence__UnitMove): seq=%p (n=%u)",
+                               seq,
+                               LogGate_Count(sLogGate));
     }
 }
 
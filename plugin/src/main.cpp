@@ -6,12 +6,16 @@
 #include <cstdio>
 
 #include "util/debug_log.hpp"
+#include "util/worker.hpp"
 #include "hook_debug.hpp"           // Debug UI for hooks (DumpHookCountsToFile, DumpKillEventsToLog)
+#include "stats_overlay.hpp"
 #include "core/hook_manager.hpp"
+#include "core/hook_config.hpp"
 #include "core/runtime.hpp"
-#include "engine/hp_kill_tracker.hpp"   // HP + kill summary engine
-#include "engine/damage_stats_module.hpp"
-#include "engine/rng_stats_module.hpp"
+#include "engine/builtin_modules.hpp"  // skill engine, HP/kill tracker, stats modules
+#include "engine/trace.hpp"
+#include "engine/rng_recorder.hpp"
+#include "engine/history_store.hpp"
 
 using namespace CTRPluginFramework;
 
@@ -36,6 +40,16 @@ static void ShowMapLifecycleState(MenuEntry *entry)
 
     using namespace Fates;
 
+    // Runs on the debug thread: read the published snapshot, not the
+    // live gMapState the game thread is writing.
+    static RuntimeSnapshot snap;
+    if (!ReadRuntimeSnapshot(snap))
+    {
+        MessageBox("Map lifecycle state", "No snapshot published yet")();
+        return;
+    }
+    const MapLifeCycleState &ms = snap.map;
+
     char buffer[512];
 
     std::snprintf(
@@ -51,16 +65,16 @@ static void ShowMapLifecycleState(MenuEntry *entry)
         "Side2 turns: %u\n"
         "Side3 turns: %u\n"
         "Kills (map): %u",
-        static_cast<unsigned>(gMapState.generation),
-        gMapState.seqRoot,
-        TurnSideToString(gMapState.startSide),
-        TurnSideToString(gMapState.currentSide),
-        static_cast<unsigned>(gMapState.totalTurns),
-        static_cast<unsigned>(gMapState.turnCount[0]),
-        static_cast<unsigned>(gMapState.turnCount[1]),
-        static_cast<unsigned>(gMapState.turnCount[2]),
-        static_cast<unsigned>(gMapState.turnCount[3]),
-        static_cast<unsigned>(gMapState.killEvents)
+        static_cast<unsigned>(ms.generation),
+        ms.seqRoot,
+        TurnSideToString(ms.startSide),
+        TurnSideToString(ms.currentSide),
+        static_cast<unsigned>(ms.totalTurns),
+        static_cast<unsigned>(ms.turnCount[0]),
+        static_cast<unsigned>(ms.turnCount[1]),
+        static_cast<unsigned>(ms.turnCount[2]),
+        static_cast<unsigned>(ms.turnCount[3]),
+        static_cast<unsigned>(ms.killEvents)
     );
 
     MessageBox("Map lifecycle state", buffer)();
@@ -78,15 +92,43 @@ extern "C" {
 
 static volatile bool gRun = true;
 
+// ---------------------------------------------------------------------
+// Worker jobs. Everything that touches the SD card runs on the worker
+// thread (util/worker.hpp); hotkeys only post these.
+// ---------------------------------------------------------------------
+
+// Drain the log / trace / RNG rings and queued map history to SD in
+// large chunks (no-op when idle). Worker periodic callback.
+static void PumpSinks(void *)
+{
+    Log_Pump();
+    Fates::Engine::Trace_Pump();
+    Fates::Engine::RngRec_Pump();
+    Fates::Engine::History_Pump();
+}
+
+static void JobDumpHookSites(void *)      { DumpHookSites(); }
+static void JobDumpHookTable(void *)      { DumpHookTable(); }
+static void JobTraceFlush(void *)         { Fates::Engine::Trace_Flush(); }
+static void JobRngRecFlush(void *)        { Fates::Engine::RngRec_Flush(); }
+
+static void JobDumpHookCounts(void *)
+{
+    DumpHookCountsToFile();
+    DumpKillEventsToLog();   // log current kill buffer as well
+}
+
 // ---------------------------------------------------------------------
 // Debug thread body (runs on main thread – no CTRPF Thread API used).
+// Polls hotkeys only; anything that writes to SD is posted to the
+// worker.
 // ---------------------------------------------------------------------
 // Most of the hotkeys are obsolete and most events are simply logged instead, 
 // will be phased out later.
 
 static void DebugThread(void *)
 {
-    Logf("DebugThread: start");
+    FATES_LOG(Info, Engine, "DebugThread: start");
 
     u32  iter = 0;
     bool hotkeyDumpLatched     = false;
@@ -94,13 +136,17 @@ static void DebugThread(void *)
     bool hotkeyTableLatched    = false;
     bool hotkeySitesLatched    = false;
     bool hotkeyMapStateLatched = false;
+    bool hotkeyTraceLatched    = false;
+    bool hotkeyRngRecLatched   = false;
+    bool hotkeyProfileLatched  = false;
+    bool hotkeyOverlayLatched  = false;
 
     while (gRun)
     {
         ++iter;
 
         if (iter % 40 == 0)
-            Logf("DebugThread: alive (iter=%u)", iter);
+            FATES_LOG(Debug, Engine, "DebugThread: alive (iter=%u)", iter);
 
         Controller::Update();
 
@@ -109,8 +155,8 @@ static void DebugThread(void *)
         {
             if (!hotkeySitesLatched)
             {
-                Logf("DebugThread: L+R+Down+Y -> DumpHookSites (iter=%u)", iter);
-                DumpHookSites();
+                FATES_LOG(Info, Engine, "DebugThread: L+R+Down+Y -> DumpHookSites (iter=%u)", iter);
+                Worker_Post(&JobDumpHookSites, nullptr, "DumpHookSites");
                 hotkeySitesLatched = true;
             }
         }
@@ -126,12 +172,11 @@ static void DebugThread(void *)
             {
                 gHpApplyLogEnabled = !gHpApplyLogEnabled;
 
-                Logf("DebugThread: L+R+A+Y -> Log SEQ_HpDamage %s (iter=%u)",
-                     gHpApplyLogEnabled ? "ENABLED" : "DISABLED",
-                     iter);
+                FATES_LOG(Info, Engine, "DebugThread: L+R+A+Y -> Log SEQ_HpDamage %s (iter=%u)",
+                                        gHpApplyLogEnabled ? "ENABLED" : "DISABLED",
+                                        iter);
 
-                DumpHookCountsToFile();
-                DumpKillEventsToLog();   // log current kill buffer as well
+                Worker_Post(&JobDumpHookCounts, nullptr, "DumpHookCounts");
                 hotkeyDumpLatched = true;
             }
         }
@@ -145,7 +190,7 @@ static void DebugThread(void *)
         {
             if (!hotkeyTestLatched)
             {
-                Logf("DebugThread: L+R+X+Y pressed (iter=%u)", iter);
+                FATES_LOG(Info, Engine, "DebugThread: L+R+X+Y pressed (iter=%u)", iter);
                 hotkeyTestLatched = true;
             }
         }
@@ -159,8 +204,8 @@ static void DebugThread(void *)
         {
             if (!hotkeyTableLatched)
             {
-                Logf("DebugThread: L+R+Up+Y -> DumpHookTable (iter=%u)", iter);
-                DumpHookTable();
+                FATES_LOG(Info, Engine, "DebugThread: L+R+Up+Y -> DumpHookTable (iter=%u)", iter);
+                Worker_Post(&JobDumpHookTable, nullptr, "DumpHookTable");
                 hotkeyTableLatched = true;
             }
         }
@@ -174,7 +219,7 @@ static void DebugThread(void *)
         {
             if (!hotkeyMapStateLatched)
             {
-                Logf("DebugThread: L+R+Left+Y -> ShowMapLifecycleState (iter=%u)", iter);
+                FATES_LOG(Info, Engine, "DebugThread: L+R+Left+Y -> ShowMapLifecycleState (iter=%u)", iter);
                 ShowMapLifecycleState(nullptr);
                 hotkeyMapStateLatched = true;
             }
@@ -184,10 +229,125 @@ static void DebugThread(void *)
             hotkeyMapStateLatched = false;
         }
 
+        // Hotkey: L + R + Right + Y -> toggle binary event trace
+        if (Controller::IsKeysDown(Key::L | Key::R | Key::DPadRight | Key::Y))
+        {
+            if (!hotkeyTraceLatched)
+            {
+                bool enable = !Fates::Engine::gTraceEnabled;
+                Fates::Engine::Trace_SetEnabled(enable);
+                if (!enable)
+                    Worker_Post(&JobTraceFlush, nullptr, "Trace_Flush");
+
+                OSD::Notify(enable ? "Event trace: ON" : "Event trace: OFF");
+                hotkeyTraceLatched = true;
+            }
+        }
+        else
+        {
+            hotkeyTraceLatched = false;
+        }
+
+        // Hotkey: L + R + B + Y -> toggle RNG stream recorder
+        if (Controller::IsKeysDown(Key::L | Key::R | Key::B | Key::Y))
+        {
+            if (!hotkeyRngRecLatched)
+            {
+                bool enable = !Fates::Engine::gRngRecEnabled;
+                Fates::Engine::RngRec_SetEnabled(enable);
+                if (!enable)
+                    Worker_Post(&JobRngRecFlush, nullptr, "RngRec_Flush");
+
+                OSD::Notify(enable ? "RNG recorder: ON" : "RNG recorder: OFF");
+                hotkeyRngRecLatched = true;
+            }
+        }
+        else
+        {
+            hotkeyRngRecLatched = false;
+        }
+
+        // Hotkey: L + R + Start + Y -> cycle hook profile (hooks.cfg is
+        // saved on the worker)
+        if (Controller::IsKeysDown(Key::L | Key::R | Key::Start | Key::Y))
+        {
+            if (!hotkeyProfileLatched)
+            {
+                int next = (static_cast<int>(Fates::HookConfig_GetProfile()) + 1) %
+                           static_cast<int>(Fates::HookProfile::Count);
+                Fates::HookConfig_SetProfile(static_cast<Fates::HookProfile>(next));
+
+                char msg[64];
+                std::snprintf(msg, sizeof(msg), "Hook profile: %s",
+                              Fates::HookProfile_Label(static_cast<Fates::HookProfile>(next)));
+                OSD::Notify(msg);
+                hotkeyProfileLatched = true;
+            }
+        }
+        else
+        {
+            hotkeyProfileLatched = false;
+        }
+
+        // Hotkey: L + R + Select + Y -> toggle live stats overlay
+        if (Controller::IsKeysDown(Key::L | Key::R | Key::Select | Key::Y))
+        {
+            if (!hotkeyOverlayLatched)
+            {
+                bool enable = !StatsOverlay_IsEnabled();
+                StatsOverlay_SetEnabled(enable);
+
+                OSD::Notify(enable ? "Stats overlay: ON" : "Stats overlay: OFF");
+                hotkeyOverlayLatched = true;
+            }
+        }
+        else
+        {
+            hotkeyOverlayLatched = false;
+        }
+
+        // The worker pumps the sinks; only do it here if it didn't start.
+        if (!Worker_IsRunning())
+            PumpSinks(nullptr);
+
         svcSleepThread(50 * 1000000LL);
     }
 
-    Logf("DebugThread: end");
+    FATES_LOG(Info, Engine, "DebugThread: end");
+    Worker_Stop();
+    Fates::Engine::Trace_Flush();
+    Fates::Engine::RngRec_Flush();
+    Fates::Engine::History_Pump();
+    Log_Flush();
+}
+
+// ---------------------------------------------------------------------
+// Crash / exit handling: make sure buffered log lines reach the SD card.
+// ---------------------------------------------------------------------
+
+static Process::ExceptionCallbackState CrashLogFlush(ERRF_ExceptionInfo *excep,
+                                                     CpuRegisters       *regs)
+{
+    (void)excep;
+
+    // The faulting thread may hold any sink's lock (the worker, mid
+    // drain): never wait on one here, skip that sink instead.
+    Log_BeginCrash();
+
+    if (regs != nullptr)
+        FATES_LOG(Error, Engine, "Crash: pc=%08X lr=%08X sp=%08X", regs->pc, regs->lr, regs->sp);
+
+    bool traceOk   = Fates::Engine::Trace_TryFlush();
+    bool rngOk     = Fates::Engine::RngRec_TryFlush();
+    bool historyOk = Fates::Engine::History_TryPump();
+    if (!traceOk || !rngOk || !historyOk)
+        FATES_LOG(Error, Engine, "Crash: skipped busy sink(s):%s%s%s",
+                                 traceOk ? "" : " trace",
+                                 rngOk ? "" : " rng",
+                                 historyOk ? "" : " history");
+
+    Log_TryFlush();
+    return Process::EXCB_DEFAULT_HANDLER;
 }
 
 // ---------------------------------------------------------------------
@@ -203,21 +363,21 @@ static void ProbeWords(u32 addr, const char *label = nullptr)
         !Process::Read32(addr + 8, w2))
     {
         if (label)
-            Logf("Probe: FAILED to read at 0x%08X [%s]", addr, label);
+            FATES_LOG(Error, Engine, "Probe: FAILED to read at 0x%08X [%s]", addr, label);
         else
-            Logf("Probe: FAILED to read at 0x%08X", addr);
+            FATES_LOG(Error, Engine, "Probe: FAILED to read at 0x%08X", addr);
         return;
     }
 
     if (label)
     {
-        Logf("Probe: words at 0x%08X [%s] = %08X %08X %08X",
-             addr, label, w0, w1, w2);
+        FATES_LOG(Info, Engine, "Probe: words at 0x%08X [%s] = %08X %08X %08X",
+                                addr, label, w0, w1, w2);
     }
     else
     {
-        Logf("Probe: words at 0x%08X = %08X %08X %08X",
-             addr, w0, w1, w2);
+        FATES_LOG(Info, Engine, "Probe: words at 0x%08X = %08X %08X %08X",
+                                addr, w0, w1, w2);
     }
 }
 
@@ -227,41 +387,54 @@ static void ProbeWords(u32 addr, const char *label = nullptr)
 
 static void MainImpl(void)
 {
-    Logf("MainImpl: starting");
+    FATES_LOG(Info, Engine, "MainImpl: starting");
+
+    // Flush buffered logs if the game crashes.
+    Process::exceptionCallback = CrashLogFlush;
 
     // Reset per-map state + kill buffer at boot.
     Fates::ResetMapState();
-    Logf("MainImpl: ResetMapState() done");
+    FATES_LOG(Info, Engine, "MainImpl: ResetMapState() done");
 
-    // Install core hooks 
-    Fates::HookManager::InstallCoreHooks();
-    Logf("MainImpl: HookManager::InstallCoreHooks() returned");
+    // Bring up the built-in engine modules (engine/builtin_modules.hpp)
+    // before any hook can fire, in list order.
+    Fates::Engine::BuiltinModules_RegisterHandlers();
+    FATES_LOG(Info, Engine, "MainImpl: BuiltinModules_RegisterHandlers() done");
 
-    // Register engine-level HP + kill tracker handlers on the event bus.
-    Fates::Engine::HpKillTracker_RegisterHandlers();
-    Logf("MainImpl: HpKillTracker_RegisterHandlers() done");
+    // Live stats overlay sampling (off until toggled).
+    StatsOverlay_RegisterHandlers();
 
-    // Register example stats modules. These are non-invasive modules
-    // that only log via the engine bus and serve as templates.
-    Fates::Engine::DamageStatsModule_RegisterHandlers();
-    Logf("MainImpl: DamageStatsModule_RegisterHandlers() done");
-
-    Fates::Engine::RngStatsModule_RegisterHandlers();
-    Logf("MainImpl: RngStatsModule_RegisterHandlers() done");
+    // Install hooks for the profile in sdmc:/Fates3GX/hooks.cfg (core
+    // hooks, i.e. "telemetry", if there is no config yet).
+    Fates::HookConfig_LoadAndApply();
+    FATES_LOG(Info, Engine, "MainImpl: HookConfig_LoadAndApply() returned");
 
     // Install optional hooks as pure MITM pass-through if/when needed.
     // Do not enable for now; it may cause instability.
     // Fates::HookManager::InstallOptionalHooks();
     // Logf("MainImpl: HookManager::InstallOptionalHooks() returned");
 
+    // SD writes (sink pumps, dumps, config saves) from here on run on
+    // the worker, on core 2 if this is a New 3DS.
+    Worker_Start(&PumpSinks);
+
     // Start the debug loop in this thread (no System::Thread needed).
-    Logf("MainImpl: starting debug loop");
+    FATES_LOG(Info, Engine, "MainImpl: starting debug loop");
     DebugThread(nullptr);
-    Logf("MainImpl: debug loop exited");
+    FATES_LOG(Info, Engine, "MainImpl: debug loop exited");
 }
 
 namespace CTRPluginFramework
 {
+    // Called by CTRPF when the game process is about to exit.
+    void OnProcessExit(void)
+    {
+        Fates::Engine::Trace_Flush();
+        Fates::Engine::RngRec_Flush();
+        Fates::Engine::History_Pump();
+        Log_Flush();
+    }
+
     void main()
     {
         MainImpl();
@@ -2,9 +2,13 @@
 //
 // Defines the shared runtime data declared in runtime.hpp: hook counters,
 // HP logging toggle, the kill-event buffer used by Hook_HP_KillCheck, and
-// the basic MapLifeCycleState summary struct.
+// the basic MapLifeCycleState summary struct, plus the seqlock-published
+// RuntimeSnapshot other threads read it through.
+
+#include <3ds.h>
 
 #include "core/runtime.hpp"
+#include "util/seqlock.hpp"
 
 // Global turn-side value (no namespace).
 volatile TurnSide gCurrentTurnSide = TurnSide::Unknown;
@@ -66,6 +70,8 @@ void ResetMapState()
     // Also reset the per-map stats at startup / hard reset. Engine code
     // is free to call ResetMapStats() again at map begin.
     ResetMapStats();
+
+    PublishRuntimeSnapshot();
 }
 
 void ResetMapStats()
@@ -82,17 +88,11 @@ void ResetMapStats()
 KillEvent gKillEvents[kMaxKillEvents];
 int       gKillEventCount = 0;
 
+// Entries past gKillEventCount are never read, so there is nothing to
+// clear.
 void ResetKillEvents()
 {
     gKillEventCount = 0;
-
-    for (int i = 0; i < kMaxKillEvents; ++i)
-    {
-        gKillEvents[i].seq   = nullptr;
-        gKillEvents[i].dead0 = nullptr;
-        gKillEvents[i].dead1 = nullptr;
-        gKillEvents[i].flags = 0u;
-    }
 }
 
 bool PushKillEvent(const KillEvent &ev)
@@ -108,4 +108,56 @@ bool PushKillEvent(const KillEvent &ev)
     return true;
 }
 
+// ---------------------------------------------------------------------
+// Snapshots
+// ---------------------------------------------------------------------
+
+namespace
+{
+
+SeqLock<RuntimeSnapshot> sSnapshot;
+
+// Staging copy for the writer, so the seqlock's odd window is a single
+// memcpy instead of the field-by-field gather below.
+RuntimeSnapshot sStaging;
+
+} // anonymous namespace
+
+void PublishRuntimeSnapshot()
+{
+    RuntimeSnapshot &s = sStaging;
+
+    s.map            = gMapState;
+    s.stats          = gMapStats;
+    s.killEventCount = gKillEventCount;
+
+    // Copy only the live entries; the tail of gKillEvents may hold a
+    // previous map's kills.
+    for (int i = 0; i < gKillEventCount; ++i)
+        s.killEvents[i] = gKillEvents[i];
+    for (int i = gKillEventCount; i < kMaxKillEvents; ++i)
+        s.killEvents[i] = KillEvent{};
+
+    for (std::size_t i = 0; i < static_cast<std::size_t>(HookId_Count); ++i)
+        s.hookCount[i] = gHookCount[i];
+
+    s.version = sSnapshot.Version() + 1;
+    sSnapshot.Publish(s);
+}
+
+bool ReadRuntimeSnapshot(RuntimeSnapshot &out)
+{
+    // If the reader preempted the game thread mid-publish on the same
+    // core, spinning can't help; yield and try again a few times.
+    for (int round = 0; round < 4; ++round)
+    {
+        if (sSnapshot.Read(out))
+            return true;
+        if (sSnapshot.Version() == 0)
+            return false;
+        svcSleepThread(100 * 1000LL);
+    }
+    return false;
+}
+
 } // namespace Fates
@@ -0,0 +1,308 @@
+// stats_overlay.cpp
+//
+// Live stats overlay. See stats_overlay.hpp.
+
+#include "stats_overlay.hpp"
+#include "core/hooks.hpp"
+#include "core/hook_profiler.hpp"
+#include "core/runtime.hpp"
+#include "engine/turn_rollup.hpp"
+#include "util/debug_log.hpp"
+#include "util/seqlock.hpp"
+#include <CTRPluginFramework.hpp>
+#include <3ds.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace CTRPluginFramework;
+using namespace Fates;
+using namespace Fates::Engine;
+
+namespace {
+
+// What the game thread publishes. Plain counters, compared as a whole
+// to decide whether to publish at all.
+struct OverlayCounters
+{
+    std::uint32_t generation;
+    std::uint32_t totalTurns;
+    std::uint32_t side;          // TurnSide of the current turn
+    std::int32_t  damage[4];     // map totals by acting side (turn rollup)
+    std::uint32_t kills[4];
+    std::uint32_t rngCalls;      // this map, all sides
+};
+
+SeqLock<OverlayCounters> sCounters;
+OverlayCounters          sSampled = {};   // game thread: last published
+
+volatile bool sEnabled = false;
+
+// ---------------------------------------------------------------------
+// OSD side. Everything below is only touched by the OSD callback.
+// ---------------------------------------------------------------------
+
+enum OverlayLineId
+{
+    Line_Map,
+    Line_Damage,
+    Line_Kills,
+    Line_Rng,
+    Line_Hook0,
+    Line_Hook1,
+    Line_Hook2,
+    Line_Count
+};
+
+constexpr int kTopHooks = 3;
+
+// One pre-formatted line plus the values it was formatted from.
+struct OverlayLine
+{
+    std::uint32_t shown[4];
+    bool          valid;
+    std::string   text;
+};
+
+OverlayLine     sLines[Line_Count];
+OverlayCounters sLatest = {};
+std::uint32_t   sSeenVersion = 0;
+
+// Once-per-second state: RNG rate and the top hooks.
+constexpr std::uint64_t kTicksPerSecond = 268111856ULL;
+
+std::uint64_t sWindowSecond   = ~0ULL;
+std::uint32_t sWindowRngStart = 0;
+std::uint32_t sRngPerSecond   = 0;
+
+struct TopHook
+{
+    std::uint32_t id;     // HookId, HookId_Count = empty
+    std::uint32_t calls;
+    std::uint32_t avgUs;  // 0 without the profiler
+};
+
+TopHook sTop[kTopHooks];
+
+#if !FATES_HOOK_PROFILER
+RuntimeSnapshot sSnap;   // hook counts, read once per second
+#endif
+
+void SampleCounters(OverlayCounters &c)
+{
+    RollupRow total;
+    TurnRollup_MapTotals(total);
+
+    c.generation = gMapState.generation;
+    c.totalTurns = gMapState.totalTurns;
+    c.side       = static_cast<std::uint32_t>(gMapState.currentSide);
+    c.rngCalls   = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        c.damage[i] = total.damage[i];
+        c.kills[i]  = total.kills[i];
+    }
+    for (int i = 0; i < kRollupColumns; ++i)
+        c.rngCalls += total.rngCalls[i];
+}
+
+// Rank hooks by total cost (profiler) or by calls.
+void RefreshTopHooks()
+{
+    for (TopHook &t : sTop)
+        t = TopHook{HookId_Count, 0, 0};
+
+#if !FATES_HOOK_PROFILER
+    if (!ReadRuntimeSnapshot(sSnap))
+        return;
+#endif
+
+    std::uint64_t best[kTopHooks] = {};
+    for (std::uint32_t id = 0; id < HookId_Count; ++id)
+    {
+#if FATES_HOOK_PROFILER
+        const HookProfileStats &p = gHookProfile[id];
+        const std::uint64_t score = p.totalTicks;
+        const std::uint32_t calls = p.calls;
+#else
+        const std::uint32_t calls = sSnap.hookCount[id];
+        const std::uint64_t score = calls;
+#endif
+        if (score == 0)
+            continue;
+
+        int at = kTopHooks;
+        while (at > 0 && score > best[at - 1])
+            --at;
+        if (at == kTopHooks)
+            continue;
+
+        for (int k = kTopHooks - 1; k > at; --k)
+        {
+            best[k] = best[k - 1];
+            sTop[k] = sTop[k - 1];
+        }
+        best[at] = score;
+        sTop[at].id    = id;
+        sTop[at].calls = calls;
+#if FATES_HOOK_PROFILER
+        sTop[at].avgUs = calls ? HookProfiler_TicksToUs(score / calls) : 0;
+#else
+        sTop[at].avgUs = 0;
+#endif
+    }
+}
+
+// The per-frame test: re-format only if the values changed.
+template <typename Fmt>
+inline void UpdateLine(OverlayLine &line, std::uint32_t a, std::uint32_t b,
+                       std::uint32_t c, std::uint32_t d, Fmt &&format)
+{
+    if (line.valid && line.shown[0] == a && line.shown[1] == b &&
+        line.shown[2] == c && line.shown[3] == d)
+        return;
+
+    line.shown[0] = a;
+    line.shown[1] = b;
+    line.shown[2] = c;
+    line.shown[3] = d;
+    line.valid    = true;
+
+    char buf[80];
+    format(buf, sizeof(buf));
+    line.text = buf;
+}
+
+void RefreshLines()
+{
+    // New counters only when the game thread published a new version.
+    const std::uint32_t version = sCounters.Version();
+    if (version != sSeenVersion && sCounters.Read(sLatest))
+        sSeenVersion = version;
+
+    const std::uint64_t second = svcGetSystemTick() / kTicksPerSecond;
+    if (second != sWindowSecond)
+    {
+        // A new map restarts the count; don't report that as a rate.
+        const std::uint32_t rng = sLatest.rngCalls;
+        sRngPerSecond   = (sWindowSecond != ~0ULL && rng >= sWindowRngStart)
+                              ? static_cast<std::uint32_t>((rng - sWindowRngStart) /
+                                                           (second - sWindowSecond))
+                              : 0;
+        sWindowRngStart = rng;
+        sWindowSecond   = second;
+        RefreshTopHooks();
+    }
+
+    const OverlayCounters &c = sLatest;
+
+    UpdateLine(sLines[Line_Map], c.generation, c.totalTurns, c.side, 0,
+               [&](char *buf, std::size_t n) {
+                   std::snprintf(buf, n, "Map %u  turn %u  %s",
+                                 (unsigned)c.generation, (unsigned)c.totalTurns,
+                                 TurnSideToString(static_cast<TurnSide>(c.side)));
+               });
+
+    UpdateLine(sLines[Line_Damage],
+               (std::uint32_t)c.damage[0], (std::uint32_t)c.damage[1],
+               (std::uint32_t)c.damage[2], (std::uint32_t)c.damage[3],
+               [&](char *buf, std::size_t n) {
+                   std::snprintf(buf, n, "Dmg   S0 %d  S1 %d  S2 %d  S3 %d",
+                                 (int)c.damage[0], (int)c.damage[1],
+                                 (int)c.damage[2], (int)c.damage[3]);
+               });
+
+    UpdateLine(sLines[Line_Kills], c.kills[0], c.kills[1], c.kills[2], c.kills[3],
+               [&](char *buf, std::size_t n) {
+                   std::snprintf(buf, n, "Kills S0 %u  S1 %u  S2 %u  S3 %u",
+                                 (unsigned)c.kills[0], (unsigned)c.kills[1],
+                                 (unsigned)c.kills[2], (unsigned)c.kills[3]);
+               });
+
+    UpdateLine(sLines[Line_Rng], sRngPerSecond, c.rngCalls, 0, 0,
+               [&](char *buf, std::size_t n) {
+                   std::snprintf(buf, n, "RNG   %u/s  (%u this map)",
+                                 (unsigned)sRngPerSecond, (unsigned)c.rngCalls);
+               });
+
+    for (int k = 0; k < kTopHooks; ++k)
+    {
+        const TopHook &t = sTop[k];
+        UpdateLine(sLines[Line_Hook0 + k], t.id, t.calls, t.avgUs, 0,
+                   [&](char *buf, std::size_t n) {
+                       if (t.id >= HookId_Count)
+                           std::snprintf(buf, n, "#%d    -", k + 1);
+#if FATES_HOOK_PROFILER
+                       else
+                           std::snprintf(buf, n, "#%d    %s  n=%u  avg %uus", k + 1,
+                                         kHookIdNames[t.id], (unsigned)t.calls,
+                                         (unsigned)t.avgUs);
+#else
+                       else
+                           std::snprintf(buf, n, "#%d    %s  n=%u", k + 1,
+                                         kHookIdNames[t.id], (unsigned)t.calls);
+#endif
+                   });
+    }
+}
+
+bool DrawOverlay(const Screen &screen)
+{
+    if (!screen.IsTop)
+        return false;
+
+    RefreshLines();
+
+    constexpr u32 kX = 4;
+    constexpr u32 kY = 4;
+    constexpr u32 kLineHeight = 10;
+    for (int i = 0; i < Line_Count; ++i)
+        screen.Draw(sLines[i].text, kX, kY + kLineHeight * i, Color::White, Color::Black);
+    return true;
+}
+
+} // anonymous namespace
+
+void StatsOverlay_Sample()
+{
+    if (!sEnabled)
+        return;
+
+    OverlayCounters c;
+    SampleCounters(c);
+    if (std::memcmp(&c, &sSampled, sizeof(c)) == 0)
+        return;
+
+    sSampled = c;
+    sCounters.Publish(c);
+}
+
+void StatsOverlay_OnMapBegin(const MapContext &)            { StatsOverlay_Sample(); }
+void StatsOverlay_OnTurnBegin(const TurnContext &)          { StatsOverlay_Sample(); }
+void StatsOverlay_OnTurnEnd(const TurnContext &)            { StatsOverlay_Sample(); }
+void StatsOverlay_OnBattleEnd(const BattleEventContext &)   { StatsOverlay_Sample(); }
+void StatsOverlay_OnActionEnd(const ActionContext &)        { StatsOverlay_Sample(); }
+
+bool StatsOverlay_RegisterHandlers()
+{
+    return RegisterModule(kStatsOverlayModule);
+}
+
+void StatsOverlay_SetEnabled(bool enabled)
+{
+    if (enabled == sEnabled)
+        return;
+
+    sEnabled = enabled;
+    if (enabled)
+        OSD::Run(DrawOverlay);
+    else
+        OSD::Stop(DrawOverlay);
+
+    FATES_LOG(Info, Engine, "StatsOverlay: %s", enabled ? "on" : "off");
+}
+
+bool StatsOverlay_IsEnabled()
+{
+    return sEnabled;
+}
@@ -0,0 +1,284 @@
+// util/debug_log.cpp
+//
+// Ring-buffered log sink behind Logf(). See util/debug_log.hpp.
+//
+// Producers (hook stubs on the game thread, DebugThread on the plugin
+// thread) format on their own stack and then copy the finished line
+// into sRing under a light lock. The only consumer is the drain below,
+// which writes [tail, head) straight out of the ring in at most two
+// contiguous chunks and then advances the tail. Producers never write
+// into that range, so the SD write itself runs without the lock held.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#include "util/debug_log.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace {
+
+constexpr const char *kLogDir  = "sdmc:/Fates3GX";
+constexpr const char *kLogPath = "sdmc:/Fates3GX/fates_3gx.log";
+
+// Ring capacity in bytes. Must be a power of two. Boot (hook install)
+// produces roughly 10 KB before the first pump, so keep some headroom.
+constexpr std::uint32_t kRingSize = 16 * 1024;
+constexpr std::uint32_t kRingMask = kRingSize - 1;
+
+// Log_Pump() writes once this much is pending...
+constexpr std::uint32_t kPumpChunkBytes = 4 * 1024;
+// ...or once the oldest pending data is about this old (~1s @ 268MHz).
+constexpr std::uint64_t kPumpMaxAgeTicks = 268111856ULL;
+
+char sRing[kRingSize];
+
+// Monotonic byte counters; (head - tail) is the pending byte count.
+volatile std::uint32_t sHead = 0;
+volatile std::uint32_t sTail = 0;
+
+volatile std::uint32_t sDroppedLines  = 0;
+std::uint32_t          sReportedDrops = 0;
+std::uint32_t          sHighWater     = 0;
+
+// Producer lock (serialises Logf callers) and drain lock (serialises
+// Log_Pump / Log_Flush, which can come from different threads).
+LightLock sProduceLock;
+LightLock sDrainLock;
+bool      sLocksReady = false;
+
+// Set by Log_BeginCrash(): Logf() then drops a line rather than wait
+// for a producer lock the faulting thread may hold.
+volatile bool sCrashMode = false;
+
+// Single long-lived file handle.
+File          sFile;
+bool          sFileOpen       = false;
+std::uint64_t sLastDrainTick  = 0;
+
+// Lazily initialise the locks. The first Logf() call happens during
+// static init / MainImpl, long before any hook can fire, so this is
+// effectively single-threaded.
+inline void EnsureLocks()
+{
+    if (sLocksReady)
+        return;
+
+    LightLock_Init(&sProduceLock);
+    LightLock_Init(&sDrainLock);
+    sLocksReady = true;
+}
+
+bool EnsureFile()
+{
+    if (sFileOpen)
+        return true;
+
+    Directory::Create(kLogDir);
+
+    if (File::Open(sFile, kLogPath, File::WRITE | File::CREATE) != 0)
+        return false;
+
+    sFile.Seek(0, File::END);
+    sFileOpen = true;
+    return true;
+}
+
+// Copy len bytes into the ring at monotonic position pos.
+inline void RingCopyIn(std::uint32_t pos, const char *src, std::uint32_t len)
+{
+    std::uint32_t off   = pos & kRingMask;
+    std::uint32_t first = kRingSize - off;
+    if (first > len)
+        first = len;
+
+    std::memcpy(&sRing[off], src, first);
+    if (len > first)
+        std::memcpy(&sRing[0], src + first, len - first);
+}
+
+// Write everything currently pending. Caller holds sDrainLock.
+void DrainLocked(bool flushHandle)
+{
+    if (!EnsureFile())
+        return;
+
+    std::uint32_t tail = sTail;
+    std::uint32_t head = sHead;
+    __sync_synchronize();
+
+    std::uint32_t pending = head - tail;
+    if (pending != 0)
+    {
+        std::uint32_t off   = tail & kRingMask;
+        std::uint32_t first = kRingSize - off;
+        if (first > pending)
+            first = pending;
+
+        sFile.Write(&sRing[off], first);
+        if (pending > first)
+            sFile.Write(&sRing[0], pending - first);
+
+        __sync_synchronize();
+        sTail = head;
+    }
+
+    // Report ring overflow once per drain, directly into the file so
+    // the notice itself can never be dropped.
+    std::uint32_t dropped = sDroppedLines;
+    if (dropped != sReportedDrops)
+    {
+        char line[96];
+        int n = std::snprintf(line, sizeof(line),
+                              "Log: dropped %u line(s) (ring full, total=%u)\r\n",
+                              static_cast<unsigned>(dropped - sReportedDrops),
+                              static_cast<unsigned>(dropped));
+        if (n > 0)
+            sFile.Write(line, static_cast<u32>(n));
+        sReportedDrops = dropped;
+    }
+
+    if (flushHandle)
+        sFile.Flush();
+
+    sLastDrainTick = svcGetSystemTick();
+}
+
+} // anonymous namespace
+
+void Logf(const char *fmt, ...)
+{
+    EnsureLocks();
+
+    char buf[256];
+
+    va_list va;
+    va_start(va, fmt);
+    int n = vsnprintf(buf, sizeof(buf) - 2, fmt, va);
+    va_end(va);
+
+    if (n < 0)
+        return;
+
+    // vsnprintf returns the untruncated length.
+    std::uint32_t len = static_cast<std::uint32_t>(n);
+    if (len > sizeof(buf) - 3)
+        len = sizeof(buf) - 3;
+
+    buf[len++] = '\r';
+    buf[len++] = '\n';
+
+    if (sCrashMode)
+    {
+        if (LightLock_TryLock(&sProduceLock) != 0)
+        {
+            ++sDroppedLines;
+            return;
+        }
+    }
+    else
+    {
+        LightLock_Lock(&sProduceLock);
+    }
+
+    std::uint32_t head    = sHead;
+    std::uint32_t pending = head - sTail;
+
+    if (kRingSize - pending < len)
+    {
+        ++sDroppedLines;
+        LightLock_Unlock(&sProduceLock);
+        return;
+    }
+
+    RingCopyIn(head, buf, len);
+    __sync_synchronize();
+    sHead = head + len;
+
+    pending += len;
+    if (pending > sHighWater)
+        sHighWater = pending;
+
+    LightLock_Unlock(&sProduceLock);
+}
+
+void Log_Pump()
+{
+    EnsureLocks();
+
+    std::uint32_t pending = sHead - sTail;
+    if (pending == 0 && sDroppedLines == sReportedDrops)
+        return;
+
+    if (pending < kPumpChunkBytes &&
+        svcGetSystemTick() - sLastDrainTick < kPumpMaxAgeTicks)
+        return;
+
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(false);
+    LightLock_Unlock(&sDrainLock);
+}
+
+void Log_Flush()
+{
+    EnsureLocks();
+
+    LightLock_Lock(&sDrainLock);
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+}
+
+bool Log_TryFlush()
+{
+    EnsureLocks();
+
+    if (LightLock_TryLock(&sDrainLock) != 0)
+        return false;
+    DrainLocked(true);
+    LightLock_Unlock(&sDrainLock);
+    return true;
+}
+
+void Log_BeginCrash()
+{
+    sCrashMode = true;
+}
+
+std::uint32_t Log_GetDroppedLines()
+{
+    return sDroppedLines;
+}
+
+std::uint32_t Log_GetHighWater()
+{
+    return sHighWater;
+}
+
+// Category filter ----------------------------------------------------
+
+volatile std::uint32_t gLogCategoryMask = FATES_LOG_CAT_ALL;
+
+void Log_SetCategoryMask(std::uint32_t mask)
+{
+    gLogCategoryMask = mask & FATES_LOG_CAT_ALL;
+}
+
+std::uint32_t Log_GetCategoryMask()
+{
+    return gLogCategoryMask;
+}
+
+const char *Log_CategoryName(std::uint32_t category)
+{
+    switch (category)
+    {
+    case LogCat_Hook:   return "Hook";
+    case LogCat_Engine: return "Engine";
+    case LogCat_Module: return "Module";
+    case LogCat_RE:     return "RE";
+    default:            return "?";
+    }
+}
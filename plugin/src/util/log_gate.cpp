@@ -0,0 +1,117 @@
+// util/log_gate.cpp
+//
+// Slow path + bookkeeping for LogGate. See util/log_gate.hpp.
+
+#include "util/log_gate.hpp"
+#include "util/debug_log.hpp"
+
+namespace {
+
+// Every gate that has fired at least once, newest first.
+LogGate *sGateHead = nullptr;
+
+} // anonymous namespace
+
+bool LogGate_Decide(LogGate &gate)
+{
+    // countdown just hit zero, so this call's number is 'deadline'.
+    std::uint32_t n = gate.deadline;
+
+    switch (gate.phase)
+    {
+    case LogGate::Phase_Fresh:
+        if (!gate.linked)
+        {
+            gate.next   = sGateHead;
+            sGateHead   = &gate;
+            gate.linked = true;
+        }
+
+        if (gate.burst > 0)
+        {
+            gate.phase     = LogGate::Phase_Burst;
+            gate.open      = true;
+            gate.countdown = gate.burst;
+            gate.deadline  = n + gate.burst;
+            return true;
+        }
+
+        // No burst: this is the first sampled line.
+        gate.phase     = LogGate::Phase_Sampling;
+        gate.open      = false;
+        gate.sampled   = 1;
+        gate.countdown = gate.sampleEvery;
+        gate.deadline  = n + gate.sampleEvery;
+        return true;
+
+    case LogGate::Phase_Burst:
+        // First call past the burst. Drop it and the next
+        // sampleEvery - 2; the one after that is sampled.
+        gate.phase     = LogGate::Phase_Sampling;
+        gate.open      = false;
+        gate.countdown = gate.sampleEvery - 1;
+        gate.deadline  = n + gate.sampleEvery - 1;
+
+        FATES_LOG(Info, Engine, "LogGate[%s]: burst of %u used, logging 1 in %u until map end",
+                                gate.name,
+                                static_cast<unsigned>(gate.burst),
+                                static_cast<unsigned>(gate.sampleEvery));
+        return false;
+
+    case LogGate::Phase_Sampling:
+    default:
+        ++gate.sampled;
+        gate.countdown = gate.sampleEvery;
+        gate.deadline  = n + gate.sampleEvery;
+        return true;
+    }
+}
+
+std::uint32_t LogGate_Dropped(const LogGate &gate)
+{
+    if (gate.phase != LogGate::Phase_Sampling)
+        return 0;
+
+    return LogGate_Count(gate) - gate.burst - gate.sampled;
+}
+
+void LogGate_ResetAll()
+{
+    for (LogGate *g = sGateHead; g != nullptr; g = g->next)
+    {
+        g->countdown = 1;
+        g->deadline  = 1;
+        g->sampled   = 0;
+        g->open      = true;
+        g->phase     = LogGate::Phase_Fresh;
+    }
+}
+
+void LogGate_ReportDrops()
+{
+    std::uint32_t totalDropped = 0;
+    int           gates        = 0;
+
+    for (const LogGate *g = sGateHead; g != nullptr; g = g->next)
+    {
+        std::uint32_t dropped = LogGate_Dropped(*g);
+        if (dropped == 0)
+            continue;
+
+        FATES_LOG(Warn, Engine, "LogGate[%s]: dropped %u of %u line(s) this map (burst=%u, 1/%u sampled)",
+                                g->name,
+                                static_cast<unsigned>(dropped),
+                                static_cast<unsigned>(LogGate_Count(*g)),
+                                static_cast<unsigned>(g->burst),
+                                static_cast<unsigned>(g->sampleEvery));
+
+        totalDropped += dropped;
+        ++gates;
+    }
+
+    if (gates > 0)
+    {
+        FATES_LOG(Warn, Engine, "LogGate: %u line(s) dropped across %d gate(s) this map",
+                                static_cast<unsigned>(totalDropped), gates);
+    }
+}
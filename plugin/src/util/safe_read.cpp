@@ -0,0 +1,7 @@
+// util/safe_read.cpp
+//
+// Reject counter for util/safe_read.hpp.
+
+#include "util/safe_read.hpp"
+
+std::uint32_t gSafeReadRejects = 0;
@@ -0,0 +1,215 @@
+// util/worker.cpp
+//
+// Background worker thread. See util/worker.hpp.
+//
+// Jobs go into a small fixed ring under a light lock; posting signals
+// sWake so the worker picks them up immediately instead of at the next
+// 50 ms tick. The worker copies a job out and runs it with the lock
+// released, so a slow SD write never blocks a poster.
+
+#include <3ds.h>
+#include <CTRPluginFramework.hpp>
+
+#include "util/debug_log.hpp"
+#include "util/worker.hpp"
+
+using namespace CTRPluginFramework;
+
+namespace {
+
+constexpr std::uint32_t kJobCapacity = 16;   // power of two
+constexpr std::uint32_t kJobMask     = kJobCapacity - 1;
+
+constexpr std::size_t kStackSize = 16 * 1024;
+
+// Periodic callback interval, same cadence as the old DebugThread pump.
+constexpr s64 kPeriodNs = 50 * 1000000LL;
+
+// Worker_Stop() gives the thread this long to finish its jobs.
+constexpr u64 kJoinTimeoutNs = 2000 * 1000000ULL;
+
+// New 3DS extra application core.
+constexpr int kN3dsAppCore = 2;
+
+constexpr std::uint64_t kTicksPerUs = 268111856ULL / 1000000ULL;
+
+struct WorkerJob
+{
+    WorkerJobFn fn;
+    void       *arg;
+    const char *tag;
+};
+
+WorkerJob sJobs[kJobCapacity];
+
+// Monotonic counters; (head - tail) is the number of queued jobs.
+std::uint32_t sJobHead = 0;
+std::uint32_t sJobTail = 0;
+
+LightLock  sJobLock;
+LightEvent sWake;
+
+Thread        sThread   = nullptr;
+WorkerJobFn   sPeriodic = nullptr;
+volatile bool sRunning  = false;
+volatile bool sStopping = false;
+
+WorkerStats sStats = { -2, 0, 0, 0, 0 };
+
+bool PopJob(WorkerJob &out)
+{
+    LightLock_Lock(&sJobLock);
+    const bool have = sJobTail != sJobHead;
+    if (have)
+        out = sJobs[sJobTail++ & kJobMask];
+    LightLock_Unlock(&sJobLock);
+    return have;
+}
+
+void RunJob(const WorkerJob &job)
+{
+    const u64 t0 = svcGetSystemTick();
+    job.fn(job.arg);
+    const u64 dt = svcGetSystemTick() - t0;
+
+    ++sStats.completed;
+    if (dt > sStats.maxJobTicks)
+        sStats.maxJobTicks = dt;
+}
+
+void RunPendingJobs()
+{
+    WorkerJob job;
+    while (PopJob(job))
+        RunJob(job);
+}
+
+void WorkerMain(void *)
+{
+    FATES_LOG(Info, Engine, "Worker: start (core %d)", static_cast<int>(sStats.core));
+
+    while (!sStopping)
+    {
+        // Woken early by Worker_Post(); otherwise one periodic pass
+        // per interval.
+        LightEvent_WaitTimeout(&sWake, kPeriodNs);
+
+        RunPendingJobs();
+        if (sPeriodic != nullptr)
+            sPeriodic(nullptr);
+    }
+
+    RunPendingJobs();
+    if (sPeriodic != nullptr)
+        sPeriodic(nullptr);
+}
+
+Thread CreateOn(int core, int prio)
+{
+    Thread t = threadCreate(&WorkerMain, nullptr, kStackSize, prio, core, false);
+    if (t != nullptr)
+        sStats.core = core;
+    return t;
+}
+
+} // namespace
+
+bool Worker_Start(WorkerJobFn periodic)
+{
+    if (sRunning)
+        return true;
+
+    LightLock_Init(&sJobLock);
+    LightEvent_Init(&sWake, RESET_ONESHOT);
+    sPeriodic = periodic;
+    sStopping = false;
+
+    // Just below the creating thread, so UI input stays responsive.
+    s32 prio = 0x30;
+    svcGetThreadPriority(&prio, CUR_THREAD_HANDLE);
+    if (prio < 0x3F)
+        ++prio;
+
+    // Core 2 only exists (and is only granted) on New 3DS; fall back
+    // to the creator's core if the process isn't allowed to use it.
+    if (System::IsNew3DS())
+        sThread = CreateOn(kN3dsAppCore, prio);
+    if (sThread == nullptr)
+        sThread = CreateOn(-2, prio);
+
+    if (sThread == nullptr)
+    {
+        FATES_LOG(Error, Engine, "Worker: threadCreate failed; jobs run inline");
+        return false;
+    }
+
+    sRunning = true;
+    return true;
+}
+
+void Worker_Stop()
+{
+    if (!sRunning)
+        return;
+
+    sStopping = true;
+    LightEvent_Signal(&sWake);
+
+    if (threadJoin(sThread, kJoinTimeoutNs) != 0)
+        FATES_LOG(Warn, Engine, "Worker: thread did not stop within %u ms", static_cast<unsigned>(kJoinTimeoutNs / 1000000ULL));
+    else
+        threadFree(sThread);
+
+    sThread  = nullptr;
+    sRunning = false;
+
+    FATES_LOG(Info, Engine, "Worker: stopped (jobs=%u dropped=%u slowest=%u us)",
+                            static_cast<unsigned>(sStats.completed),
+                            static_cast<unsigned>(sStats.dropped),
+                            static_cast<unsigned>(sStats.maxJobTicks / kTicksPerUs));
+}
+
+bool Worker_IsRunning()
+{
+    return sRunning;
+}
+
+bool Worker_Post(WorkerJobFn fn, void *arg, const char *tag)
+{
+    if (fn == nullptr)
+        return false;
+
+    if (!sRunning || sStopping)
+    {
+        fn(arg);
+        return true;
+    }
+
+    LightLock_Lock(&sJobLock);
+    const bool full = sJobHead - sJobTail >= kJobCapacity;
+    if (!full)
+    {
+        sJobs[sJobHead & kJobMask] = WorkerJob{ fn, arg, tag };
+        ++sJobHead;
+        ++sStats.posted;
+    }
+    else
+    {
+        ++sStats.dropped;
+    }
+    LightLock_Unlock(&sJobLock);
+
+    if (full)
+    {
+        FATES_LOG(Warn, Engine, "Worker: queue full, dropped job '%s'", tag ? tag : "?");
+        return false;
+    }
+
+    LightEvent_Signal(&sWake);
+    return true;
+}
+
+void Worker_GetStats(WorkerStats &out)
+{
+    out = sStats;
+}
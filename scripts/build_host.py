@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+Build and run the host-side engine harness (host/, binary fates_host).
+
+The engine layer (plugin/src/engine, plugin/src/util, plugin/src/runtime.cpp)
+is compiled with the host C++ compiler against the stub platform headers in
+host/include, so dispatch / context / module changes can be measured on a PC
+before going to hardware. Hook stubs, CTRPF menus and anything else outside
+the engine layer are not part of this build.
+
+Usage:
+  py scripts/build_host.py                          # build only
+  py scripts/build_host.py bench                    # microbenchmarks
+  py scripts/build_host.py bench --iters 200000
+  py scripts/build_host.py replay fates_trace.bin   # replay a recorded trace
+  py scripts/build_host.py replay --synthetic       # replay a generated trace
+  py scripts/build_host.py bench --save-baseline base.json
+  py scripts/build_host.py bench --baseline base.json --tolerance 0.15
+  py scripts/build_host.py --static-modules bench   # FATES_STATIC_MODULES=1
+
+With --baseline, every RESULT that got worse by more than --tolerance
+(fraction, default 0.10) is reported and the script exits with 1.
+Units ending in "/s" are higher-is-better, all others lower-is-better.
+
+Environment:
+  CXX   host C++ compiler (default: g++)
+"""
+import argparse, json, os, shlex, subprocess, sys
+from pathlib import Path
+
+HERE = Path(__file__).resolve().parent.parent
+OUT_DIR = HERE / "build" / "host"
+
+SOURCE_GLOBS = [
+    "plugin/src/engine/*.cpp",
+    "plugin/src/util/*.cpp",
+    "plugin/src/runtime.cpp",
+    "host/*.cpp",
+]
+INCLUDE_DIRS = ["host/include", "plugin/include", "host"]
+CXXFLAGS = ["-std=gnu++17", "-O2", "-g", "-fno-exceptions", "-fno-rtti",
+            "-fno-threadsafe-statics", "-Wall", "-Wno-unused-function"]
+
+
+def run(cmd: list[str], verbose: bool, **kw) -> subprocess.CompletedProcess:
+    if verbose:
+        print(" ".join(shlex.quote(c) for c in cmd))
+    res = subprocess.run(cmd, **kw)
+    if res.returncode != 0:
+        sys.exit(res.returncode)
+    return res
+
+
+def build(static_modules: bool, log_level: str, verbose: bool) -> Path:
+    cxx = os.environ.get("CXX", "g++")
+    variant = "static" if static_modules else "runtime"
+    if log_level:
+        variant += "-log" + log_level
+    obj_dir = OUT_DIR / variant / "obj"
+    exe = OUT_DIR / variant / "fates_host"
+
+    defines = [f"FATES_STATIC_MODULES={1 if static_modules else 0}"]
+    if log_level:
+        defines.append(f"FATES_LOG_LEVEL=FATES_LOG_LEVEL_{log_level.upper()}")
+    flags = CXXFLAGS + sum([["-I", str(HERE / d)] for d in INCLUDE_DIRS], []) + \
+        sum([["-D", d] for d in defines], [])
+
+    srcs = sorted({p for g in SOURCE_GLOBS for p in HERE.glob(g) if p.is_file()})
+    headers = [p for d in ("plugin/include", "host") for p in (HERE / d).rglob("*.h*")]
+    newest_header = max((p.stat().st_mtime_ns for p in headers), default=0)
+
+    objects = []
+    for src in srcs:
+        rel = src.relative_to(HERE)
+        obj = obj_dir / rel.with_suffix(".o")
+        objects.append(obj)
+        if obj.exists() and obj.stat().st_mtime_ns >= max(src.stat().st_mtime_ns, newest_header):
+            continue
+        obj.parent.mkdir(parents=True, exist_ok=True)
+        print(f"Compiling {rel}")
+        run([cxx, "-c", str(src), "-o", str(obj)] + flags, verbose)
+
+    print(f"Linking {exe.relative_to(HERE)}")
+    run([cxx] + [str(o) for o in objects] + ["-pthread", "-o", str(exe)], verbose)
+    return exe
+
+
+def run_harness(exe: Path, args: list[str], verbose: bool) -> dict:
+    env = dict(os.environ)
+    # sdmc:/ maps here, so logs / traces / history land next to the binary.
+    env.setdefault("FATES_HOST_SDMC", str(exe.parent / "sdmc"))
+    Path(env["FATES_HOST_SDMC"]).mkdir(parents=True, exist_ok=True)
+
+    res = run([str(exe)] + args, verbose, env=env, stdout=subprocess.PIPE, text=True)
+    results = {}
+    for line in res.stdout.splitlines():
+        print(line)
+        parts = line.split()
+        if len(parts) == 4 and parts[0] == "RESULT":
+            results[parts[1]] = {"value": float(parts[2]), "unit": parts[3]}
+    return results
+
+
+def compare(results: dict, baseline: dict, tolerance: float) -> int:
+    regressions = 0
+    for name, base in sorted(baseline.items()):
+        cur = results.get(name)
+        if cur is None or base["value"] == 0:
+            continue
+        higher_is_better = base["unit"].endswith("/s")
+        ratio = cur["value"] / base["value"]
+        worse = (1.0 - ratio) if higher_is_better else (ratio - 1.0)
+        mark = "REGRESSION" if worse > tolerance else "ok"
+        print(f"  {mark:<10} {name:<36} {base['value']:>14.3f} -> {cur['value']:>14.3f} "
+              f"{cur['unit']} ({(ratio - 1.0) * 100:+.1f}%)")
+        if worse > tolerance:
+            regressions += 1
+    if regressions:
+        print(f"[x] {regressions} result(s) regressed by more than {tolerance * 100:.0f}%")
+        return 1
+    print("[ok] no regressions")
+    return 0
+
+
+def main(argv: list[str]) -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("action", nargs="?", choices=["build", "bench", "replay", "clean"], default="build")
+    ap.add_argument("trace", nargs="?", help="fates_trace.bin to replay")
+    ap.add_argument("--synthetic", action="store_true", help="replay a generated trace instead")
+    ap.add_argument("--repeat", type=int, default=1, help="replay passes over the trace")
+    ap.add_argument("--iters", type=int, help="bench iterations per case")
+    ap.add_argument("--static-modules", action="store_true", help="build with FATES_STATIC_MODULES=1")
+    ap.add_argument("--log-level", choices=["none", "error", "warn", "info", "debug", "trace"],
+                    help="build with this FATES_LOG_LEVEL (default: the header's, debug)")
+    ap.add_argument("--baseline", help="compare RESULT lines against this JSON file")
+    ap.add_argument("--save-baseline", help="write RESULT lines to this JSON file")
+    ap.add_argument("--tolerance", type=float, default=0.10)
+    ap.add_argument("-v", "--verbose", action="store_true")
+    args = ap.parse_args(argv)
+
+    if args.action == "clean":
+        if OUT_DIR.exists():
+            import shutil
+            print(f"Removing {OUT_DIR}")
+            shutil.rmtree(OUT_DIR)
+        return 0
+
+    exe = build(args.static_modules, args.log_level, args.verbose)
+    if args.action == "build":
+        print("Build: OK")
+        return 0
+
+    if args.action == "bench":
+        harness_args = ["bench"] + (["--iters", str(args.iters)] if args.iters else [])
+    else:
+        trace = args.trace
+        if args.synthetic:
+            trace = str(exe.parent / "synthetic_trace.bin")
+            run_harness(exe, ["gen", trace], args.verbose)
+        if not trace:
+            print("ERROR: replay needs a trace file or --synthetic", file=sys.stderr)
+            return 2
+        harness_args = ["replay", trace, "--repeat", str(args.repeat)]
+
+    results = run_harness(exe, harness_args, args.verbose)
+
+    if args.save_baseline:
+        Path(args.save_baseline).write_text(json.dumps(results, indent=2), encoding="utf-8")
+        print(f"[ok] baseline written to {args.save_baseline}")
+    if args.baseline:
+        baseline = json.loads(Path(args.baseline).read_text(encoding="utf-8"))
+        return compare(results, baseline, args.tolerance)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Decode sdmc:/Fates3GX/history.bin (campaign history, one record per
+finished map) into text or CSV. Layout mirrors
+plugin/include/engine/history_store.hpp:
+
+    struct HistoryFileHeader {      // 16 bytes
+        u32 magic; u16 version; u16 entrySize; u32 reserved[2];
+    };
+    struct HistoryRecord {          // 128 bytes, little-endian
+        u32 session; u32 generation; u64 endTimeMs;
+        u32 totalTurns; u32 killEvents; u8 startSide; u8 endSide; u16 res;
+        u32 rngCalls;
+        u32 turns[4]; s32 damage[4]; s32 heals[4]; u32 kills[4];
+        u32 rngCallsBySide[4]; u32 reserved[4];
+    };
+
+Usage:
+  py scripts/decode_history.py history.bin                 # text to stdout
+  py scripts/decode_history.py history.bin --csv out.csv   # CSV
+  py scripts/decode_history.py history.bin --last 20       # newest 20 maps
+"""
+import argparse
+import csv
+import datetime
+import struct
+import sys
+from pathlib import Path
+
+HEADER = struct.Struct("<IHH2I")
+RECORD = struct.Struct("<IIQIIBBHI4I4i4i4I4I4I")
+assert HEADER.size == 16
+assert RECORD.size == 128
+
+HISTORY_MAGIC = 0x48483346  # "F3HH"
+HISTORY_VERSION = 1
+
+SIDES = {0: "Side0", 1: "Side1", 2: "Side2", 3: "Side3", 0xFF: "Unknown"}
+
+# osGetTime() counts milliseconds since 1900-01-01.
+EPOCH_1900 = datetime.datetime(1900, 1, 1)
+
+
+def read_records(path: Path):
+    """Yield one dict per record."""
+    data = path.read_bytes()
+    if len(data) < HEADER.size:
+        return
+
+    magic, version, entry_size, *_ = HEADER.unpack_from(data, 0)
+    if magic != HISTORY_MAGIC:
+        raise SystemExit(f"[x] bad magic 0x{magic:08X}")
+    if version != HISTORY_VERSION or entry_size != RECORD.size:
+        raise SystemExit(f"[x] unsupported version {version} / record size {entry_size}")
+
+    body = len(data) - HEADER.size
+    if body % RECORD.size:
+        print(f"[!] trailing {body % RECORD.size} byte(s) ignored", file=sys.stderr)
+
+    for off in range(HEADER.size, len(data) - RECORD.size + 1, RECORD.size):
+        v = RECORD.unpack_from(data, off)
+        yield {
+            "session": v[0],
+            "generation": v[1],
+            "end": EPOCH_1900 + datetime.timedelta(milliseconds=v[2]),
+            "totalTurns": v[3],
+            "killEvents": v[4],
+            "startSide": SIDES.get(v[5], str(v[5])),
+            "endSide": SIDES.get(v[6], str(v[6])),
+            "rngCalls": v[8],
+            "turns": list(v[9:13]),
+            "damage": list(v[13:17]),
+            "heals": list(v[17:21]),
+            "kills": list(v[21:25]),
+            "rngBySide": list(v[25:29]),
+        }
+
+
+PER_SIDE = ("turns", "damage", "heals", "kills", "rngBySide")
+
+
+def main(argv):
+    ap = argparse.ArgumentParser()
+    ap.add_argument("history", help="path to history.bin")
+    ap.add_argument("--csv", dest="csv_out", help="write CSV to this path instead of text")
+    ap.add_argument("--last", type=int, help="only the newest N maps")
+    args = ap.parse_args(argv)
+
+    records = list(read_records(Path(args.history)))
+    if args.last:
+        records = records[-args.last:]
+
+    if args.csv_out:
+        with open(args.csv_out, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["session", "gen", "end", "totalTurns", "killEvents",
+                        "startSide", "endSide", "rngCalls"] +
+                       [f"{k}{i}" for k in PER_SIDE for i in range(4)])
+            for r in records:
+                w.writerow([r["session"], r["generation"], r["end"].isoformat(sep=" "),
+                            r["totalTurns"], r["killEvents"], r["startSide"],
+                            r["endSide"], r["rngCalls"]] +
+                           [r[k][i] for k in PER_SIDE for i in range(4)])
+        print(f"[ok] wrote {len(records)} record(s) to {args.csv_out}")
+        return 0
+
+    for r in records:
+        print(f"[{r['session']}] gen={r['generation']:<4} {r['end']:%Y-%m-%d %H:%M:%S} "
+              f"turns={r['totalTurns']} kills={r['killEvents']} rng={r['rngCalls']} "
+              f"start={r['startSide']} end={r['endSide']}")
+        for i in range(4):
+            if not any(r[k][i] for k in PER_SIDE):
+                continue
+            print(f"      {SIDES[i]}: turns={r['turns'][i]} dmg={r['damage'][i]} "
+                  f"heal={r['heals'][i]} kills={r['kills'][i]} rng={r['rngBySide'][i]}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
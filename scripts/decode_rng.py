@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""
+Decode sdmc:/Fates3GX/fates_rng.bin (RNG stream recorder) into text or
+CSV. Stream encoding mirrors plugin/include/engine/rng_recorder.hpp:
+
+    0x00..0x03  RNG call: [varint bound if bit0] [u32 state if bit1] u32 raw
+    0x10 | m    marker m: u8 side, varint tick delta, varint arg
+    0x20        gap: varint records lost
+    0xFF        session header: u32 magic, u8 version, u32 tick Hz, u64 tick0
+
+Every RNG call is emitted with the map generation, side, side turn index,
+action number and battle serial (0 outside a battle) it happened in, plus the result the game saw
+((raw * bound) >> 32). Calls carry no tick of their own; time_s is the
+time of the preceding marker.
+
+Usage:
+  py scripts/decode_rng.py fates_rng.bin                  # text to stdout
+  py scripts/decode_rng.py fates_rng.bin --csv out.csv    # CSV, calls only
+  py scripts/decode_rng.py fates_rng.bin --summary        # per-turn counts
+"""
+import argparse
+import csv
+import struct
+import sys
+from collections import Counter
+from pathlib import Path
+
+RNG_MAGIC = 0x4E523346  # "F3RN"
+DEFAULT_TICK_HZ = 268111856
+
+TAG_BOUND = 0x01
+TAG_STATE = 0x02
+TAG_MARKER = 0x10
+TAG_GAP = 0x20
+TAG_HEADER = 0xFF
+
+# Must match Fates::Engine::RngMarker (append-only).
+MARKERS = ["MapBegin", "MapEnd", "TurnBegin", "TurnEnd", "ActionEnd",
+           "BattleBegin", "BattleEnd"]
+
+SIDES = {0: "Side0", 1: "Side1", 2: "Side2", 3: "Side3", 0xFF: "Unknown"}
+
+
+class Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def eof(self) -> bool:
+        return self.pos >= len(self.data)
+
+    def u8(self) -> int:
+        v = self.data[self.pos]
+        self.pos += 1
+        return v
+
+    def u32(self) -> int:
+        (v,) = struct.unpack_from("<I", self.data, self.pos)
+        self.pos += 4
+        return v
+
+    def u64(self) -> int:
+        (v,) = struct.unpack_from("<Q", self.data, self.pos)
+        self.pos += 8
+        return v
+
+    def varint(self) -> int:
+        v = 0
+        shift = 0
+        while True:
+            b = self.u8()
+            v |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return v
+            shift += 7
+
+
+def read_stream(path: Path):
+    """Yield dicts: {type: call|marker|gap, ...} with running context."""
+    r = Reader(path.read_bytes())
+
+    session = 0
+    tick_hz = DEFAULT_TICK_HZ
+    tick = 0
+    tick0 = 0
+    bound = 0
+    state = 0
+    gen = 0
+    side = "Unknown"
+    side_turn = 0
+    action = 0
+    battle = 0
+    index = 0
+
+    while not r.eof():
+        start = r.pos
+        try:
+            tag = r.u8()
+
+            if tag == TAG_HEADER:
+                magic = r.u32()
+                if magic != RNG_MAGIC:
+                    raise SystemExit(f"[x] bad header magic at offset 0x{start:X}")
+                version = r.u8()
+                if version != 1:
+                    raise SystemExit(f"[x] unsupported version {version} at offset 0x{start:X}")
+                tick_hz = r.u32() or DEFAULT_TICK_HZ
+                tick0 = tick = r.u64()
+                session += 1
+                bound = state = 0
+                gen, side, side_turn, action, battle, index = 0, "Unknown", 0, 0, 0, 0
+                continue
+
+            if tag <= (TAG_BOUND | TAG_STATE):
+                if tag & TAG_BOUND:
+                    bound = r.varint()
+                if tag & TAG_STATE:
+                    state = r.u32()
+                raw = r.u32()
+                index += 1
+                yield {
+                    "type": "call", "session": session, "index": index,
+                    "time_s": (tick - tick0) / tick_hz, "gen": gen, "side": side,
+                    "sideTurn": side_turn, "action": action, "battle": battle, "state": state,
+                    "raw": raw, "bound": bound, "result": (raw * bound) >> 32,
+                }
+                continue
+
+            if tag & 0xF0 == TAG_MARKER:
+                m = tag & 0x0F
+                name = MARKERS[m] if m < len(MARKERS) else f"Marker{m}"
+                side = SIDES.get(r.u8(), "Unknown")
+                tick += r.varint()
+                arg = r.varint()
+                if name == "MapBegin":
+                    gen, side_turn, action, battle = arg, 0, 0, 0
+                elif name in ("TurnBegin", "TurnEnd"):
+                    side_turn = arg
+                elif name == "ActionEnd":
+                    action += 1
+                    battle = 0
+                elif name == "BattleBegin":
+                    battle = arg
+                elif name in ("BattleEnd", "MapEnd"):
+                    battle = 0
+                yield {
+                    "type": "marker", "session": session, "name": name,
+                    "time_s": (tick - tick0) / tick_hz, "gen": gen, "side": side,
+                    "arg": arg,
+                }
+                continue
+
+            if tag == TAG_GAP:
+                yield {"type": "gap", "session": session, "lost": r.varint()}
+                continue
+
+            raise SystemExit(f"[x] unknown tag 0x{tag:02X} at offset 0x{start:X}")
+        except (IndexError, struct.error):
+            print(f"[!] truncated record at offset 0x{start:X} ignored", file=sys.stderr)
+            return
+
+
+def main(argv):
+    ap = argparse.ArgumentParser()
+    ap.add_argument("stream", help="path to fates_rng.bin")
+    ap.add_argument("--csv", dest="csv_out", help="write RNG calls as CSV to this path")
+    ap.add_argument("--summary", action="store_true", help="print call counts per map/turn/side")
+    args = ap.parse_args(argv)
+
+    items = read_stream(Path(args.stream))
+
+    if args.csv_out:
+        cols = ["session", "index", "time_s", "gen", "side", "sideTurn",
+                "action", "battle", "state", "raw", "bound", "result"]
+        n = 0
+        with open(args.csv_out, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(cols)
+            for it in items:
+                if it["type"] != "call":
+                    continue
+                row = dict(it, time_s=f"{it['time_s']:.6f}",
+                           state=f"0x{it['state']:08X}", raw=f"0x{it['raw']:08X}")
+                w.writerow([row[c] for c in cols])
+                n += 1
+        print(f"[ok] wrote {n} call(s) to {args.csv_out}")
+        return 0
+
+    if args.summary:
+        counts = Counter()
+        lost = 0
+        for it in items:
+            if it["type"] == "call":
+                counts[(it["session"], it["gen"], it["sideTurn"], it["side"])] += 1
+            elif it["type"] == "gap":
+                lost += it["lost"]
+        for (sess, gen, turn, side), n in sorted(counts.items()):
+            print(f"[{sess}] gen={gen:<4} turn={turn:<3} {side:<7} calls={n}")
+        if lost:
+            print(f"[!] {lost} record(s) lost to ring overflow")
+        return 0
+
+    for it in items:
+        if it["type"] == "call":
+            print(f"[{it['session']}] #{it['index']:<8} gen={it['gen']:<4} {it['side']:<7} "
+                  f"turn={it['sideTurn']:<3} act={it['action']:<4} btl={it['battle']:<3} raw=0x{it['raw']:08X} "
+                  f"bound={it['bound']:<6} -> {it['result']}")
+        elif it["type"] == "marker":
+            print(f"[{it['session']}] {it['time_s']:12.6f} -- {it['name']} {it['side']} arg={it['arg']}")
+        else:
+            print(f"[{it['session']}] !! gap: {it['lost']} record(s) lost")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+Decode sdmc:/Fates3GX/fates_trace.bin (binary engine event trace) into
+text or CSV. Record layout mirrors plugin/include/engine/trace.hpp:
+
+    struct TraceRecord {            // 32 bytes, little-endian
+        u64 tick; u16 kind; u8 side; u8 flags;
+        u32 generation; u32 arg[4];
+    };
+
+Usage:
+  py scripts/decode_trace.py fates_trace.bin                 # text to stdout
+  py scripts/decode_trace.py fates_trace.bin --csv out.csv   # CSV
+  py scripts/decode_trace.py fates_trace.bin --kind RngCall  # filter
+"""
+import argparse
+import csv
+import struct
+import sys
+from pathlib import Path
+
+RECORD = struct.Struct("<QHBBI4I")
+assert RECORD.size == 32
+
+KIND_HEADER = 0xFFFF
+TRACE_MAGIC = 0x52543346  # "F3TR"
+DEFAULT_TICK_HZ = 268111856
+
+# Must match Fates::Engine::EventKind (append-only).
+KINDS = [
+    "MapBegin",
+    "MapEnd",
+    "TurnBegin",
+    "TurnEnd",
+    "Kill",
+    "RngCall",
+    "LevelUp",
+    "SkillLearn",
+    "ItemGain",
+    "HpChange",
+    "ActionEnd",
+    "BattleBegin",
+    "BattleEnd",
+    "HpSync",
+    "UnitMove",
+    "ItemUse",
+    "UnitPrewarm",
+]
+
+SIDES = {0: "Side0", 1: "Side1", 2: "Side2", 3: "Side3", 0xFF: "Unknown"}
+
+
+# --- payload formatting ---------------------------------------------------
+
+
+def s32(v: int) -> int:
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+def s16(v: int) -> int:
+    return v - (1 << 16) if v & 0x8000 else v
+
+
+def payload(kind: str, a):
+    """Return an ordered list of (field, value-string) for a record."""
+    if kind in ("MapBegin", "MapEnd"):
+        return [("seq", f"0x{a[0]:08X}"), ("totalTurns", a[1]),
+                ("killEvents", a[2]), ("startSide", SIDES.get(a[3], a[3]))]
+    if kind == "TurnBegin":
+        return [("sideTurn", a[0]), ("totalTurns", a[1])]
+    if kind == "TurnEnd":
+        return [("sideTurn", a[0]), ("totalTurns", a[1]), ("seq", f"0x{a[2]:08X}")]
+    if kind == "Kill":
+        return [("seq", f"0x{a[0]:08X}"), ("dead0", f"0x{a[1]:08X}"),
+                ("dead1", f"0x{a[2]:08X}"), ("flags", f"0x{a[3]:08X}")]
+    if kind == "RngCall":
+        return [("state", f"0x{a[0]:08X}"), ("raw", f"0x{a[1]:08X}"),
+                ("bound", a[2]), ("result", a[3])]
+    if kind == "LevelUp":
+        return [("unit", f"0x{a[0]:08X}"), ("level", a[1])]
+    if kind == "SkillLearn":
+        return [("unit", f"0x{a[0]:08X}"), ("skill", f"0x{a[1] & 0xFFFF:04X}"),
+                ("flags", f"0x{a[1] >> 16:04X}"), ("result", s32(a[2]))]
+    if kind == "ItemGain":
+        return [("unit", f"0x{a[0]:08X}"), ("itemArg", f"0x{a[1]:08X}"),
+                ("mode", f"0x{a[2]:08X}"), ("result", s32(a[3]))]
+    if kind == "HpChange":
+        return [("src", f"0x{a[0]:08X}"), ("tgt", f"0x{a[1]:08X}"),
+                ("amount", s32(a[2])), ("flags", f"0x{a[3]:08X}")]
+    if kind == "HpSync":
+        return [("unit", f"0x{a[0]:08X}"), ("src", f"0x{a[1]:08X}"),
+                ("prev", s32(a[2])), ("new", s32(a[3]))]
+    if kind == "ItemUse":
+        return [("inst", f"0x{a[0]:08X}"), ("unit", f"0x{a[1]:08X}"),
+                ("cmdId", a[2]), ("sideRaw", a[3])]
+    if kind == "UnitPrewarm":
+        return [("unit", f"0x{a[0]:08X}"), ("hp", s32(a[1])),
+                ("level", s32(a[2])), ("sideRaw", s32(a[3]))]
+    if kind in ("ActionEnd", "UnitMove"):
+        return [("inst", f"0x{a[0]:08X}"), ("cmdId", a[1]),
+                ("sideRaw", a[2]), ("unk28", a[3])]
+    if kind == "BattleBegin":
+        return [("calc", f"0x{a[0]:08X}"), ("root", f"0x{a[1]:08X}"),
+                ("atk", f"0x{a[2]:08X}"), ("def", f"0x{a[3]:08X}")]
+    if kind == "BattleEnd":
+        return [("atk", f"0x{a[0]:08X}"), ("def", f"0x{a[1]:08X}"),
+                ("atkLost", s16(a[2] & 0xFFFF)), ("defLost", s16(a[2] >> 16)),
+                ("kills", a[3])]
+    return [(f"a{i}", f"0x{v:08X}") for i, v in enumerate(a)]
+
+
+# --- decoding -------------------------------------------------------------
+
+
+def read_records(path: Path):
+    """Yield (session, seconds, kind, side, generation, args, fields) tuples."""
+    data = path.read_bytes()
+    if len(data) % RECORD.size:
+        print(f"[!] trailing {len(data) % RECORD.size} byte(s) ignored", file=sys.stderr)
+
+    session = 0
+    tick0 = None
+    tick_hz = DEFAULT_TICK_HZ
+
+    for off in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        tick, kind_id, side, _flags, gen, *args = RECORD.unpack_from(data, off)
+
+        if kind_id == KIND_HEADER:
+            if args[0] != TRACE_MAGIC:
+                raise SystemExit(f"[x] bad header magic at offset 0x{off:X}")
+            if gen != RECORD.size:
+                raise SystemExit(f"[x] unsupported record size {gen} at offset 0x{off:X}")
+            session += 1
+            tick0 = tick
+            tick_hz = args[2] or DEFAULT_TICK_HZ
+            continue
+
+        if tick0 is None:
+            tick0 = tick
+
+        kind = KINDS[kind_id] if kind_id < len(KINDS) else f"Kind{kind_id}"
+        secs = (tick - tick0) / tick_hz
+        yield session, secs, kind, SIDES.get(side, str(side)), gen, args, payload(kind, args)
+
+
+def main(argv):
+    ap = argparse.ArgumentParser()
+    ap.add_argument("trace", help="path to fates_trace.bin")
+    ap.add_argument("--csv", dest="csv_out", help="write CSV to this path instead of text")
+    ap.add_argument("--kind", action="append", help="only emit these kinds (repeatable)")
+    args = ap.parse_args(argv)
+
+    records = read_records(Path(args.trace))
+    if args.kind:
+        wanted = set(args.kind)
+        records = (r for r in records if r[2] in wanted)
+
+    if args.csv_out:
+        with open(args.csv_out, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["session", "time_s", "kind", "side", "gen",
+                        "a0", "a1", "a2", "a3", "decoded"])
+            n = 0
+            for sess, secs, kind, side, gen, raw, fields in records:
+                body = " ".join(f"{k}={v}" for k, v in fields)
+                w.writerow([sess, f"{secs:.6f}", kind, side, gen] + list(raw) + [body])
+                n += 1
+        print(f"[ok] wrote {n} record(s) to {args.csv_out}")
+        return 0
+
+    for sess, secs, kind, side, gen, _raw, fields in records:
+        body = " ".join(f"{k}={v}" for k, v in fields)
+        print(f"[{sess}] {secs:12.6f} gen={gen:<4} {side:<7} {kind:<10} {body}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""
+Generate plugin/src/hooks_table.cpp (per-region hook tables) from
+addresses/*.yml.
+
+Every region file that has a title_id and a hooks mapping becomes one
+HookEntry table indexed by Fates::HookId. HookIds are read from
+plugin/include/core/hooks.hpp, so a hook the YAML does not map gets an
+"unmapped" row (targetVA == 0) and is never installed. Region files
+without a title_id or hooks are skipped.
+
+Hook schema (see addresses/na_v11.yml):
+
+  hooks:
+    BTL_HitCalc_Main:            # HookId without the HookId_ prefix
+      name: BTL_HitCalc_Main     # optional display name
+      addr: 0x003A3588           # code VA
+      file_offset: 0x002A3588    # optional, defaults to addr - 0x00100000
+      guard_words: [w0, w1, w2]  # optional, all zero = unchecked
+      thumb: false
+      stability: Core            # Core | Optional | Experimental
+      backend: inline            # optional, mitm (default) | inline
+      aob: "E9 2D 40 ?0 ..."     # optional signature, nibble wildcards
+      aob_offset: 0              # optional, hook site = match + offset
+      note: "..."                # optional, copied as a comment
+
+Region data outside the hook table (also in the region file):
+
+  rng_core: 0x0044AE14          # RNG step function SYS_Rng32 calls;
+                                # required if SYS_Rng32 is mapped
+  turn_state_root: 0x003A4944   # turn-side pointer chain root
+                                # (core/turn_state.hpp), optional
+  layout:                       # struct offsets (engine/unit_layout.hpp)
+    unit:       { level: 0xF1, cur_hp: 0xF3, clone: 0xAC }
+    seq_battle: { dead_flags: 0x280, dead0: 0x284, dead1: 0x288 }
+    battle:     { calc_root: 0x00, root_main: 0x04, root_flags: 0x10 }
+
+A layout field left out is unmapped (kUnmappedField). Each region's
+layout is static_assert'ed against Engine::IsValidLayout in the
+generated file, so a bad offset fails the build.
+
+aob uses the same token syntax as scripts/make_inline.py ("??", "E?",
+"?0"). It is packed into little-endian words for the plugin's
+word-aligned scanner (core/sig_scanner.cpp), so the match start must be
+4-byte aligned; use aob_offset to point at a site inside the pattern.
+
+build.py runs this automatically when a YAML file is newer than the
+generated table.
+
+Usage:
+  py scripts/gen_hook_tables.py            # write plugin/src/hooks_table.cpp
+  py scripts/gen_hook_tables.py --check    # exit 1 if the file is stale
+  py scripts/gen_hook_tables.py --guards-from code.bin [--region na_v11]
+                                           # print guard_words read from a
+                                           # code.bin dump, flag mismatches
+"""
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+
+import yaml
+
+REPO = Path(__file__).resolve().parents[1]
+ADDRS = REPO / "addresses"
+HOOKS_HPP = REPO / "plugin" / "include" / "core" / "hooks.hpp"
+OUT = REPO / "plugin" / "src" / "hooks_table.cpp"
+
+CODE_BASE = 0x00100000
+STABILITIES = ("Core", "Optional", "Experimental")
+BACKENDS = {"mitm": "Mitm", "inline": "Inline"}
+SIG_MAX_WORDS = 16  # kSigMaxWords in core/hooks.hpp
+
+# engine/unit_layout.hpp struct members, in declaration order:
+# (yaml key, C++ member) per GameLayout member.
+LAYOUT_FIELDS = {
+    "unit": ("UnitLayout", [("level", "level"), ("cur_hp", "curHp"), ("max_hp", "maxHp"),
+                            ("side", "side"), ("clone", "clone")]),
+    "seq_battle": ("SeqBattleLayout", [("dead_flags", "deadFlags"), ("dead0", "dead0"),
+                                       ("dead1", "dead1")]),
+    "battle": ("BattleLayout", [("calc_root", "calcRoot"), ("root_main", "rootMain"),
+                                ("root_target", "rootTarget"), ("root_flags", "rootFlags")]),
+}
+UNMAPPED_FIELD = 0xFFFF  # Engine::kUnmappedField
+
+
+def read_hook_ids() -> list[str]:
+    """HookId enumerators in declaration order, without the prefix."""
+    text = HOOKS_HPP.read_text(encoding="utf-8")
+    m = re.search(r"enum\s+HookId\b[^{]*\{(.*?)\};", text, re.S)
+    if not m:
+        raise SystemExit(f"[x] enum HookId not found in {HOOKS_HPP}")
+    body = re.sub(r"//[^\n]*", "", m.group(1))
+    ids = []
+    for tok in body.split(","):
+        name = tok.split("=")[0].strip()
+        if not name:
+            continue
+        if name == "HookId_Count":
+            break
+        if not name.startswith("HookId_"):
+            raise SystemExit(f"[x] unexpected enumerator '{name}' in enum HookId")
+        ids.append(name[len("HookId_"):])
+    return ids
+
+
+def _parse_token(t: str):
+    """One aob token -> (value, mask), nibble wildcards allowed."""
+    if len(t) != 2:
+        raise ValueError(f"bad aob token '{t}'")
+    v = m = 0
+    for shift, ch in ((4, t[0]), (0, t[1])):
+        if ch == "?":
+            continue
+        v |= int(ch, 16) << shift
+        m |= 0xF << shift
+    return v, m
+
+
+def aob_to_words(aob: str):
+    """aob string -> (words, masks), little-endian, padded with wildcards."""
+    toks = [t for t in aob.replace("\t", " ").split(" ") if t]
+    while len(toks) % 4:
+        toks.append("??")
+    words, masks = [], []
+    for i in range(0, len(toks), 4):
+        wv = wm = 0
+        for j, t in enumerate(toks[i:i + 4]):
+            v, m = _parse_token(t)
+            wv |= v << (8 * j)
+            wm |= m << (8 * j)
+        words.append(wv)
+        masks.append(wm)
+    return words, masks
+
+
+def c_str(s: str) -> str:
+    return '"' + s.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def load_layout(path: Path, spec) -> dict:
+    """layout mapping -> {struct key: [offset or None, ...]} in member order."""
+    if not isinstance(spec, dict):
+        raise SystemExit(f"[x] {path.name}: needs a layout mapping (engine/unit_layout.hpp)")
+    unknown = sorted(set(spec) - set(LAYOUT_FIELDS))
+    if unknown:
+        raise SystemExit(f"[x] {path.name}: unknown layout struct(s): {', '.join(unknown)}")
+
+    layout = {}
+    for key, (_, fields) in LAYOUT_FIELDS.items():
+        sub = spec.get(key) or {}
+        names = [f for f, _ in fields]
+        bad = sorted(set(sub) - set(names))
+        if bad:
+            raise SystemExit(f"[x] {path.name}: layout.{key}: unknown field(s): {', '.join(bad)}")
+        offsets = []
+        for name in names:
+            v = sub.get(name)
+            if v is not None:
+                v = int(v)
+                if not 0 <= v < UNMAPPED_FIELD:
+                    raise SystemExit(f"[x] {path.name}: layout.{key}.{name}: bad offset {v:#x}")
+            offsets.append(v)
+        layout[key] = offsets
+    return layout
+
+
+def load_region(path: Path, hook_ids: list[str]):
+    y = yaml.safe_load(path.read_text(encoding="utf-8")) or {}
+    region = y.get("region", path.stem)
+    title_id = y.get("title_id")
+    hooks = y.get("hooks") or {}
+
+    if title_id is None or not hooks:
+        print(f"[skip] {path.name}: no title_id/hooks yet")
+        return None
+
+    unknown = sorted(set(hooks) - set(hook_ids))
+    if unknown:
+        raise SystemExit(f"[x] {path.name}: unknown hook id(s): {', '.join(unknown)}")
+
+    rows = []
+    for hid in hook_ids:
+        spec = hooks.get(hid)
+        if spec is None:
+            rows.append(None)
+            continue
+
+        addr = int(spec["addr"])
+        guard = [int(w) for w in spec.get("guard_words", [0, 0, 0])]
+        if len(guard) != 3:
+            raise SystemExit(f"[x] {path.name}: {hid}: guard_words needs 3 words")
+        stability = spec.get("stability", "Optional")
+        if stability not in STABILITIES:
+            raise SystemExit(f"[x] {path.name}: {hid}: bad stability '{stability}'")
+
+        backend = str(spec.get("backend", "mitm")).lower()
+        if backend not in BACKENDS:
+            raise SystemExit(f"[x] {path.name}: {hid}: bad backend '{backend}'")
+
+        sig = None
+        if spec.get("aob"):
+            try:
+                words, masks = aob_to_words(str(spec["aob"]))
+            except ValueError as e:
+                raise SystemExit(f"[x] {path.name}: {hid}: {e}")
+            if not any(masks):
+                raise SystemExit(f"[x] {path.name}: {hid}: aob is all wildcards")
+            if len(words) > SIG_MAX_WORDS:
+                raise SystemExit(f"[x] {path.name}: {hid}: aob longer than {SIG_MAX_WORDS * 4} bytes")
+            offset = int(spec.get("aob_offset", 0))
+            if not -0x8000 <= offset <= 0x7FFF or offset % 2:
+                raise SystemExit(f"[x] {path.name}: {hid}: bad aob_offset {offset}")
+            sig = {"words": words, "masks": masks, "offset": offset}
+
+        rows.append({
+            "name": spec.get("name", hid),
+            "addr": addr,
+            "file_offset": int(spec.get("file_offset", addr - CODE_BASE)),
+            "guard": guard,
+            "thumb": bool(spec.get("thumb", False)),
+            "stability": stability,
+            "backend": BACKENDS[backend],
+            "sig": sig,
+            "note": spec.get("note"),
+        })
+
+    rng_core = int(y.get("rng_core", 0))
+    if rng_core == 0 and hooks.get("SYS_Rng32") is not None:
+        raise SystemExit(f"[x] {path.name}: SYS_Rng32 is mapped but rng_core is not")
+
+    return {"region": region, "title_id": int(title_id), "file": path.name, "rows": rows,
+            "rng_core": rng_core, "turn_state_root": int(y.get("turn_state_root", 0)),
+            "layout": load_layout(path, y.get("layout"))}
+
+
+def render(regions, hook_ids) -> str:
+    out = []
+    w = out.append
+    w("// hooks_table.cpp")
+    w("//")
+    w("// GENERATED by scripts/gen_hook_tables.py from addresses/*.yml. Do not")
+    w("// edit by hand: change the YAML and re-run the script (build.py does")
+    w("// this automatically when a YAML file is newer than this file).")
+    w("//")
+    w("// One table per region, each indexed by HookId. Hooks a region does not")
+    w("// map have targetVA == 0 and are never installed. The active table is")
+    w("// picked by title ID at boot (SelectHookRegion, core/hook_manager.cpp).")
+    w("// ALL entries currently marked Optional are unstable and do not function.")
+    w('#include "core/hooks.hpp"')
+    w('#include "engine/unit_layout.hpp"')
+    w("")
+    w("namespace Fates {")
+    w("")
+    w("namespace {")
+    for reg in regions:
+        mapped = sum(1 for r in reg["rows"] if r is not None)
+        w("")
+        w(f"// {reg['region']} ({reg['file']}, title {reg['title_id']:016X}): "
+          f"{mapped}/{len(hook_ids)} hooks mapped")
+        w(f"const HookEntry kHooks_{reg['region']}[HookId_Count] = {{")
+        for hid, r in zip(hook_ids, reg["rows"]):
+            if r is None:
+                w(f"    {{ HookId_{hid}, {c_str(hid)}, 0u, 0u, {{ 0u, 0u, 0u }}, "
+                  f"false, HookStability::Optional, HookBackend::Mitm }},  // not mapped")
+                continue
+            if r["note"]:
+                w(f"    // {r['note']}")
+            g = ", ".join(f"0x{v:08X}u" for v in r["guard"])
+            w(f"    {{ HookId_{hid}, {c_str(r['name'])}, 0x{r['addr']:08X}u, "
+              f"0x{r['file_offset']:08X}u, {{ {g} }}, "
+              f"{'true' if r['thumb'] else 'false'}, HookStability::{r['stability']}, "
+              f"HookBackend::{r['backend']} }},")
+        w("};")
+
+        w("")
+        w(f"constexpr Engine::GameLayout kLayout_{reg['region']} = {{")
+        for key, (struct, fields) in LAYOUT_FIELDS.items():
+            vals = ", ".join("Engine::kUnmappedField" if v is None else f"0x{v:03X}u"
+                             for v in reg["layout"][key])
+            w(f"    {{ {vals} }},  // {struct}: {', '.join(m for _, m in fields)}")
+        w("};")
+        w(f"static_assert(Engine::IsValidLayout(kLayout_{reg['region']}),")
+        w(f"              \"addresses/{reg['file']}: layout fails Engine::IsValidLayout\");")
+
+        sigs = [(hid, r["sig"]) for hid, r in zip(hook_ids, reg["rows"])
+                if r is not None and r["sig"] is not None]
+        reg["num_sigs"] = len(sigs)
+        if not sigs:
+            continue
+        w("")
+        for hid, sig in sigs:
+            words = ", ".join(f"0x{v:08X}u" for v in sig["words"])
+            masks = ", ".join(f"0x{v:08X}u" for v in sig["masks"])
+            w(f"const std::uint32_t kSigWords_{reg['region']}_{hid}[] = {{ {words} }};")
+            w(f"const std::uint32_t kSigMasks_{reg['region']}_{hid}[] = {{ {masks} }};")
+        w("")
+        w(f"const HookSignature kSigs_{reg['region']}[] = {{")
+        for hid, sig in sigs:
+            w(f"    {{ HookId_{hid}, {len(sig['words'])}, {sig['offset']}, "
+              f"kSigWords_{reg['region']}_{hid}, kSigMasks_{reg['region']}_{hid} }},")
+        w("};")
+    w("")
+    w("} // anonymous namespace")
+    w("")
+    w("const HookRegionTable kHookRegions[] = {")
+    for reg in regions:
+        if reg["num_sigs"]:
+            sigs = f"kSigs_{reg['region']}, {reg['num_sigs']}"
+        else:
+            sigs = "nullptr, 0"
+        w(f"    {{ {c_str(reg['region'])}, 0x{reg['title_id']:016X}ULL, "
+          f"kHooks_{reg['region']}, HookId_Count, {sigs},")
+        w(f"      0x{reg['rng_core']:08X}u, 0x{reg['turn_state_root']:08X}u, "
+          f"&kLayout_{reg['region']} }},")
+    w("};")
+    w("")
+    w("const std::size_t kNumHookRegions = sizeof(kHookRegions) / sizeof(kHookRegions[0]);")
+    w("")
+    w("const char *const kHookIdNames[HookId_Count] = {")
+    for hid in hook_ids:
+        w(f"    {c_str(hid)},")
+    w("};")
+    w("")
+    w("} // namespace Fates")
+    return "\n".join(out) + "\n"
+
+
+def guards_from(code_bin: Path, regions) -> int:
+    """Print the first three words at each hook's file_offset."""
+    buf = code_bin.read_bytes()
+    bad = 0
+    for reg in regions:
+        print(f"# {reg['region']} ({reg['file']})")
+        for hid, r in zip(reg["hook_ids"], reg["rows"]):
+            if r is None:
+                continue
+            off = r["file_offset"] & ~1
+            if off + 12 > len(buf):
+                print(f"  {hid}: file_offset 0x{off:08X} past end of {code_bin.name}")
+                bad += 1
+                continue
+            cur = list(struct.unpack_from("<3I", buf, off))
+            words = ", ".join(f"0x{v:08X}" for v in cur)
+            if not any(r["guard"]):
+                status = "unchecked, capture these"
+            elif cur == r["guard"]:
+                status = "ok"
+            else:
+                status = "MISMATCH"
+                bad += 1
+            print(f"  {hid}: guard_words: [{words}]  # {status}")
+    return 1 if bad else 0
+
+
+def main(argv):
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--check", action="store_true", help="fail if the generated file is out of date")
+    ap.add_argument("--guards-from", type=Path, metavar="CODE_BIN",
+                    help="print guard words read from a code.bin dump instead of generating")
+    ap.add_argument("--region", help="with --guards-from: only this region")
+    args = ap.parse_args(argv)
+
+    hook_ids = read_hook_ids()
+
+    regions = []
+    for path in sorted(ADDRS.glob("*.yml")):
+        reg = load_region(path, hook_ids)
+        if reg is not None:
+            regions.append(reg)
+
+    if not regions:
+        raise SystemExit("[x] no region in addresses/ has a title_id and hooks")
+
+    seen = {}
+    for reg in regions:
+        if reg["title_id"] in seen:
+            raise SystemExit(f"[x] title_id {reg['title_id']:016X} used by both "
+                             f"{seen[reg['title_id']]} and {reg['file']}")
+        seen[reg["title_id"]] = reg["file"]
+
+    if args.guards_from:
+        picked = [r for r in regions if args.region in (None, r["region"])]
+        if not picked:
+            raise SystemExit(f"[x] no region '{args.region}'")
+        for reg in picked:
+            reg["hook_ids"] = hook_ids
+        return guards_from(args.guards_from, picked)
+
+    text = render(regions, hook_ids)
+
+    if args.check:
+        current = OUT.read_text(encoding="utf-8") if OUT.exists() else ""
+        if current != text:
+            print(f"[x] {OUT.relative_to(REPO)} is stale; run scripts/gen_hook_tables.py")
+            return 1
+        print("[ok] hook tables up to date")
+        return 0
+
+    OUT.write_text(text, encoding="utf-8", newline="\n")
+    print(f"[ok] wrote {OUT.relative_to(REPO)} ({len(regions)} region(s), {len(hook_ids)} hook ids)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))